@@ -0,0 +1,62 @@
+#include <string_view>
+
+#include <sebib/seblog.hpp>
+
+#include "arguments.hpp"
+
+namespace benchmark
+{
+    Arguments::Arguments(int argc, const char* const* argv)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view argument {argv[i]};
+
+            seb::assertFatal(argument.starts_with("--"), "Unexpected argument {}", argument);
+
+            std::string name {argument.substr(2)};
+
+            if (i + 1 < argc && !std::string_view {argv[i + 1]}.starts_with("--"))
+            {
+                this->values[std::move(name)] = argv[i + 1];
+                ++i;
+            }
+            else
+            {
+                this->values[std::move(name)] = "";
+            }
+        }
+    }
+
+    bool Arguments::hasFlag(const std::string& name) const
+    {
+        return this->values.contains(name);
+    }
+
+    std::string Arguments::getString(const std::string& name, std::string defaultValue) const
+    {
+        if (const auto it = this->values.find(name); it != this->values.end())
+        {
+            return it->second;
+        }
+
+        return defaultValue;
+    }
+
+    std::size_t Arguments::getSize(const std::string& name, std::size_t defaultValue) const
+    {
+        if (const auto it = this->values.find(name); it != this->values.end())
+        {
+            try
+            {
+                return static_cast<std::size_t>(std::stoull(it->second));
+            }
+            catch (const std::exception&)
+            {
+                seb::panic("Argument --{} expects a number, got {}", name, it->second);
+            }
+        }
+
+        return defaultValue;
+    }
+} // namespace benchmark
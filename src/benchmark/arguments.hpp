@@ -0,0 +1,32 @@
+#ifndef SRC_BENCHMARK_ARGUMENTS_HPP
+#define SRC_BENCHMARK_ARGUMENTS_HPP
+
+#include <map>
+#include <string>
+
+namespace benchmark
+{
+    /// @brief `--key value` and `--flag` style command line arguments
+    class Arguments
+    {
+    public:
+
+        Arguments(int argc, const char* const* argv);
+        ~Arguments()                           = default;
+
+        Arguments()                            = delete;
+        Arguments(const Arguments&)            = delete;
+        Arguments(Arguments&&)                 = delete;
+        Arguments& operator=(const Arguments&) = delete;
+        Arguments& operator=(Arguments&&)      = delete;
+
+        [[nodiscard]] bool hasFlag(const std::string& name) const;
+        [[nodiscard]] std::string getString(const std::string& name, std::string defaultValue) const;
+        [[nodiscard]] std::size_t getSize(const std::string& name, std::size_t defaultValue) const;
+
+    private:
+        std::map<std::string, std::string> values;
+    }; // class Arguments
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_ARGUMENTS_HPP
@@ -0,0 +1,209 @@
+#include <chrono>
+#include <random>
+
+#include <sebib/seblog.hpp>
+
+#include <world/binary_mesher.hpp>
+#include <world/brickmap.hpp>
+#include <world/chunk_mesh.hpp>
+#include <world/padded_chunk.hpp>
+#include <world/terrain.hpp>
+
+#include "brickmap_benchmark.hpp"
+#include "terrain_fixture.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double toMicroseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::micro> {duration}.count();
+    }
+
+    /// @brief What Brickmap::isEmpty() has to agree with
+    bool isEmptyInStorage(const world::VoxelStorage& storage, world::WorldPosition min, world::WorldPosition max)
+    {
+        for (std::int32_t y = min.y; y <= max.y; ++y)
+        {
+            for (std::int32_t z = min.z; z <= max.z; ++z)
+            {
+                for (std::int32_t x = min.x; x <= max.x; ++x)
+                {
+                    if (storage.getVoxel({x, y, z}) != world::AirVoxel)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runBrickmapBenchmark(const Arguments& arguments)
+    {
+        const auto radius  = static_cast<std::int32_t>(arguments.getSize("radius", 8));
+        const auto seed    = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const auto queries = arguments.getSize("queries", 100000);
+
+        const world::TerrainGenerator generator {seed};
+
+        world::VoxelStorage                       storage {};
+        const std::vector<world::ChunkCoordinate> coordinates = generateTerrainDisc(storage, generator, radius);
+        const std::size_t                         columns     = coordinates.size() / static_cast<std::size_t>(MaxTerrainChunkY);
+
+        // as the streamer would hand them over, one at a time
+        world::Brickmap brickmap {};
+
+        Clock::time_point start = Clock::now();
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            brickmap.setChunk(coordinate, *storage.getChunk(coordinate));
+        }
+        const Clock::duration buildTime = Clock::now() - start;
+
+        std::size_t meshBytes = 0;
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            const world::PaddedChunk padded {storage, coordinate};
+
+            meshBytes += world::buildChunkMesh(world::meshBinary(padded)).faces.size() * sizeof(render::VoxelFace);
+        }
+
+        std::vector<std::uint32_t> words (brickmap.getGpuWordCount());
+
+        start = Clock::now();
+        brickmap.writeGpuWords(words);
+        const Clock::duration flattenTime = Clock::now() - start;
+
+        const world::Brickmap::Statistics statistics = brickmap.getStatistics();
+
+        const double squareKilometres =
+            static_cast<double>(columns * world::ChunkExtent * world::ChunkExtent) / 1e6;
+
+        Report report {};
+        report.setInteger("chunks", coordinates.size());
+        report.setNumber("square_kilometres", squareKilometres);
+        report.setNumber("build_us_per_chunk", toMicroseconds(buildTime) / static_cast<double>(coordinates.size()));
+        report.setNumber(
+            "chunks_per_second",
+            static_cast<double>(coordinates.size()) / std::chrono::duration<double> {buildTime}.count());
+        report.setNumber("gpu_flatten_us", toMicroseconds(flattenTime));
+        report.setInteger("bricks", statistics.bricks);
+        report.setInteger("solid_slots", statistics.solid_slots);
+        report.setInteger("octree_nodes", statistics.octree_nodes);
+        report.setInteger("octree_depth", static_cast<std::size_t>(statistics.octree_depth));
+
+        Report memory {};
+        memory.setInteger("brickmap_bytes", statistics.bytes);
+        memory.setInteger("voxel_bytes", storage.getMemoryUsage());
+        memory.setInteger("mesh_bytes", meshBytes);
+        memory.setNumber("brickmap_mib_per_km2", static_cast<double>(statistics.bytes) / (1024.0 * 1024.0) / squareKilometres);
+        memory.setNumber("voxel_mib_per_km2", static_cast<double>(storage.getMemoryUsage()) / (1024.0 * 1024.0) / squareKilometres);
+        memory.setNumber("mesh_mib_per_km2", static_cast<double>(meshBytes) / (1024.0 * 1024.0) / squareKilometres);
+        memory.setNumber("mesh_vs_brickmap", static_cast<double>(meshBytes) / static_cast<double>(statistics.bytes));
+        report.setObject("memory", memory);
+
+        // every voxel of the origin's column has to read the same
+        std::size_t mismatchedVoxels = 0;
+        for (std::int32_t y = 0; y < MaxTerrainChunkY * world::ChunkExtent; ++y)
+        {
+            for (std::int32_t z = 0; z < world::ChunkExtent; ++z)
+            {
+                for (std::int32_t x = 0; x < world::ChunkExtent; ++x)
+                {
+                    const bool isSolid = storage.getVoxel({x, y, z}) != world::AirVoxel;
+
+                    mismatchedVoxels += brickmap.isSolid({x, y, z}) != isSolid ? 1U : 0U;
+                }
+            }
+        }
+
+        // what an edit costs, a pit dug into the surface chunk at the origin
+        const world::ChunkCoordinate edited = world::toChunkCoordinate({0, generator.getSurfaceHeight(0, 0), 0});
+        world::Chunk&                chunk  = storage.getOrCreateChunk(edited);
+
+        for (std::int32_t y = 0; y < world::ChunkExtent; ++y)
+        {
+            for (std::int32_t z = 8; z < 24; ++z)
+            {
+                for (std::int32_t x = 8; x < 24; ++x)
+                {
+                    chunk.set({x, y, z}, world::AirVoxel);
+                }
+            }
+        }
+
+        start = Clock::now();
+        brickmap.setChunk(edited, chunk);
+        report.setNumber("edit_us", toMicroseconds(Clock::now() - start));
+
+        std::mt19937 random {11};
+        const std::int32_t extent = (radius - 1) * world::ChunkExtent * 7 / 10;
+        std::uniform_int_distribution<std::int32_t> horizontal {-extent, extent};
+        std::uniform_int_distribution<std::int32_t> vertical {0, MaxTerrainChunkY * world::ChunkExtent - 1};
+        std::uniform_int_distribution<std::int32_t> size {0, 15};
+
+        std::vector<std::pair<world::WorldPosition, world::WorldPosition>> boxes {};
+        for (std::size_t i = 0; i < queries; ++i)
+        {
+            const world::WorldPosition min {horizontal(random), vertical(random), horizontal(random)};
+            boxes.emplace_back(min, min + world::WorldPosition {size(random), size(random), size(random)});
+        }
+
+        std::size_t empty = 0;
+        start = Clock::now();
+        for (const auto& [min, max] : boxes)
+        {
+            empty += brickmap.isEmpty(min, max) ? 1U : 0U;
+        }
+        const Clock::duration queryTime = Clock::now() - start;
+
+        std::size_t storageEmpty = 0;
+        std::size_t mismatchedBoxes = 0;
+        start = Clock::now();
+        for (const auto& [min, max] : boxes)
+        {
+            const bool isEmpty = isEmptyInStorage(storage, min, max);
+
+            storageEmpty += isEmpty ? 1U : 0U;
+            mismatchedBoxes += isEmpty != brickmap.isEmpty(min, max) ? 1U : 0U;
+        }
+        const Clock::duration storageQueryTime = Clock::now() - start;
+
+        seb::assertFatal(
+            mismatchedVoxels == 0 && mismatchedBoxes == 0 && storageEmpty == empty,
+            "Brickmap disagrees with the chunks on {} voxels and {} boxes",
+            mismatchedVoxels,
+            mismatchedBoxes);
+
+        report.setNumber("empty_box_fraction", static_cast<double>(empty) / static_cast<double>(queries));
+        report.setNumber("box_query_ns", toMicroseconds(queryTime) * 1000.0 / static_cast<double>(queries));
+        report.setNumber(
+            "box_query_speedup_vs_chunks",
+            std::chrono::duration<double> {storageQueryTime}.count() / std::chrono::duration<double> {queryTime}.count());
+
+        // removing and adding every chunk again goes through the free lists
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            brickmap.removeChunk(coordinate);
+        }
+
+        seb::assertFatal(brickmap.getStatistics().chunks == 0, "Brickmap kept chunks after removing every one");
+
+        start = Clock::now();
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            brickmap.setChunk(coordinate, *storage.getChunk(coordinate));
+        }
+        report.setNumber(
+            "rebuild_us_per_chunk", toMicroseconds(Clock::now() - start) / static_cast<double>(coordinates.size()));
+        report.setInteger("rebuilt_bytes", brickmap.getStatistics().bytes);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,22 @@
+#ifndef SRC_BENCHMARK_BRICKMAP__BENCHMARK_HPP
+#define SRC_BENCHMARK_BRICKMAP__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Generates the terrain scene's full resolution chunks around
+    /// the origin and adds them to a world::Brickmap one at a time. Reports
+    /// what building, editing and flattening it for the GPU costs and its
+    /// bytes per square kilometre, one voxel being a metre, next to those
+    /// of the chunks themselves and of their meshes. Times box queries and
+    /// checks every answer against the chunks. All on one core.
+    ///
+    /// --radius  <n>   chunk columns within n of the origin (8)
+    /// --seed    <n>   terrain seed (1337)
+    /// --queries <n>   random boxes to query (100000)
+    [[nodiscard]] Report runBrickmapBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_BRICKMAP__BENCHMARK_HPP
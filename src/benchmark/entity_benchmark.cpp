@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include <sebib/seblog.hpp>
+
+#include <render/vulkan/gpu_structs.hpp>
+#include <util/worker_pool.hpp>
+#include <world/entity_store.hpp>
+#include <world/meshing_pipeline.hpp>
+#include <world/system_scheduler.hpp>
+
+#include "entity_benchmark.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float TickSeconds  = 1.0f / 60.0f;
+    constexpr float FrameMs      = 1000.0f / 60.0f;
+    // entities bounce back between the planes at y = +-Bound
+    constexpr float Bound        = 256.0f;
+    // iterations of the single threaded query, so short runs still time well
+    constexpr std::size_t Passes = 16;
+
+    struct Position
+    {
+        glm::vec3 value;
+    };
+
+    struct Velocity
+    {
+        glm::vec3 value;
+    };
+
+    struct Spin
+    {
+        float angle;
+        float rate;
+    };
+
+    struct Health
+    {
+        float value;
+        float decay;
+    };
+
+    struct Model
+    {
+        glm::mat4 matrix;
+    };
+
+    /// @brief One entity laid out the way render::Object keeps its
+    /// transform, everything together
+    struct Actor
+    {
+        Position position;
+        Velocity velocity;
+        Spin     spin;
+        Health   health;
+        Model    model;
+    };
+
+    /// @brief The same @param count entities for every @param seed, every
+    /// other one spins and every third decays
+    std::vector<world::Entity> populate(world::EntityStore& store, std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937                          generator {seed};
+        std::uniform_real_distribution<float> coordinate {-Bound, Bound};
+        std::uniform_real_distribution<float> speed {-32.0f, 32.0f};
+
+        std::vector<world::Entity> entities {};
+        entities.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Position position {{coordinate(generator), coordinate(generator), coordinate(generator)}};
+            const Velocity velocity {{speed(generator), speed(generator), speed(generator)}};
+            const Spin     spin {0.0f, speed(generator)};
+            const Health   health {100.0f, std::abs(speed(generator))};
+            const Model    model {glm::mat4 {1.0f}};
+
+            const bool isSpinning = i % 2 == 0;
+            const bool isDecaying = i % 3 == 0;
+
+            if (isSpinning && isDecaying)
+            {
+                entities.push_back(store.create(position, velocity, model, spin, health));
+            }
+            else if (isSpinning)
+            {
+                entities.push_back(store.create(position, velocity, model, spin));
+            }
+            else if (isDecaying)
+            {
+                entities.push_back(store.create(position, velocity, model, health));
+            }
+            else
+            {
+                entities.push_back(store.create(position, velocity, model));
+            }
+        }
+
+        return entities;
+    }
+
+    void integrate(Position& position, const Velocity& velocity)
+    {
+        position.value = position.value + velocity.value * TickSeconds;
+    }
+
+    /// @brief Two stages: integrate, spin and decay touch different
+    /// components and run together, bounce and models read the positions
+    /// integrate writes and run after
+    void addSystems(world::SystemScheduler& scheduler)
+    {
+        scheduler.add<Position, const Velocity>("integrate", integrate);
+
+        scheduler.add<Spin>("spin", [](Spin& spin)
+        {
+            spin.angle = std::fmod(spin.angle + spin.rate * TickSeconds, 6.28318530718f);
+        });
+
+        scheduler.add<Health>("decay", [](Health& health)
+        {
+            health.value = std::max(0.0f, health.value - health.decay * TickSeconds);
+        });
+
+        scheduler.add<const Position, Velocity>("bounce", [](const Position& position, Velocity& velocity)
+        {
+            if ((position.value.y > Bound && velocity.value.y > 0.0f)
+                || (position.value.y < -Bound && velocity.value.y < 0.0f))
+            {
+                velocity.value.y = -velocity.value.y;
+            }
+        });
+
+        scheduler.add<const Position, const Spin, Model>(
+            "models",
+            [](const Position& position, const Spin& spin, Model& model)
+            {
+                const float cosine = std::cos(spin.angle);
+                const float sine   = std::sin(spin.angle);
+
+                model.matrix[0] = glm::vec4 {cosine, 0.0f, -sine, 0.0f};
+                model.matrix[2] = glm::vec4 {sine, 0.0f, cosine, 0.0f};
+                model.matrix[3] = glm::vec4 {position.value.x, position.value.y, position.value.z, 1.0f};
+            });
+    }
+
+    /// @brief Ticks of @param scheduler in milliseconds
+    std::vector<double> tick(world::SystemScheduler& scheduler, world::EntityStore& store, std::size_t ticks)
+    {
+        std::vector<double> tickMs {};
+
+        for (std::size_t i = 0; i < ticks; ++i)
+        {
+            const Clock::time_point start = Clock::now();
+            scheduler.run(store);
+            tickMs.push_back(std::chrono::duration<double, std::milli> {Clock::now() - start}.count());
+        }
+
+        return tickMs;
+    }
+
+    /// @brief Entities of @param entities whose @param Component isn't
+    /// bit for bit the same in @param store and @param expected
+    template<class Component>
+    std::size_t countMismatches(
+        const world::EntityStore&         store,
+        const world::EntityStore&         expected,
+        const std::vector<world::Entity>& entities)
+    {
+        std::size_t mismatches = 0;
+
+        for (world::Entity entity : entities)
+        {
+            const Component* actual = store.get<Component>(entity);
+            const Component* wanted = expected.get<Component>(entity);
+
+            if ((actual == nullptr) != (wanted == nullptr)
+                || (actual != nullptr && std::memcmp(actual, wanted, sizeof(Component)) != 0))
+            {
+                ++mismatches;
+            }
+        }
+
+        return mismatches;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runEntityBenchmark(const Arguments& arguments)
+    {
+        const auto count   = arguments.getSize("entities", 250000);
+        const auto ticks   = arguments.getSize("ticks", 120);
+        const auto seed    = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const auto workers = arguments.getSize("workers", world::MeshingPipeline::getDefaultWorkerCount());
+
+        const auto perEntity = [&](Clock::duration duration, std::size_t operations)
+        {
+            return std::chrono::duration<double, std::nano> {duration}.count() / static_cast<double>(operations);
+        };
+
+        Report report {};
+        report.setInteger("entities", count);
+        report.setInteger("workers", workers);
+
+        world::EntityStore store {};
+
+        Clock::time_point start = Clock::now();
+        populate(store, count, seed);
+        report.setNumber("create_ns_per_entity", perEntity(Clock::now() - start, count));
+        report.setInteger("archetypes", store.getStatistics().archetypes);
+
+        // one query over contiguous columns, against the same update over
+        // whole structs that drag their matrices through the cache
+        Report iteration {};
+
+        start = Clock::now();
+        for (std::size_t i = 0; i < Passes; ++i)
+        {
+            store.forEach<Position, const Velocity>(integrate);
+        }
+        const double storeNs = perEntity(Clock::now() - start, count * Passes);
+
+        std::vector<Actor> actors (count);
+        store.forEach<const Position, const Velocity>([&, i = std::size_t {0}](const Position& p, const Velocity& v) mutable
+        {
+            actors[i++] = Actor {.position {p}, .velocity {v}, .spin {}, .health {}, .model {glm::mat4 {1.0f}}};
+        });
+
+        start = Clock::now();
+        for (std::size_t i = 0; i < Passes; ++i)
+        {
+            for (Actor& actor : actors)
+            {
+                integrate(actor.position, actor.velocity);
+            }
+        }
+        const double actorNs = perEntity(Clock::now() - start, count * Passes);
+
+        iteration.setNumber("store_ns_per_entity", storeNs);
+        iteration.setNumber("array_of_structs_ns_per_entity", actorNs);
+        iteration.setNumber("store_speedup", actorNs / storeNs);
+        report.setObject("iteration", iteration);
+
+        // the same entities twice, ticked without and with workers
+        world::EntityStore               expected {};
+        world::EntityStore               ticked {};
+        const std::vector<world::Entity> expectedEntities = populate(expected, count, seed);
+        const std::vector<world::Entity> tickedEntities   = populate(ticked, count, seed);
+
+        util::WorkerPool       noWorkers {0};
+        util::WorkerPool       pool {workers};
+        world::SystemScheduler oneThread {noWorkers};
+        world::SystemScheduler scheduled {pool};
+        addSystems(oneThread);
+        addSystems(scheduled);
+
+        const std::vector<double> oneThreadMs = tick(oneThread, expected, ticks);
+        const std::vector<double> scheduledMs = tick(scheduled, ticked, ticks);
+
+        const Statistics oneThreadStatistics = Statistics::fromSamples(oneThreadMs);
+        const Statistics scheduledStatistics = Statistics::fromSamples(scheduledMs);
+
+        Report systems {};
+        systems.setInteger("systems", scheduled.getStatistics().systems);
+        systems.setInteger("stages", scheduled.getStatistics().stages);
+        systems.setInteger("batches", scheduled.getStatistics().batches);
+        systems.setStatistics("one_thread_tick_ms", oneThreadStatistics);
+        systems.setStatistics("tick_ms", scheduledStatistics);
+        systems.setNumber("worker_speedup", oneThreadStatistics.mean / scheduledStatistics.mean);
+        systems.setNumber("ns_per_entity", scheduledStatistics.mean * 1e6 / static_cast<double>(count));
+        systems.setNumber("p99_frame_fraction", scheduledStatistics.p99 / static_cast<double>(FrameMs));
+        report.setObject("systems", systems);
+
+        // handles are handed out in the same order, so both stores agree on them
+        const std::size_t mismatches =
+            countMismatches<Position>(ticked, expected, tickedEntities)
+            + countMismatches<Velocity>(ticked, expected, tickedEntities)
+            + countMismatches<Spin>(ticked, expected, tickedEntities)
+            + countMismatches<Health>(ticked, expected, tickedEntities)
+            + countMismatches<Model>(ticked, expected, tickedEntities);
+
+        seb::assertFatal(
+            tickedEntities == expectedEntities && mismatches == 0,
+            "Ticking with workers disagrees with one thread on {} components",
+            mismatches);
+
+        // structural changes on a tenth of the entities, picked at random
+        std::mt19937 generator {seed};
+        std::vector<world::Entity> picked {};
+
+        for (std::size_t i = 0; i < std::max(count / 10, std::size_t {1}); ++i)
+        {
+            picked.push_back(tickedEntities[generator() % count]);
+        }
+
+        std::sort(picked.begin(), picked.end(), [](world::Entity l, world::Entity r) { return l.index < r.index; });
+        picked.erase(std::unique(picked.begin(), picked.end()), picked.end());
+
+        Report structural {};
+
+        start = Clock::now();
+        for (world::Entity entity : picked)
+        {
+            ticked.add(entity, Health {50.0f, 1.0f});
+        }
+        for (world::Entity entity : picked)
+        {
+            ticked.remove<Health>(entity);
+        }
+        structural.setNumber("add_remove_ns", perEntity(Clock::now() - start, picked.size() * 2));
+
+        start = Clock::now();
+        for (world::Entity entity : picked)
+        {
+            ticked.destroy(entity);
+        }
+        structural.setNumber("destroy_ns", perEntity(Clock::now() - start, picked.size()));
+
+        std::size_t aliveStaleHandles = 0;
+        for (world::Entity entity : picked)
+        {
+            aliveStaleHandles += ticked.isAlive(entity) ? 1U : 0U;
+        }
+
+        // reuses every destroyed slot
+        start = Clock::now();
+        populate(ticked, picked.size(), seed + 1);
+        structural.setNumber("recreate_ns", perEntity(Clock::now() - start, picked.size()));
+
+        for (world::Entity entity : picked)
+        {
+            aliveStaleHandles += ticked.isAlive(entity) ? 1U : 0U;
+        }
+
+        structural.setInteger("changed_entities", picked.size());
+        structural.setInteger("archetypes", ticked.getStatistics().archetypes);
+        report.setObject("structural", structural);
+
+        seb::assertFatal(aliveStaleHandles == 0, "{} handles of destroyed entities are still alive", aliveStaleHandles);
+
+        return report;
+    }
+} // namespace benchmark
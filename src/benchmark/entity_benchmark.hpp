@@ -0,0 +1,26 @@
+#ifndef SRC_BENCHMARK_ENTITY__BENCHMARK_HPP
+#define SRC_BENCHMARK_ENTITY__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Fills a world::EntityStore with moving, spinning and decaying
+    /// entities spread over four archetypes and measures creating them,
+    /// iterating one query on one thread against the same update over an
+    /// array of structs, and ticking five systems with a
+    /// world::SystemScheduler on the calling thread alone and with workers,
+    /// each tick against a 60Hz frame. Both schedulers' results have to match
+    /// exactly. Then times adding and removing a component and destroying and
+    /// recreating entities, and checks every destroyed entity's handle went
+    /// stale.
+    ///
+    /// --entities <n>   entities (250000)
+    /// --ticks    <n>   ticks per scheduler (120)
+    /// --seed     <n>   seed of the entities' initial state (1337)
+    /// --workers  <n>   system workers besides the calling thread (all but one hardware thread)
+    [[nodiscard]] Report runEntityBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_ENTITY__BENCHMARK_HPP
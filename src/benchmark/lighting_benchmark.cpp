@@ -0,0 +1,211 @@
+#include <chrono>
+#include <memory>
+
+#include <sebib/seblog.hpp>
+
+#include <util/worker_pool.hpp>
+#include <world/light_engine.hpp>
+#include <world/meshing_pipeline.hpp>
+#include <world/terrain.hpp>
+
+#include "lighting_benchmark.hpp"
+#include "terrain_fixture.hpp"
+
+namespace
+{
+    struct Relight
+    {
+        double      ms;
+        std::size_t rounds;
+        std::size_t visited_voxels;
+    };
+
+    /// @brief Waits for @param engine to spread everything queued and
+    /// collects it. The changes may be spread over several propagations, so
+    /// it's the engine's totals since @param before
+    Relight settle(world::LightEngine& engine, const world::LightEngine::Statistics& before)
+    {
+        engine.waitUntilSettled();
+        static_cast<void>(engine.collect());
+
+        const world::LightEngine::Statistics after = engine.getStatistics();
+        const auto elapsed = std::chrono::duration<double, std::milli> {
+            after.propagation_time_total - before.propagation_time_total};
+
+        return Relight {
+            .ms             {elapsed.count()},
+            .rounds         {after.rounds_total - before.rounds_total},
+            .visited_voxels {after.visited_voxels_total - before.visited_voxels_total},
+        };
+    }
+
+    /// @brief A new engine, every chunk of @param storage queued but not
+    /// necessarily spread yet
+    std::unique_ptr<world::LightEngine> lightFromScratch(const world::VoxelStorage& storage, util::WorkerPool& pool)
+    {
+        auto engine = std::make_unique<world::LightEngine>(pool);
+
+        storage.forEachChunk([&](world::ChunkCoordinate coordinate, const world::Chunk& chunk)
+        {
+            engine->addChunk(coordinate, chunk);
+        });
+
+        return engine;
+    }
+
+    /// @brief Sets the voxel in the storage and tells @param engine
+    void setVoxel(
+        world::VoxelStorage& storage, world::LightEngine& engine, world::WorldPosition position, world::Voxel voxel)
+    {
+        world::Chunk& chunk = storage.getOrCreateChunk(world::toChunkCoordinate(position));
+        const world::LocalPosition local  = world::toLocalPosition(position);
+        const world::Voxel         before = chunk.get(local);
+
+        chunk.set(local, voxel);
+        engine.updateVoxel(position, before, voxel);
+    }
+
+    benchmark::Report toReport(const Relight& relight)
+    {
+        benchmark::Report report {};
+        report.setNumber("ms", relight.ms);
+        report.setInteger("rounds", relight.rounds);
+        report.setInteger("visited_voxels", relight.visited_voxels);
+
+        return report;
+    }
+
+    /// @brief The topmost air voxel at least 16 below the surface in the
+    /// origin's column, nullopt if there is no cave
+    std::optional<world::WorldPosition> findCave(const world::VoxelStorage& storage, std::int32_t surface)
+    {
+        for (std::int32_t y = surface - 16; y > 0; --y)
+        {
+            const world::Chunk* chunk = storage.getChunk(world::toChunkCoordinate({0, y, 0}));
+
+            if (chunk != nullptr && chunk->get(world::toLocalPosition({0, y, 0})) == world::AirVoxel)
+            {
+                return world::WorldPosition {0, y, 0};
+            }
+        }
+
+        return std::nullopt;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runLightingBenchmark(const Arguments& arguments)
+    {
+        const auto radius  = static_cast<std::int32_t>(arguments.getSize("radius", 6));
+        const auto seed    = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const auto workers = arguments.getSize("workers", world::MeshingPipeline::getDefaultWorkerCount());
+
+        const world::TerrainGenerator generator {seed};
+
+        world::VoxelStorage storage {};
+        generateTerrainDisc(storage, generator, radius);
+
+        const auto chunks = static_cast<double>(storage.getChunkCount());
+
+        Report report {};
+        report.setInteger("chunks", storage.getChunkCount());
+        report.setInteger("workers", workers);
+
+        util::WorkerPool noWorkers {0};
+        util::WorkerPool pool {workers};
+
+        const Relight singleThreaded = settle(*lightFromScratch(storage, noWorkers), {});
+
+        std::unique_ptr<world::LightEngine> engine  = lightFromScratch(storage, pool);
+        const Relight                       initial = settle(*engine, {});
+
+        report.setObject("initial_one_thread", toReport(singleThreaded));
+        report.setObject("initial", toReport(initial));
+        report.setNumber("chunks_per_second", chunks / (initial.ms / 1000.0));
+        report.setNumber("worker_speedup", singleThreaded.ms / initial.ms);
+        report.setInteger("light_bytes", engine->getStatistics().light_bytes);
+        report.setNumber(
+            "light_bytes_per_chunk", static_cast<double>(engine->getStatistics().light_bytes) / chunks);
+
+        const std::int32_t surface = generator.getSurfaceHeight(0, 0);
+
+        Report edits {};
+
+        const auto edit = [&](const char* name, auto&& apply)
+        {
+            const world::LightEngine::Statistics before = engine->getStatistics();
+
+            apply();
+            edits.setObject(name, toReport(settle(*engine, before)));
+        };
+
+        const world::WorldPosition surfaceLamp {0, surface + 2, 0};
+
+        edit("place_surface_lamp", [&] { setVoxel(storage, *engine, surfaceLamp, world::material::Lamp); });
+        edit("remove_surface_lamp", [&] { setVoxel(storage, *engine, surfaceLamp, world::AirVoxel); });
+
+        if (const std::optional<world::WorldPosition> cave = findCave(storage, surface); cave.has_value())
+        {
+            edit("place_cave_lamp", [&] { setVoxel(storage, *engine, *cave, world::material::Lamp); });
+            edit("remove_cave_lamp", [&] { setVoxel(storage, *engine, *cave, world::AirVoxel); });
+            // left in place, so the check below covers block light too
+            edit("place_cave_lamp_again", [&] { setVoxel(storage, *engine, *cave, world::material::Lamp); });
+        }
+
+        // lets sky light down into the rock
+        edit("dig_pit", [&]
+        {
+            for (std::int32_t y = surface - 12; y <= surface; ++y)
+            {
+                for (std::int32_t z = 4; z < 8; ++z)
+                {
+                    for (std::int32_t x = 4; x < 8; ++x)
+                    {
+                        setVoxel(storage, *engine, {x, y, z}, world::AirVoxel);
+                    }
+                }
+            }
+        });
+        edit("cover_pit", [&]
+        {
+            for (std::int32_t z = 4; z < 8; ++z)
+            {
+                for (std::int32_t x = 4; x < 8; ++x)
+                {
+                    setVoxel(storage, *engine, {x, surface, z}, world::material::Stone);
+                }
+            }
+        });
+
+        const Relight relight = settle(*lightFromScratch(storage, pool), {});
+        edits.setObject("full_relight", toReport(relight));
+
+        report.setObject("edits", edits);
+
+        // the incremental updates have to land where lighting the edited
+        // terrain from scratch does
+        const std::unique_ptr<world::LightEngine> fresh = lightFromScratch(storage, pool);
+        static_cast<void>(settle(*fresh, {}));
+
+        std::size_t mismatchedVoxels = 0;
+
+        storage.forEachChunk([&](world::ChunkCoordinate coordinate, const world::Chunk&)
+        {
+            const world::ChunkLight* incremental = engine->getLight(coordinate);
+            const world::ChunkLight* expected    = fresh->getLight(coordinate);
+
+            for (std::size_t i = 0; i < world::ChunkVolume; ++i)
+            {
+                mismatchedVoxels += incremental->get(i) != expected->get(i) ? 1U : 0U;
+            }
+        });
+
+        seb::assertFatal(
+            mismatchedVoxels == 0,
+            "Incremental light disagrees with a full relight on {} voxels",
+            mismatchedVoxels);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,24 @@
+#ifndef SRC_BENCHMARK_LIGHTING__BENCHMARK_HPP
+#define SRC_BENCHMARK_LIGHTING__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Generates the terrain scene's full resolution chunks around
+    /// the origin and lights them from scratch with the world::LightEngine,
+    /// once on the calling thread alone and once with workers. Then places
+    /// and removes a lamp in a cave and on the surface and digs a pit,
+    /// timing each incremental update against relighting everything, and
+    /// checks the incrementally updated light matches a fresh relight of
+    /// the edited terrain. Times are the engine's own, spent on its thread
+    /// between queueing the changes and their light settling.
+    ///
+    /// --radius  <n>   chunk columns within n of the origin (6)
+    /// --seed    <n>   terrain seed (1337)
+    /// --workers <n>   light workers besides the calling thread (all but one hardware thread)
+    [[nodiscard]] Report runLightingBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_LIGHTING__BENCHMARK_HPP
@@ -0,0 +1,208 @@
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+#include <fmt/format.h>
+
+#include <world/binary_mesher.hpp>
+#include <world/chunk_mesh.hpp>
+#include <world/lod_terrain.hpp>
+#include <world/padded_chunk.hpp>
+#include <world/terrain.hpp>
+
+#include "lod_benchmark.hpp"
+
+namespace
+{
+    constexpr std::int32_t MaxChunkY = world::TerrainGenerator::MaxSurfaceHeight / world::ChunkExtent + 1;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Ring
+    {
+        std::size_t nodes;
+        std::size_t voxel_bytes;
+        std::size_t triangles;
+        std::size_t mesh_bytes;
+        double      generate_seconds;
+        double      mesh_seconds;
+    };
+
+    /// @brief Every node column within @param radius nodes of the origin,
+    /// keyed like world::ColumnCounts
+    std::vector<world::ChunkCoordinate> getColumnsWithin(std::int32_t radius)
+    {
+        std::vector<world::ChunkCoordinate> columns {};
+
+        for (std::int32_t z = -radius; z <= radius; ++z)
+        {
+            for (std::int32_t x = -radius; x <= radius; ++x)
+            {
+                if (x * x + z * z <= radius * radius)
+                {
+                    columns.push_back({x, 0, z});
+                }
+            }
+        }
+
+        return columns;
+    }
+
+    /// @brief Generates every node of @param level the level's streamer
+    /// would keep resident, then meshes the ones that draw anything
+    Ring buildRing(
+        const world::TerrainGenerator& generator,
+        const world::LodRings&         rings,
+        std::size_t                    level,
+        std::int32_t                   radius)
+    {
+        const std::int32_t scale   = world::getLodScale(level);
+        const std::int32_t layers  = level == 0 ? MaxChunkY : world::toLodNode({0, MaxChunkY - 1, 0}, level).y + 1;
+        // level 0 is exactly the resident columns, coarser levels load the
+        // same margin their streamers do
+        const std::vector<world::ChunkCoordinate> columns =
+            getColumnsWithin(level == 0 ? radius : radius / scale + 2);
+
+        world::VoxelStorage storage {};
+        Ring                ring {};
+
+        const Clock::time_point generateStart = Clock::now();
+        for (world::ChunkCoordinate column : columns)
+        {
+            for (std::int32_t y = 0; y < layers; ++y)
+            {
+                storage.getOrCreateChunk({column.x, y, column.z}) =
+                    generator.generateCells({column.x, y, column.z}, scale);
+            }
+        }
+        ring.generate_seconds = std::chrono::duration<double> {Clock::now() - generateStart}.count();
+        ring.voxel_bytes      = storage.getMemoryUsage();
+
+        const Clock::time_point meshStart = Clock::now();
+        for (world::ChunkCoordinate column : columns)
+        {
+            // nodes left with only border columns have nothing of their own
+            // to draw
+            const world::LodRings::Signature signature = rings.getSignature(level, column);
+            bool                             isDrawn   = false;
+
+            for (std::int32_t dz = 0; dz < scale; ++dz)
+            {
+                for (std::int32_t dx = 0; dx < scale; ++dx)
+                {
+                    isDrawn = isDrawn || signature[static_cast<std::size_t>((dz + 1) * (scale + 2) + dx + 1)];
+                }
+            }
+
+            if (!isDrawn)
+            {
+                continue;
+            }
+
+            for (std::int32_t y = 0; y < layers; ++y)
+            {
+                const world::ChunkCoordinate node {column.x, y, column.z};
+
+                world::PaddedChunk padded {storage, node};
+                if (level != 0)
+                {
+                    padded.keepColumns(rings.getColumnMask(level, node));
+                }
+
+                const world::ChunkMesh mesh = world::buildChunkMesh(world::meshBinary(padded));
+
+                ++ring.nodes;
+                ring.triangles += mesh.faces.size() * 2;
+                ring.mesh_bytes += mesh.faces.size() * sizeof(render::VoxelFace);
+            }
+        }
+        ring.mesh_seconds = std::chrono::duration<double> {Clock::now() - meshStart}.count();
+
+        return ring;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runLodBenchmark(const Arguments& arguments)
+    {
+        const auto radius = static_cast<std::int32_t>(arguments.getSize("radius", 8));
+        const auto seed   = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+
+        const std::array<std::int32_t, world::LodLevelCount> radii {radius * 2, radius * 4, radius * 8};
+
+        // the full resolution columns, as a streamer around the origin
+        // would have them
+        world::ColumnCounts residentColumns {};
+        for (world::ChunkCoordinate column : getColumnsWithin(radius))
+        {
+            residentColumns[column] = MaxChunkY;
+        }
+
+        const world::TerrainGenerator generator {seed};
+        const world::LodRings         rings {radii, {0, 0, 0}, residentColumns};
+
+        Report report {};
+        report.setInteger("full_resolution_radius", static_cast<std::uint64_t>(radius));
+        report.setInteger("draw_distance", static_cast<std::uint64_t>(radii.back()));
+
+        Ring total {};
+        Ring fullResolution {};
+
+        for (std::size_t level = 0; level <= world::LodLevelCount; ++level)
+        {
+            const std::int32_t outerRadius = level == 0 ? radius : radii[level - 1];
+            const Ring         ring        = buildRing(generator, rings, level, outerRadius);
+
+            if (level == 0)
+            {
+                fullResolution = ring;
+            }
+
+            total.nodes += ring.nodes;
+            total.voxel_bytes += ring.voxel_bytes;
+            total.triangles += ring.triangles;
+            total.mesh_bytes += ring.mesh_bytes;
+            total.generate_seconds += ring.generate_seconds;
+            total.mesh_seconds += ring.mesh_seconds;
+
+            Report ringReport {};
+            ringReport.setInteger("scale", static_cast<std::uint64_t>(world::getLodScale(level)));
+            ringReport.setInteger("outer_radius", static_cast<std::uint64_t>(outerRadius));
+            ringReport.setInteger("nodes", ring.nodes);
+            ringReport.setInteger("voxel_bytes", ring.voxel_bytes);
+            ringReport.setInteger("triangles", ring.triangles);
+            ringReport.setInteger("mesh_bytes", ring.mesh_bytes);
+            ringReport.setNumber("generate_seconds", ring.generate_seconds);
+            ringReport.setNumber("mesh_seconds", ring.mesh_seconds);
+
+            report.setObject(fmt::format("level_{}", level), ringReport);
+        }
+
+        // full resolution terrain is about as dense everywhere, so its cost
+        // per column scales with the area of the draw distance
+        const double areaRatio = std::numbers::pi * std::pow(static_cast<double>(radii.back()), 2.0)
+                               / static_cast<double>(residentColumns.size());
+
+        const double estimatedTriangles  = static_cast<double>(fullResolution.triangles) * areaRatio;
+        const double estimatedMeshBytes  = static_cast<double>(fullResolution.mesh_bytes) * areaRatio;
+        const double estimatedVoxelBytes = static_cast<double>(fullResolution.voxel_bytes) * areaRatio;
+
+        Report totals {};
+        totals.setInteger("nodes", total.nodes);
+        totals.setInteger("voxel_bytes", total.voxel_bytes);
+        totals.setInteger("triangles", total.triangles);
+        totals.setInteger("mesh_bytes", total.mesh_bytes);
+        totals.setNumber("generate_seconds", total.generate_seconds);
+        totals.setNumber("mesh_seconds", total.mesh_seconds);
+        totals.setNumber("full_resolution_triangles_estimate", estimatedTriangles);
+        totals.setNumber("full_resolution_mesh_bytes_estimate", estimatedMeshBytes);
+        totals.setNumber("full_resolution_voxel_bytes_estimate", estimatedVoxelBytes);
+        totals.setNumber("triangle_reduction", estimatedTriangles / static_cast<double>(total.triangles));
+        totals.setNumber("mesh_bytes_reduction", estimatedMeshBytes / static_cast<double>(total.mesh_bytes));
+        totals.setNumber("voxel_bytes_reduction", estimatedVoxelBytes / static_cast<double>(total.voxel_bytes));
+        report.setObject("total", totals);
+
+        return report;
+    }
+} // namespace benchmark
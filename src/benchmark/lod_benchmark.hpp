@@ -0,0 +1,22 @@
+#ifndef SRC_BENCHMARK_LOD__BENCHMARK_HPP
+#define SRC_BENCHMARK_LOD__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief What each ring of the terrain scene's draw distance costs,
+    /// generated and meshed on one core the way world::LodTerrain masks
+    /// them: resident nodes, voxel and mesh bytes, triangles and time per
+    /// ring. The totals compare the whole draw distance against full
+    /// resolution chunks out to the last ring, estimated from the full
+    /// resolution columns' average.
+    ///
+    /// --radius <n>   full resolution radius in chunks, the rings reach 2, 4
+    ///                and 8 times as far (8)
+    /// --seed   <n>   terrain seed (1337)
+    [[nodiscard]] Report runLodBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_LOD__BENCHMARK_HPP
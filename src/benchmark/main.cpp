@@ -0,0 +1,90 @@
+#include <functional>
+#include <map>
+
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "arguments.hpp"
+#include "brickmap_benchmark.hpp"
+#include "entity_benchmark.hpp"
+#include "lighting_benchmark.hpp"
+#include "lod_benchmark.hpp"
+#include "matrix_benchmark.hpp"
+#include "meshing_benchmark.hpp"
+#include "meshing_pipeline_benchmark.hpp"
+#include "occlusion_benchmark.hpp"
+#include "raycast_benchmark.hpp"
+#include "report.hpp"
+#include "region_benchmark.hpp"
+#include "scene_benchmark.hpp"
+#include "simulation_benchmark.hpp"
+#include "streaming_benchmark.hpp"
+#include "terrain_benchmark.hpp"
+#include "transform_benchmark.hpp"
+#include "voxel_storage_benchmark.hpp"
+
+/// Usage: DynamoBenchmark [--suite <name>] [--out <file.json>] [--trace <file.json>] [suite options]
+/// Suites are documented next to their run functions, --trace additionally
+/// dumps every CPU profiler zone recorded during the run
+int main(int argc, char** argv)
+{
+    seb::logLog("Dynamo benchmark | Version: {}.{}.{}.{}",
+        VERSION_MAJOR,
+        VERSION_MINOR,
+        VERSION_PATCH,
+        VERSION_TWEAK
+    );
+
+    const std::map<std::string, std::function<benchmark::Report(const benchmark::Arguments&)>> suites
+    {
+        {"brickmap",         benchmark::runBrickmapBenchmark},
+        {"entities",         benchmark::runEntityBenchmark},
+        {"lighting",         benchmark::runLightingBenchmark},
+        {"lod",              benchmark::runLodBenchmark},
+        {"matrices",         benchmark::runMatrixBenchmark},
+        {"meshing",          benchmark::runMeshingBenchmark},
+        {"meshing_pipeline", benchmark::runMeshingPipelineBenchmark},
+        {"occlusion",        benchmark::runOcclusionBenchmark},
+        {"raycast",          benchmark::runRaycastBenchmark},
+        {"region",           benchmark::runRegionBenchmark},
+        {"scene",            benchmark::runSceneBenchmark},
+        {"simulation",       benchmark::runSimulationBenchmark},
+        {"streaming",        benchmark::runStreamingBenchmark},
+        {"terrain",          benchmark::runTerrainBenchmark},
+        {"transforms",       benchmark::runTransformBenchmark},
+        {"voxel_storage",    benchmark::runVoxelStorageBenchmark},
+    };
+
+    util::profiler::setThreadName("Main");
+
+    try
+    {
+        const benchmark::Arguments arguments {argc, argv};
+
+        const std::string suiteName = arguments.getString("suite", "scene");
+        const auto suite = suites.find(suiteName);
+
+        if (suite == suites.cend())
+        {
+            seb::logFatal("Unknown benchmark suite {}", suiteName);
+            return 1;
+        }
+
+        benchmark::Report report {};
+        report.setString("suite", suiteName);
+        report.setObject("results", suite->second(arguments));
+
+        report.writeToFile(arguments.getString("out", "benchmark.json"));
+
+        if (arguments.hasFlag("trace"))
+        {
+            util::profiler::dumpChromeTrace(arguments.getString("trace", "trace.json"));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        seb::logFatal("Exception propagated to main! | {}", e.what());
+        return 1;
+    }
+}
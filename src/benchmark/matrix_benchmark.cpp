@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include <sebib/seblog.hpp>
+
+#include <world/transform_kernels.hpp>
+
+#include "matrix_benchmark.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // a closed form from the same floats rounds a few times per element,
+    // each worth half an ULP of at most the column's largest element
+    constexpr double MaxModelUlps  = 8.0;
+    // R * S^-1 is only the inverse transpose for a unit quaternion, a
+    // normalized float one is off by up to an ULP, which the rotation's
+    // terms turn into several more
+    constexpr double MaxNormalUlps = 32.0;
+
+    struct Ulps
+    {
+        double model;
+        double normal;
+    };
+
+    /// @brief The same transforms as render::Transforms and by component,
+    /// the rotations' x, y, z and w
+    struct Transforms
+    {
+        std::vector<render::Transform>    transforms;
+        std::array<std::vector<float>, 3> translations;
+        std::array<std::vector<float>, 4> rotations;
+        std::array<std::vector<float>, 3> scales;
+    };
+
+    /// @brief The same @param count transforms for every @param seed
+    Transforms makeTransforms(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937                          generator {seed};
+        std::uniform_real_distribution<float> coordinate {-256.0f, 256.0f};
+        std::normal_distribution<float>       component {0.0f, 1.0f};
+        std::uniform_real_distribution<float> scale {0.25f, 4.0f};
+
+        Transforms transforms {};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            render::Transform transform {};
+            transform.translation = {coordinate(generator), coordinate(generator), coordinate(generator)};
+            // normally distributed components are uniformly distributed
+            // rotations once normalized
+            transform.rotation = glm::normalize(
+                glm::quat {component(generator), component(generator), component(generator), component(generator)});
+            transform.scale = {scale(generator), scale(generator), scale(generator)};
+
+            transforms.transforms.push_back(transform);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                transforms.translations[axis].push_back(transform.translation[static_cast<glm::length_t>(axis)]);
+                transforms.scales[axis].push_back(transform.scale[static_cast<glm::length_t>(axis)]);
+            }
+
+            transforms.rotations[0].push_back(transform.rotation.x);
+            transforms.rotations[1].push_back(transform.rotation.y);
+            transforms.rotations[2].push_back(transform.rotation.z);
+            transforms.rotations[3].push_back(transform.rotation.w);
+        }
+
+        return transforms;
+    }
+
+    /// @brief A transform's matrices in double, by column
+    struct Reference
+    {
+        std::array<std::array<double, 4>, 4> model;
+        std::array<std::array<double, 3>, 3> normal;
+    };
+
+    std::array<double, 3> cross(const std::array<double, 4>& a, const std::array<double, 4>& b)
+    {
+        return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    }
+
+    Reference getReference(const render::Transform& transform)
+    {
+        const double x = transform.rotation.x;
+        const double y = transform.rotation.y;
+        const double z = transform.rotation.z;
+        const double w = transform.rotation.w;
+
+        const std::array<double, 3> scale {transform.scale.x, transform.scale.y, transform.scale.z};
+        const std::array<std::array<double, 3>, 3> rotation {{
+            {1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + w * z), 2.0 * (x * z - w * y)},
+            {2.0 * (x * y - w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z + w * x)},
+            {2.0 * (x * z + w * y), 2.0 * (y * z - w * x), 1.0 - 2.0 * (x * x + y * y)},
+        }};
+
+        Reference reference {};
+
+        for (std::size_t column = 0; column < 3; ++column)
+        {
+            for (std::size_t row = 0; row < 3; ++row)
+            {
+                reference.model[column][row] = rotation[column][row] * scale[column];
+            }
+        }
+
+        reference.model[3] = {transform.translation.x, transform.translation.y, transform.translation.z, 1.0};
+
+        // by cofactors rather than the closed form being checked, the columns
+        // of the inverse transpose are those of the adjugate over the determinant
+        const std::array<std::array<double, 3>, 3> cofactors {
+            cross(reference.model[1], reference.model[2]),
+            cross(reference.model[2], reference.model[0]),
+            cross(reference.model[0], reference.model[1]),
+        };
+
+        const double determinant = reference.model[0][0] * cofactors[0][0]
+                                 + reference.model[0][1] * cofactors[0][1]
+                                 + reference.model[0][2] * cofactors[0][2];
+
+        for (std::size_t column = 0; column < 3; ++column)
+        {
+            for (std::size_t row = 0; row < 3; ++row)
+            {
+                reference.normal[column][row] = cofactors[column][row] / determinant;
+            }
+        }
+
+        return reference;
+    }
+
+    /// @brief Largest error of the @param rows floats of a column, in ULPs
+    /// of the float nearest the largest element of @param expected
+    template<std::size_t Rows>
+    double getColumnUlps(const glm::vec4& actual, const std::array<double, Rows>& expected)
+    {
+        double magnitude = 0.0;
+        double error     = 0.0;
+
+        for (std::size_t row = 0; row < Rows; ++row)
+        {
+            magnitude = std::max(magnitude, std::abs(expected[row]));
+            error     = std::max(error, std::abs(static_cast<double>(actual[static_cast<int>(row)]) - expected[row]));
+        }
+
+        const auto  largest = static_cast<float>(magnitude);
+        const float ulp     = std::nextafter(largest, std::numeric_limits<float>::infinity()) - largest;
+
+        return error / static_cast<double>(ulp);
+    }
+
+    /// @brief How far one way's matrices are from the references
+    benchmark::Report checkMatrices(
+        std::span<const glm::mat4>            models,
+        std::span<const render::NormalMatrix> normals,
+        const std::vector<Reference>&         references,
+        Ulps&                                 maxUlps)
+    {
+        double maxModel  = 0.0;
+        double maxNormal = 0.0;
+        double sumModel  = 0.0;
+        double sumNormal = 0.0;
+
+        for (std::size_t i = 0; i < references.size(); ++i)
+        {
+            for (std::size_t column = 0; column < 4; ++column)
+            {
+                const double ulps = getColumnUlps(models[i][static_cast<int>(column)], references[i].model[column]);
+
+                maxModel = std::max(maxModel, ulps);
+                sumModel += ulps;
+            }
+
+            for (std::size_t column = 0; column < 3; ++column)
+            {
+                const double ulps = getColumnUlps(normals[i][static_cast<int>(column)], references[i].normal[column]);
+
+                maxNormal = std::max(maxNormal, ulps);
+                sumNormal += ulps;
+            }
+        }
+
+        const auto count = static_cast<double>(std::max(references.size(), std::size_t {1}));
+
+        benchmark::Report report {};
+        report.setNumber("max_model_ulps", maxModel);
+        report.setNumber("mean_model_ulps", sumModel / (count * 4.0));
+        report.setNumber("max_normal_ulps", maxNormal);
+        report.setNumber("mean_normal_ulps", sumNormal / (count * 3.0));
+
+        maxUlps = Ulps {.model {maxModel}, .normal {maxNormal}};
+
+        return report;
+    }
+
+    /// @brief Milliseconds of each of @param iterations calls to @param pass
+    template<class Pass>
+    std::vector<double> timePasses(std::size_t iterations, Pass pass)
+    {
+        std::vector<double> passMs {};
+
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            const Clock::time_point start = Clock::now();
+            pass();
+            passMs.push_back(std::chrono::duration<double, std::milli> {Clock::now() - start}.count());
+        }
+
+        return passMs;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runMatrixBenchmark(const Arguments& arguments)
+    {
+        const auto count      = arguments.getSize("transforms", 100000);
+        const auto iterations = arguments.getSize("iterations", 50);
+        const auto seed       = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+
+        seb::assertFatal(count > 0 && iterations > 0, "Need at least one transform and one pass");
+
+        const Transforms transforms = makeTransforms(count, seed);
+        const world::TransformFields fields {
+            .translation {transforms.translations[0], transforms.translations[1], transforms.translations[2]},
+            .rotation    {
+                transforms.rotations[0], transforms.rotations[1], transforms.rotations[2], transforms.rotations[3]},
+            .scale       {transforms.scales[0], transforms.scales[1], transforms.scales[2]},
+        };
+
+        std::vector<std::uint32_t> inOrder (count);
+        std::iota(inOrder.begin(), inOrder.end(), std::uint32_t {0});
+
+        // as a TransformHierarchy's queued nodes can be, scattered over the
+        // components so every lane is gathered
+        std::vector<std::uint32_t> shuffled = inOrder;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937 {seed});
+
+        std::vector<Reference> references {};
+        references.reserve(count);
+
+        for (const render::Transform& transform : transforms.transforms)
+        {
+            references.push_back(getReference(transform));
+        }
+
+        std::vector<glm::mat4>            models (count, glm::mat4 {1.0f});
+        std::vector<render::NormalMatrix> normals (count, render::NormalMatrix {1.0f});
+
+        Report report {};
+        report.setInteger("transforms", count);
+#if defined(__AVX2__)
+        report.setString("kernel", "avx2");
+#else
+        report.setString("kernel", "scalar");
+#endif // __AVX2__
+
+        Ulps worstUlps {.model {0.0}, .normal {0.0}};
+
+        /// @brief Reports the way's timings and how accurate the matrices
+        /// it left are, @param isChecked ones are held to MaxModelUlps and
+        /// MaxNormalUlps
+        const auto addWay = [&](const std::string& name, const std::vector<double>& passMs, bool isChecked)
+        {
+            const Statistics statistics = Statistics::fromSamples(passMs);
+
+            Report way {};
+            way.setStatistics("pass_ms", statistics);
+            way.setNumber("ns_per_transform", statistics.mean * 1e6 / static_cast<double>(count));
+
+            Ulps ulps {};
+            way.setObject("accuracy", checkMatrices(models, normals, references, ulps));
+
+            if (isChecked)
+            {
+                worstUlps.model  = std::max(worstUlps.model, ulps.model);
+                worstUlps.normal = std::max(worstUlps.normal, ulps.normal);
+            }
+
+            report.setObject(name, way);
+
+            return statistics.mean;
+        };
+
+        // what every object's matrix used to be built with, and what the
+        // shaders worked out per vertex
+        const double glmMs = addWay("glm", timePasses(iterations, [&]
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                models[i] = transforms.transforms[i].asModelMatrix();
+
+                const glm::mat3 normal = glm::inverse(glm::transpose(glm::mat3 {models[i]}));
+
+                for (int column = 0; column < 3; ++column)
+                {
+                    normals[i][column] = glm::vec4 {normal[column][0], normal[column][1], normal[column][2], 0.0f};
+                }
+            }
+        }), false);
+
+        const double scalarMs = addWay("scalar", timePasses(iterations, [&]
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const render::Transform& transform = transforms.transforms[i];
+
+                models[i]  = world::composeModelMatrix(transform.translation, transform.rotation, transform.scale);
+                normals[i] = world::composeNormalMatrix(transform.rotation, transform.scale);
+            }
+        }), true);
+
+        // eight consecutive indices at a time, every component one load
+        const double contiguousMs = addWay("batched_contiguous", timePasses(iterations, [&]
+        {
+            world::composeMatrices(fields, inOrder, models, normals);
+        }), true);
+
+        // the shuffled matrices are in the shuffled order, unshuffled to be checked
+        std::vector<glm::mat4>            shuffledModels (count, glm::mat4 {1.0f});
+        std::vector<render::NormalMatrix> shuffledNormals (count, render::NormalMatrix {1.0f});
+
+        const std::vector<double> shuffledMs = timePasses(iterations, [&]
+        {
+            world::composeMatrices(fields, shuffled, shuffledModels, shuffledNormals);
+        });
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            models[shuffled[i]]  = shuffledModels[i];
+            normals[shuffled[i]] = shuffledNormals[i];
+        }
+
+        const double gatheredMs = addWay("batched_gathered", shuffledMs, true);
+
+        report.setNumber("contiguous_speedup_over_glm", glmMs / contiguousMs);
+        report.setNumber("contiguous_speedup_over_scalar", scalarMs / contiguousMs);
+        report.setNumber("gathered_speedup_over_glm", glmMs / gatheredMs);
+        report.setNumber("gathered_speedup_over_scalar", scalarMs / gatheredMs);
+
+        seb::assertFatal(
+            worstUlps.model <= MaxModelUlps,
+            "Composed model matrices are up to {} ULPs off, more than {}",
+            worstUlps.model,
+            MaxModelUlps);
+        seb::assertFatal(
+            worstUlps.normal <= MaxNormalUlps,
+            "Composed normal matrices are up to {} ULPs off, more than {}",
+            worstUlps.normal,
+            MaxNormalUlps);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,26 @@
+#ifndef SRC_BENCHMARK_MATRIX__BENCHMARK_HPP
+#define SRC_BENCHMARK_MATRIX__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Turns random transforms into model and normal matrices four
+    /// ways: render::Transform::asModelMatrix() with glm's inverse transpose
+    /// of it, world::composeModelMatrix() and world::composeNormalMatrix()
+    /// one at a time, and world::composeMatrices() over their components in
+    /// order, where it loads eight transforms' component at once, and
+    /// shuffled, where it gathers them. Reports nanoseconds per transform of
+    /// each and the speedups of both batched ways separately. Every
+    /// way's matrices are checked against the same computed in double, in
+    /// ULPs of the largest element of their column since most elements are
+    /// differences that can cancel to nothing. All on one core.
+    ///
+    /// --transforms <n>   transforms per pass (100000)
+    /// --iterations <n>   passes per way (50)
+    /// --seed       <n>   seed of the transforms (1337)
+    [[nodiscard]] Report runMatrixBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_MATRIX__BENCHMARK_HPP
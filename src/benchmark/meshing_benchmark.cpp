@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include <sebib/seblog.hpp>
+
+#include <world/binary_mesher.hpp>
+#include <world/chunk_mesh.hpp>
+#include <world/greedy_mesher.hpp>
+#include <world/padded_chunk.hpp>
+#include <world/terrain.hpp>
+
+#include "meshing_benchmark.hpp"
+
+namespace
+{
+    constexpr std::int32_t WorldHeightChunks = 4;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMicroseconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro> {Clock::now() - start}.count();
+    }
+
+    /// @brief Padded chunks the hills world never produces, every cell
+    /// including the border is written so neighbour culling is covered too
+    std::vector<world::PaddedChunk> makeSyntheticChunks()
+    {
+        std::vector<world::PaddedChunk> chunks {};
+
+        const auto make = [&](auto&& voxelAt)
+        {
+            world::PaddedChunk& chunk = chunks.emplace_back();
+
+            for (std::int32_t y = -1; y <= world::ChunkExtent; ++y)
+            {
+                for (std::int32_t z = -1; z <= world::ChunkExtent; ++z)
+                {
+                    for (std::int32_t x = -1; x <= world::ChunkExtent; ++x)
+                    {
+                        chunk.set({x, y, z}, voxelAt(world::LocalPosition {x, y, z}));
+                    }
+                }
+            }
+        };
+
+        std::mt19937 generator {7};
+
+        make([&](world::LocalPosition) { return static_cast<world::Voxel>(generator() % 4); });
+        make([&](world::LocalPosition) { return static_cast<world::Voxel>(generator() % 2); });
+        make([](world::LocalPosition p) { return static_cast<world::Voxel>((p.x + p.y + p.z) & 1); });
+        make([](world::LocalPosition p) { return static_cast<world::Voxel>(p == world::LocalPosition {5, 6, 7} ? 1 : 0); });
+        make([](world::LocalPosition) { return world::material::Stone; });
+        make([](world::LocalPosition p)
+        {
+            const bool inside = p.x >= 0 && p.y >= 0 && p.z >= 0
+                && p.x < world::ChunkExtent && p.y < world::ChunkExtent && p.z < world::ChunkExtent;
+            return inside ? world::material::Stone : world::AirVoxel;
+        });
+
+        return chunks;
+    }
+
+    /// @brief Both meshers sorted, since only the order may differ
+    bool meshersAgree(const world::PaddedChunk& chunk, world::AmbientOcclusion ambientOcclusion)
+    {
+        std::vector<world::GreedyQuad> greedy = world::meshGreedy(chunk, ambientOcclusion);
+        std::vector<world::GreedyQuad> binary = world::meshBinary(chunk, ambientOcclusion);
+
+        std::ranges::sort(greedy);
+        std::ranges::sort(binary);
+
+        return greedy == binary;
+    }
+
+    bool meshersAgree(const world::PaddedChunk& chunk)
+    {
+        return meshersAgree(chunk, world::AmbientOcclusion::Bake)
+            && meshersAgree(chunk, world::AmbientOcclusion::Ignore);
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runMeshingBenchmark(const Arguments& arguments)
+    {
+        const auto        chunksPerAxis = static_cast<std::int32_t>(arguments.getSize("chunks", 8));
+        const std::size_t repeats       = arguments.getSize("repeats", 3);
+
+        world::VoxelStorage storage {};
+        std::vector<world::ChunkCoordinate> coordinates {};
+
+        for (std::int32_t cy = 0; cy < WorldHeightChunks; ++cy)
+        {
+            for (std::int32_t cz = 0; cz < chunksPerAxis; ++cz)
+            {
+                for (std::int32_t cx = 0; cx < chunksPerAxis; ++cx)
+                {
+                    storage.insertChunk({cx, cy, cz}, world::generateHillsChunk({cx, cy, cz}));
+                    coordinates.push_back({cx, cy, cz});
+                }
+            }
+        }
+
+        // Triangle counts, chunks without any visible faces are left out
+        std::vector<double> greedyTriangles;
+        // faces merged on the voxel alone, what baking occlusion costs
+        std::vector<double> unoccludedTriangles;
+        std::vector<double> culledTriangles;
+        std::vector<double> cubeTriangles;
+        std::size_t faceBytes    = 0;
+        // what four render::Vertex and six indices per quad used to take
+        std::size_t indexedBytes = 0;
+
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            const world::PaddedChunk padded {storage, coordinate};
+            const std::vector<world::GreedyQuad> quads = world::meshGreedy(padded);
+
+            if (quads.empty())
+            {
+                continue;
+            }
+
+            std::size_t visibleFaces = 0;
+            for (const world::GreedyQuad& quad : quads)
+            {
+                visibleFaces += std::size_t {quad.width} * quad.height;
+            }
+
+            std::size_t solidVoxels = 0;
+            for (std::int32_t y = 0; y < world::ChunkExtent; ++y)
+            {
+                for (std::int32_t z = 0; z < world::ChunkExtent; ++z)
+                {
+                    for (std::int32_t x = 0; x < world::ChunkExtent; ++x)
+                    {
+                        if (padded.get({x, y, z}) != world::AirVoxel)
+                        {
+                            ++solidVoxels;
+                        }
+                    }
+                }
+            }
+
+            const world::ChunkMesh mesh = world::buildChunkMesh(quads);
+            faceBytes += mesh.faces.size() * sizeof(render::VoxelFace);
+            indexedBytes += quads.size() * (4 * sizeof(render::Vertex) + 6 * sizeof(render::Index));
+
+            greedyTriangles.push_back(static_cast<double>(quads.size() * 2));
+            unoccludedTriangles.push_back(
+                static_cast<double>(world::meshGreedy(padded, world::AmbientOcclusion::Ignore).size() * 2));
+            culledTriangles.push_back(static_cast<double>(visibleFaces * 2));
+            cubeTriangles.push_back(static_cast<double>(solidVoxels * 12));
+        }
+
+        // The binary mesher must produce exactly the greedy mesher's quads
+        std::size_t validatedChunks  = 0;
+        std::size_t mismatchedChunks = 0;
+
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            mismatchedChunks += meshersAgree(world::PaddedChunk {storage, coordinate}) ? 0U : 1U;
+            ++validatedChunks;
+        }
+
+        for (const world::PaddedChunk& chunk : makeSyntheticChunks())
+        {
+            mismatchedChunks += meshersAgree(chunk) ? 0U : 1U;
+            ++validatedChunks;
+        }
+
+        seb::assertFatal(
+            mismatchedChunks == 0,
+            "Binary mesher disagrees with the greedy mesher on {} of {} chunks",
+            mismatchedChunks,
+            validatedChunks);
+
+        // Timings, every stage of every chunk repeats times
+        std::vector<double> gatherUs;
+        std::vector<double> greedyUs;
+        std::vector<double> binaryUs;
+        std::vector<double> unoccludedBinaryUs;
+        std::vector<double> buildUs;
+        double totalUs = 0.0;
+
+        for (std::size_t r = 0; r < repeats; ++r)
+        {
+            for (world::ChunkCoordinate coordinate : coordinates)
+            {
+                const Clock::time_point gatherStart = Clock::now();
+                const world::PaddedChunk padded {storage, coordinate};
+                gatherUs.push_back(elapsedMicroseconds(gatherStart));
+
+                const Clock::time_point greedyStart = Clock::now();
+                const std::vector<world::GreedyQuad> quads = world::meshGreedy(padded);
+                greedyUs.push_back(elapsedMicroseconds(greedyStart));
+
+                const Clock::time_point binaryStart = Clock::now();
+                const std::vector<world::GreedyQuad> binaryQuads = world::meshBinary(padded);
+                binaryUs.push_back(elapsedMicroseconds(binaryStart));
+
+                const Clock::time_point unoccludedStart = Clock::now();
+                const std::vector<world::GreedyQuad> unoccludedQuads =
+                    world::meshBinary(padded, world::AmbientOcclusion::Ignore);
+                unoccludedBinaryUs.push_back(elapsedMicroseconds(unoccludedStart));
+
+                const Clock::time_point buildStart = Clock::now();
+                const world::ChunkMesh mesh = world::buildChunkMesh(binaryQuads);
+                buildUs.push_back(elapsedMicroseconds(buildStart));
+
+                // the engine meshes with the binary mesher
+                totalUs += gatherUs.back() + binaryUs.back() + buildUs.back();
+            }
+        }
+
+        const auto sum = [](const std::vector<double>& values)
+        {
+            double total = 0.0;
+            for (double v : values)
+            {
+                total += v;
+            }
+            return total;
+        };
+
+        Report triangles {};
+        triangles.setInteger("meshed_chunks", greedyTriangles.size());
+        triangles.setStatistics("greedy_per_chunk", Statistics::fromSamples(greedyTriangles));
+        triangles.setStatistics("greedy_without_occlusion_per_chunk", Statistics::fromSamples(unoccludedTriangles));
+        triangles.setNumber("occlusion_vs_without", sum(greedyTriangles) / sum(unoccludedTriangles));
+        triangles.setStatistics("culled_faces_per_chunk", Statistics::fromSamples(culledTriangles));
+        triangles.setStatistics("naive_cubes_per_chunk", Statistics::fromSamples(cubeTriangles));
+        triangles.setNumber("greedy_vs_culled_faces", sum(culledTriangles) / sum(greedyTriangles));
+        triangles.setNumber("greedy_vs_naive_cubes", sum(cubeTriangles) / sum(greedyTriangles));
+        triangles.setInteger("mesh_bytes", faceBytes);
+        triangles.setInteger("indexed_mesh_bytes", indexedBytes);
+        triangles.setNumber(
+            "indexed_vs_packed_bytes", static_cast<double>(indexedBytes) / static_cast<double>(faceBytes));
+
+        Report crossValidation {};
+        crossValidation.setInteger("chunks", validatedChunks);
+        crossValidation.setInteger("mismatched_chunks", mismatchedChunks);
+
+        const double binarySpeedup     = sum(greedyUs) / sum(binaryUs);
+        const double occlusionSlowdown = sum(binaryUs) / sum(unoccludedBinaryUs);
+
+        Report timings {};
+        timings.setStatistics("gather_us", Statistics::fromSamples(std::move(gatherUs)));
+        timings.setStatistics("greedy_us", Statistics::fromSamples(std::move(greedyUs)));
+        timings.setStatistics("binary_us", Statistics::fromSamples(std::move(binaryUs)));
+        timings.setNumber("binary_vs_greedy_speedup", binarySpeedup);
+        timings.setStatistics("binary_without_occlusion_us", Statistics::fromSamples(std::move(unoccludedBinaryUs)));
+        timings.setNumber("binary_occlusion_slowdown", occlusionSlowdown);
+        timings.setStatistics("build_vertices_us", Statistics::fromSamples(std::move(buildUs)));
+        timings.setNumber("chunks_meshed_per_second",
+            static_cast<double>(coordinates.size() * repeats) / (totalUs / 1e6));
+
+        Report report {};
+        report.setInteger("chunks", coordinates.size());
+        report.setInteger("repeats", repeats);
+        report.setObject("triangles", triangles);
+        report.setObject("cross_validation", crossValidation);
+        report.setObject("timings", timings);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,23 @@
+#ifndef SRC_BENCHMARK_MESHING__BENCHMARK_HPP
+#define SRC_BENCHMARK_MESHING__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Meshes every chunk of a hills world and reports triangles per
+    /// chunk against naive meshing, plus per stage timings and chunks meshed
+    /// per second on one thread. Baked ambient occlusion is measured against
+    /// meshing without it, both in triangles and binary mesher time.
+    ///
+    /// The binary mesher is checked quad for quad against the greedy mesher,
+    /// with and without occlusion, on every chunk and a handful of synthetic worst cases, a mismatch is
+    /// fatal.
+    ///
+    /// --chunks  <n>   chunks per horizontal axis of the test world (8)
+    /// --repeats <n>   times every chunk is meshed for the timings (3)
+    [[nodiscard]] Report runMeshingBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_MESHING__BENCHMARK_HPP
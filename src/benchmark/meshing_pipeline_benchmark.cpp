@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <render/camera_path.hpp>
+#include <world/binary_mesher.hpp>
+#include <world/meshing_pipeline.hpp>
+#include <world/terrain.hpp>
+#include <world/world.hpp>
+
+#include "meshing_pipeline_benchmark.hpp"
+
+namespace
+{
+    constexpr std::int32_t WorldHeightChunks = 4;
+
+    using Clock = std::chrono::steady_clock;
+} // namespace
+
+namespace benchmark
+{
+    Report runMeshingPipelineBenchmark(const Arguments& arguments)
+    {
+        const auto        chunksPerAxis = static_cast<std::int32_t>(arguments.getSize("chunks", 24));
+        const std::size_t workers       = arguments.getSize("workers", world::MeshingPipeline::getDefaultWorkerCount());
+        const std::size_t uploads       = arguments.getSize("uploads", 32);
+        const std::chrono::milliseconds framePeriod {arguments.getSize("frame_ms", 16)};
+
+        world::VoxelStorage storage {};
+        std::vector<world::ChunkCoordinate> coordinates {};
+
+        for (std::int32_t cy = 0; cy < WorldHeightChunks; ++cy)
+        {
+            for (std::int32_t cz = -chunksPerAxis / 2; cz < chunksPerAxis - chunksPerAxis / 2; ++cz)
+            {
+                for (std::int32_t cx = -chunksPerAxis / 2; cx < chunksPerAxis - chunksPerAxis / 2; ++cx)
+                {
+                    storage.insertChunk({cx, cy, cz}, world::generateHillsChunk({cx, cy, cz}));
+                    coordinates.push_back({cx, cy, cz});
+                }
+            }
+        }
+
+        // Baseline, everything on the calling thread the way World used to
+        const Clock::time_point serialStart = Clock::now();
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            const world::ChunkMesh mesh = world::buildChunkMesh(
+                world::meshBinary(world::PaddedChunk {storage, coordinate}));
+        }
+        const std::chrono::duration<double> serialTime = Clock::now() - serialStart;
+
+        // One orbit every 600 frames, about 10 seconds at 60 fps
+        const render::CameraPath path = render::CameraPath::orbit(600, 250.0f, 120.0f);
+        const vk::Extent2D       extent {.width {1280}, .height {720}};
+
+        world::MeshingPipeline pipeline {workers, uploads * 2};
+
+        std::vector<double> frameUs;
+        std::vector<double> timeToMeshMs;
+        std::size_t         maxQueueDepth = 0;
+        timeToMeshMs.reserve(coordinates.size());
+
+        const Clock::time_point start = Clock::now();
+
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            pipeline.markDirty(coordinate);
+        }
+
+        for (std::size_t frame = 0; !pipeline.isIdle(); ++frame)
+        {
+            const Clock::time_point frameStart = Clock::now();
+
+            pipeline.dispatch(storage, world::World::getCameraView(path.getCamera(frame), extent));
+            const std::vector<world::MeshingPipeline::Result> results = pipeline.collect(uploads);
+
+            const Clock::time_point frameEnd = Clock::now();
+            frameUs.push_back(std::chrono::duration<double, std::micro> {frameEnd - frameStart}.count());
+
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                timeToMeshMs.push_back(std::chrono::duration<double, std::milli> {frameEnd - start}.count());
+            }
+
+            maxQueueDepth = std::max(maxQueueDepth, pipeline.getStatistics().getQueueDepth());
+
+            std::this_thread::sleep_until(frameStart + framePeriod);
+        }
+
+        const std::chrono::duration<double> pipelineTime = Clock::now() - start;
+        const world::MeshingPipeline::Statistics statistics = pipeline.getStatistics();
+
+        Report throughput {};
+        throughput.setNumber("serial_chunks_per_second", static_cast<double>(coordinates.size()) / serialTime.count());
+        throughput.setNumber("pipeline_chunks_per_second", static_cast<double>(coordinates.size()) / pipelineTime.count());
+        throughput.setNumber("worker_mesh_ms", statistics.average_mesh_time.count() * 1000.0);
+
+        Report report {};
+        report.setInteger("chunks", coordinates.size());
+        report.setInteger("workers", workers);
+        report.setInteger("uploads_per_frame", uploads);
+        report.setInteger("frames_to_drain", frameUs.size());
+        report.setInteger("max_queue_depth", maxQueueDepth);
+        report.setStatistics("main_thread_frame_us", Statistics::fromSamples(std::move(frameUs)));
+        report.setStatistics("time_to_mesh_ms", Statistics::fromSamples(std::move(timeToMeshMs)));
+        report.setObject("throughput", throughput);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,22 @@
+#ifndef SRC_BENCHMARK_MESHING__PIPELINE__BENCHMARK_HPP
+#define SRC_BENCHMARK_MESHING__PIPELINE__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Marks every chunk of a hills world dirty at once and drains
+    /// the MeshingPipeline from a simulated frame loop with an orbiting
+    /// camera, no GPU involved. Reports the main thread's per frame cost
+    /// while the workers mesh, how long each chunk took to come back and
+    /// the throughput against meshing on the main thread alone.
+    ///
+    /// --chunks   <n>   chunks per horizontal axis, 4 chunks high (24)
+    /// --workers  <n>   meshing threads (all but one hardware thread)
+    /// --frame_ms <n>   simulated frame period (16)
+    /// --uploads  <n>   results collected per frame (32)
+    [[nodiscard]] Report runMeshingPipelineBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_MESHING__PIPELINE__BENCHMARK_HPP
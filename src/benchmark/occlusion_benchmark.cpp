@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numbers>
+
+#include <world/binary_mesher.hpp>
+#include <world/chunk_connectivity.hpp>
+#include <world/occlusion_culler.hpp>
+#include <world/padded_chunk.hpp>
+#include <world/terrain.hpp>
+#include <world/world.hpp>
+
+#include "occlusion_benchmark.hpp"
+#include "terrain_fixture.hpp"
+
+namespace
+{
+    constexpr std::size_t Directions = 8;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Draws
+    {
+        std::size_t chunk_objects;
+        std::size_t in_frustum;
+        std::size_t drawn;
+        double      cull_us;
+    };
+
+    /// @brief The topmost air voxel at least 16 below the surface in the
+    /// origin's column, the rock under the surface if there is no cave
+    glm::vec3 findCave(const world::VoxelStorage& storage, std::int32_t surface)
+    {
+        for (std::int32_t y = surface - 16; y > 0; --y)
+        {
+            const world::Chunk* chunk = storage.getChunk(world::toChunkCoordinate({0, y, 0}));
+
+            if (chunk != nullptr && chunk->get(world::toLocalPosition({0, y, 0})) == world::AirVoxel)
+            {
+                return {0.5f, static_cast<float>(y) + 0.5f, 0.5f};
+            }
+        }
+
+        return {0.5f, static_cast<float>(surface - 16) + 0.5f, 0.5f};
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runOcclusionBenchmark(const Arguments& arguments)
+    {
+        const auto radius = static_cast<std::int32_t>(arguments.getSize("radius", 8));
+        const auto seed   = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+
+        const world::TerrainGenerator generator {seed};
+        const vk::Extent2D            extent {.width {1280}, .height {720}};
+
+        world::VoxelStorage storage {};
+        generateTerrainDisc(storage, generator, radius);
+
+        // what World records as meshes come back, chunks with faces are
+        // the ones that get drawn
+        world::OcclusionCuller              culler {};
+        std::vector<world::ChunkCoordinate> chunkObjects {};
+        std::size_t                         closedChunks = 0;
+        double                              connectivitySeconds = 0.0;
+
+        storage.forEachChunk([&](world::ChunkCoordinate coordinate, const world::Chunk&)
+        {
+            const world::PaddedChunk padded {storage, coordinate};
+
+            const Clock::time_point           start        = Clock::now();
+            const world::ChunkConnectivity    connectivity = world::ChunkConnectivity::compute(padded);
+            connectivitySeconds += std::chrono::duration<double> {Clock::now() - start}.count();
+
+            culler.setConnectivity(coordinate, connectivity);
+            closedChunks += connectivity.isClosed() ? 1U : 0U;
+
+            if (!world::meshBinary(padded).empty())
+            {
+                chunkObjects.push_back(coordinate);
+            }
+        });
+
+        const std::int32_t surface = generator.getSurfaceHeight(0, 0);
+
+        const std::array<std::pair<const char*, glm::vec3>, 2> positions {
+            std::pair {"surface", glm::vec3 {0.5f, static_cast<float>(surface) + 2.5f, 0.5f}},
+            std::pair {"underground", findCave(storage, surface)},
+        };
+
+        const world::ChunkCoordinate min {-radius, 0, -radius};
+        const world::ChunkCoordinate max {radius, MaxTerrainChunkY - 1, radius};
+
+        Report report {};
+        report.setInteger("chunks", storage.getChunkCount());
+        report.setInteger("chunk_objects", chunkObjects.size());
+        report.setInteger("closed_chunks", closedChunks);
+        report.setNumber(
+            "connectivity_us_per_chunk",
+            connectivitySeconds * 1e6 / static_cast<double>(storage.getChunkCount()));
+
+        for (const auto& [name, position] : positions)
+        {
+            Draws total {};
+
+            for (std::size_t i = 0; i < Directions; ++i)
+            {
+                const float         yaw = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i) / Directions;
+                const render::Camera camera {position, 0.0f, yaw};
+                const world::CameraView view = world::World::getCameraView(camera, extent);
+
+                const Clock::time_point start = Clock::now();
+                culler.cull(view, min, max);
+                total.cull_us += std::chrono::duration<double, std::micro> {Clock::now() - start}.count();
+
+                const world::ChunkPrioritizer frustum {view};
+
+                for (world::ChunkCoordinate coordinate : chunkObjects)
+                {
+                    ++total.chunk_objects;
+                    total.in_frustum += frustum.isInFrustum(coordinate) ? 1U : 0U;
+                    total.drawn += culler.isVisible(coordinate) ? 1U : 0U;
+                }
+            }
+
+            Report view {};
+            view.setNumber("camera_y", static_cast<double>(position.y));
+            view.setNumber("chunk_objects", static_cast<double>(total.chunk_objects) / Directions);
+            view.setNumber("in_frustum", static_cast<double>(total.in_frustum) / Directions);
+            view.setNumber("drawn", static_cast<double>(total.drawn) / Directions);
+            view.setNumber(
+                "occlusion_draw_reduction",
+                static_cast<double>(total.in_frustum) / static_cast<double>(std::max(total.drawn, std::size_t {1})));
+            view.setNumber(
+                "total_draw_reduction",
+                static_cast<double>(total.chunk_objects) / static_cast<double>(std::max(total.drawn, std::size_t {1})));
+            view.setNumber("cull_us", total.cull_us / Directions);
+
+            report.setObject(name, view);
+        }
+
+        return report;
+    }
+} // namespace benchmark
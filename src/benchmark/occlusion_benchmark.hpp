@@ -0,0 +1,22 @@
+#ifndef SRC_BENCHMARK_OCCLUSION__BENCHMARK_HPP
+#define SRC_BENCHMARK_OCCLUSION__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Generates the terrain scene's full resolution chunks around
+    /// the origin, computes every chunk's connectivity and culls them from
+    /// cameras looking around in eight directions, once just above the
+    /// surface and once from a cave, or the rock, below it. Reports the
+    /// chunk draws each camera is left with after frustum culling alone
+    /// and after the world::OcclusionCuller, and what connectivity and
+    /// culling cost, all on one core.
+    ///
+    /// --radius <n>   chunk columns within n of the origin (8)
+    /// --seed   <n>   terrain seed (1337)
+    [[nodiscard]] Report runOcclusionBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_OCCLUSION__BENCHMARK_HPP
@@ -0,0 +1,208 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <sebib/seblog.hpp>
+
+#include <world/raycast.hpp>
+#include <world/terrain.hpp>
+
+#include "raycast_benchmark.hpp"
+#include "terrain_fixture.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief The textbook DDA, one storage lookup per voxel and no
+    /// skipping, what world::raycast() is checked against
+    std::optional<world::WorldPosition> castReference(const world::VoxelStorage& storage, const world::Ray& ray)
+    {
+        const glm::vec3 direction = glm::normalize(ray.direction);
+
+        world::WorldPosition position {glm::floor(ray.origin)};
+        glm::i32vec3         step {};
+        glm::vec3            nextBoundary {};
+        glm::vec3            boundaryDelta {};
+
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            step[axis] = direction[axis] > 0.0f ? 1 : direction[axis] < 0.0f ? -1 : 0;
+
+            const float boundary = static_cast<float>(position[axis] + (step[axis] > 0 ? 1 : 0));
+
+            nextBoundary[axis]  = step[axis] != 0
+                ? (boundary - ray.origin[axis]) / direction[axis]
+                : std::numeric_limits<float>::infinity();
+            boundaryDelta[axis] = step[axis] != 0
+                ? 1.0f / std::abs(direction[axis])
+                : std::numeric_limits<float>::infinity();
+        }
+
+        float distance = 0.0f;
+
+        while (distance <= ray.max_distance)
+        {
+            if (storage.getVoxel(position) != world::AirVoxel)
+            {
+                return position;
+            }
+
+            glm::length_t axis = 0;
+            if (nextBoundary[1] < nextBoundary[axis])
+            {
+                axis = 1;
+            }
+            if (nextBoundary[2] < nextBoundary[axis])
+            {
+                axis = 2;
+            }
+
+            distance = nextBoundary[axis];
+            position[axis] += step[axis];
+            nextBoundary[axis] += boundaryDelta[axis];
+        }
+
+        return std::nullopt;
+    }
+
+    double toRaysPerSecond(std::size_t rays, Clock::duration elapsed)
+    {
+        return static_cast<double>(rays) / std::chrono::duration<double> {elapsed}.count();
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runRaycastBenchmark(const Arguments& arguments)
+    {
+        const auto radius = static_cast<std::int32_t>(arguments.getSize("radius", 6));
+        const auto seed   = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const auto rays   = arguments.getSize("rays", 100000);
+
+        const world::TerrainGenerator generator {seed};
+
+        world::VoxelStorage storage {};
+        generateTerrainDisc(storage, generator, radius);
+
+        // columns well inside the generated chunks
+        std::mt19937 random {42};
+        const auto   extent = static_cast<float>((radius - 1) * world::ChunkExtent) * 0.7f;
+        std::uniform_real_distribution<float> horizontal {-extent, extent};
+        std::uniform_real_distribution<float> unit {-1.0f, 1.0f};
+
+        const auto aboveSurface = [&]
+        {
+            const float x = horizontal(random);
+            const float z = horizontal(random);
+            const auto  surface = generator.getSurfaceHeight(
+                static_cast<std::int32_t>(std::floor(x)), static_cast<std::int32_t>(std::floor(z)));
+
+            return glm::vec3 {x, static_cast<float>(surface) + 2.5f, z};
+        };
+
+        std::array<std::pair<const char*, std::vector<world::Ray>>, 3> sets {
+            std::pair {"picking", std::vector<world::Ray> {}},
+            std::pair {"line_of_sight", std::vector<world::Ray> {}},
+            std::pair {"sky", std::vector<world::Ray> {}},
+        };
+
+        for (std::size_t i = 0; i < rays; ++i)
+        {
+            // mostly looking down at the ground in front
+            sets[0].second.push_back(world::Ray {
+                .origin       {aboveSurface()},
+                .direction    {unit(random), std::min(unit(random), 0.2f), unit(random)},
+                .max_distance {64.0f},
+            });
+
+            const glm::vec3 from = aboveSurface();
+            const glm::vec3 to   = aboveSurface();
+            sets[1].second.push_back(world::Ray {
+                .origin       {from},
+                .direction    {to - from},
+                .max_distance {glm::length(to - from)},
+            });
+
+            sets[2].second.push_back(world::Ray {
+                .origin {
+                    horizontal(random),
+                    static_cast<float>(world::TerrainGenerator::MaxSurfaceHeight + 8),
+                    horizontal(random)},
+                .direction    {unit(random), 0.1f, unit(random)},
+                .max_distance {512.0f},
+            });
+        }
+
+        Report report {};
+        report.setInteger("chunks", storage.getChunkCount());
+        report.setInteger("rays_per_set", rays);
+
+        for (auto& [name, set] : sets)
+        {
+            std::vector<std::optional<world::RaycastHit>> single (set.size());
+            std::vector<std::optional<world::RaycastHit>> batched (set.size());
+            std::vector<std::optional<world::WorldPosition>> reference (set.size());
+
+            Clock::time_point start = Clock::now();
+            for (std::size_t i = 0; i < set.size(); ++i)
+            {
+                single[i] = world::raycast(storage, set[i]);
+            }
+            const Clock::duration singleTime = Clock::now() - start;
+
+            start = Clock::now();
+            world::raycast(storage, set, batched);
+            const Clock::duration batchedTime = Clock::now() - start;
+
+            start = Clock::now();
+            for (std::size_t i = 0; i < set.size(); ++i)
+            {
+                reference[i] = castReference(storage, set[i]);
+            }
+            const Clock::duration referenceTime = Clock::now() - start;
+
+            std::size_t hits       = 0;
+            std::size_t mismatches = 0;
+            double      hitDistance = 0.0;
+
+            for (std::size_t i = 0; i < set.size(); ++i)
+            {
+                const std::optional<world::WorldPosition> position =
+                    batched[i].has_value() ? std::optional {batched[i]->position} : std::nullopt;
+
+                mismatches += position != reference[i] ? 1U : 0U;
+
+                if (batched[i].has_value())
+                {
+                    ++hits;
+                    hitDistance += static_cast<double>(batched[i]->distance);
+                }
+            }
+
+            seb::assertFatal(
+                mismatches == 0,
+                "world::raycast disagrees with the reference DDA on {} of {} {} rays",
+                mismatches,
+                set.size(),
+                name);
+
+            Report result {};
+            result.setNumber("hit_fraction", static_cast<double>(hits) / static_cast<double>(set.size()));
+            result.setNumber("average_hit_distance", hits == 0 ? 0.0 : hitDistance / static_cast<double>(hits));
+            result.setNumber("rays_per_second", toRaysPerSecond(set.size(), singleTime));
+            result.setNumber("batched_rays_per_second", toRaysPerSecond(set.size(), batchedTime));
+            result.setNumber("reference_rays_per_second", toRaysPerSecond(set.size(), referenceTime));
+            result.setNumber(
+                "speedup_vs_reference",
+                std::chrono::duration<double> {referenceTime}.count()
+                    / std::chrono::duration<double> {batchedTime}.count());
+
+            report.setObject(name, result);
+        }
+
+        return report;
+    }
+} // namespace benchmark
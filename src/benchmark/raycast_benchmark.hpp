@@ -0,0 +1,23 @@
+#ifndef SRC_BENCHMARK_RAYCAST__BENCHMARK_HPP
+#define SRC_BENCHMARK_RAYCAST__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Generates the terrain scene's full resolution chunks around
+    /// the origin and casts three sets of rays through them with
+    /// world::raycast(): picking rays from just above the surface, line of
+    /// sight checks between points on the surface and long rays across the
+    /// empty sky. Reports rays per second cast one at a time, batched and
+    /// with a plain DDA reading every voxel through the storage, which the
+    /// hits are checked against. All on one core.
+    ///
+    /// --radius <n>   chunk columns within n of the origin (6)
+    /// --seed   <n>   terrain seed (1337)
+    /// --rays   <n>   rays per set (100000)
+    [[nodiscard]] Report runRaycastBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_RAYCAST__BENCHMARK_HPP
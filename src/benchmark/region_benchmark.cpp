@@ -0,0 +1,178 @@
+#include <chrono>
+#include <filesystem>
+
+#include <sebib/seblog.hpp>
+
+#include <world/region_store.hpp>
+#include <world/terrain.hpp>
+
+#include "region_benchmark.hpp"
+
+namespace
+{
+    constexpr std::int32_t WorldHeightChunks = 4;
+    constexpr double       BytesPerMiB       = 1024.0 * 1024.0;
+
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<world::Voxel> unpackChunk(const world::Chunk& chunk)
+    {
+        std::vector<world::Voxel> voxels (world::ChunkVolume);
+        chunk.unpack(std::span<world::Voxel, world::ChunkVolume> {voxels.data(), world::ChunkVolume});
+
+        return voxels;
+    }
+
+    double getSecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double> {Clock::now() - start}.count();
+    }
+
+    std::size_t getDirectorySize(const std::filesystem::path& directory)
+    {
+        std::size_t bytes = 0;
+
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator {directory})
+        {
+            bytes += entry.file_size();
+        }
+
+        return bytes;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runRegionBenchmark(const Arguments& arguments)
+    {
+        const auto chunksPerAxis = static_cast<std::int32_t>(arguments.getSize("chunks", 8));
+        const auto seed          = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const std::filesystem::path directory = arguments.getString(
+            "dir", (std::filesystem::temp_directory_path() / "dynamo_region_benchmark").string());
+
+        std::filesystem::remove_all(directory);
+
+        std::vector<world::ChunkCoordinate> coordinates {};
+        for (std::int32_t cy = 0; cy < WorldHeightChunks; ++cy)
+        {
+            for (std::int32_t cz = -chunksPerAxis / 2; cz < chunksPerAxis - chunksPerAxis / 2; ++cz)
+            {
+                for (std::int32_t cx = -chunksPerAxis / 2; cx < chunksPerAxis - chunksPerAxis / 2; ++cx)
+                {
+                    coordinates.push_back({cx, cy, cz});
+                }
+            }
+        }
+
+        // Generation, what loading has to beat
+        const world::TerrainGenerator generator {seed};
+
+        std::vector<world::Chunk> chunks {};
+        std::size_t               memoryBytes = 0;
+
+        const Clock::time_point generateStart = Clock::now();
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            chunks.push_back(generator.generateChunk(coordinate));
+            memoryBytes += chunks.back().getMemoryUsage();
+        }
+        const double generateSeconds = getSecondsSince(generateStart);
+
+        const double rawMiB =
+            static_cast<double>(coordinates.size() * world::ChunkVolume * sizeof(world::Voxel)) / BytesPerMiB;
+
+        // The codec on its own
+        std::vector<std::vector<std::byte>> encoded {};
+        std::size_t                         encodedBytes = 0;
+
+        const Clock::time_point encodeStart = Clock::now();
+        for (const world::Chunk& chunk : chunks)
+        {
+            encoded.push_back(world::encodeChunk(chunk));
+            encodedBytes += encoded.back().size();
+        }
+        const double encodeSeconds = getSecondsSince(encodeStart);
+
+        std::size_t undecodable = 0;
+
+        const Clock::time_point decodeStart = Clock::now();
+        for (const std::vector<std::byte>& bytes : encoded)
+        {
+            if (!world::decodeChunk(bytes).has_value())
+            {
+                ++undecodable;
+            }
+        }
+        const double decodeSeconds = getSecondsSince(decodeStart);
+
+        seb::assertFatal(undecodable == 0, "{} encoded chunks failed to decode", undecodable);
+
+        Report codec {};
+        codec.setInteger("chunks", coordinates.size());
+        codec.setInteger("encoded_bytes", encodedBytes);
+        codec.setNumber("ratio_to_raw", rawMiB * BytesPerMiB / static_cast<double>(encodedBytes));
+        codec.setNumber("ratio_to_memory", static_cast<double>(memoryBytes) / static_cast<double>(encodedBytes));
+        codec.setNumber("encode_mib_per_second", rawMiB / encodeSeconds);
+        codec.setNumber("decode_mib_per_second", rawMiB / decodeSeconds);
+
+        // Through region files, saving includes waiting for the writer
+        double      saveSeconds = 0.0;
+        std::size_t fileBytes   = 0;
+        {
+            world::RegionStore store {directory};
+
+            const Clock::time_point saveStart = Clock::now();
+            for (std::size_t i = 0; i < coordinates.size(); ++i)
+            {
+                store.save(coordinates[i], chunks[i]);
+            }
+            store.flush();
+            saveSeconds = getSecondsSince(saveStart);
+
+            fileBytes = getDirectorySize(directory);
+        }
+
+        // a fresh store, so every region is opened and mapped again
+        std::vector<std::optional<world::Chunk>> loaded {};
+        double                                   loadSeconds = 0.0;
+        {
+            world::RegionStore store {directory};
+
+            const Clock::time_point loadStart = Clock::now();
+            for (world::ChunkCoordinate coordinate : coordinates)
+            {
+                loaded.push_back(store.load(coordinate));
+            }
+            loadSeconds = getSecondsSince(loadStart);
+        }
+
+        std::size_t mismatched = 0;
+        for (std::size_t i = 0; i < coordinates.size(); ++i)
+        {
+            if (!loaded[i].has_value() || unpackChunk(*loaded[i]) != unpackChunk(chunks[i]))
+            {
+                ++mismatched;
+            }
+        }
+
+        seb::assertFatal(mismatched == 0, "{} chunks loaded differently than they were saved", mismatched);
+
+        std::filesystem::remove_all(directory);
+
+        Report regions {};
+        regions.setInteger("file_bytes", fileBytes);
+        regions.setNumber("save_mib_per_second", rawMiB / saveSeconds);
+        regions.setNumber("load_mib_per_second", rawMiB / loadSeconds);
+        regions.setNumber("load_chunks_per_second", static_cast<double>(coordinates.size()) / loadSeconds);
+        regions.setNumber("generate_chunks_per_second", static_cast<double>(coordinates.size()) / generateSeconds);
+        regions.setNumber("load_speedup_over_generate", generateSeconds / loadSeconds);
+        regions.setInteger("mismatched", mismatched);
+
+        Report report {};
+        report.setInteger("seed", seed);
+        report.setObject("codec", codec);
+        report.setObject("regions", regions);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,23 @@
+#ifndef SRC_BENCHMARK_REGION__BENCHMARK_HPP
+#define SRC_BENCHMARK_REGION__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Persistence of generated terrain chunks: encode and decode
+    /// throughput and compression ratio of the chunk codec, then saving
+    /// through a world::RegionStore and loading back with a fresh one,
+    /// against generating the same chunks again. Throughput is in
+    /// uncompressed voxel bytes. Every loaded chunk is checked against the
+    /// one that was saved.
+    ///
+    /// --chunks <n>     chunks per horizontal axis, 4 chunks high (8)
+    /// --seed   <n>     terrain seed (1337)
+    /// --dir    <path>  scratch directory, removed afterwards
+    ///                  (<temp>/dynamo_region_benchmark)
+    [[nodiscard]] Report runRegionBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_REGION__BENCHMARK_HPP
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+#include <fmt/format.h>
+
+#include <sebib/seblog.hpp>
+
+#include "report.hpp"
+
+static std::string encodeString(std::string_view string)
+{
+    std::string output {"\""};
+
+    for (char c : string)
+    {
+        switch (c)
+        {
+            case '"':  output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\n': output += "\\n";  break;
+            case '\t': output += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    output += fmt::format("\\u{:04x}", static_cast<unsigned>(c));
+                }
+                else
+                {
+                    output += c;
+                }
+        }
+    }
+
+    return output + "\"";
+}
+
+namespace benchmark
+{
+    Statistics Statistics::fromSamples(std::vector<double> samples)
+    {
+        if (samples.empty())
+        {
+            return Statistics {};
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        const auto percentile = [&](double p) -> double
+        {
+            const auto rank = static_cast<std::size_t>(
+                std::ceil(p * static_cast<double>(samples.size())));
+
+            return samples.at(std::clamp<std::size_t>(rank, 1, samples.size()) - 1);
+        };
+
+        return Statistics {
+            .samples {samples.size()},
+            .mean    {
+                std::accumulate(samples.cbegin(), samples.cend(), 0.0) /
+                static_cast<double>(samples.size())
+            },
+            .p50     {percentile(0.50)},
+            .p95     {percentile(0.95)},
+            .p99     {percentile(0.99)},
+            .max     {samples.back()},
+        };
+    }
+
+    void Report::setString(std::string key, std::string_view value)
+    {
+        this->set(std::move(key), encodeString(value));
+    }
+
+    void Report::setNumber(std::string key, double value)
+    {
+        // JSON has no representation for nan or inf
+        this->set(std::move(key), std::isfinite(value) ? fmt::format("{}", value) : "null");
+    }
+
+    void Report::setInteger(std::string key, std::uint64_t value)
+    {
+        this->set(std::move(key), fmt::format("{}", value));
+    }
+
+    void Report::setBool(std::string key, bool value)
+    {
+        this->set(std::move(key), value ? "true" : "false");
+    }
+
+    void Report::setStatistics(std::string key, const Statistics& statistics)
+    {
+        Report object {};
+
+        object.setInteger("samples", statistics.samples);
+        object.setNumber("mean", statistics.mean);
+        object.setNumber("p50", statistics.p50);
+        object.setNumber("p95", statistics.p95);
+        object.setNumber("p99", statistics.p99);
+        object.setNumber("max", statistics.max);
+
+        this->setObject(std::move(key), object);
+    }
+
+    void Report::setObject(std::string key, const Report& object)
+    {
+        this->set(std::move(key), object.toJson());
+    }
+
+    std::string Report::toJson() const
+    {
+        if (this->fields.empty())
+        {
+            return "{}";
+        }
+
+        // nested objects are re-indented by the parent
+        const std::string padding (4, ' ');
+        std::string output {"{\n"};
+
+        for (std::size_t i = 0; i < this->fields.size(); ++i)
+        {
+            std::string value = this->fields.at(i).second;
+
+            for (std::size_t n = value.find('\n'); n != std::string::npos; n = value.find('\n', n + 1))
+            {
+                value.insert(n + 1, padding);
+            }
+
+            output += fmt::format("{}{}: {}{}\n",
+                padding,
+                encodeString(this->fields.at(i).first),
+                value,
+                i + 1 == this->fields.size() ? "" : ","
+            );
+        }
+
+        return output + "}";
+    }
+
+    void Report::writeToFile(const std::string& filepath) const
+    {
+        std::ofstream fileStream {filepath, std::ios::out | std::ios::trunc};
+        seb::assertFatal(fileStream.is_open(), "Failed to open report file [{}]", filepath);
+
+        fileStream << this->toJson() << '\n';
+
+        seb::logLog("Wrote benchmark report to {}", filepath);
+    }
+
+    void Report::set(std::string key, std::string encodedValue)
+    {
+        const auto existing = std::find_if(this->fields.begin(), this->fields.end(),
+            [&](const std::pair<std::string, std::string>& field)
+            {
+                return field.first == key;
+            });
+
+        if (existing != this->fields.end())
+        {
+            existing->second = std::move(encodedValue);
+        }
+        else
+        {
+            this->fields.emplace_back(std::move(key), std::move(encodedValue));
+        }
+    }
+} // namespace benchmark
@@ -0,0 +1,57 @@
+#ifndef SRC_BENCHMARK_REPORT_HPP
+#define SRC_BENCHMARK_REPORT_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace benchmark
+{
+    /// @brief Percentiles use the nearest rank method
+    struct Statistics
+    {
+        std::size_t samples;
+        double      mean;
+        double      p50;
+        double      p95;
+        double      p99;
+        double      max;
+
+        [[nodiscard]] static Statistics fromSamples(std::vector<double>);
+    };
+
+    /// @brief An ordered JSON object, fields keep their insertion order so
+    /// reports from different builds diff cleanly
+    class Report
+    {
+    public:
+
+        Report()                         = default;
+        ~Report()                        = default;
+
+        Report(const Report&)            = default;
+        Report(Report&&)                 = default;
+        Report& operator=(const Report&) = default;
+        Report& operator=(Report&&)      = default;
+
+        void setString(std::string key, std::string_view);
+        void setNumber(std::string key, double);
+        void setInteger(std::string key, std::uint64_t);
+        void setBool(std::string key, bool);
+        void setStatistics(std::string key, const Statistics&);
+        void setObject(std::string key, const Report&);
+
+        [[nodiscard]] std::string toJson() const;
+        void writeToFile(const std::string& filepath) const;
+
+    private:
+        void set(std::string key, std::string encodedValue);
+
+        // values are stored already encoded as JSON
+        std::vector<std::pair<std::string, std::string>> fields;
+    }; // class Report
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_REPORT_HPP
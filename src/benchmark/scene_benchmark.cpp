@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <sebib/seblog.hpp>
+
+#include <render/camera_path.hpp>
+#include <render/renderer.hpp>
+#include <world/world.hpp>
+
+#include "scene_benchmark.hpp"
+
+// pixels between those the far field check casts a ray through
+constexpr std::uint32_t FarFieldCheckSpacing  = 8;
+// well past the chunks any scene keeps resident
+constexpr float         FarFieldCheckDistance = 4096.0f;
+// for streaming to settle and the brickmap to catch up before the check
+constexpr std::chrono::seconds FarFieldSettleTimeout {60};
+
+static render::PresentMode parsePresentMode(const std::string& mode)
+{
+    if (mode == "immediate")    return render::PresentMode::Immediate;
+    if (mode == "mailbox")      return render::PresentMode::Mailbox;
+    if (mode == "fifo")         return render::PresentMode::Fifo;
+    if (mode == "fifo_relaxed") return render::PresentMode::FifoRelaxed;
+
+    seb::panic("Unknown present mode {}", mode);
+}
+
+/// @brief The far field against World::raycast() from where its rays
+/// start, hits agree if they're about as far away. Holds @param camera
+/// still without edits until streaming settled and the renderer has the
+/// brickmap of every resident chunk, then draws the frame that is checked
+static benchmark::Report checkFarField(
+    render::Renderer& renderer, world::World& world, const render::Camera& camera, float distance)
+{
+    const auto settleStart = std::chrono::steady_clock::now();
+
+    while (!world.isStreamingSettled() || !world.isFarFieldCurrent())
+    {
+        seb::assertFatal(
+            std::chrono::steady_clock::now() - settleStart < FarFieldSettleTimeout,
+            "Far field brickmap didn't catch up with the chunks in {}s",
+            FarFieldSettleTimeout.count());
+
+        world.tick(renderer, camera);
+        renderer.drawFrame(camera, world.getVisibleObjects());
+    }
+
+    // the brickmap was handed over in the last tick, march it once more
+    world.tick(renderer, camera);
+    renderer.drawFrame(camera, world.getVisibleObjects());
+
+    const vk::Extent2D       extent  = renderer.getRenderExtent();
+    const std::vector<float> depth   = renderer.readFarFieldDepth();
+    const world::CameraView  view    = world::World::getCameraView(camera, extent);
+    const glm::mat4          inverse = glm::inverse(view.view_projection);
+
+    const auto unproject = [&](glm::vec2 ndc, float z)
+    {
+        const glm::vec4 point = inverse * glm::vec4 {ndc, z, 1.0f};
+
+        return glm::vec3 {point} / point.w;
+    };
+
+    std::vector<world::Ray> rays;
+    // to every marched hit, negative for misses
+    std::vector<float>      marched;
+
+    for (std::uint32_t y = 0; y < extent.height; y += FarFieldCheckSpacing)
+    {
+        for (std::uint32_t x = 0; x < extent.width; x += FarFieldCheckSpacing)
+        {
+            // through the pixel's center, like voxel_march.comp
+            const glm::vec2 ndc {
+                (static_cast<float>(x) + 0.5f) / static_cast<float>(extent.width) * 2.0f - 1.0f,
+                (static_cast<float>(y) + 0.5f) / static_cast<float>(extent.height) * 2.0f - 1.0f,
+            };
+            const glm::vec3 direction  = glm::normalize(unproject(ndc, 1.0f) - unproject(ndc, 0.0f));
+            const float     pixelDepth = depth[static_cast<std::size_t>(y) * extent.width + x];
+
+            rays.push_back(world::Ray {
+                .origin       {view.position + direction * distance},
+                .direction    {direction},
+                .max_distance {FarFieldCheckDistance},
+            });
+            marched.push_back(pixelDepth < 1.0f ? glm::length(unproject(ndc, pixelDepth) - view.position) : -1.0f);
+        }
+    }
+
+    std::vector<std::optional<world::RaycastHit>> hits (rays.size());
+    world.raycast(rays, hits);
+
+    std::size_t hitPixels        = 0;
+    std::size_t mismatchedPixels = 0;
+
+    for (std::size_t i = 0; i < rays.size(); ++i)
+    {
+        const bool isMarchedHit = marched[i] >= 0.0f;
+
+        if (isMarchedHit != hits[i].has_value())
+        {
+            ++mismatchedPixels;
+            continue;
+        }
+
+        if (!isMarchedHit)
+        {
+            continue;
+        }
+
+        ++hitPixels;
+
+        // depth loses precision with distance
+        const float cast = hits[i]->distance + distance;
+
+        if (std::abs(marched[i] - cast) > 1.0f + cast * 0.002f)
+        {
+            ++mismatchedPixels;
+        }
+    }
+
+    seb::assertFatal(
+        mismatchedPixels == 0,
+        "Far field disagrees with World::raycast() at {} of {} pixels",
+        mismatchedPixels,
+        rays.size());
+
+    benchmark::Report report {};
+    report.setNumber("distance", static_cast<double>(distance));
+    report.setInteger("checked_pixels", rays.size());
+    report.setInteger("hit_pixels", hitPixels);
+    report.setInteger("mismatched_pixels", mismatchedPixels);
+
+    return report;
+}
+
+namespace benchmark
+{
+    Report runSceneBenchmark(const Arguments& arguments)
+    {
+        const std::string scene      = arguments.getString("scene", "default");
+        const std::string pathName   = arguments.getString("path", "orbit");
+        const std::size_t frames     = arguments.getSize("frames", 1000);
+        const std::size_t warmup     = arguments.getSize("warmup", 60);
+        const bool        isHeadless = !arguments.hasFlag("windowed");
+        const std::size_t editEvery  = arguments.getSize("edit_every", 0);
+        const std::size_t editRadius = arguments.getSize("edit_radius", 6);
+        const auto        farField   = static_cast<float>(arguments.getSize("far_field", 0));
+        // dug out, then filled back in
+        const std::array<world::Voxel, 2> editVoxels {world::AirVoxel, world::material::Stone};
+
+        const vk::Extent2D extent {
+            .width  {static_cast<std::uint32_t>(arguments.getSize("width", 1280))},
+            .height {static_cast<std::uint32_t>(arguments.getSize("height", 720))},
+        };
+
+        render::Renderer renderer {
+            extent,
+            "Dynamo Benchmark",
+            render::PresentPolicy {
+                .mode        {parsePresentMode(arguments.getString("present", "immediate"))},
+                .image_count {std::nullopt},
+            },
+            isHeadless ? render::Renderer::Target::Headless : render::Renderer::Target::Window
+        };
+        world::World world {
+            renderer, scene, arguments.getString("saves", world::World::getDefaultSaveDirectory().string())};
+
+        if (farField > 0.0f)
+        {
+            world.setFarFieldDistance(farField);
+        }
+
+        const render::CameraPath path = pathName == "orbit"
+            ? render::CameraPath::orbit(frames, 250.0f, 120.0f)
+            : render::CameraPath::loadFromFile(pathName);
+
+        std::vector<double> cpuFrameMs;
+        std::vector<double> cpuFrameMsWhileMeshing;
+        std::vector<double> gpuFrameMs;
+        std::map<std::string, std::vector<double>> gpuZoneMs;
+        // full resolution chunk objects per frame, see World::CullingStatistics
+        std::vector<double> chunkObjects;
+        std::vector<double> chunksInFrustum;
+        std::vector<double> chunksDrawn;
+        std::vector<double> chunksPastFarField;
+        std::vector<double> cullMs;
+        cpuFrameMs.reserve(frames);
+        gpuFrameMs.reserve(frames);
+
+        // of the last frame drawn, for checking the far field
+        std::optional<render::Camera> lastCamera {std::nullopt};
+
+        for (std::size_t frame = 0; frame < warmup + frames && !renderer.shouldClose(); ++frame)
+        {
+            const bool isMeasured = frame >= warmup;
+            const render::Camera camera = path.getCamera(isMeasured ? frame - warmup : frame);
+
+            const bool isMeshing = !world.isMeshingIdle();
+            const auto start = std::chrono::steady_clock::now();
+
+            if (isMeasured && editEvery != 0 && (frame - warmup) % editEvery == 0)
+            {
+                render::Camera aim = camera;
+
+                world.fillSphere(
+                    aim.getPosition() + aim.getForwardVector() * 24.0f,
+                    static_cast<float>(editRadius),
+                    editVoxels[(frame - warmup) / editEvery % editVoxels.size()]
+                );
+            }
+
+            world.tick(renderer, camera);
+            renderer.drawFrame(camera, world.getVisibleObjects());
+            lastCamera = camera;
+
+            const std::chrono::duration<double, std::milli> cpuTime =
+                std::chrono::steady_clock::now() - start;
+
+            if (!isMeasured)
+            {
+                continue;
+            }
+
+            cpuFrameMs.push_back(cpuTime.count());
+
+            const world::World::CullingStatistics culling = world.getCullingStatistics();
+            chunkObjects.push_back(static_cast<double>(culling.chunk_objects));
+            chunksInFrustum.push_back(static_cast<double>(culling.in_frustum));
+            chunksDrawn.push_back(static_cast<double>(culling.drawn));
+            chunksPastFarField.push_back(static_cast<double>(culling.past_far_field));
+            cullMs.push_back(std::chrono::duration<double, std::milli> {culling.cull_time}.count());
+
+            if (isMeshing)
+            {
+                cpuFrameMsWhileMeshing.push_back(cpuTime.count());
+            }
+
+            if (const auto gpuTime = renderer.getLastGpuFrameTime(); gpuTime.has_value())
+            {
+                gpuFrameMs.push_back(std::chrono::duration<double, std::milli> {*gpuTime}.count());
+            }
+
+            for (const render::GpuProfiler::ZoneTiming& zone : renderer.getGpuTimings())
+            {
+                gpuZoneMs[zone.name].push_back(zone.last_ms);
+            }
+        }
+
+        // Per pass and per pipeline bucket, shows which one dominates
+        Report gpuZones {};
+        for (const render::GpuProfiler::ZoneTiming& zone : renderer.getGpuTimings())
+        {
+            Report zoneReport {};
+            zoneReport.setNumber("rolling_average_ms", zone.average_ms);
+            zoneReport.setStatistics("ms", Statistics::fromSamples(std::move(gpuZoneMs[zone.name])));
+
+            gpuZones.setObject(zone.name, zoneReport);
+        }
+
+        const auto meshingStatistics = world.getMeshingStatistics();
+
+        Report meshing {};
+        meshing.setInteger("workers", meshingStatistics.workers);
+        meshing.setInteger("chunks_meshed", meshingStatistics.meshed_total);
+        meshing.setInteger("queue_depth_at_end", meshingStatistics.getQueueDepth());
+        meshing.setNumber("average_mesh_ms", meshingStatistics.average_mesh_time.count() * 1000.0);
+        meshing.setNumber("average_latency_ms", meshingStatistics.average_latency.count() * 1000.0);
+        meshing.setNumber("worst_latency_ms", meshingStatistics.worst_latency.count() * 1000.0);
+        meshing.setStatistics("cpu_frame_ms_while_meshing", Statistics::fromSamples(std::move(cpuFrameMsWhileMeshing)));
+
+        const auto sum = [](const std::vector<double>& values)
+        {
+            double total = 0.0;
+            for (double v : values)
+            {
+                total += v;
+            }
+            return total;
+        };
+
+        Report culling {};
+        culling.setNumber("frustum_draw_reduction", sum(chunkObjects) / std::max(sum(chunksInFrustum), 1.0));
+        culling.setNumber("occlusion_draw_reduction", sum(chunksInFrustum) / std::max(sum(chunksDrawn), 1.0));
+        culling.setNumber("total_draw_reduction", sum(chunkObjects) / std::max(sum(chunksDrawn), 1.0));
+        culling.setStatistics("chunk_objects", Statistics::fromSamples(std::move(chunkObjects)));
+        culling.setStatistics("in_frustum", Statistics::fromSamples(std::move(chunksInFrustum)));
+        culling.setStatistics("drawn", Statistics::fromSamples(std::move(chunksDrawn)));
+        culling.setStatistics("past_far_field", Statistics::fromSamples(std::move(chunksPastFarField)));
+        culling.setStatistics("cull_ms", Statistics::fromSamples(std::move(cullMs)));
+
+        Report report {};
+        report.setString("scene", scene);
+        report.setString("path", pathName);
+        report.setInteger("frames", cpuFrameMs.size());
+        report.setInteger("warmup_frames", warmup);
+        report.setBool("headless", isHeadless);
+        report.setInteger("width", extent.width);
+        report.setInteger("height", extent.height);
+        report.setStatistics("cpu_frame_ms", Statistics::fromSamples(std::move(cpuFrameMs)));
+        report.setStatistics("gpu_frame_ms", Statistics::fromSamples(std::move(gpuFrameMs)));
+        report.setObject("gpu_zones", gpuZones);
+        report.setObject("meshing", meshing);
+        report.setObject("culling", culling);
+
+        if (editEvery != 0)
+        {
+            const auto editStatistics = world.getEditStatistics();
+
+            Report edits {};
+            edits.setInteger("edits", editStatistics.edits_total);
+            edits.setInteger("edited_chunks", editStatistics.edited_chunks_total);
+            edits.setInteger("pending_batches_at_end", editStatistics.pending_batches);
+            edits.setNumber("average_edit_to_visible_ms", editStatistics.average_latency.count() * 1000.0);
+            edits.setNumber("worst_edit_to_visible_ms", editStatistics.worst_latency.count() * 1000.0);
+
+            report.setObject("edits", edits);
+        }
+
+        if (farField > 0.0f && lastCamera.has_value())
+        {
+            report.setObject("far_field", checkFarField(renderer, world, *lastCamera, farField));
+        }
+
+        if (const auto streamingStatistics = world.getStreamingStatistics(); streamingStatistics.has_value())
+        {
+            Report streaming {};
+            streaming.setInteger("resident_chunks_at_end", streamingStatistics->resident_chunks);
+            streaming.setInteger("resident_bytes_at_end", streamingStatistics->resident_bytes);
+            streaming.setInteger("cached_bytes_at_end", streamingStatistics->cached_bytes);
+            streaming.setInteger("generated", streamingStatistics->generated_total);
+            streaming.setInteger("loaded_from_disk", streamingStatistics->loaded_from_disk_total);
+            streaming.setInteger("evicted", streamingStatistics->evicted_total);
+
+            report.setObject("streaming", streaming);
+        }
+
+        if (const auto rings = world.getLodStatistics(); rings.size() > 1)
+        {
+            Report lod {};
+
+            for (const auto& ring : rings)
+            {
+                Report ringReport {};
+                ringReport.setInteger("scale", static_cast<std::uint64_t>(ring.scale));
+                ringReport.setInteger("resident_at_end", ring.resident);
+                ringReport.setInteger("voxel_bytes_at_end", ring.voxel_bytes);
+                ringReport.setInteger("objects_at_end", ring.objects);
+                ringReport.setInteger("triangles_at_end", ring.triangles);
+                ringReport.setInteger("mesh_bytes_at_end", ring.mesh_bytes);
+
+                lod.setObject(fmt::format("level_{}", ring.level), ringReport);
+            }
+
+            report.setObject("lod", lod);
+        }
+
+        return report;
+    }
+} // namespace benchmark
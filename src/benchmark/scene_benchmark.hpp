@@ -0,0 +1,32 @@
+#ifndef SRC_BENCHMARK_SCENE__BENCHMARK_HPP
+#define SRC_BENCHMARK_SCENE__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Replays a CameraPath through a World scene for a fixed number
+    /// of frames and reports CPU and GPU frame time percentiles. Frames
+    /// during which chunks were still meshing are also reported on their own.
+    ///
+    /// --scene   <name>   World scene to load (default)
+    /// --path    <file>   recorded CameraPath, defaults to a built in orbit
+    /// --frames  <n>      measured frames (1000)
+    /// --warmup  <n>      frames rendered before measuring (60)
+    /// --width / --height render extent (1280 x 720)
+    /// --present <mode>   immediate | mailbox | fifo | fifo_relaxed (immediate)
+    /// --edit_every  <n>  measured frames between sphere edits in front of the
+    ///                    camera, alternately dug out and filled, 0 for none (0)
+    /// --edit_radius <n>  radius of those spheres in voxels (6)
+    /// --far_field   <n>  voxels past which chunks are ray marched instead of
+    ///                    drawn, 0 for none (0). Once streaming settled and
+    ///                    the brickmap caught up, the last camera's march
+    ///                    must agree with World::raycast() every 8th pixel
+    /// --saves <dir>      where streamed scenes keep edited chunks, next to
+    ///                    the executable by default
+    /// --windowed         present to a window instead of rendering headless
+    [[nodiscard]] Report runSceneBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_SCENE__BENCHMARK_HPP
@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#include <sebib/seblog.hpp>
+
+#include <util/worker_pool.hpp>
+#include <world/meshing_pipeline.hpp>
+#include <world/simulation.hpp>
+
+#include "simulation_benchmark.hpp"
+
+namespace
+{
+    using Clock  = world::Simulation::Clock;
+    using Motion = world::Simulation::Motion;
+
+    // float error piled up over a few hundred ticks of += at most a few
+    // hundred voxels from the origin
+    constexpr float MaxTranslationError = 1e-2f;
+    constexpr float MaxRotationError    = 1e-3f;
+    // checking every body would take longer than the frames it checks
+    constexpr std::size_t CheckStride   = 7;
+
+    struct Bodies
+    {
+        std::vector<render::Transform> transforms;
+        std::vector<Motion>            motions;
+    };
+
+    /// @brief The same @param count bodies for every @param seed
+    Bodies makeBodies(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937                          generator {seed};
+        std::uniform_real_distribution<float> coordinate {-256.0f, 256.0f};
+        std::uniform_real_distribution<float> speed {-32.0f, 32.0f};
+        std::uniform_real_distribution<float> spin {-3.0f, 3.0f};
+
+        Bodies bodies {};
+        bodies.transforms.reserve(count);
+        bodies.motions.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            render::Transform transform {};
+            transform.translation = {coordinate(generator), coordinate(generator), coordinate(generator)};
+
+            bodies.transforms.push_back(transform);
+            bodies.motions.push_back(Motion {
+                .velocity         {speed(generator), speed(generator), speed(generator)},
+                .angular_velocity {spin(generator), spin(generator), spin(generator)},
+            });
+        }
+
+        return bodies;
+    }
+
+    /// @brief Milliseconds of @param frame, each started at the next of
+    /// @param count instants @param interval apart. @param afterFrame runs
+    /// untimed in between
+    template<class Frame, class AfterFrame>
+    std::vector<double> runFrames(std::size_t count, Clock::duration interval, Frame frame, AfterFrame afterFrame)
+    {
+        std::vector<double> frameMs {};
+        Clock::time_point   next = Clock::now();
+
+        for (std::size_t i = 0; i < count; ++i, next += interval)
+        {
+            std::this_thread::sleep_until(next);
+
+            const Clock::time_point start = Clock::now();
+            frame();
+            frameMs.push_back(std::chrono::duration<double, std::milli> {Clock::now() - start}.count());
+
+            afterFrame();
+        }
+
+        return frameMs;
+    }
+
+    /// @brief How far @param actual is from where @param motion moves
+    /// @param reference in @param seconds
+    struct Errors
+    {
+        float translation;
+        // radians
+        float rotation;
+
+        void add(const render::Transform& reference, const Motion& motion, float seconds, const render::Transform& actual)
+        {
+            render::Transform expected = reference;
+            world::Simulation::move(expected, motion, seconds);
+
+            // q and -q are the same rotation, twice the chord is the angle
+            // while it's small, acos() of their dot product would lose it
+            const float     sign       = glm::dot(actual.rotation, expected.rotation) < 0.0f ? -1.0f : 1.0f;
+            const glm::quat difference = actual.rotation - expected.rotation * sign;
+
+            this->translation = std::max(this->translation, glm::length(actual.translation - expected.translation));
+            this->rotation    = std::max(this->rotation, 2.0f * glm::length(difference));
+        }
+    };
+
+    double sum(const std::vector<double>& samples)
+    {
+        return std::accumulate(samples.cbegin(), samples.cend(), 0.0);
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runSimulationBenchmark(const Arguments& arguments)
+    {
+        const auto count     = arguments.getSize("bodies", 100000);
+        const auto seconds   = arguments.getSize("seconds", 3);
+        const auto tickRate  = arguments.getSize("tick_rate", 60);
+        const auto frameRate = arguments.getSize("frame_rate", 240);
+        const auto seed      = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const auto workers   = arguments.getSize("workers", world::MeshingPipeline::getDefaultWorkerCount());
+
+        seb::assertFatal(tickRate > 0 && frameRate > 0, "Tick and frame rates must be positive");
+
+        const std::size_t     frames        = seconds * frameRate;
+        const float           frameSeconds  = 1.0f / static_cast<float>(frameRate);
+        const Clock::duration frameInterval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double> {1.0 / static_cast<double>(frameRate)});
+
+        Report report {};
+        report.setInteger("bodies", count);
+        report.setInteger("tick_rate", tickRate);
+        report.setInteger("frame_rate", frameRate);
+        report.setInteger("workers", workers);
+
+        // every frame steps every body by the frame's time and draws it
+        Bodies lockstep = makeBodies(count, seed);
+        std::vector<render::Transform> drawn (count);
+
+        const std::vector<double> lockstepMs = runFrames(frames, frameInterval, [&]
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                world::Simulation::move(lockstep.transforms[i], lockstep.motions[i], frameSeconds);
+                drawn[i] = lockstep.transforms[i];
+            }
+        }, [] {});
+
+        Report lockstepReport {};
+        lockstepReport.setStatistics("frame_ms", Statistics::fromSamples(lockstepMs));
+        lockstepReport.setInteger("steps", frames);
+        lockstepReport.setNumber("cpu_ms_per_second", sum(lockstepMs) / static_cast<double>(seconds));
+        report.setObject("lockstep", lockstepReport);
+
+        // every frame draws a tick behind, between the two newest ticks
+        const Bodies            bodies = makeBodies(count, seed);
+        const Clock::time_point start  = Clock::now();
+
+        util::WorkerPool  pool {workers};
+        world::Simulation simulation {static_cast<double>(tickRate), pool};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            seb::assertFatal(
+                simulation.addBody(bodies.transforms[i], bodies.motions[i]) == i,
+                "Body {} got another index",
+                i);
+        }
+
+        const float tickSeconds = std::chrono::duration<float> {simulation.getTickDuration()}.count();
+
+        // the first snapshot with every body, what every later one is checked against
+        std::vector<render::Transform> reference {};
+        std::uint64_t                  referenceTick = 0;
+
+        bool          isAcquired   = false;
+        float         alpha        = 0.0f;
+        std::size_t   acquired     = 0;
+        std::size_t   lastTicks    = 0;
+        std::uint64_t lastTick     = 0;
+        Errors        snapshotErrors {};
+        Errors        drawnErrors {};
+        std::vector<double> tickMs {};
+
+        const std::vector<double> decoupledMs = runFrames(frames, frameInterval, [&]
+        {
+            isAcquired = simulation.acquireSnapshot();
+
+            const world::Simulation::Snapshot& snapshot = simulation.getSnapshot();
+            alpha = simulation.getAlpha(snapshot, Clock::now());
+
+            if (snapshot.current.size() == count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    drawn[i] = world::Simulation::interpolate(snapshot.previous[i], snapshot.current[i], alpha);
+                }
+            }
+        }, [&]
+        {
+            const world::Simulation::Snapshot& snapshot = simulation.getSnapshot();
+
+            if (const world::Simulation::Statistics statistics = simulation.getStatistics();
+                statistics.ticks != lastTicks)
+            {
+                tickMs.push_back(statistics.tick_time.count() * 1000.0);
+                lastTicks = statistics.ticks;
+            }
+
+            if (isAcquired)
+            {
+                seb::assertFatal(snapshot.tick > lastTick, "Snapshot of tick {} after tick {}", snapshot.tick, lastTick);
+
+                ++acquired;
+                lastTick = snapshot.tick;
+            }
+
+            if (snapshot.current.size() != count)
+            {
+                return;
+            }
+
+            if (reference.empty())
+            {
+                reference     = snapshot.current;
+                referenceTick = snapshot.tick;
+
+                return;
+            }
+
+            const auto ticks = static_cast<float>(snapshot.tick - referenceTick);
+
+            for (std::size_t i = 0; i < count; i += CheckStride)
+            {
+                if (isAcquired)
+                {
+                    snapshotErrors.add(reference[i], bodies.motions[i], ticks * tickSeconds, snapshot.current[i]);
+                    snapshotErrors.add(
+                        reference[i], bodies.motions[i], (ticks - 1.0f) * tickSeconds, snapshot.previous[i]);
+                }
+
+                if (snapshot.tick > referenceTick)
+                {
+                    drawnErrors.add(reference[i], bodies.motions[i], (ticks - 1.0f + alpha) * tickSeconds, drawn[i]);
+                }
+            }
+        });
+
+        const world::Simulation::Statistics statistics = simulation.getStatistics();
+        const double elapsedSeconds = std::chrono::duration<double> {Clock::now() - start}.count();
+        const auto   expectedTicks  = static_cast<std::size_t>(elapsedSeconds * static_cast<double>(tickRate));
+
+        Report decoupled {};
+        decoupled.setStatistics("frame_ms", Statistics::fromSamples(decoupledMs));
+        decoupled.setStatistics("tick_ms", Statistics::fromSamples(tickMs));
+        decoupled.setInteger("ticks", statistics.ticks);
+        decoupled.setInteger("expected_ticks", expectedTicks);
+        decoupled.setInteger("dropped_ticks", statistics.dropped_ticks);
+        // published, then replaced before any frame took them
+        decoupled.setInteger("unacquired_ticks", statistics.ticks - std::min(statistics.ticks, acquired));
+        decoupled.setNumber(
+            "cpu_ms_per_second",
+            (sum(decoupledMs) + sum(tickMs) * static_cast<double>(statistics.ticks)
+                                    / static_cast<double>(std::max(tickMs.size(), std::size_t {1})))
+                / elapsedSeconds);
+        report.setObject("decoupled", decoupled);
+
+        Report accuracy {};
+        accuracy.setInteger("reference_tick", referenceTick);
+        accuracy.setNumber("max_snapshot_translation_error", snapshotErrors.translation);
+        accuracy.setNumber("max_snapshot_rotation_error", snapshotErrors.rotation);
+        accuracy.setNumber("max_drawn_translation_error", drawnErrors.translation);
+        accuracy.setNumber("max_drawn_rotation_error", drawnErrors.rotation);
+        report.setObject("accuracy", accuracy);
+
+        // late ticks are made up for or dropped, never lost
+        if (statistics.ticks + statistics.dropped_ticks + 1 < expectedTicks
+            || statistics.ticks + statistics.dropped_ticks > expectedTicks + 1)
+        {
+            seb::logWarn(
+                "Ran {} and dropped {} ticks in {}s at {} ticks per second",
+                statistics.ticks,
+                statistics.dropped_ticks,
+                elapsedSeconds,
+                tickRate);
+        }
+
+        seb::assertFatal(!reference.empty(), "No snapshot with every body in {}s", seconds);
+        seb::assertFatal(
+            snapshotErrors.translation <= MaxTranslationError && snapshotErrors.rotation <= MaxRotationError,
+            "Snapshots are {} voxels and {} radians off the bodies' motion",
+            snapshotErrors.translation,
+            snapshotErrors.rotation);
+        seb::assertFatal(
+            drawnErrors.translation <= MaxTranslationError && drawnErrors.rotation <= MaxRotationError,
+            "Interpolated transforms are {} voxels and {} radians off the bodies' motion",
+            drawnErrors.translation,
+            drawnErrors.rotation);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,27 @@
+#ifndef SRC_BENCHMARK_SIMULATION__BENCHMARK_HPP
+#define SRC_BENCHMARK_SIMULATION__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Moves bodies at constant linear and angular velocities while
+    /// frames are paced at the frame rate, first stepped inline once per
+    /// frame, then by a world::Simulation at the tick rate with every frame
+    /// interpolating its snapshots. Measures both frames' CPU time, what each
+    /// costs per second of frames, and counts the simulation's ticks against
+    /// the tick rate. Every snapshot acquired and every interpolated
+    /// transform is checked against the bodies' motion from the first
+    /// complete snapshot, which catches torn snapshots as well.
+    ///
+    /// --bodies     <n>   bodies (100000)
+    /// --seconds    <n>   of frames per run (3)
+    /// --tick_rate  <n>   simulation ticks per second (60)
+    /// --frame_rate <n>   frames per second (240)
+    /// --seed       <n>   seed of the bodies' initial state (1337)
+    /// --workers    <n>   simulation workers besides its own thread (all but one hardware thread)
+    [[nodiscard]] Report runSimulationBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_SIMULATION__BENCHMARK_HPP
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <world/chunk_streamer.hpp>
+#include <world/meshing_pipeline.hpp>
+#include <world/terrain.hpp>
+#include <world/world.hpp>
+
+#include "streaming_benchmark.hpp"
+
+namespace
+{
+    constexpr std::size_t MiB = std::size_t {1024} * 1024;
+
+    using Clock = std::chrono::steady_clock;
+} // namespace
+
+namespace benchmark
+{
+    Report runStreamingBenchmark(const Arguments& arguments)
+    {
+        const std::size_t frames  = arguments.getSize("frames", 1200);
+        const auto        speed   = static_cast<float>(arguments.getSize("speed", 8));
+        const auto        radius  = static_cast<std::int32_t>(arguments.getSize("radius", 8));
+        const std::size_t workers = arguments.getSize(
+            "workers", std::max(std::size_t {1}, world::MeshingPipeline::getDefaultWorkerCount() / 2));
+        const std::chrono::milliseconds framePeriod {arguments.getSize("frame_ms", 16)};
+
+        const world::StreamingSettings settings {
+            .load_radius         {radius},
+            .unload_radius       {radius + 2},
+            .min_chunk_y         {0},
+            .max_chunk_y         {3},
+            .max_resident_chunks {static_cast<std::size_t>((2 * radius + 1) * (2 * radius + 1) * 3)},
+            .max_resident_bytes  {arguments.getSize("max_mb", 64) * MiB},
+            .max_cached_bytes    {arguments.getSize("cache_mb", 32) * MiB},
+            .max_generating      {workers * 4},
+        };
+
+        world::VoxelStorage    storage {};
+        world::ChunkStreamer   streamer {settings, world::generateHillsChunk, workers};
+        world::MeshingPipeline pipeline {workers, 64};
+
+        const vk::Extent2D extent {.width {1280}, .height {720}};
+
+        std::vector<double> frameUs;
+        std::vector<double> updateUs;
+        std::size_t         maxResidentChunks = 0;
+        std::size_t         maxResidentBytes  = 0;
+        std::size_t         maxCachedBytes    = 0;
+        std::size_t         unsettledFrames   = 0;
+        std::size_t         meshesCollected   = 0;
+        frameUs.reserve(frames);
+        updateUs.reserve(frames);
+
+        for (std::size_t frame = 0; frame < frames; ++frame)
+        {
+            // out along +x, then back over the same ground
+            const std::size_t step = frame < frames / 2 ? frame : frames - frame;
+            const render::Camera camera {
+                glm::vec3 {static_cast<float>(step) * speed, 120.0f, 0.0f}, 0.0f, 0.0f};
+            const world::CameraView view = world::World::getCameraView(camera, extent);
+
+            const Clock::time_point frameStart = Clock::now();
+
+            const world::ChunkStreamer::Changes changes = streamer.update(storage, view);
+            const Clock::time_point updateEnd = Clock::now();
+
+            for (world::ChunkCoordinate coordinate : changes.loaded)
+            {
+                pipeline.markDirty(coordinate);
+            }
+
+            pipeline.dispatch(storage, view);
+            meshesCollected += pipeline.collect(32).size();
+
+            const Clock::time_point frameEnd = Clock::now();
+            updateUs.push_back(std::chrono::duration<double, std::micro> {updateEnd - frameStart}.count());
+            frameUs.push_back(std::chrono::duration<double, std::micro> {frameEnd - frameStart}.count());
+
+            const world::ChunkStreamer::Statistics statistics = streamer.getStatistics();
+            maxResidentChunks = std::max(maxResidentChunks, statistics.resident_chunks);
+            maxResidentBytes  = std::max(maxResidentBytes, statistics.resident_bytes);
+            maxCachedBytes    = std::max(maxCachedBytes, statistics.cached_bytes);
+
+            if (!streamer.isSettled())
+            {
+                ++unsettledFrames;
+            }
+
+            std::this_thread::sleep_until(frameStart + framePeriod);
+        }
+
+        const world::ChunkStreamer::Statistics statistics = streamer.getStatistics();
+
+        Report limits {};
+        limits.setInteger("max_resident_chunks", settings.max_resident_chunks);
+        limits.setInteger("max_resident_bytes", settings.max_resident_bytes);
+        limits.setInteger("max_cached_bytes", settings.max_cached_bytes);
+
+        Report peaks {};
+        peaks.setInteger("resident_chunks", maxResidentChunks);
+        peaks.setInteger("resident_bytes", maxResidentBytes);
+        peaks.setInteger("cached_bytes", maxCachedBytes);
+
+        Report totals {};
+        totals.setInteger("generated", statistics.generated_total);
+        totals.setInteger("cache_hits", statistics.cache_hits_total);
+        totals.setInteger("evicted", statistics.evicted_total);
+        totals.setInteger("dropped_from_cache", statistics.dropped_from_cache_total);
+        totals.setInteger("limit_evictions", statistics.limit_evictions_total);
+        totals.setInteger("meshes_collected", meshesCollected);
+
+        Report report {};
+        report.setInteger("frames", frames);
+        report.setInteger("workers", workers);
+        report.setInteger("load_radius", static_cast<std::size_t>(settings.load_radius));
+        report.setNumber("distance_chunks", static_cast<double>(frames / 2) * static_cast<double>(speed) / world::ChunkExtent);
+        report.setInteger("unsettled_frames", unsettledFrames);
+        report.setStatistics("main_thread_frame_us", Statistics::fromSamples(std::move(frameUs)));
+        report.setStatistics("streamer_update_us", Statistics::fromSamples(std::move(updateUs)));
+        report.setObject("limits", limits);
+        report.setObject("peaks", peaks);
+        report.setObject("totals", totals);
+
+        return report;
+    }
+} // namespace benchmark
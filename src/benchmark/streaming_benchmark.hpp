@@ -0,0 +1,25 @@
+#ifndef SRC_BENCHMARK_STREAMING__BENCHMARK_HPP
+#define SRC_BENCHMARK_STREAMING__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Flies a camera in a straight line over endless hills with a
+    /// ChunkStreamer and MeshingPipeline driven from a simulated frame loop,
+    /// no GPU involved. Reports the main thread's per frame cost, how many
+    /// chunks and bytes were resident at worst against the configured
+    /// limits and how the cache was used after turning back halfway.
+    ///
+    /// --frames   <n>   simulated frames, the second half flies back (1200)
+    /// --speed    <n>   voxels per frame (8)
+    /// --radius   <n>   load radius in chunks, unloads 2 further out (8)
+    /// --max_mb   <n>   resident memory limit (64)
+    /// --cache_mb <n>   cache memory limit (32)
+    /// --workers  <n>   generator and meshing threads each (half the hardware threads)
+    /// --frame_ms <n>   simulated frame period (16)
+    [[nodiscard]] Report runStreamingBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_STREAMING__BENCHMARK_HPP
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+#include <sebib/seblog.hpp>
+
+#include <world/noise.hpp>
+#include <world/terrain.hpp>
+
+#include "terrain_benchmark.hpp"
+
+namespace
+{
+    constexpr std::int32_t WorldHeightChunks = 4;
+    constexpr std::size_t  RowLength         = world::ChunkExtent;
+    // a power of two so x + i * step is exact and single samples land on
+    // exactly the row's positions
+    constexpr float        SampleStep        = 1.0f / 8.0f;
+
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<world::Voxel> unpackChunk(const world::Chunk& chunk)
+    {
+        std::vector<world::Voxel> voxels (world::ChunkVolume);
+        chunk.unpack(std::span<world::Voxel, world::ChunkVolume> {voxels.data(), world::ChunkVolume});
+
+        return voxels;
+    }
+
+    /// @brief Samples per second of @param sample called one at a time and
+    /// of @param sampleRow over rows of RowLength, plus the largest
+    /// difference between the two
+    benchmark::Report compareNoise(
+        std::size_t samples,
+        const std::function<float(float x, float y, float z)>& sample,
+        const std::function<void(float x, float y, float z, std::span<float>)>& sampleRow)
+    {
+        const std::size_t rows = samples / RowLength;
+
+        std::vector<float> single (rows * RowLength);
+        std::vector<float> batched (rows * RowLength);
+
+        const auto getRowStart = [](std::size_t row)
+        {
+            return std::array<float, 3> {
+                static_cast<float>(row % 64) * static_cast<float>(RowLength) * SampleStep,
+                static_cast<float>(row / 64 % 64) * SampleStep,
+                static_cast<float>(row / 4096) * SampleStep,
+            };
+        };
+
+        const Clock::time_point singleStart = Clock::now();
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            const auto [x, y, z] = getRowStart(row);
+
+            for (std::size_t i = 0; i < RowLength; ++i)
+            {
+                single[row * RowLength + i] = sample(x + static_cast<float>(i) * SampleStep, y, z);
+            }
+        }
+        const std::chrono::duration<double> singleTime = Clock::now() - singleStart;
+
+        const Clock::time_point batchedStart = Clock::now();
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            const auto [x, y, z] = getRowStart(row);
+
+            sampleRow(x, y, z, std::span {batched}.subspan(row * RowLength, RowLength));
+        }
+        const std::chrono::duration<double> batchedTime = Clock::now() - batchedStart;
+
+        float largestDifference = 0.0f;
+        for (std::size_t i = 0; i < single.size(); ++i)
+        {
+            largestDifference = std::max(largestDifference, std::abs(single[i] - batched[i]));
+        }
+
+        benchmark::Report report {};
+        report.setNumber("single_samples_per_second", static_cast<double>(single.size()) / singleTime.count());
+        report.setNumber("row_samples_per_second", static_cast<double>(batched.size()) / batchedTime.count());
+        report.setNumber("row_speedup", singleTime.count() / batchedTime.count());
+        report.setNumber("largest_difference", static_cast<double>(largestDifference));
+
+        return report;
+    }
+
+    /// @brief Seconds to generate every chunk at @param coordinates on the
+    /// calling thread
+    double timeGeneration(
+        const std::vector<world::ChunkCoordinate>& coordinates,
+        const std::function<world::Chunk(world::ChunkCoordinate)>& generate)
+    {
+        const Clock::time_point start = Clock::now();
+
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            static_cast<void>(generate(coordinate));
+        }
+
+        return std::chrono::duration<double> {Clock::now() - start}.count();
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runTerrainBenchmark(const Arguments& arguments)
+    {
+        const auto        chunksPerAxis = static_cast<std::int32_t>(arguments.getSize("chunks", 8));
+        const auto        seed          = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const std::size_t samples       = arguments.getSize("samples", std::size_t {1} << 22);
+
+        std::vector<world::ChunkCoordinate> coordinates {};
+        for (std::int32_t cy = 0; cy < WorldHeightChunks; ++cy)
+        {
+            for (std::int32_t cz = -chunksPerAxis / 2; cz < chunksPerAxis - chunksPerAxis / 2; ++cz)
+            {
+                for (std::int32_t cx = -chunksPerAxis / 2; cx < chunksPerAxis - chunksPerAxis / 2; ++cx)
+                {
+                    coordinates.push_back({cx, cy, cz});
+                }
+            }
+        }
+
+        // Noise on its own
+        const world::GradientNoise gradient {seed};
+
+        Report noise {};
+        noise.setObject("gradient_2d", compareNoise(samples,
+            [&](float x, float, float z) { return gradient.sample(x, z); },
+            [&](float x, float, float z, std::span<float> out) { gradient.sampleRow(x, z, SampleStep, out); }));
+        noise.setObject("gradient_3d", compareNoise(samples,
+            [&](float x, float y, float z) { return gradient.sample(x, y, z); },
+            [&](float x, float y, float z, std::span<float> out) { gradient.sampleRow(x, y, z, SampleStep, out); }));
+
+        // Whole chunks on this thread
+        const world::TerrainGenerator generator {seed};
+
+        const double noiseSeconds = timeGeneration(coordinates,
+            [&](world::ChunkCoordinate coordinate) { return generator.generateChunk(coordinate); });
+        const double hillsSeconds = timeGeneration(coordinates, world::generateHillsChunk);
+
+        const double voxels = static_cast<double>(coordinates.size() * world::ChunkVolume);
+
+        Report generation {};
+        generation.setInteger("chunks", coordinates.size());
+        generation.setNumber("chunks_per_second", static_cast<double>(coordinates.size()) / noiseSeconds);
+        generation.setNumber("voxels_per_second_per_core", voxels / noiseSeconds);
+        generation.setNumber("hills_voxels_per_second_per_core", voxels / hillsSeconds);
+
+        // Determinism, an equally seeded copy on another thread going through
+        // the chunks backwards has to produce the same voxels, and packing
+        // has to agree with setting every voxel
+        std::vector<world::Chunk> reference {};
+        for (world::ChunkCoordinate coordinate : coordinates)
+        {
+            reference.push_back(generator.generateChunk(coordinate));
+        }
+
+        std::vector<std::optional<world::Chunk>> fromOtherThread (coordinates.size());
+        std::jthread {[&, copy = world::TerrainGenerator {seed}]
+        {
+            for (std::size_t i = coordinates.size(); i-- > 0;)
+            {
+                fromOtherThread[i] = copy.generateChunk(coordinates[i]);
+            }
+        }}.join();
+
+        const world::TerrainGenerator otherSeed {seed + 1};
+
+        std::size_t mismatched     = 0;
+        std::size_t packMismatched = 0;
+        bool        seedsDiffer    = false;
+
+        for (std::size_t i = 0; i < coordinates.size(); ++i)
+        {
+            const std::vector<world::Voxel> voxelsHere = unpackChunk(reference[i]);
+
+            if (voxelsHere != unpackChunk(*fromOtherThread[i]))
+            {
+                ++mismatched;
+            }
+
+            if (voxelsHere != unpackChunk(otherSeed.generateChunk(coordinates[i])))
+            {
+                seedsDiffer = true;
+            }
+
+            world::Chunk setChunk {};
+            for (std::int32_t y = 0; y < world::ChunkExtent; ++y)
+            {
+                for (std::int32_t z = 0; z < world::ChunkExtent; ++z)
+                {
+                    for (std::int32_t x = 0; x < world::ChunkExtent; ++x)
+                    {
+                        setChunk.set({x, y, z}, voxelsHere[world::toLinearIndex({x, y, z})]);
+                    }
+                }
+            }
+
+            if (unpackChunk(setChunk) != voxelsHere || setChunk.getPaletteSize() != reference[i].getPaletteSize())
+            {
+                ++packMismatched;
+            }
+        }
+
+        seb::assertFatal(mismatched == 0, "{} chunks differed between equally seeded generators", mismatched);
+        seb::assertFatal(packMismatched == 0, "{} packed chunks differed from set voxel by voxel", packMismatched);
+        seb::assertFatal(seedsDiffer, "Seeds {} and {} generated the same terrain", seed, seed + 1);
+
+        Report determinism {};
+        determinism.setInteger("chunks", coordinates.size());
+        determinism.setInteger("mismatched_between_threads", mismatched);
+        determinism.setInteger("pack_mismatched", packMismatched);
+        determinism.setBool("seeds_differ", seedsDiffer);
+
+        Report report {};
+        report.setInteger("seed", seed);
+        report.setObject("noise", noise);
+        report.setObject("generation", generation);
+        report.setObject("determinism", determinism);
+
+        return report;
+    }
+} // namespace benchmark
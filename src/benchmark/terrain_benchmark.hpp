@@ -0,0 +1,21 @@
+#ifndef SRC_BENCHMARK_TERRAIN__BENCHMARK_HPP
+#define SRC_BENCHMARK_TERRAIN__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Generation throughput of world::TerrainGenerator on one core,
+    /// which bounds how fast the camera can fly into new terrain, next to
+    /// the old hills. Also reports noise samples per second one at a time
+    /// against whole rows, and checks that equally seeded generators on
+    /// different threads produce identical chunks.
+    ///
+    /// --chunks  <n>   chunks per horizontal axis, 4 chunks high (8)
+    /// --seed    <n>   terrain seed (1337)
+    /// --samples <n>   noise samples per throughput measurement (4194304)
+    [[nodiscard]] Report runTerrainBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_TERRAIN__BENCHMARK_HPP
@@ -0,0 +1,24 @@
+#include "terrain_fixture.hpp"
+
+namespace benchmark
+{
+    std::vector<world::ChunkCoordinate> generateTerrainDisc(
+        world::VoxelStorage& storage, const world::TerrainGenerator& generator, std::int32_t radius)
+    {
+        std::vector<world::ChunkCoordinate> coordinates {};
+
+        for (std::int32_t z = -radius; z <= radius; ++z)
+        {
+            for (std::int32_t x = -radius; x <= radius; ++x)
+            {
+                for (std::int32_t y = 0; y < MaxTerrainChunkY && x * x + z * z <= radius * radius; ++y)
+                {
+                    storage.getOrCreateChunk({x, y, z}) = generator.generateChunk({x, y, z});
+                    coordinates.push_back({x, y, z});
+                }
+            }
+        }
+
+        return coordinates;
+    }
+} // namespace benchmark
@@ -0,0 +1,23 @@
+#ifndef SRC_BENCHMARK_TERRAIN__FIXTURE_HPP
+#define SRC_BENCHMARK_TERRAIN__FIXTURE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <world/terrain.hpp>
+#include <world/voxel_storage.hpp>
+
+namespace benchmark
+{
+    /// @brief Chunks from y 0 up to this one hold every terrain surface,
+    /// those above it are all air
+    constexpr std::int32_t MaxTerrainChunkY = world::TerrainGenerator::MaxSurfaceHeight / world::ChunkExtent + 1;
+
+    /// @brief Generates every chunk of the columns within @param radius
+    /// chunks of the origin, up to MaxTerrainChunkY, into @param storage.
+    /// Returns their coordinates column by column, bottom up
+    std::vector<world::ChunkCoordinate> generateTerrainDisc(
+        world::VoxelStorage& storage, const world::TerrainGenerator& generator, std::int32_t radius);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_TERRAIN__FIXTURE_HPP
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <sebib/seblog.hpp>
+
+#include <util/worker_pool.hpp>
+#include <world/meshing_pipeline.hpp>
+#include <world/transform_hierarchy.hpp>
+
+#include "transform_benchmark.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t NoParent    = std::numeric_limits<std::size_t>::max();
+    // uploaded per changed node
+    constexpr std::size_t MatrixBytes = sizeof(glm::mat4) + sizeof(render::NormalMatrix);
+    // a few levels of scales up to 2 and translations of a few dozen voxels
+    // stay well within this relative to the matrices' magnitude
+    constexpr float MaxMatrixError = 1e-4f;
+    // normal times world matrix is the identity, as far as four levels of
+    // float products keep it
+    constexpr float MaxNormalError = 1e-4f;
+
+    /// @brief Nodes by index, parents before their children
+    struct Forest
+    {
+        std::vector<render::Transform> transforms;
+        std::vector<std::size_t>       parents;
+        std::size_t                    roots;
+    };
+
+    render::Transform makeTransform(std::mt19937& generator)
+    {
+        std::uniform_real_distribution<float> coordinate {-64.0f, 64.0f};
+        std::uniform_real_distribution<float> axis {-1.0f, 1.0f};
+        std::uniform_real_distribution<float> angle {0.0f, 6.2831853f};
+        std::uniform_real_distribution<float> scale {0.5f, 2.0f};
+
+        glm::vec3 direction {axis(generator), axis(generator), axis(generator)};
+
+        if (glm::length(direction) < 1e-3f)
+        {
+            direction = {0.0f, 1.0f, 0.0f};
+        }
+
+        render::Transform transform {};
+        transform.translation = {coordinate(generator), coordinate(generator), coordinate(generator)};
+        transform.rotation    = glm::angleAxis(angle(generator), glm::normalize(direction));
+        transform.scale       = {scale(generator), scale(generator), scale(generator)};
+
+        return transform;
+    }
+
+    /// @brief @param nodes split evenly over @param depth levels
+    Forest makeForest(std::size_t nodes, std::size_t depth, std::mt19937& generator)
+    {
+        const std::size_t perLevel = std::max(nodes / depth, std::size_t {1});
+
+        Forest forest {};
+        forest.roots = std::min(perLevel, nodes);
+        forest.transforms.reserve(nodes);
+        forest.parents.reserve(nodes);
+
+        for (std::size_t i = 0; i < nodes; ++i)
+        {
+            const std::size_t level = std::min(i / perLevel, depth - 1);
+
+            std::size_t parent = NoParent;
+
+            if (level > 0)
+            {
+                std::uniform_int_distribution<std::size_t> above {(level - 1) * perLevel, level * perLevel - 1};
+                parent = above(generator);
+            }
+
+            forest.transforms.push_back(makeTransform(generator));
+            forest.parents.push_back(parent);
+        }
+
+        return forest;
+    }
+
+    /// @brief Every world matrix from scratch, what a frame without the
+    /// hierarchy's cache does
+    void recompute(const Forest& forest, std::vector<glm::mat4>& matrices)
+    {
+        for (std::size_t i = 0; i < forest.transforms.size(); ++i)
+        {
+            const render::Transform& transform = forest.transforms[i];
+            const glm::mat4 local = world::composeModelMatrix(
+                transform.translation, transform.rotation, transform.scale);
+
+            matrices[i] = forest.parents[i] == NoParent ? local : matrices[forest.parents[i]] * local;
+        }
+    }
+
+    /// @brief Largest difference between @param actual and @param expected,
+    /// relative to the magnitude of the element
+    float getMaxError(std::span<const glm::mat4> actual, const std::vector<glm::mat4>& expected)
+    {
+        float error = 0.0f;
+
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                for (int row = 0; row < 4; ++row)
+                {
+                    const float e = expected[i][column][row];
+
+                    error = std::max(error, std::abs(actual[i][column][row] - e) / (1.0f + std::abs(e)));
+                }
+            }
+        }
+
+        return error;
+    }
+
+    /// @brief Largest difference between every one of @param normals times
+    /// the upper 3x3 of its transposed @param models and the identity
+    float getMaxNormalError(std::span<const render::NormalMatrix> normals, std::span<const glm::mat4> models)
+    {
+        float error = 0.0f;
+
+        for (std::size_t i = 0; i < normals.size(); ++i)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                for (int row = 0; row < 3; ++row)
+                {
+                    // (M^-T)^T * M = M^-1 * M
+                    float product = 0.0f;
+
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        product += normals[i][row][k] * models[i][column][k];
+                    }
+
+                    error = std::max(error, std::abs(product - (row == column ? 1.0f : 0.0f)));
+                }
+            }
+        }
+
+        return error;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runTransformBenchmark(const Arguments& arguments)
+    {
+        const auto nodes      = arguments.getSize("nodes", 100000);
+        const auto depth      = arguments.getSize("depth", 4);
+        const auto iterations = arguments.getSize("iterations", 100);
+        const auto dirty      = arguments.getSize("dirty", 10);
+        const auto seed       = static_cast<std::uint32_t>(arguments.getSize("seed", 1337));
+        const auto workers    = arguments.getSize("workers", world::MeshingPipeline::getDefaultWorkerCount());
+
+        seb::assertFatal(nodes > 0 && depth > 0, "Need at least one node and one level");
+        seb::assertFatal(dirty <= 1000, "--dirty is per mille, {} is more than every node", dirty);
+
+        std::mt19937 generator {seed};
+        Forest       forest = makeForest(nodes, depth, generator);
+
+        Report report {};
+        report.setInteger("nodes", nodes);
+        report.setInteger("depth", depth);
+        report.setInteger("roots", forest.roots);
+        report.setInteger("workers", workers);
+
+        std::vector<glm::mat4> expected (nodes);
+
+        // every matrix every frame, and all of them uploaded
+        std::vector<double> recomputeMs {};
+
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            const Clock::time_point start = Clock::now();
+            recompute(forest, expected);
+            recomputeMs.push_back(std::chrono::duration<double, std::milli> {Clock::now() - start}.count());
+        }
+
+        Report full {};
+        full.setStatistics("update_ms", Statistics::fromSamples(recomputeMs));
+        full.setInteger("upload_bytes", nodes * MatrixBytes);
+        report.setObject("full_recompute", full);
+
+        util::WorkerPool          pool {workers};
+        world::TransformHierarchy hierarchy {pool};
+
+        for (std::size_t i = 0; i < nodes; ++i)
+        {
+            const std::optional<world::TransformNode> parent =
+                forest.parents[i] == NoParent
+                ? std::nullopt
+                : std::optional {world::TransformNode {static_cast<std::uint32_t>(forest.parents[i])}};
+
+            seb::assertFatal(
+                hierarchy.create(forest.transforms[i], parent).index == i,
+                "Node {} got another index",
+                i);
+        }
+
+        const Clock::time_point buildStart = Clock::now();
+        (void)hierarchy.update();
+        report.setNumber(
+            "first_update_ms", std::chrono::duration<double, std::milli> {Clock::now() - buildStart}.count());
+
+        float maxError       = getMaxError(hierarchy.getWorldMatrices(), expected);
+        float maxNormalError = getMaxNormalError(hierarchy.getNormalMatrices(), hierarchy.getWorldMatrices());
+
+        std::uniform_int_distribution<std::size_t> anyNode {0, nodes - 1};
+        const std::size_t dirtyNodes = std::max(nodes * dirty / 1000, std::size_t {1});
+
+        /// @brief @param setNodes once per iteration, then an update
+        const auto runCase = [&](auto setNodes)
+        {
+            std::vector<double> updateMs {};
+            double updated  = 0.0;
+            double ranges   = 0.0;
+            double matrices = 0.0;
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                setNodes();
+
+                const Clock::time_point start = Clock::now();
+                const std::vector<world::TransformHierarchy::Range> changed = hierarchy.update();
+                updateMs.push_back(std::chrono::duration<double, std::milli> {Clock::now() - start}.count());
+
+                const world::TransformHierarchy::Statistics statistics = hierarchy.getStatistics();
+                updated  += static_cast<double>(statistics.updated_nodes);
+                ranges   += static_cast<double>(changed.size());
+                matrices += static_cast<double>(statistics.changed_matrices);
+
+                recompute(forest, expected);
+                maxError = std::max(maxError, getMaxError(hierarchy.getWorldMatrices(), expected));
+                maxNormalError = std::max(
+                    maxNormalError, getMaxNormalError(hierarchy.getNormalMatrices(), hierarchy.getWorldMatrices()));
+            }
+
+            const auto count = static_cast<double>(std::max(iterations, std::size_t {1}));
+
+            Report result {};
+            result.setStatistics("update_ms", Statistics::fromSamples(updateMs));
+            result.setNumber("updated_nodes", updated / count);
+            result.setNumber("ranges", ranges / count);
+            result.setNumber("upload_bytes", matrices / count * static_cast<double>(MatrixBytes));
+
+            return result;
+        };
+
+        report.setObject("clean", runCase([] {}));
+
+        report.setObject("sparse", runCase([&]
+        {
+            for (std::size_t i = 0; i < dirtyNodes; ++i)
+            {
+                const std::size_t node = anyNode(generator);
+
+                forest.transforms[node] = makeTransform(generator);
+                hierarchy.setTransform(world::TransformNode {static_cast<std::uint32_t>(node)}, forest.transforms[node]);
+            }
+        }));
+
+        // moves everything, the worst case for the cache
+        report.setObject("roots", runCase([&]
+        {
+            for (std::size_t node = 0; node < forest.roots; ++node)
+            {
+                forest.transforms[node].translation.y += 1.0f;
+                hierarchy.setTransform(world::TransformNode {static_cast<std::uint32_t>(node)}, forest.transforms[node]);
+            }
+        }));
+
+        report.setInteger("sparse_set_nodes", dirtyNodes);
+        report.setNumber("max_matrix_error", maxError);
+        report.setNumber("max_normal_error", maxNormalError);
+
+        seb::assertFatal(
+            maxError <= MaxMatrixError,
+            "Cached world matrices are up to {} off a full recompute",
+            maxError);
+        seb::assertFatal(
+            maxNormalError <= MaxNormalError,
+            "Cached normal matrices are up to {} off the world matrices' inverse transpose",
+            maxNormalError);
+
+        return report;
+    }
+} // namespace benchmark
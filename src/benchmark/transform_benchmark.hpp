@@ -0,0 +1,27 @@
+#ifndef SRC_BENCHMARK_TRANSFORM__BENCHMARK_HPP
+#define SRC_BENCHMARK_TRANSFORM__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Builds a forest of world::TransformHierarchy nodes, a level of
+    /// roots and every deeper level parented to random nodes of the one
+    /// above, then times update() with nothing changed, with a share of
+    /// random nodes set and with every root set, against recomputing every
+    /// world matrix each frame. Reports the ranges and bytes each would
+    /// upload. After every update the cached world matrices are checked
+    /// against the full recompute, and the normal matrices against the
+    /// inverse transpose of the world matrices.
+    ///
+    /// --nodes      <n>   nodes in total (100000)
+    /// --depth      <n>   levels of the forest (4)
+    /// --iterations <n>   updates per case (100)
+    /// --dirty      <n>   per mille of nodes set in the sparse case (10)
+    /// --seed       <n>   seed of the forest and its transforms (1337)
+    /// --workers    <n>   workers besides the updating thread (all but one hardware thread)
+    [[nodiscard]] Report runTransformBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_TRANSFORM__BENCHMARK_HPP
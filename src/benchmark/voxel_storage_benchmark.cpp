@@ -0,0 +1,196 @@
+#include <chrono>
+#include <functional>
+#include <random>
+
+#include <sebib/seblog.hpp>
+
+#include <world/terrain.hpp>
+#include <world/voxel_storage.hpp>
+
+#include "voxel_storage_benchmark.hpp"
+
+namespace
+{
+    constexpr std::int32_t WorldHeightChunks = 4;
+
+    world::Chunk makeChunk(const std::function<world::Voxel(world::LocalPosition)>& sample)
+    {
+        world::Chunk chunk {};
+
+        for (std::int32_t y = 0; y < world::ChunkExtent; ++y)
+        {
+            for (std::int32_t z = 0; z < world::ChunkExtent; ++z)
+            {
+                for (std::int32_t x = 0; x < world::ChunkExtent; ++x)
+                {
+                    chunk.set({x, y, z}, sample({x, y, z}));
+                }
+            }
+        }
+
+        return chunk;
+    }
+
+    benchmark::Report describeChunk(const world::Chunk& chunk)
+    {
+        constexpr double RawBytes = static_cast<double>(world::ChunkVolume * sizeof(world::Voxel));
+
+        benchmark::Report report {};
+        report.setInteger("palette_size", chunk.getPaletteSize());
+        report.setInteger("bits_per_index", chunk.getBitsPerIndex());
+        report.setInteger("bytes", chunk.getMemoryUsage());
+        report.setNumber("bytes_per_voxel",
+            static_cast<double>(chunk.getMemoryUsage()) / static_cast<double>(world::ChunkVolume));
+        report.setNumber("compression_ratio", RawBytes / static_cast<double>(chunk.getMemoryUsage()));
+
+        return report;
+    }
+
+    /// @brief Runs @param body @param repeats times, each performing
+    /// @param operations accesses, and reports nanoseconds per access
+    benchmark::Report timeAccesses(std::size_t repeats, std::size_t operations,
+        const std::function<void()>& body)
+    {
+        std::vector<double> nanosecondsPerAccess;
+
+        for (std::size_t r = 0; r < repeats; ++r)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+            nanosecondsPerAccess.push_back(elapsed.count() / static_cast<double>(operations));
+        }
+
+        const benchmark::Statistics statistics = benchmark::Statistics::fromSamples(nanosecondsPerAccess);
+
+        benchmark::Report report {};
+        report.setStatistics("ns_per_access", statistics);
+        report.setNumber("million_accesses_per_second", 1000.0 / statistics.p50);
+
+        return report;
+    }
+} // namespace
+
+namespace benchmark
+{
+    Report runVoxelStorageBenchmark(const Arguments& arguments)
+    {
+        const auto        chunksPerAxis = static_cast<std::int32_t>(arguments.getSize("chunks", 16));
+        const std::size_t operations    = arguments.getSize("operations", 10000000);
+        const std::size_t repeats       = arguments.getSize("repeats", 5);
+
+        // Memory per chunk, from best to worst case
+        std::mt19937 generator {0xD1A0};
+        const auto randomMaterial = [&](std::uint32_t materials)
+        {
+            return [&generator, materials](world::LocalPosition)
+            {
+                return static_cast<world::Voxel>(1 + generator() % materials);
+            };
+        };
+
+        Report memory {};
+        memory.setObject("uniform", describeChunk(world::Chunk {1}));
+        memory.setObject("terrain_surface", describeChunk(makeChunk(
+            [](world::LocalPosition p) { return world::sampleHills(p + world::WorldPosition {0, 48, 0}); }
+        )));
+        memory.setObject("random_2", describeChunk(makeChunk(randomMaterial(2))));
+        memory.setObject("random_16", describeChunk(makeChunk(randomMaterial(16))));
+        memory.setObject("random_256", describeChunk(makeChunk(randomMaterial(256))));
+        memory.setObject("random_4096", describeChunk(makeChunk(randomMaterial(4096))));
+
+        // Throughput through the chunk map of a terrain world
+        world::VoxelStorage storage {};
+
+        const auto buildStart = std::chrono::steady_clock::now();
+        for (std::int32_t cy = 0; cy < WorldHeightChunks; ++cy)
+        {
+            for (std::int32_t cz = 0; cz < chunksPerAxis; ++cz)
+            {
+                for (std::int32_t cx = 0; cx < chunksPerAxis; ++cx)
+                {
+                    const world::ChunkCoordinate coordinate {cx, cy, cz};
+
+                    storage.insertChunk(coordinate, world::generateHillsChunk(coordinate));
+                }
+            }
+        }
+        const std::chrono::duration<double, std::milli> buildTime = std::chrono::steady_clock::now() - buildStart;
+
+        Report terrainWorld {};
+        terrainWorld.setInteger("chunks", storage.getChunkCount());
+        terrainWorld.setInteger("voxels", storage.getChunkCount() * world::ChunkVolume);
+        terrainWorld.setInteger("bytes", storage.getMemoryUsage());
+        terrainWorld.setNumber("bytes_per_chunk",
+            static_cast<double>(storage.getMemoryUsage()) / static_cast<double>(storage.getChunkCount()));
+        terrainWorld.setNumber("build_ms", buildTime.count());
+
+        const world::WorldPosition worldExtent {
+            chunksPerAxis * world::ChunkExtent,
+            WorldHeightChunks * world::ChunkExtent,
+            chunksPerAxis * world::ChunkExtent
+        };
+
+        // positions are generated up front so the generator isn't timed
+        std::vector<world::WorldPosition> randomPositions (std::min(operations, std::size_t {1} << 20));
+        for (world::WorldPosition& p : randomPositions)
+        {
+            p = {
+                static_cast<std::int32_t>(generator() % static_cast<std::uint32_t>(worldExtent.x)),
+                static_cast<std::int32_t>(generator() % static_cast<std::uint32_t>(worldExtent.y)),
+                static_cast<std::int32_t>(generator() % static_cast<std::uint32_t>(worldExtent.z)),
+            };
+        }
+
+        std::uint64_t checksum = 0;
+
+        Report throughput {};
+        throughput.setObject("random_get", timeAccesses(repeats, operations, [&]
+        {
+            for (std::size_t i = 0; i < operations; ++i)
+            {
+                checksum += storage.getVoxel(randomPositions[i % randomPositions.size()]);
+            }
+        }));
+
+        throughput.setObject("sequential_get", timeAccesses(repeats, operations, [&]
+        {
+            std::size_t i = 0;
+
+            while (i < operations)
+            {
+                for (std::int32_t y = 0; y < worldExtent.y && i < operations; ++y)
+                {
+                    for (std::int32_t z = 0; z < worldExtent.z && i < operations; ++z)
+                    {
+                        for (std::int32_t x = 0; x < worldExtent.x && i < operations; ++x, ++i)
+                        {
+                            checksum += storage.getVoxel({x, y, z});
+                        }
+                    }
+                }
+            }
+        }));
+
+        // stays within the existing palettes, the common edit case
+        throughput.setObject("random_set", timeAccesses(repeats, operations, [&]
+        {
+            for (std::size_t i = 0; i < operations; ++i)
+            {
+                storage.setVoxel(randomPositions[i % randomPositions.size()], static_cast<world::Voxel>(i & 3));
+            }
+        }));
+
+        seb::logTrace("Voxel storage benchmark checksum {}", checksum);
+
+        Report report {};
+        report.setObject("chunk_memory", memory);
+        report.setObject("terrain_world", terrainWorld);
+        report.setInteger("operations", operations);
+        report.setInteger("repeats", repeats);
+        report.setObject("throughput", throughput);
+
+        return report;
+    }
+} // namespace benchmark
@@ -0,0 +1,18 @@
+#ifndef SRC_BENCHMARK_VOXEL__STORAGE__BENCHMARK_HPP
+#define SRC_BENCHMARK_VOXEL__STORAGE__BENCHMARK_HPP
+
+#include "arguments.hpp"
+#include "report.hpp"
+
+namespace benchmark
+{
+    /// @brief Reports chunk memory usage for typical and worst case contents
+    /// and get / set throughput through world::VoxelStorage.
+    ///
+    /// --chunks     <n>   chunks per horizontal axis of the test world (16)
+    /// --operations <n>   voxels read or written per repeat (10000000)
+    /// --repeats    <n>   timed repeats of every access pattern (5)
+    [[nodiscard]] Report runVoxelStorageBenchmark(const Arguments&);
+} // namespace benchmark
+
+#endif // SRC_BENCHMARK_VOXEL__STORAGE__BENCHMARK_HPP
@@ -1,8 +1,14 @@
+#include <filesystem>
+
 #include <sebib/seblog.hpp>
+#include <render/camera_path.hpp>
 #include <render/renderer.hpp>
+#include <util/profiler.hpp>
 #include <world/world.hpp>
 
-int main()
+/// Usage: Dynamo [scene] [save directory], see world::World::getSceneNames().
+/// Saves default to world::World::getDefaultSaveDirectory()
+int main(int argc, char** argv)
 {
     seb::logLog("Dynamo started | Version: {}.{}.{}.{}",
         VERSION_MAJOR,
@@ -11,21 +17,146 @@ int main()
         VERSION_TWEAK
     );
 
+    util::profiler::setThreadName("Main");
+
     try
     {
         render::Renderer renderer {{1200, 1200}, "Dynamo"};
-        world::World world {renderer};     
+        world::World world {
+            renderer,
+            argc > 1 ? argv[1] : "default",
+            argc > 2 ? std::filesystem::path {argv[2]} : world::World::getDefaultSaveDirectory()};
 
         render::Camera camera {{-35.0f, 35.0f, 35.0f}, -0.570792479f, 0.785398f};
 
+        // R toggles recording a camera path for DynamoBenchmark --path
+        std::optional<render::CameraPath> cameraRecording {std::nullopt};
+        bool wasRecordKeyPressed   = false;
+        bool wasTraceKeyPressed    = false;
+        bool wasEditKeyPressed     = false;
+        bool wasLampKeyPressed     = false;
+        bool wasFarFieldKeyPressed = false;
+
         while (!renderer.shouldClose())
         {
             if (renderer.getKeyCallback()(vkfw::Key::eJ))
             {
-                seb::logLog("FPS: {} | Camera: {}", 
+                const render::Renderer::PresentTimings presentTimings = renderer.getPresentTimings();
+                const auto meshing = world.getMeshingStatistics();
+
+                seb::logLog("FPS: {} | Present avg: {}ms worst: {}ms | Camera: {}", 
                     1.0f / renderer.getDeltaTimeSeconds(), 
+                    presentTimings.average.count() * 1000.0,
+                    presentTimings.worst.count() * 1000.0,
                     static_cast<std::string>(camera)
                 );
+                seb::logLog("Meshing queue: {} | Mesh avg: {}ms | Latency avg: {}ms worst: {}ms",
+                    meshing.getQueueDepth(),
+                    meshing.average_mesh_time.count() * 1000.0,
+                    meshing.average_latency.count() * 1000.0,
+                    meshing.worst_latency.count() * 1000.0
+                );
+
+                if (const auto streaming = world.getStreamingStatistics(); streaming.has_value())
+                {
+                    seb::logLog("Resident chunks: {} ({}MiB) | Cached: {} ({}MiB) | Generating: {} | From disk: {} | Saved: {}",
+                        streaming->resident_chunks,
+                        streaming->resident_bytes / (1024 * 1024),
+                        streaming->cached_chunks,
+                        streaming->cached_bytes / (1024 * 1024),
+                        streaming->generating,
+                        streaming->loaded_from_disk_total,
+                        streaming->saved_total
+                    );
+                }
+
+                const auto edits = world.getEditStatistics();
+
+                seb::logLog("Edits: {} ({} chunks) | Pending batches: {} | Edit to visible avg: {}ms worst: {}ms",
+                    edits.edits_total,
+                    edits.edited_chunks_total,
+                    edits.pending_batches,
+                    edits.average_latency.count() * 1000.0,
+                    edits.worst_latency.count() * 1000.0
+                );
+
+                const auto lighting = world.getLightingStatistics();
+
+                seb::logLog("Lit chunks: {} ({}KiB) | Pending light changes: {} | Last relight: {}ms ({} rounds, {} voxels)",
+                    lighting.lit_chunks,
+                    lighting.light_bytes / 1024,
+                    lighting.pending_changes,
+                    lighting.propagation_time.count() * 1000.0,
+                    lighting.rounds,
+                    lighting.visited_voxels
+                );
+
+                const auto bricks = world.getSimulationStatistics().brickmap;
+
+                seb::logLog("Brickmap: {} chunks | Bricks: {} | Solid slots: {} | Octree: {} nodes, depth {} | {}MiB",
+                    bricks.chunks,
+                    bricks.bricks,
+                    bricks.solid_slots,
+                    bricks.octree_nodes,
+                    bricks.octree_depth,
+                    bricks.bytes / (1024 * 1024)
+                );
+
+                const auto culling = world.getCullingStatistics();
+
+                seb::logLog("Chunk draws: {} of {} | In frustum: {} | Far field: {} | Cull: {}ms ({} steps)",
+                    culling.drawn,
+                    culling.chunk_objects,
+                    culling.in_frustum,
+                    culling.past_far_field,
+                    culling.cull_time.count() * 1000.0,
+                    culling.visited_steps
+                );
+
+                const auto entities = world.getEntities().getStatistics();
+                const auto systems  = world.getSystemStatistics();
+
+                seb::logLog("Entities: {} in {} archetypes | Systems: {} in {} stages, {} batches | Last run: {}ms",
+                    entities.entities,
+                    entities.archetypes,
+                    systems.systems,
+                    systems.stages,
+                    systems.batches,
+                    systems.run_time.count() * 1000.0
+                );
+
+                const auto simulation = world.getSimulationStatistics();
+
+                seb::logLog("Simulation: {} bodies | Ticks: {} | Dropped: {} | Last tick: {}ms",
+                    simulation.bodies,
+                    simulation.ticks,
+                    simulation.dropped_ticks,
+                    simulation.tick_time.count() * 1000.0
+                );
+
+                const auto transforms = world.getTransformStatistics();
+
+                seb::logLog("Transforms: {} nodes, depth {} | Last update: {} nodes, {} ranges ({} matrices) in {}ms",
+                    transforms.nodes,
+                    transforms.depth,
+                    transforms.updated_nodes,
+                    transforms.changed_ranges,
+                    transforms.changed_matrices,
+                    transforms.update_time.count() * 1000.0
+                );
+
+                for (const auto& ring : world.getLodStatistics())
+                {
+                    seb::logLog("LOD {} ({}x): resident {} ({}MiB) | Objects: {} | Triangles: {} | Mesh: {}MiB",
+                        ring.level,
+                        ring.scale,
+                        ring.resident,
+                        ring.voxel_bytes / (1024 * 1024),
+                        ring.objects,
+                        ring.triangles,
+                        ring.mesh_bytes / (1024 * 1024)
+                    );
+                }
             }
 
             if (renderer.getKeyCallback()(vkfw::Key::eT))
@@ -33,9 +164,84 @@ int main()
                 renderer.detachCursor();
             }
         
+            const bool isRecordKeyPressed = renderer.getKeyCallback()(vkfw::Key::eR);
+            if (isRecordKeyPressed && !wasRecordKeyPressed)
+            {
+                if (cameraRecording.has_value())
+                {
+                    cameraRecording->saveToFile("camera_path.txt");
+                    seb::logLog("Saved {} camera keyframes to camera_path.txt", cameraRecording->size());
+                    cameraRecording.reset();
+                }
+                else
+                {
+                    seb::logLog("Recording camera path");
+                    cameraRecording.emplace();
+                }
+            }
+            wasRecordKeyPressed = isRecordKeyPressed;
+
+            // P dumps every zone recorded so far, open with ui.perfetto.dev
+            const bool isTraceKeyPressed = renderer.getKeyCallback()(vkfw::Key::eP);
+            if (isTraceKeyPressed && !wasTraceKeyPressed)
+            {
+                util::profiler::dumpChromeTrace("trace.json");
+                util::profiler::clear();
+            }
+            wasTraceKeyPressed = isTraceKeyPressed;
+
+            // F digs a sphere out in front of the camera, G fills one with stone
+            const bool isDigKeyPressed  = renderer.getKeyCallback()(vkfw::Key::eF);
+            const bool isFillKeyPressed = renderer.getKeyCallback()(vkfw::Key::eG);
+            if ((isDigKeyPressed || isFillKeyPressed) && !wasEditKeyPressed)
+            {
+                world.fillSphere(
+                    camera.getPosition() + camera.getForwardVector() * 16.0f,
+                    6.0f,
+                    isDigKeyPressed ? world::AirVoxel : world::material::Stone
+                );
+            }
+            wasEditKeyPressed = isDigKeyPressed || isFillKeyPressed;
+
+            // L places a lamp on the voxel the camera looks at
+            const bool isLampKeyPressed = renderer.getKeyCallback()(vkfw::Key::eL);
+            if (isLampKeyPressed && !wasLampKeyPressed)
+            {
+                const std::optional<world::RaycastHit> hit = world.raycast(world::Ray {
+                    .origin       {camera.getPosition()},
+                    .direction    {camera.getForwardVector()},
+                    .max_distance {256.0f},
+                });
+
+                if (hit.has_value())
+                {
+                    world.setVoxel(hit->position + world::getFaceNormal(hit->face), world::material::Lamp);
+                }
+            }
+            wasLampKeyPressed = isLampKeyPressed;
+
+            // V ray marches chunks past four chunks away instead of drawing them
+            const bool isFarFieldKeyPressed = renderer.getKeyCallback()(vkfw::Key::eV);
+            if (isFarFieldKeyPressed && !wasFarFieldKeyPressed)
+            {
+                world.setFarFieldDistance(
+                    world.getFarFieldDistance().has_value()
+                    ? std::nullopt
+                    : std::make_optional(4.0f * static_cast<float>(world::ChunkExtent))
+                );
+                seb::logLog("Far field {}", world.getFarFieldDistance().has_value() ? "on" : "off");
+            }
+            wasFarFieldKeyPressed = isFarFieldKeyPressed;
+        
             camera.update(renderer.getKeyCallback(), renderer.getMouseDelta(), renderer.getDeltaTimeSeconds());
+
+            if (cameraRecording.has_value())
+            {
+                cameraRecording->record(camera);
+            }
             
-            renderer.drawFrame(camera, world.getObjects());
+            world.tick(renderer, camera);
+            renderer.drawFrame(camera, world.getVisibleObjects());
         }
     }
     catch (const std::exception& e)
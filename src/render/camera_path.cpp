@@ -0,0 +1,91 @@
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include <sebib/seblog.hpp>
+
+#include "camera_path.hpp"
+
+namespace render
+{
+    CameraPath CameraPath::loadFromFile(const std::string& filepath)
+    {
+        std::ifstream fileStream {filepath};
+        seb::assertFatal(fileStream.is_open(), "Failed to open camera path [{}]", filepath);
+
+        CameraPath path {};
+        Keyframe   keyframe {};
+
+        while (fileStream 
+            >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z
+            >> keyframe.pitch >> keyframe.yaw)
+        {
+            path.keyframes.push_back(keyframe);
+        }
+
+        seb::assertFatal(!path.empty(), "Camera path [{}] has no keyframes", filepath);
+
+        return path;
+    }
+
+    CameraPath CameraPath::orbit(std::size_t frames, float radius, float height)
+    {
+        CameraPath path {};
+        path.keyframes.reserve(frames);
+
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            const float angle = glm::two_pi<float>() *
+                static_cast<float>(i) / static_cast<float>(frames);
+
+            // yaw rotates around -y, so the camera looks back at the origin
+            path.keyframes.push_back(Keyframe {
+                .position {radius * std::sin(angle), height, radius * std::cos(angle)},
+                .pitch    {-std::atan2(height, radius)},
+                .yaw      {-angle},
+            });
+        }
+
+        return path;
+    }
+
+    void CameraPath::record(const Camera& camera)
+    {
+        this->keyframes.push_back(Keyframe {
+            .position {camera.getPosition()},
+            .pitch    {camera.getPitch()},
+            .yaw      {camera.getYaw()},
+        });
+    }
+
+    void CameraPath::saveToFile(const std::string& filepath) const
+    {
+        std::ofstream fileStream {filepath, std::ios::out | std::ios::trunc};
+        seb::assertFatal(fileStream.is_open(), "Failed to open camera path [{}]", filepath);
+
+        for (const Keyframe& k : this->keyframes)
+        {
+            fileStream << fmt::format("{} {} {} {} {}\n",
+                k.position.x, k.position.y, k.position.z, k.pitch, k.yaw);
+        }
+    }
+
+    std::size_t CameraPath::size() const
+    {
+        return this->keyframes.size();
+    }
+
+    bool CameraPath::empty() const
+    {
+        return this->keyframes.empty();
+    }
+
+    Camera CameraPath::getCamera(std::size_t frame) const
+    {
+        seb::assertFatal(!this->empty(), "Tried to replay an empty camera path");
+
+        const Keyframe& k = this->keyframes.at(frame % this->keyframes.size());
+
+        return Camera {k.position, k.pitch, k.yaw};
+    }
+} // namespace render
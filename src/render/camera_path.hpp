@@ -0,0 +1,56 @@
+#ifndef SRC_RENDER_CAMERA__PATH_HPP
+#define SRC_RENDER_CAMERA__PATH_HPP
+
+#include <string>
+#include <vector>
+
+#include "render_structs.hpp"
+
+namespace render
+{
+    /// @brief A per frame recording of a Camera's position and orientation.
+    /// Replaying one gives every run the exact same sequence of views, which
+    /// is what makes benchmark runs comparable between builds
+    class CameraPath
+    {
+    public:
+        struct Keyframe
+        {
+            glm::vec3 position;
+            float     pitch;
+            float     yaw;
+        };
+
+        /// @brief Reads a file written by saveToFile, one
+        /// `x y z pitch yaw` keyframe per line
+        [[nodiscard]] static CameraPath loadFromFile(const std::string& filepath);
+
+        /// @brief A built in path that circles the origin once over
+        /// @param frames frames, useful when no recording is at hand
+        [[nodiscard]] static CameraPath orbit(std::size_t frames, float radius, float height);
+
+        CameraPath()                             = default;
+        ~CameraPath()                            = default;
+
+        CameraPath(const CameraPath&)            = default;
+        CameraPath(CameraPath&&)                 = default;
+        CameraPath& operator=(const CameraPath&) = default;
+        CameraPath& operator=(CameraPath&&)      = default;
+
+        void record(const Camera&);
+        void saveToFile(const std::string& filepath) const;
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] bool empty() const;
+
+        /// @brief Camera for @param frame, wraps around when the path is
+        /// shorter than the number of frames being replayed
+        [[nodiscard]] Camera getCamera(std::size_t frame) const;
+
+    private:
+        std::vector<Keyframe> keyframes;
+    }; // class CameraPath
+
+} // namespace render
+
+#endif // SRC_RENDER_CAMERA__PATH_HPP
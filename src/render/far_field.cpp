@@ -0,0 +1,311 @@
+#include <cstring>
+
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "vulkan/pipeline.hpp"
+
+#include "far_field.hpp"
+
+namespace render
+{
+    FarField::FarField(vk::Device device_, const Allocator& allocator_, vk::Extent2D extent_)
+        : device          {device_}
+        , allocator       {&allocator_}
+        , extent          {extent_}
+        , march           {
+            device_,
+            Pipeline::createShaderFromFile(device_, "src/render/shaders/voxel_march.comp.bin"),
+            "VoxelMarch"
+        }
+        , descriptor_pool {
+            device_,
+            this->march.getDescriptorSetLayout(),
+            1,
+            std::vector {
+                vk::DescriptorPoolSize
+                {
+                    .type            {vk::DescriptorType::eStorageBuffer},
+                    .descriptorCount {1}
+                },
+                vk::DescriptorPoolSize
+                {
+                    .type            {vk::DescriptorType::eStorageImage},
+                    .descriptorCount {2}
+                }
+            }
+        }
+        , descriptor_set  {std::move(this->descriptor_pool.allocate().front())}
+        , brickmap        {nullptr}
+        , color           {nullptr}
+        , depth           {nullptr}
+        , start_distance  {std::nullopt}
+    {
+        this->resize(this->extent);
+    }
+
+    void FarField::setBrickmap(std::span<const std::uint32_t> words)
+    {
+        PROFILE_SCOPE("FarField::setBrickmap");
+
+        if (this->brickmap == nullptr || this->brickmap->sizeBytes() < words.size_bytes())
+        {
+            // streaming grows the brickmap a little at a time
+            this->brickmap = std::make_unique<Buffer>(
+                **this->allocator,
+                words.size_bytes() * 2,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                vk::MemoryPropertyFlagBits::eHostVisible |
+                vk::MemoryPropertyFlagBits::eHostCoherent
+            );
+
+            this->writeDescriptors();
+        }
+
+        std::memcpy(this->brickmap->getMappedPtr(), words.data(), words.size_bytes());
+    }
+
+    void FarField::setStartDistance(std::optional<float> distance)
+    {
+        this->start_distance = distance;
+    }
+
+    void FarField::resize(vk::Extent2D extent_)
+    {
+        this->extent = extent_;
+
+        this->color = std::make_unique<Image2D>(
+            *this->allocator,
+            this->device,
+            this->extent,
+            vk::Format::eR16G16B16A16Sfloat,
+            vk::ImageUsageFlagBits::eStorage,
+            vk::ImageAspectFlagBits::eColor,
+            vk::ImageTiling::eOptimal,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        );
+
+        this->depth = std::make_unique<Image2D>(
+            *this->allocator,
+            this->device,
+            this->extent,
+            vk::Format::eR32Sfloat,
+            vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eTransferSrc,
+            vk::ImageAspectFlagBits::eColor,
+            vk::ImageTiling::eOptimal,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        );
+
+        this->writeDescriptors();
+    }
+
+    bool FarField::isEnabled() const
+    {
+        return this->brickmap != nullptr && this->start_distance.has_value();
+    }
+
+    void FarField::dispatch(
+        vk::CommandBuffer commandBuffer,
+        const glm::mat4&  viewProjection,
+        glm::vec3         cameraPosition,
+        GpuProfiler&      profiler)
+    {
+        seb::assertFatal(this->isEnabled(), "Dispatched a far field without a brickmap or start distance");
+
+        const std::size_t zone = profiler.beginZone(commandBuffer, "far_field");
+
+        if (this->color->getLayout() == vk::ImageLayout::eUndefined)
+        {
+            // nothing to keep, every pixel is written
+            for (Image2D* image : {this->color.get(), this->depth.get()})
+            {
+                image->transitionLayout(
+                    commandBuffer,
+                    vk::ImageLayout::eUndefined,
+                    vk::ImageLayout::eGeneral,
+                    vk::PipelineStageFlagBits::eTopOfPipe,
+                    vk::PipelineStageFlagBits::eComputeShader,
+                    vk::AccessFlagBits::eNone,
+                    vk::AccessFlagBits::eShaderWrite
+                );
+            }
+        }
+        else
+        {
+            // the last frame's composite and copies have to be done reading
+            commandBuffer.pipelineBarrier(
+                vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eTransfer,
+                vk::PipelineStageFlagBits::eComputeShader,
+                {},
+                nullptr,
+                nullptr,
+                nullptr
+            );
+        }
+
+        // rows 2 and 3, glm matrices are column major
+        const std::array<FarFieldPushConstants, 1> pushConstants {
+            FarFieldPushConstants
+            {
+                .inverse_view_projection {glm::inverse(viewProjection)},
+                .depth_row {viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]},
+                .w_row     {viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]},
+                .camera_position {cameraPosition, *this->start_distance},
+            }
+        };
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *this->march);
+        commandBuffer.bindDescriptorSets(
+            vk::PipelineBindPoint::eCompute,
+            this->march.getLayout(),
+            0,
+            std::array<vk::DescriptorSet, 1> {*this->descriptor_set},
+            nullptr
+        );
+        commandBuffer.pushConstants<FarFieldPushConstants>(
+            this->march.getLayout(),
+            vk::ShaderStageFlagBits::eCompute,
+            0,
+            pushConstants
+        );
+
+        // voxel_march.comp's 8 x 8 workgroups
+        commandBuffer.dispatch((this->extent.width + 7) / 8, (this->extent.height + 7) / 8, 1);
+
+        const vk::MemoryBarrier marchedBarrier
+        {
+            .sType         {vk::StructureType::eMemoryBarrier},
+            .pNext         {nullptr},
+            .srcAccessMask {vk::AccessFlagBits::eShaderWrite},
+            .dstAccessMask {vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eTransferRead},
+        };
+
+        commandBuffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eTransfer,
+            {},
+            marchedBarrier,
+            nullptr,
+            nullptr
+        );
+
+        profiler.endZone(commandBuffer, zone);
+    }
+
+    void FarField::copyDepth(vk::CommandBuffer commandBuffer, const Buffer& buffer) const
+    {
+        seb::assertFatal(
+            this->depth->getLayout() == vk::ImageLayout::eGeneral,
+            "Copied the far field's depth before it was ever dispatched"
+        );
+
+        this->depth->copyToBuffer(commandBuffer, buffer);
+
+        const vk::MemoryBarrier copiedBarrier
+        {
+            .sType         {vk::StructureType::eMemoryBarrier},
+            .pNext         {nullptr},
+            .srcAccessMask {vk::AccessFlagBits::eTransferWrite},
+            .dstAccessMask {vk::AccessFlagBits::eHostRead},
+        };
+
+        commandBuffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eHost,
+            {},
+            copiedBarrier,
+            nullptr,
+            nullptr
+        );
+    }
+
+    const Image2D& FarField::getColor() const
+    {
+        return *this->color;
+    }
+
+    const Image2D& FarField::getDepth() const
+    {
+        return *this->depth;
+    }
+
+    vk::Extent2D FarField::getExtent() const
+    {
+        return this->extent;
+    }
+
+    void FarField::writeDescriptors()
+    {
+        const vk::DescriptorImageInfo colorBindingInfo
+        {
+            .sampler     {nullptr},
+            .imageView   {*this->color},
+            .imageLayout {vk::ImageLayout::eGeneral},
+        };
+
+        const vk::DescriptorImageInfo depthBindingInfo
+        {
+            .sampler     {nullptr},
+            .imageView   {*this->depth},
+            .imageLayout {vk::ImageLayout::eGeneral},
+        };
+
+        std::vector<vk::WriteDescriptorSet> writeInfo
+        {
+            vk::WriteDescriptorSet
+            {
+                .sType            {vk::StructureType::eWriteDescriptorSet},
+                .pNext            {nullptr},
+                .dstSet           {*this->descriptor_set},
+                .dstBinding       {1},
+                .dstArrayElement  {0},
+                .descriptorCount  {1},
+                .descriptorType   {vk::DescriptorType::eStorageImage},
+                .pImageInfo       {&colorBindingInfo},
+                .pBufferInfo      {nullptr},
+                .pTexelBufferView {nullptr},
+            },
+            vk::WriteDescriptorSet
+            {
+                .sType            {vk::StructureType::eWriteDescriptorSet},
+                .pNext            {nullptr},
+                .dstSet           {*this->descriptor_set},
+                .dstBinding       {2},
+                .dstArrayElement  {0},
+                .descriptorCount  {1},
+                .descriptorType   {vk::DescriptorType::eStorageImage},
+                .pImageInfo       {&depthBindingInfo},
+                .pBufferInfo      {nullptr},
+                .pTexelBufferView {nullptr},
+            },
+        };
+
+        // written once there is one
+        const vk::DescriptorBufferInfo brickmapBindingInfo
+        {
+            .buffer {this->brickmap != nullptr ? **this->brickmap : vk::Buffer {nullptr}},
+            .offset {0},
+            .range  {VK_WHOLE_SIZE},
+        };
+
+        if (this->brickmap != nullptr)
+        {
+            writeInfo.push_back(vk::WriteDescriptorSet
+            {
+                .sType            {vk::StructureType::eWriteDescriptorSet},
+                .pNext            {nullptr},
+                .dstSet           {*this->descriptor_set},
+                .dstBinding       {0},
+                .dstArrayElement  {0},
+                .descriptorCount  {1},
+                .descriptorType   {vk::DescriptorType::eStorageBuffer},
+                .pImageInfo       {nullptr},
+                .pBufferInfo      {&brickmapBindingInfo},
+                .pTexelBufferView {nullptr},
+            });
+        }
+
+        this->device.updateDescriptorSets(writeInfo, nullptr);
+    }
+} // namespace render
@@ -0,0 +1,90 @@
+#ifndef SRC_RENDER_FAR__FIELD_HPP
+#define SRC_RENDER_FAR__FIELD_HPP
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "vulkan/allocator.hpp"
+#include "vulkan/buffer.hpp"
+#include "vulkan/compute_pipeline.hpp"
+#include "vulkan/descriptor_pool.hpp"
+#include "vulkan/gpu_structs.hpp"
+#include "vulkan/image.hpp"
+#include "vulkan/includes.hpp"
+
+#include "gpu_profiler.hpp"
+
+namespace render
+{
+    /// @brief Voxels past the meshes, ray marched through a world::Brickmap
+    /// by voxel_march.comp rather than rasterized, so they cost per pixel
+    /// instead of per triangle.
+    ///
+    /// The march writes the color and depth of every pixel into two storage
+    /// images before the render pass, far_field.frag then copies them into
+    /// the color and depth attachments before any object is drawn. Objects
+    /// depth test against the far field like against each other.
+    ///
+    /// The Recorder waits for every frame it submits, so nothing here is in
+    /// use between two frames and the brickmap is written straight into a
+    /// host visible buffer.
+    class FarField
+    {
+    public:
+        FarField(vk::Device, const Allocator&, vk::Extent2D);
+        ~FarField() = default;
+
+        FarField()                           = delete;
+        FarField(const FarField&)            = delete;
+        FarField(FarField&&)                 = delete;
+        FarField& operator=(const FarField&) = delete;
+        FarField& operator=(FarField&&)      = delete;
+
+        /// @brief Replaces the brickmap with @param words, laid out like
+        /// world::Brickmap::writeGpuWords()
+        void setBrickmap(std::span<const std::uint32_t> words);
+        /// @brief Rays start @param distance away from the camera, nullopt
+        /// draws nothing
+        void setStartDistance(std::optional<float> distance);
+        /// @brief Recreates the images at @param extent
+        void resize(vk::Extent2D extent);
+
+        /// @brief A brickmap and a start distance were set
+        [[nodiscard]] bool isEnabled() const;
+
+        /// @brief Marches a ray through every pixel, recorded outside of a
+        /// render pass. GPU time goes into @param profiler under "far_field"
+        void dispatch(
+            vk::CommandBuffer,
+            const glm::mat4& viewProjection,
+            glm::vec3 cameraPosition,
+            GpuProfiler& profiler);
+        /// @brief The depth of every pixel of the last dispatch, 1 where
+        /// nothing was hit. @param buffer is host visible and read once the
+        /// command buffer has completed
+        void copyDepth(vk::CommandBuffer, const Buffer& buffer) const;
+
+        [[nodiscard]] const Image2D& getColor() const;
+        [[nodiscard]] const Image2D& getDepth() const;
+        [[nodiscard]] vk::Extent2D getExtent() const;
+
+    private:
+        void writeDescriptors();
+
+        vk::Device               device;
+        const Allocator*         allocator;
+        vk::Extent2D             extent;
+        ComputePipeline          march;
+        DescriptorPool           descriptor_pool;
+        vk::UniqueDescriptorSet  descriptor_set;
+        // null until the first setBrickmap(), grows to twice what it needs
+        std::unique_ptr<Buffer>  brickmap;
+        std::unique_ptr<Image2D> color;
+        std::unique_ptr<Image2D> depth;
+        std::optional<float>     start_distance;
+    }; // class FarField
+} // namespace render
+
+#endif // SRC_RENDER_FAR__FIELD_HPP
@@ -0,0 +1,194 @@
+#include <numeric>
+
+#include <sebib/seblog.hpp>
+
+#include "gpu_profiler.hpp"
+
+static render::GpuProfiler::ZoneTiming makeZoneTiming(
+    const std::string& name, const std::deque<double>& history)
+{
+    return render::GpuProfiler::ZoneTiming {
+        .name       {name},
+        .last_ms    {history.back()},
+        .average_ms {
+            std::accumulate(history.cbegin(), history.cend(), 0.0) /
+            static_cast<double>(history.size())
+        },
+    };
+}
+
+namespace render
+{
+    GpuProfiler::GpuProfiler(const Device& device_, std::size_t framesInFlight)
+        : device           {device_.asLogicalDevice()}
+        , timestamp_period {std::nullopt}
+        , timestamp_mask   {0}
+        , frames           {}
+        , current_frame    {0}
+    {
+        const vk::PhysicalDeviceLimits limits = device_.asPhysicalDevice().getProperties().limits;
+        const std::uint32_t validBits = device_.asPhysicalDevice()
+            .getQueueFamilyProperties().at(device_.getRenderComputeTransferIndex())
+            .timestampValidBits;
+
+        if (!limits.timestampComputeAndGraphics || validBits == 0)
+        {
+            seb::logWarn("Timestamp queries unsupported, GPU profiling disabled");
+            return;
+        }
+
+        this->timestamp_period = limits.timestampPeriod;
+        this->timestamp_mask = validBits >= 64
+            ? std::numeric_limits<std::uint64_t>::max()
+            : (std::uint64_t {1} << validBits) - 1;
+
+        const vk::QueryPoolCreateInfo queryPoolCreateInfo
+        {
+            .sType              {vk::StructureType::eQueryPoolCreateInfo},
+            .pNext              {nullptr},
+            .flags              {},
+            .queryType          {vk::QueryType::eTimestamp},
+            .queryCount         {static_cast<std::uint32_t>(MaxZonesPerFrame * 2)},
+            .pipelineStatistics {},
+        };
+
+        for (std::size_t i = 0; i < framesInFlight; ++i)
+        {
+            this->frames.push_back(Frame {
+                .query_pool {this->device.createQueryPoolUnique(queryPoolCreateInfo)},
+                .zone_names {},
+            });
+        }
+    }
+
+    void GpuProfiler::beginFrame(vk::CommandBuffer commandBuffer, std::size_t frameIndex)
+    {
+        if (!this->isEnabled())
+        {
+            return;
+        }
+
+        this->current_frame = frameIndex;
+        Frame& frame = this->frames.at(frameIndex);
+
+        this->collect(frame);
+
+        commandBuffer.resetQueryPool(
+            *frame.query_pool, 0, static_cast<std::uint32_t>(MaxZonesPerFrame * 2));
+    }
+
+    std::size_t GpuProfiler::beginZone(vk::CommandBuffer commandBuffer, std::string name)
+    {
+        if (!this->isEnabled())
+        {
+            return 0;
+        }
+
+        Frame& frame = this->frames.at(this->current_frame);
+
+        if (frame.zone_names.size() >= MaxZonesPerFrame)
+        {
+            seb::logWarn("Too many GPU profiler zones, dropping {}", name);
+            return MaxZonesPerFrame;
+        }
+
+        const std::size_t zone = frame.zone_names.size();
+        frame.zone_names.push_back(std::move(name));
+
+        commandBuffer.writeTimestamp(
+            vk::PipelineStageFlagBits::eTopOfPipe,
+            *frame.query_pool,
+            static_cast<std::uint32_t>(zone * 2)
+        );
+
+        return zone;
+    }
+
+    void GpuProfiler::endZone(vk::CommandBuffer commandBuffer, std::size_t zone)
+    {
+        if (!this->isEnabled() || zone >= MaxZonesPerFrame)
+        {
+            return;
+        }
+
+        commandBuffer.writeTimestamp(
+            vk::PipelineStageFlagBits::eBottomOfPipe,
+            *this->frames.at(this->current_frame).query_pool,
+            static_cast<std::uint32_t>(zone * 2 + 1)
+        );
+    }
+
+    bool GpuProfiler::isEnabled() const
+    {
+        return this->timestamp_period.has_value();
+    }
+
+    auto GpuProfiler::getTimings() const
+        -> std::vector<ZoneTiming>
+    {
+        std::vector<ZoneTiming> timings;
+        timings.reserve(this->history_ms.size());
+
+        for (const auto& [name, history] : this->history_ms)
+        {
+            timings.push_back(makeZoneTiming(name, history));
+        }
+
+        return timings;
+    }
+
+    auto GpuProfiler::getTiming(const std::string& name) const
+        -> std::optional<ZoneTiming>
+    {
+        const auto it = this->history_ms.find(name);
+
+        if (it == this->history_ms.cend())
+        {
+            return std::nullopt;
+        }
+
+        return makeZoneTiming(it->first, it->second);
+    }
+
+    void GpuProfiler::collect(Frame& frame)
+    {
+        if (frame.zone_names.empty())
+        {
+            return;
+        }
+
+        const std::size_t queryCount = frame.zone_names.size() * 2;
+
+        // no eWait, if a result somehow isn't available it's dropped rather
+        // than stalling the frame
+        const auto [result, timestamps] = this->device.getQueryPoolResults<std::uint64_t>(
+            *frame.query_pool,
+            0,
+            static_cast<std::uint32_t>(queryCount),
+            queryCount * sizeof(std::uint64_t),
+            sizeof(std::uint64_t),
+            vk::QueryResultFlagBits::e64
+        );
+
+        if (result == vk::Result::eSuccess)
+        {
+            for (std::size_t zone = 0; zone < frame.zone_names.size(); ++zone)
+            {
+                const std::uint64_t ticks = 
+                    (timestamps.at(zone * 2 + 1) - timestamps.at(zone * 2)) & this->timestamp_mask;
+
+                std::deque<double>& history = this->history_ms[frame.zone_names.at(zone)];
+                history.push_back(
+                    static_cast<double>(ticks) * static_cast<double>(*this->timestamp_period) / 1'000'000.0
+                );
+
+                if (history.size() > HistoryLength)
+                {
+                    history.pop_front();
+                }
+            }
+        }
+
+        frame.zone_names.clear();
+    }
+} // namespace render
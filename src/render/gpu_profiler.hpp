@@ -0,0 +1,75 @@
+#ifndef SRC_RENDER_GPU__PROFILER_HPP
+#define SRC_RENDER_GPU__PROFILER_HPP
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "vulkan/device.hpp"
+#include "vulkan/includes.hpp"
+
+namespace render
+{
+    /// @brief Measures GPU time of named zones with vkCmdWriteTimestamp pairs.
+    /// Every frame in flight has its own query pool, which is only read back
+    /// once that frame slot comes around again. By then the Recorder has
+    /// waited on the slot's fence so reading never stalls the GPU.
+    /// Is a no-op on queues without timestamp support.
+    class GpuProfiler
+    {
+    public:
+        struct ZoneTiming
+        {
+            std::string name;
+            double      last_ms;
+            double      average_ms; // over the last HistoryLength frames
+        };
+
+        constexpr static std::size_t MaxZonesPerFrame = 64;
+        constexpr static std::size_t HistoryLength    = 128;
+
+    public:
+
+        GpuProfiler(const Device&, std::size_t framesInFlight);
+        ~GpuProfiler()                             = default;
+
+        GpuProfiler()                              = delete;
+        GpuProfiler(const GpuProfiler&)            = delete;
+        GpuProfiler(GpuProfiler&&)                 = delete;
+        GpuProfiler& operator=(const GpuProfiler&) = delete;
+        GpuProfiler& operator=(GpuProfiler&&)      = delete;
+
+        /// @brief Collects @param frameIndex's previous results and resets its
+        /// queries, must be recorded outside of a render pass
+        void beginFrame(vk::CommandBuffer, std::size_t frameIndex);
+
+        /// @return a handle to pass to endZone
+        [[nodiscard]] std::size_t beginZone(vk::CommandBuffer, std::string name);
+        void endZone(vk::CommandBuffer, std::size_t zone);
+
+        [[nodiscard]] bool isEnabled() const;
+        [[nodiscard]] std::vector<ZoneTiming> getTimings() const;
+        [[nodiscard]] std::optional<ZoneTiming> getTiming(const std::string& name) const;
+
+    private:
+        struct Frame
+        {
+            vk::UniqueQueryPool      query_pool;
+            std::vector<std::string> zone_names;
+        };
+
+        void collect(Frame&);
+
+        vk::Device           device;
+        std::optional<float> timestamp_period; // nanoseconds per tick
+        std::uint64_t        timestamp_mask;
+        std::vector<Frame>   frames;
+        std::size_t          current_frame;
+
+        std::map<std::string, std::deque<double>> history_ms;
+    }; // class GpuProfiler
+} // namespace render
+
+#endif // SRC_RENDER_GPU__PROFILER_HPP
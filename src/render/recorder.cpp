@@ -1,5 +1,7 @@
 #include <sebib/seblog.hpp>
 
+#include <util/profiler.hpp>
+
 #include "vulkan/gpu_structs.hpp"
 #include "recorder.hpp"
 
@@ -28,31 +30,45 @@ namespace render
     }
 
     vk::Result Recorder::render(
-        const Device& device, const Swapchain& swapchain,
-        const RenderPass& renderPass,
+        const Device& device, const Swapchain* swapchain,
+        vk::Extent2D renderExtent, const RenderPass& renderPass,
         const std::vector<vk::UniqueFramebuffer>& framebuffers,
         vk::DescriptorSet descriptorSet,
         const std::vector<std::pair<const Pipeline*, std::vector<const Object*>>>& pipelinedObjects, 
         const Camera& camera, 
-        std::queue<std::function<void(vk::CommandBuffer)>>& extraCommandsQueue)
+        std::queue<std::function<void(vk::CommandBuffer)>>& extraCommandsQueue,
+        GpuProfiler& profiler, std::size_t frameIndex,
+        FarField* farField, const Pipeline& farFieldComposite)
     {
+        PROFILE_SCOPE("Recorder::render");
 
         const auto timeout = std::numeric_limits<std::uint64_t>::max();
 
-        auto result = device.asLogicalDevice().waitForFences(*this->frame_in_flight, true, timeout);
-        seb::assertFatal(
-            result == vk::Result::eSuccess || result == vk::Result::eTimeout,
-            "Failed to wait for render fence {}", vk::to_string(result)
-        );
+        {
+            PROFILE_SCOPE("Recorder::waitForPreviousFrame");
+
+            auto result = device.asLogicalDevice().waitForFences(*this->frame_in_flight, true, timeout);
+            seb::assertFatal(
+                result == vk::Result::eSuccess || result == vk::Result::eTimeout,
+                "Failed to wait for render fence {}", vk::to_string(result)
+            );
+        }
 
-        const auto [result1, maybeNextIdx] = device.asLogicalDevice()
-            .acquireNextImageKHR(*swapchain, timeout, *this->image_available);
+        std::uint32_t maybeNextIdx = 0;
 
-        if (result1 == vk::Result::eErrorOutOfDateKHR || result1 == vk::Result::eSuboptimalKHR)
+        if (swapchain != nullptr)
         {
-            return vk::Result::eErrorOutOfDateKHR;
+            const auto [result1, acquiredIdx] = device.asLogicalDevice()
+                .acquireNextImageKHR(**swapchain, timeout, *this->image_available);
+
+            if (result1 == vk::Result::eErrorOutOfDateKHR || result1 == vk::Result::eSuboptimalKHR)
+            {
+                return vk::Result::eErrorOutOfDateKHR;
+            }
+            seb::assertFatal(result1 == vk::Result::eSuccess, "Failed to acquire next Image {}", vk::to_string(result));
+
+            maybeNextIdx = acquiredIdx;
         }
-        seb::assertFatal(result1 == vk::Result::eSuccess, "Failed to acquire next Image {}", vk::to_string(result));
 
         device.asLogicalDevice().resetFences(*this->frame_in_flight);
 
@@ -68,6 +84,9 @@ namespace render
 
         this->command_buffer->begin(commandBufferBeginInfo);
 
+        profiler.beginFrame(*this->command_buffer, frameIndex);
+        const std::size_t frameZone = profiler.beginZone(*this->command_buffer, "frame");
+
         while (!extraCommandsQueue.empty())
         {
             extraCommandsQueue.front()(*this->command_buffer);
@@ -75,6 +94,21 @@ namespace render
             extraCommandsQueue.pop();
         }
 
+        const glm::mat4 viewProjection =
+            Camera::getPerspectiveMatrix(
+                glm::radians(70.f),
+                static_cast<float>(renderExtent.width) / 
+                static_cast<float>(renderExtent.height),
+                0.1f,
+                200000.0f
+            ) * 
+            camera.asViewMatrix();
+
+        if (farField != nullptr)
+        {
+            farField->dispatch(*this->command_buffer, viewProjection, camera.getPosition(), profiler);
+        }
+
         std::array<vk::ClearValue, 2> clearValues
         {
             vk::ClearValue
@@ -103,17 +137,40 @@ namespace render
                 vk::Rect2D 
                 {
                     .offset {0, 0},
-                    .extent {swapchain.getExtent()},
+                    .extent {renderExtent},
                 }
             },
             .clearValueCount {clearValues.size()},
             .pClearValues    {clearValues.data()},
         };
 
+        const std::size_t renderPassZone = profiler.beginZone(*this->command_buffer, "render_pass");
         this->command_buffer->beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
 
+        // first, so every object is depth tested against it
+        if (farField != nullptr)
+        {
+            const std::size_t compositeZone = profiler.beginZone(
+                *this->command_buffer, "pipeline/" + farFieldComposite.getName());
+
+            this->command_buffer->bindPipeline(vk::PipelineBindPoint::eGraphics, *farFieldComposite);
+            this->command_buffer->bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics,
+                farFieldComposite.getLayout(), 
+                0,
+                std::array<vk::DescriptorSet, 1> {descriptorSet},
+                nullptr
+            );
+            this->command_buffer->draw(3, 1, 0, 0);
+
+            profiler.endZone(*this->command_buffer, compositeZone);
+        }
+
         for (const auto& [pipeline, objectVector] : pipelinedObjects)
         {
+            const std::size_t pipelineZone = profiler.beginZone(
+                *this->command_buffer, "pipeline/" + pipeline->getName());
+
             this->command_buffer->bindPipeline(vk::PipelineBindPoint::eGraphics, **pipeline);
 
             for (const Object* o : objectVector)
@@ -123,19 +180,8 @@ namespace render
                 std::array<PushConstants, 1> pushConstants {
                     PushConstants
                     {
-                        .view_projection {
-                            Camera::getPerspectiveMatrix(
-                                glm::radians(70.f),
-                                static_cast<float>(swapchain.getExtent().width) / 
-                                static_cast<float>(swapchain.getExtent().height),
-                                0.1f,
-                                200000.0f
-                            ) * 
-                            camera.asViewMatrix()
-                        },
-                        .model {
-                            o->transform.asModelMatrix()
-                        }
+                        .view_projection {viewProjection},
+                        .model_index     {o->model_index},
                     },
                 };
                 
@@ -157,9 +203,14 @@ namespace render
 
                 o->draw(this->command_buffer.get());
             }
+
+            profiler.endZone(*this->command_buffer, pipelineZone);
         }
 
         this->command_buffer->endRenderPass();
+        profiler.endZone(*this->command_buffer, renderPassZone);
+        profiler.endZone(*this->command_buffer, frameZone);
+
         this->command_buffer->end();
 
 
@@ -167,56 +218,66 @@ namespace render
         // Submission to graphics card
         const vk::PipelineStageFlags waitStages = vk::PipelineStageFlagBits::eColorAttachmentOutput;
     
+        // Headless frames have nothing to wait on or signal
+        const bool isPresenting = swapchain != nullptr;
+
         std::array<vk::SubmitInfo, 1> submitInfos
         {
             vk::SubmitInfo
             {
                 .sType                {vk::StructureType::eSubmitInfo},
                 .pNext                {nullptr},
-                .waitSemaphoreCount   {1},
-                .pWaitSemaphores      {&*this->image_available},
-                .pWaitDstStageMask    {&waitStages},
+                .waitSemaphoreCount   {isPresenting ? 1U : 0U},
+                .pWaitSemaphores      {isPresenting ? &*this->image_available : nullptr},
+                .pWaitDstStageMask    {isPresenting ? &waitStages : nullptr},
                 .commandBufferCount   {1},
                 .pCommandBuffers      {&*this->command_buffer}, 
-                .signalSemaphoreCount {1},
-                .pSignalSemaphores    {&*this->render_finished},
+                .signalSemaphoreCount {isPresenting ? 1U : 0U},
+                .pSignalSemaphores    {isPresenting ? &*this->render_finished : nullptr},
             }
         };
 
         device.getRenderComputeTransferQueue().submit(submitInfos, *this->frame_in_flight);
 
-        vk::SwapchainKHR swapchainPtr = *swapchain;
-
-        vk::PresentInfoKHR presentInfo
-        {
-            .sType              {vk::StructureType::ePresentInfoKHR},
-            .pNext              {nullptr},
-            .waitSemaphoreCount {1},
-            .pWaitSemaphores    {&*this->render_finished},
-            .swapchainCount     {1},
-            .pSwapchains        {&swapchainPtr},
-            .pImageIndices      {&maybeNextIdx},
-            .pResults           {nullptr},
-        };
-        
-        try
+        if (isPresenting)
         {
-            (void)device.getRenderComputeTransferQueue().presentKHR(presentInfo);
+            vk::SwapchainKHR swapchainPtr = **swapchain;
+
+            vk::PresentInfoKHR presentInfo
+            {
+                .sType              {vk::StructureType::ePresentInfoKHR},
+                .pNext              {nullptr},
+                .waitSemaphoreCount {1},
+                .pWaitSemaphores    {&*this->render_finished},
+                .swapchainCount     {1},
+                .pSwapchains        {&swapchainPtr},
+                .pImageIndices      {&maybeNextIdx},
+                .pResults           {nullptr},
+            };
+            
+            try
+            {
+                (void)device.getRenderComputeTransferQueue().presentKHR(presentInfo);
+            }
+            catch (vk::OutOfDateKHRError& e)
+            {
+                return vk::Result::eErrorOutOfDateKHR;
+            }
         }
-        catch (vk::OutOfDateKHRError& e)
+
         {
-            return vk::Result::eErrorOutOfDateKHR;
+            PROFILE_SCOPE("Recorder::waitForFrame");
+
+            seb::assertFatal(
+                device.asLogicalDevice().waitForFences(
+                    *this->frame_in_flight,
+                    true,
+                    std::numeric_limits<std::uint64_t>::max()
+                ) == vk::Result::eSuccess,
+                "Failed to wait for frame to complete drawing"
+            );
         }
 
-        seb::assertFatal(
-            device.asLogicalDevice().waitForFences(
-                *this->frame_in_flight,
-                true,
-                std::numeric_limits<std::uint64_t>::max()
-            ) == vk::Result::eSuccess,
-            "Failed to wait for frame to complete drawing"
-        );
-
         return vk::Result::eSuccess;
     }
 
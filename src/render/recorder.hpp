@@ -11,6 +11,8 @@
 #include "vulkan/includes.hpp"
 #include "vulkan/render_pass.hpp"
 
+#include "far_field.hpp"
+#include "gpu_profiler.hpp"
 #include "render_structs.hpp"
 
 namespace render
@@ -27,12 +29,22 @@ namespace render
         Recorder& operator=(const Recorder&) = delete;
         Recorder& operator=(Recorder&&)      = delete;
 
+        /// @brief Records, submits and presents one frame. When @param swapchain
+        /// is nullptr the frame is rendered into framebuffers[0] and nothing
+        /// is acquired or presented (headless rendering).
+        /// GPU time is recorded into @param profiler under "frame",
+        /// "render_pass" and each pipeline's name.
+        /// Unless @param farField is nullptr it's dispatched before the
+        /// render pass and drawn with @param farFieldComposite before any
+        /// object
         vk::Result render(
-            const Device&, const Swapchain&, const RenderPass&,
+            const Device&, const Swapchain* swapchain, vk::Extent2D, const RenderPass&,
             const std::vector<vk::UniqueFramebuffer>&, vk::DescriptorSet,
             const std::vector<std::pair<const Pipeline*, std::vector<const Object*>>>&,
             const Camera&, 
-            std::queue<std::function<void(vk::CommandBuffer)>>&
+            std::queue<std::function<void(vk::CommandBuffer)>>&,
+            GpuProfiler& profiler, std::size_t frameIndex,
+            FarField* farField, const Pipeline& farFieldComposite
         );
 
     private:
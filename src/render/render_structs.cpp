@@ -8,6 +8,8 @@
 
 #include <sebib/seblog.hpp>
 
+#include <util/profiler.hpp>
+
 #include "render_structs.hpp"
 
 
@@ -67,6 +69,8 @@ namespace render
     auto Object::readVerticesFromFile(const std::string& filepath)
         -> std::pair<std::vector<render::Vertex>, std::vector<uint32_t>>
     {
+        PROFILE_SCOPE("Object::readVerticesFromFile");
+
         tinyobj::attrib_t attribute {}; 
         std::vector<tinyobj::shape_t> shapes; 
         std::vector<tinyobj::material_t> materials;
@@ -150,9 +154,11 @@ namespace render
 
     Object::Object(VmaAllocator allocator, std::vector<Vertex> vertices_,
         std::optional<std::vector<Index>> maybeIndicies)
-        : vertices {std::move(vertices_)}
+        : model_index {0}
+        , vertices {std::move(vertices_)}
         , indicies {std::move(maybeIndicies)}
         , vertex_buffer {
+            std::in_place,
             allocator,
             this->vertices.size() * sizeof(Vertex),
             vk::BufferUsageFlagBits::eVertexBuffer, 
@@ -173,8 +179,9 @@ namespace render
             :
             std::nullopt
         }
+        , faces {std::nullopt}
     {
-        this->vertex_buffer.write(
+        this->vertex_buffer->write(
             std::span<const std::byte> {
                 reinterpret_cast<const std::byte*>(vertices.data()),
                 vertices.size() * sizeof (Vertex)
@@ -193,11 +200,26 @@ namespace render
         
     }
 
+    Object::Object(VoxelFaceArena::Allocation faces_)
+        : model_index {0}
+        , vertices {}
+        , indicies {std::nullopt}
+        , vertex_buffer {std::nullopt}
+        , index_buffer {std::nullopt}
+        , faces {std::move(faces_)}
+    {}
+
     void Object::bind(vk::CommandBuffer commandBuffer) const
     {
+        // the arena is bound with the descriptor set
+        if (this->faces.has_value())
+        {
+            return;
+        }
+
         commandBuffer.bindVertexBuffers(
             0, 
-            *this->vertex_buffer, 
+            **this->vertex_buffer, 
             std::array<vk::DeviceSize, 1> {0}
         );
 
@@ -210,7 +232,18 @@ namespace render
 
     void Object::draw(vk::CommandBuffer commandBuffer) const
     {
-        if (this->index_buffer.has_value())
+        if (this->faces.has_value())
+        {
+            // voxel_face.vert finds its face at gl_VertexIndex / 6, which
+            // counts from firstVertex
+            commandBuffer.draw(
+                static_cast<std::uint32_t>(this->faces->getCount() * 6),
+                1,
+                static_cast<std::uint32_t>(this->faces->getFirst() * 6),
+                0
+            );
+        }
+        else if (this->index_buffer.has_value())
         {
             commandBuffer.drawIndexed(
                 static_cast<std::uint32_t>(this->indicies->size()), 
@@ -307,6 +340,21 @@ namespace render
         return this->transform.getUpVector();
     }
 
+    glm::vec3 Camera::getPosition() const
+    {
+        return this->transform.translation;
+    }
+
+    float Camera::getPitch() const
+    {
+        return this->pitch;
+    }
+
+    float Camera::getYaw() const
+    {
+        return this->yaw;
+    }
+
     Camera::operator std::string() const
     {
         return fmt::format("{} | Pitch {} | Yaw {}",
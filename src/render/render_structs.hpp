@@ -6,6 +6,7 @@
 
 #include "vulkan/buffer.hpp"
 #include "vulkan/gpu_structs.hpp"
+#include "voxel_face_arena.hpp"
 
 namespace render
 {
@@ -42,6 +43,9 @@ namespace render
             -> std::pair<std::vector<render::Vertex>, std::vector<uint32_t>>;
             
         Object(VmaAllocator, std::vector<Vertex>, std::optional<std::vector<Index>>);
+        /// @brief Voxel faces the vertex shader pulls out of the arena, with
+        /// no vertex or index buffer of its own
+        explicit Object(VoxelFaceArena::Allocation);
         ~Object()                        = default;
 
         Object()                         = delete;
@@ -53,16 +57,20 @@ namespace render
         void bind(vk::CommandBuffer) const;
         void draw(vk::CommandBuffer) const;
 
-        Transform transform;
+        /// @brief Drawn with the matrix at this index, see
+        /// Renderer::writeModelMatrices()
+        std::uint32_t model_index;
 
     private:
         
         std::vector<Vertex> vertices;
         std::optional<std::vector<Index>> indicies;
 
-        Buffer vertex_buffer;   
+        std::optional<Buffer> vertex_buffer;
         std::optional<Buffer> index_buffer;
 
+        std::optional<VoxelFaceArena::Allocation> faces;
+
     }; // class Object
 
     // TODO: This is quite a bad stateful design, try and fix this.
@@ -86,6 +94,10 @@ namespace render
         [[nodiscard]] auto getUpVector()
             -> glm::vec3;
 
+        [[nodiscard]] glm::vec3 getPosition() const;
+        [[nodiscard]] float getPitch() const;
+        [[nodiscard]] float getYaw() const;
+
         [[nodiscard]] explicit operator std::string() const;
 
         auto asViewMatrix() const
@@ -1,18 +1,28 @@
+#include <cstring>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
 #include <sebib/seblog.hpp>
 
+#include <util/profiler.hpp>
+
 #include "renderer.hpp"
 
 namespace render
 {
-    Renderer::Renderer(vk::Extent2D size, std::string name)
-        : window       {size, name}
+    Renderer::Renderer(vk::Extent2D size, std::string name, PresentPolicy presentPolicy,
+        Target target)
+        : window         {target == Target::Window ? std::make_unique<Window>(size, name) : nullptr}
+        , present_policy {presentPolicy}
+        , headless_extent {size}
         , instance     {nullptr}
         , draw_surface {nullptr}
         , device       {nullptr}
         , allocator    {nullptr}
+        , voxel_faces  {nullptr}
+        , model_matrices {nullptr}
+        , normal_matrices {nullptr}
         , command_pool {nullptr}
         , image_buffer {nullptr}
         , texture      {nullptr}
@@ -23,24 +33,36 @@ namespace render
         , framebuffers {0}
         , render_index {0}
         , frames       {nullptr, nullptr}
+        , headless_frame_end_time {std::chrono::steady_clock::now()}
+        , headless_frame_duration {0.0f}
     {
         const vk::DynamicLoader dl;
         const PFN_vkGetInstanceProcAddr dynVkGetInstanceProcAddr = 
             dl.getProcAddress<PFN_vkGetInstanceProcAddr>("vkGetInstanceProcAddr");
         VULKAN_HPP_DEFAULT_DISPATCHER.init(dynVkGetInstanceProcAddr);
 
-        this->instance = std::make_unique<Instance>(dynVkGetInstanceProcAddr);
+        this->instance = std::make_unique<Instance>(dynVkGetInstanceProcAddr, !this->isHeadless());
 
         VULKAN_HPP_DEFAULT_DISPATCHER.init(**this->instance);
 
-        this->draw_surface = this->window.createSurface(**this->instance);
+        if (!this->isHeadless())
+        {
+            this->draw_surface = this->window->createSurface(**this->instance);
+        }
 
-        this->device = std::make_unique<Device>(**this->instance, *this->draw_surface);
+        this->device = std::make_unique<Device>(
+            **this->instance,
+            this->isHeadless()
+            ? std::nullopt
+            : std::make_optional(*this->draw_surface)
+        );
 
         VULKAN_HPP_DEFAULT_DISPATCHER.init(**this->instance, this->device->asLogicalDevice());
 
         this->command_pool = std::make_unique<CommandPool>(*this->device);
 
+        this->gpu_profiler = std::make_unique<GpuProfiler>(*this->device, this->MaxFramesInFlight);
+
         this->allocator = std::make_unique<Allocator>(
             **this->instance,
             this->device->asPhysicalDevice(),
@@ -49,9 +71,29 @@ namespace render
             dl.getProcAddress<PFN_vkGetDeviceProcAddr>("vkGetDeviceProcAddr")
         );
 
+        this->voxel_faces = std::make_unique<VoxelFaceArena>(**this->allocator, MaxVoxelFaces);
+        this->model_matrices = std::make_unique<Buffer>(
+            **this->allocator,
+            MaxModelMatrices * sizeof(glm::mat4),
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            vk::MemoryPropertyFlagBits::eDeviceLocal |
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent
+        );
+        this->normal_matrices = std::make_unique<Buffer>(
+            **this->allocator,
+            MaxModelMatrices * sizeof(NormalMatrix),
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            vk::MemoryPropertyFlagBits::eDeviceLocal |
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent
+        );
+
         // this->texture && this->texture_sampler initalization
         this->extra_commands.push([&](vk::CommandBuffer commandBuffer)
         {
+            PROFILE_SCOPE("Renderer::loadTexture");
+
             int width;
             int height;
             int textureChannels;
@@ -136,7 +178,7 @@ namespace render
         });
         this->initializeRenderer();
 
-        seb::logLog("Renderer initalized successfully");
+        seb::logLog("Renderer initalized successfully{}", this->isHeadless() ? " | Headless" : "");
     }
 
     Renderer::~Renderer()
@@ -146,6 +188,8 @@ namespace render
 
     Object Renderer::createObject(std::vector<Vertex> v, std::optional<std::vector<Index>> i) const
     {
+        PROFILE_SCOPE("Renderer::createObject");
+
         return Object {
             **this->allocator,
             std::forward<std::vector<Vertex>>(v),
@@ -153,41 +197,248 @@ namespace render
         };
     }
 
+    std::optional<Object> Renderer::createVoxelObject(std::span<const VoxelFace> faces) const
+    {
+        PROFILE_SCOPE("Renderer::createVoxelObject");
+
+        std::optional<VoxelFaceArena::Allocation> allocation = this->voxel_faces->allocate(faces);
+
+        if (!allocation.has_value())
+        {
+            return std::nullopt;
+        }
+
+        return Object {std::move(*allocation)};
+    }
+
+    void Renderer::retireObject(Object object)
+    {
+        this->retiring_objects.push_back(std::move(object));
+    }
+
     std::pair<double, double> Renderer::getMouseDelta()
     {
-        return this->window.getMouseDelta();
+        if (this->isHeadless())
+        {
+            return std::make_pair<double, double>(0.0, 0.0);
+        }
+
+        return this->window->getMouseDelta();
     }
 
     bool Renderer::shouldClose() const
     {
-        return this->window.shouldClose();
+        return !this->isHeadless() && this->window->shouldClose();
+    }
+
+    void Renderer::setFarFieldBrickmap(std::span<const std::uint32_t> brickmapWords)
+    {
+        this->far_field->setBrickmap(brickmapWords);
+    }
+
+    void Renderer::setFarFieldDistance(std::optional<float> distance)
+    {
+        this->far_field->setStartDistance(distance);
+    }
+
+    void Renderer::writeModelMatrices(
+        std::size_t                   first,
+        std::span<const glm::mat4>    models,
+        std::span<const NormalMatrix> normals)
+    {
+        seb::assertFatal(
+            models.size() == normals.size(),
+            "{} model matrices but {} normal matrices",
+            models.size(),
+            normals.size()
+        );
+        seb::assertFatal(
+            first + models.size() <= MaxModelMatrices,
+            "Model matrices [{}, {}) are past the buffer's {}",
+            first,
+            first + models.size(),
+            MaxModelMatrices
+        );
+
+        std::memcpy(
+            static_cast<std::byte*>(this->model_matrices->getMappedPtr()) + first * sizeof(glm::mat4),
+            models.data(),
+            models.size_bytes()
+        );
+        std::memcpy(
+            static_cast<std::byte*>(this->normal_matrices->getMappedPtr()) + first * sizeof(NormalMatrix),
+            normals.data(),
+            normals.size_bytes()
+        );
+    }
+
+    std::vector<float> Renderer::readFarFieldDepth() const
+    {
+        PROFILE_SCOPE("Renderer::readFarFieldDepth");
+
+        seb::assertFatal(this->far_field->isEnabled(), "There is no far field to read");
+
+        const vk::Extent2D extent = this->far_field->getExtent();
+        std::vector<float> depth (static_cast<std::size_t>(extent.width) * extent.height);
+
+        const Buffer readback {
+            **this->allocator,
+            depth.size() * sizeof(float),
+            vk::BufferUsageFlagBits::eTransferDst,
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent
+        };
+
+        const vk::CommandBufferAllocateInfo commandBufferAllocateInfo
+        {
+            .sType              {vk::StructureType::eCommandBufferAllocateInfo},
+            .pNext              {},
+            .commandPool        {**this->command_pool},
+            .level              {vk::CommandBufferLevel::ePrimary},
+            .commandBufferCount {1},
+        };
+
+        vk::UniqueCommandBuffer commandBuffer = std::move(
+            this->device->asLogicalDevice().allocateCommandBuffersUnique(commandBufferAllocateInfo).front());
+
+        const vk::CommandBufferBeginInfo commandBufferBeginInfo
+        {
+            .sType            {vk::StructureType::eCommandBufferBeginInfo},
+            .pNext            {nullptr},
+            .flags            {vk::CommandBufferUsageFlagBits::eOneTimeSubmit},
+            .pInheritanceInfo {nullptr},
+        };
+
+        commandBuffer->begin(commandBufferBeginInfo);
+        this->far_field->copyDepth(*commandBuffer, readback);
+        commandBuffer->end();
+
+        const std::array<vk::SubmitInfo, 1> submitInfos
+        {
+            vk::SubmitInfo
+            {
+                .sType                {vk::StructureType::eSubmitInfo},
+                .pNext                {nullptr},
+                .waitSemaphoreCount   {0},
+                .pWaitSemaphores      {nullptr},
+                .pWaitDstStageMask    {nullptr},
+                .commandBufferCount   {1},
+                .pCommandBuffers      {&*commandBuffer},
+                .signalSemaphoreCount {0},
+                .pSignalSemaphores    {nullptr},
+            }
+        };
+
+        this->device->getRenderComputeTransferQueue().submit(submitInfos, nullptr);
+        this->device->getRenderComputeTransferQueue().waitIdle();
+
+        std::memcpy(depth.data(), readback.getMappedPtr(), depth.size() * sizeof(float));
+
+        return depth;
     }
 
     void Renderer::attachCursor() const
     {
-        this->window.attachCursor();
+        if (!this->isHeadless())
+        {
+            this->window->attachCursor();
+        }
     }
 
     void Renderer::detachCursor() const
     {
-        this->window.detachCursor();
+        if (!this->isHeadless())
+        {
+            this->window->detachCursor();
+        }
     }
 
     std::function<bool(vkfw::Key)> Renderer::getKeyCallback() const
     {
         return [this](vkfw::Key key) -> bool
         {
-            return this->window.isKeyPressed(key);
+            return !this->isHeadless() && this->window->isKeyPressed(key);
         };
     }
 
     float Renderer::getDeltaTimeSeconds() const
     {
-        return this->window.getDeltaTimeSeconds();
+        if (this->isHeadless())
+        {
+            return this->headless_frame_duration.count();
+        }
+
+        return this->window->getDeltaTimeSeconds();
+    }
+
+    auto Renderer::getLastGpuFrameTime() const
+        -> std::optional<std::chrono::duration<double>>
+    {
+        if (const auto frame = this->gpu_profiler->getTiming("frame"); frame.has_value())
+        {
+            return std::chrono::duration<double, std::milli> {frame->last_ms};
+        }
+
+        return std::nullopt;
+    }
+
+    auto Renderer::getGpuTimings() const
+        -> std::vector<GpuProfiler::ZoneTiming>
+    {
+        return this->gpu_profiler->getTimings();
+    }
+
+    vk::Extent2D Renderer::getRenderExtent() const
+    {
+        return this->isHeadless() ? this->headless_extent : this->swapchain->getExtent();
+    }
+
+    bool Renderer::isHeadless() const
+    {
+        return this->window == nullptr;
+    }
+
+    auto Renderer::getPresentTimings() const
+        -> PresentTimings
+    {
+        if (this->present_intervals.empty())
+        {
+            return PresentTimings {};
+        }
+
+        std::chrono::duration<double> sum {0.0};
+        std::chrono::duration<double> worst {0.0};
+
+        for (std::chrono::duration<double> d : this->present_intervals)
+        {
+            sum += d;
+            worst = std::max(worst, d);
+        }
+
+        return PresentTimings {
+            .last    {this->present_intervals.back()},
+            .average {sum / static_cast<double>(this->present_intervals.size())},
+            .worst   {worst},
+        };
     }
 
     void Renderer::drawFrame(const Camera& camera, const std::vector<PipelinedObject>& objectView)
     {
+        std::vector<const PipelinedObject*> everyObject {};
+        everyObject.reserve(objectView.size());
+
+        for (const PipelinedObject& pO : objectView)
+        {
+            everyObject.push_back(&pO);
+        }
+
+        this->drawFrame(camera, everyObject);
+    }
+
+    void Renderer::drawFrame(const Camera& camera, std::span<const PipelinedObject* const> objectView)
+    {
+        PROFILE_SCOPE("Renderer::drawFrame");
+
         static float idx = 0.0f;
 
         idx += 30.5f * this->getDeltaTimeSeconds();
@@ -213,17 +464,21 @@ namespace render
             objects.push_back({&p, std::vector<const Object*> {}});
         }
 
-        for (const PipelinedObject& pO : objectView)
+        for (const PipelinedObject* pO : objectView)
         {
-            switch (pO.pipeline)
+            switch (pO->pipeline)
             {
             case Pipelines::FaceTexture:
                 objects.at(static_cast<std::size_t>(Pipelines::FaceTexture))
-                    .second.push_back(&pO.object);
+                    .second.push_back(&pO->object);
                 break;
             case Pipelines::WorldVoxels:
                 objects.at(static_cast<std::size_t>(Pipelines::WorldVoxels))
-                    .second.push_back(&pO.object);
+                    .second.push_back(&pO->object);
+                break;
+            case Pipelines::VoxelFaces:
+                objects.at(static_cast<std::size_t>(Pipelines::VoxelFaces))
+                    .second.push_back(&pO->object);
                 break;
             default:
                 seb::panic("Unimplemented case");
@@ -231,18 +486,55 @@ namespace render
         }
 
         auto result = this->frames.at(this->render_index)->render(
-            *this->device, *this->swapchain, *this->render_pass,
+            *this->device, this->swapchain.get(), this->getRenderExtent(), *this->render_pass,
             this->framebuffers,
             *this->descriptor_sets.at(this->render_index),
             objects,
-            camera, this->extra_commands
+            camera, this->extra_commands,
+            *this->gpu_profiler, this->render_index,
+            this->far_field->isEnabled() ? this->far_field.get() : nullptr,
+            *this->far_field_composite
         );
 
+        // render() just waited on the previous frame drawn with this index,
+        // anything retired before that frame was drawn is no longer in use
+        this->retired_objects.at(this->render_index).clear();
+        std::swap(this->retired_objects.at(this->render_index), this->retiring_objects);
+
         this->render_index = (this->render_index + 1) % this->MaxFramesInFlight;
-        
-        this->window.pollEvents(
-            std::make_optional<std::chrono::duration<double>>(0.004166666)
-        );
+
+        if (result == vk::Result::eSuccess)
+        {
+            const auto presentTime = std::chrono::steady_clock::now();
+
+            if (this->last_present_time.has_value())
+            {
+                this->present_intervals.push_back(presentTime - *this->last_present_time);
+
+                if (this->present_intervals.size() > PresentTimingWindow)
+                {
+                    this->present_intervals.pop_front();
+                }
+            }
+            this->last_present_time = presentTime;
+        }
+
+        if (this->isHeadless())
+        {
+            const auto currentTime = std::chrono::steady_clock::now();
+
+            this->headless_frame_duration = currentTime - this->headless_frame_end_time;
+            this->headless_frame_end_time = currentTime;
+        }
+        else
+        {
+            // Immediate is used for throughput measurements, so it stays uncapped
+            this->window->pollEvents(
+                this->swapchain->getPresentMode() == vk::PresentModeKHR::eImmediate
+                ? std::nullopt
+                : std::make_optional<std::chrono::duration<double>>(0.004166666)
+            );
+        }
 
         switch (result)
         {
@@ -260,8 +552,10 @@ namespace render
     {
         seb::logTrace("Renderer resizimg!");
 
+        seb::assertFatal(!this->isHeadless(), "Headless renderers have a fixed extent");
+
         // Sanity checks
-        this->window.blockThisThreadIfMinimized();
+        this->window->blockThisThreadIfMinimized();
         this->device->asLogicalDevice().waitIdle();
 
         for (std::unique_ptr<Recorder>& f : this->frames)
@@ -275,26 +569,50 @@ namespace render
         }
         this->framebuffers.clear();
         this->descriptor_pool.reset();
+        this->far_field_composite.reset();
         this->pipelines.reset();
         this->render_pass.reset();
         this->depth_buffer.reset();
         this->swapchain.reset();
+        this->last_present_time.reset();
  
         this->initializeRenderer();
     }
 
     void Renderer::initializeRenderer()
     {
-        this->swapchain = std::make_unique<Swapchain>(
-            *this->device,
-            *this->draw_surface,
-            this->window.size()
-        );
+        if (this->isHeadless())
+        {
+            this->offscreen_color = std::make_unique<Image2D>(
+                *this->allocator,
+                this->device->asLogicalDevice(),
+                this->headless_extent,
+                vk::Format::eR8G8B8A8Srgb,
+                vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+                vk::ImageAspectFlagBits::eColor,
+                vk::ImageTiling::eOptimal,
+                vk::MemoryPropertyFlagBits::eDeviceLocal
+            );
+        }
+        else
+        {
+            this->swapchain = std::make_unique<Swapchain>(
+                *this->device,
+                *this->draw_surface,
+                this->window->size(),
+                this->present_policy
+            );
+
+            seb::logLog("Swapchain created | Present mode: {} | Images: {}",
+                vk::to_string(this->swapchain->getPresentMode()),
+                this->swapchain->getImageViews().size()
+            );
+        }
 
         this->depth_buffer = std::make_unique<Image2D>(
             *this->allocator,
             this->device->asLogicalDevice(),
-            this->swapchain->getExtent(),
+            this->getRenderExtent(),
             vk::Format::eD32Sfloat,
             vk::ImageUsageFlagBits::eDepthStencilAttachment,
             vk::ImageAspectFlagBits::eDepth,
@@ -302,9 +620,27 @@ namespace render
             vk::MemoryPropertyFlagBits::eDeviceLocal
         );
 
+        if (this->far_field == nullptr)
+        {
+            this->far_field = std::make_unique<FarField>(
+                this->device->asLogicalDevice(),
+                *this->allocator,
+                this->getRenderExtent()
+            );
+        }
+        else
+        {
+            this->far_field->resize(this->getRenderExtent());
+        }
+
         this->render_pass = std::make_unique<RenderPass>(
             this->device->asLogicalDevice(),
-            *this->swapchain,
+            this->isHeadless()
+                ? this->offscreen_color->getFormat()
+                : this->swapchain->getSurfaceFormat().format,
+            this->isHeadless()
+                ? vk::ImageLayout::eTransferSrcOptimal
+                : vk::ImageLayout::ePresentSrcKHR,
             *this->depth_buffer
         );
 
@@ -314,7 +650,7 @@ namespace render
                 {
                     this->device->asLogicalDevice(),
                     **this->render_pass,
-                    this->swapchain->getExtent(),
+                    this->getRenderExtent(),
                     Pipeline::createShaderFromFile(
                         this->device->asLogicalDevice(),
                         "src/render/shaders/face_texture.vert.bin"
@@ -322,13 +658,15 @@ namespace render
                     Pipeline::createShaderFromFile(
                         this->device->asLogicalDevice(),
                         "src/render/shaders/face_texture.frag.bin"
-                    )
+                    ),
+                    Pipeline::VertexInput::Attributes,
+                    "FaceTexture"
                 },
                 Pipeline 
                 {
                     this->device->asLogicalDevice(),
                     **this->render_pass,
-                    this->swapchain->getExtent(),
+                    this->getRenderExtent(),
                     Pipeline::createShaderFromFile(
                         this->device->asLogicalDevice(),
                         "src/render/shaders/terrain_voxel.vert.bin"
@@ -336,15 +674,50 @@ namespace render
                     Pipeline::createShaderFromFile(
                         this->device->asLogicalDevice(),
                         "src/render/shaders/terrain_voxel.frag.bin"
-                    )
+                    ),
+                    Pipeline::VertexInput::Attributes,
+                    "WorldVoxels"
+                },
+                Pipeline 
+                {
+                    this->device->asLogicalDevice(),
+                    **this->render_pass,
+                    this->getRenderExtent(),
+                    Pipeline::createShaderFromFile(
+                        this->device->asLogicalDevice(),
+                        "src/render/shaders/voxel_face.vert.bin"
+                    ),
+                    Pipeline::createShaderFromFile(
+                        this->device->asLogicalDevice(),
+                        "src/render/shaders/terrain_voxel.frag.bin"
+                    ),
+                    Pipeline::VertexInput::Pulled,
+                    "VoxelFaces"
                 }
             }
         );
 
+        this->far_field_composite = std::make_unique<Pipeline>(
+            this->device->asLogicalDevice(),
+            **this->render_pass,
+            this->getRenderExtent(),
+            Pipeline::createShaderFromFile(
+                this->device->asLogicalDevice(),
+                "src/render/shaders/far_field.vert.bin"
+            ),
+            Pipeline::createShaderFromFile(
+                this->device->asLogicalDevice(),
+                "src/render/shaders/far_field.frag.bin"
+            ),
+            Pipeline::VertexInput::Pulled,
+            "FarField"
+        );
+
         seb::logWarn("Unhardcode");
         this->descriptor_pool = std::make_unique<DescriptorPool>(
             this->device->asLogicalDevice(),
             this->pipelines->at(0).getDescriptorSetLayout(),
+            this->MaxFramesInFlight,
             std::vector {
                 vk::DescriptorPoolSize
                 {
@@ -355,16 +728,43 @@ namespace render
                 {
                     .type            {vk::DescriptorType::eCombinedImageSampler},
                     .descriptorCount {static_cast<std::uint32_t>(this->MaxFramesInFlight)}
+                },
+                // voxel faces, model and normal matrices
+                vk::DescriptorPoolSize
+                {
+                    .type            {vk::DescriptorType::eStorageBuffer},
+                    .descriptorCount {static_cast<std::uint32_t>(this->MaxFramesInFlight * 3)}
+                },
+                // far field color and depth
+                vk::DescriptorPoolSize
+                {
+                    .type            {vk::DescriptorType::eStorageImage},
+                    .descriptorCount {static_cast<std::uint32_t>(this->MaxFramesInFlight * 2)}
                 }
             }
         );
 
         // framebuffer creation
-        for (const vk::UniqueImageView& view : this->swapchain->getImageViews())
+        const std::vector<vk::ImageView> colorViews = [this]
+        {
+            if (this->isHeadless())
+            {
+                return std::vector<vk::ImageView> {**this->offscreen_color};
+            }
+
+            std::vector<vk::ImageView> views;
+            for (const vk::UniqueImageView& view : this->swapchain->getImageViews())
+            {
+                views.push_back(*view);
+            }
+            return views;
+        }();
+
+        for (vk::ImageView view : colorViews)
         {
             std::array<vk::ImageView, 2> attachments
             {
-                *view,
+                view,
                 **this->depth_buffer
             };
 
@@ -375,8 +775,8 @@ namespace render
                 .renderPass      {**this->render_pass},
                 .attachmentCount {attachments.size()},
                 .pAttachments    {attachments.data()},
-                .width           {this->swapchain->getExtent().width},
-                .height          {this->swapchain->getExtent().height},
+                .width           {this->getRenderExtent().width},
+                .height          {this->getRenderExtent().height},
                 .layers          {1},
             };
 
@@ -427,7 +827,42 @@ namespace render
                     .imageLayout {vk::ImageLayout::eShaderReadOnlyOptimal},
                 };
 
-                std::array<vk::WriteDescriptorSet, 2> writeInfo
+                const vk::DescriptorBufferInfo voxelFacesBindingInfo
+                {
+                    .buffer {*this->voxel_faces->getBuffer()},
+                    .offset {0},
+                    .range  {VK_WHOLE_SIZE},
+                };
+
+                const vk::DescriptorBufferInfo modelMatricesBindingInfo
+                {
+                    .buffer {**this->model_matrices},
+                    .offset {0},
+                    .range  {VK_WHOLE_SIZE},
+                };
+
+                const vk::DescriptorBufferInfo normalMatricesBindingInfo
+                {
+                    .buffer {**this->normal_matrices},
+                    .offset {0},
+                    .range  {VK_WHOLE_SIZE},
+                };
+
+                const vk::DescriptorImageInfo farFieldColorBindingInfo
+                {
+                    .sampler     {nullptr},
+                    .imageView   {*this->far_field->getColor()},
+                    .imageLayout {vk::ImageLayout::eGeneral},
+                };
+
+                const vk::DescriptorImageInfo farFieldDepthBindingInfo
+                {
+                    .sampler     {nullptr},
+                    .imageView   {*this->far_field->getDepth()},
+                    .imageLayout {vk::ImageLayout::eGeneral},
+                };
+
+                std::array<vk::WriteDescriptorSet, 7> writeInfo
                 {
                     vk::WriteDescriptorSet
                     {
@@ -455,6 +890,71 @@ namespace render
                         .pBufferInfo      {nullptr},
                         .pTexelBufferView {nullptr},
                     },
+                    vk::WriteDescriptorSet
+                    {
+                        .sType            {vk::StructureType::eWriteDescriptorSet},
+                        .pNext            {nullptr},
+                        .dstSet           {*this->descriptor_sets.at(i)},
+                        .dstBinding       {2},
+                        .dstArrayElement  {0},
+                        .descriptorCount  {1},
+                        .descriptorType   {vk::DescriptorType::eStorageBuffer},
+                        .pImageInfo       {nullptr},
+                        .pBufferInfo      {&voxelFacesBindingInfo},
+                        .pTexelBufferView {nullptr},
+                    },
+                    vk::WriteDescriptorSet
+                    {
+                        .sType            {vk::StructureType::eWriteDescriptorSet},
+                        .pNext            {nullptr},
+                        .dstSet           {*this->descriptor_sets.at(i)},
+                        .dstBinding       {3},
+                        .dstArrayElement  {0},
+                        .descriptorCount  {1},
+                        .descriptorType   {vk::DescriptorType::eStorageImage},
+                        .pImageInfo       {&farFieldColorBindingInfo},
+                        .pBufferInfo      {nullptr},
+                        .pTexelBufferView {nullptr},
+                    },
+                    vk::WriteDescriptorSet
+                    {
+                        .sType            {vk::StructureType::eWriteDescriptorSet},
+                        .pNext            {nullptr},
+                        .dstSet           {*this->descriptor_sets.at(i)},
+                        .dstBinding       {4},
+                        .dstArrayElement  {0},
+                        .descriptorCount  {1},
+                        .descriptorType   {vk::DescriptorType::eStorageImage},
+                        .pImageInfo       {&farFieldDepthBindingInfo},
+                        .pBufferInfo      {nullptr},
+                        .pTexelBufferView {nullptr},
+                    },
+                    vk::WriteDescriptorSet
+                    {
+                        .sType            {vk::StructureType::eWriteDescriptorSet},
+                        .pNext            {nullptr},
+                        .dstSet           {*this->descriptor_sets.at(i)},
+                        .dstBinding       {5},
+                        .dstArrayElement  {0},
+                        .descriptorCount  {1},
+                        .descriptorType   {vk::DescriptorType::eStorageBuffer},
+                        .pImageInfo       {nullptr},
+                        .pBufferInfo      {&modelMatricesBindingInfo},
+                        .pTexelBufferView {nullptr},
+                    },
+                    vk::WriteDescriptorSet
+                    {
+                        .sType            {vk::StructureType::eWriteDescriptorSet},
+                        .pNext            {nullptr},
+                        .dstSet           {*this->descriptor_sets.at(i)},
+                        .dstBinding       {6},
+                        .dstArrayElement  {0},
+                        .descriptorCount  {1},
+                        .descriptorType   {vk::DescriptorType::eStorageBuffer},
+                        .pImageInfo       {nullptr},
+                        .pBufferInfo      {&normalMatricesBindingInfo},
+                        .pTexelBufferView {nullptr},
+                    },
                 };
 
                 this->device->asLogicalDevice().updateDescriptorSets(writeInfo, nullptr);
@@ -1,7 +1,10 @@
 #ifndef SRC_RENDER_RENDERER_HPP
 #define SRC_RENDER_RENDERER_HPP
 
+#include <chrono>
+#include <deque>
 #include <set>
+#include <span>
 
 #include <sebib/seblog.hpp>
 #include <sebib/sebmis.hpp>
@@ -10,6 +13,7 @@
 #include "vulkan/command_pool.hpp"
 #include "vulkan/descriptor_pool.hpp"
 #include "vulkan/device.hpp"
+#include "gpu_profiler.hpp"
 #include "recorder.hpp"
 #include "vulkan/instance.hpp"
 #include "vulkan/pipeline.hpp"
@@ -17,6 +21,8 @@
 #include "vulkan/image.hpp"
 #include "vulkan/swapchain.hpp"
 #include "vulkan/includes.hpp"
+#include "far_field.hpp"
+#include "voxel_face_arena.hpp"
 
 #include "window.hpp"
 
@@ -33,7 +39,8 @@ namespace render
         {
             FaceTexture = 0,
             WorldVoxels = 1,
-            MAX_PIPELINE_SIZE = 2,
+            VoxelFaces  = 2, // Objects from createVoxelObject()
+            MAX_PIPELINE_SIZE = 3,
         };
 
         struct PipelinedObject
@@ -41,6 +48,24 @@ namespace render
             render::Renderer::Pipelines pipeline;
             render::Object              object;
         };
+
+        /// @brief Where frames end up. Headless renders into an offscreen
+        /// image and needs neither a display nor a window system, which
+        /// allows running under lavapipe on CI machines
+        enum class Target
+        {
+            Window,
+            Headless,
+        };
+
+        /// @brief present to present intervals over the last
+        /// PresentTimingWindow frames
+        struct PresentTimings
+        {
+            std::chrono::duration<double> last;
+            std::chrono::duration<double> average;
+            std::chrono::duration<double> worst;
+        };
     private:
         using PipelineArray = std::array<
             Pipeline, 
@@ -48,7 +73,9 @@ namespace render
         >;
     public:
 
-        Renderer(vk::Extent2D defaultSize, std::string name);
+        Renderer(vk::Extent2D defaultSize, std::string name,
+            PresentPolicy = PresentPolicy {.mode {PresentMode::Mailbox}, .image_count {std::nullopt}},
+            Target = Target::Window);
         ~Renderer();
 
         Renderer(const Renderer&)            = delete;
@@ -58,15 +85,53 @@ namespace render
 
         // This function list is a mess TODO: redesign
         [[nodiscard]] Object createObject(std::vector<Vertex>, std::optional<std::vector<Index>>) const;
+        /// @brief An Object for the VoxelFaces pipeline, empty once the
+        /// voxel face arena has no room left for @param faces
+        [[nodiscard]] std::optional<Object> createVoxelObject(std::span<const VoxelFace> faces) const;
+        /// @brief Destroys @param object once no frame in flight can still be
+        /// drawing it, instead of waiting for the GPU
+        void retireObject(Object object);
         [[nodiscard]] auto getKeyCallback() const -> std::function<bool(vkfw::Key)>;
         [[nodiscard]] std::pair<double, double> getMouseDelta();
         [[nodiscard]] float getDeltaTimeSeconds() const;
         [[nodiscard]] bool shouldClose() const;
+        [[nodiscard]] PresentTimings getPresentTimings() const;
+        [[nodiscard]] auto getLastGpuFrameTime() const
+            -> std::optional<std::chrono::duration<double>>;
+        /// @brief rolling GPU time of the frame, render pass and each pipeline
+        /// bucket, lags MaxFramesInFlight frames behind
+        [[nodiscard]] auto getGpuTimings() const
+            -> std::vector<GpuProfiler::ZoneTiming>;
+        [[nodiscard]] vk::Extent2D getRenderExtent() const;
+        [[nodiscard]] bool isHeadless() const;
+
+        /// @brief Ray marches @param brickmapWords, laid out like
+        /// world::Brickmap::writeGpuWords(), for everything further away than
+        /// setFarFieldDistance(), see FarField
+        void setFarFieldBrickmap(std::span<const std::uint32_t> brickmapWords);
+        /// @brief nullopt, the default, draws no far field
+        void setFarFieldDistance(std::optional<float> distance);
+        /// @brief Objects are drawn with the matrices at their model_index, of
+        /// MaxModelMatrices, @param normals parallel to @param models. The
+        /// Recorder waits for every frame it submits, so the matrices are
+        /// written straight into the buffers the shaders read and only ever
+        /// what changed has to be
+        void writeModelMatrices(
+            std::size_t                   first,
+            std::span<const glm::mat4>    models,
+            std::span<const NormalMatrix> normals);
+        /// @brief The far field's depth at every pixel of the last frame, row
+        /// by row and 1 where nothing was hit. Waits for the GPU, for checking
+        /// the march against the CPU
+        [[nodiscard]] std::vector<float> readFarFieldDepth() const;
 
         void attachCursor() const;
         void detachCursor() const;
         
         void drawFrame(const Camera& camera, const std::vector<PipelinedObject>& objectView);
+        /// @brief Draws only the objects pointed to, which have to live
+        /// until the frame is recorded
+        void drawFrame(const Camera& camera, std::span<const PipelinedObject* const> objectView);
         
         void resize();
 
@@ -74,7 +139,9 @@ namespace render
         void initializeRenderer();
 
 
-        Window window;
+        std::unique_ptr<Window> window; // nullptr when headless
+        PresentPolicy present_policy;
+        vk::Extent2D  headless_extent;
         std::queue<std::function<void(vk::CommandBuffer)>> extra_commands;
 
         // Vulkan Initialization 
@@ -82,7 +149,13 @@ namespace render
         vk::UniqueSurfaceKHR         draw_surface;
         std::unique_ptr<Device>      device;
         std::unique_ptr<Allocator>   allocator;
+        // outlives every Object, the retired ones included
+        std::unique_ptr<VoxelFaceArena> voxel_faces;
+        // kept across resizes like the voxel faces, by Object::model_index
+        std::unique_ptr<Buffer>         model_matrices;
+        std::unique_ptr<Buffer>         normal_matrices;
         std::unique_ptr<CommandPool> command_pool; // one pool per thread
+        std::unique_ptr<GpuProfiler> gpu_profiler;
 
         // scratch stuff
         std::unique_ptr<Buffer>  image_buffer;
@@ -90,10 +163,14 @@ namespace render
         vk::UniqueSampler        texture_sampler;
 
         // Vulkan Rendering 
-        std::unique_ptr<Swapchain>      swapchain;
+        std::unique_ptr<Swapchain>      swapchain;       // nullptr when headless
+        std::unique_ptr<Image2D>        offscreen_color; // nullptr when presenting
         std::unique_ptr<Image2D>        depth_buffer;
         std::unique_ptr<RenderPass>     render_pass;
         std::unique_ptr<PipelineArray>  pipelines; 
+        // keeps its brickmap across resizes, only the images are recreated
+        std::unique_ptr<FarField>       far_field;
+        std::unique_ptr<Pipeline>       far_field_composite;
         std::unique_ptr<DescriptorPool> descriptor_pool; // one pool per thread
         
         // Frames in Flight
@@ -102,10 +179,29 @@ namespace render
         // renderer
         std::size_t                                              render_index;
         constexpr static std::size_t                             MaxFramesInFlight = 2;
+        // 128 MiB, several times what the terrain scene draws
+        constexpr static std::size_t                             MaxVoxelFaces     = std::size_t {1} << 24;
+        // 8 MiB and 6 MiB of normal matrices, far more than the objects of
+        // every scene
+        constexpr static std::size_t                             MaxModelMatrices  = std::size_t {1} << 17;
         std::array<std::unique_ptr<Buffer>, MaxFramesInFlight>   uniform_buffers;
         std::vector<vk::UniqueDescriptorSet>                     descriptor_sets;
         std::array<std::unique_ptr<Recorder>, MaxFramesInFlight> frames;
-        
+
+        // retired since the last frame, then per frame index until that
+        // index's fence has been waited on again
+        std::vector<Object>                                      retiring_objects;
+        std::array<std::vector<Object>, MaxFramesInFlight>       retired_objects;
+
+        // present timing
+        constexpr static std::size_t                                PresentTimingWindow = 128;
+        std::optional<std::chrono::steady_clock::time_point>        last_present_time;
+        std::deque<std::chrono::duration<double>>                   present_intervals;
+
+        // headless frame pacing, Window handles this when presenting
+        std::chrono::steady_clock::time_point                       headless_frame_end_time;
+        std::chrono::duration<float>                                headless_frame_duration;
+
     }; // class Renderer
 } // namespace render
 
@@ -8,7 +8,7 @@ layout(location = 3) in vec2 in_uv;
 layout(push_constant) uniform PushConstants
 {
     mat4 view_projection;
-    mat4 model;
+    uint model_index;
 } in_push_constants;
 
 layout(binding = 0) uniform UniformBuffer
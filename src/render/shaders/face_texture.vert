@@ -8,7 +8,7 @@ layout(location = 3) in vec2 in_uv;
 layout(push_constant) uniform PushConstants
 {
     mat4 view_projection;
-    mat4 model;
+    uint model_index;
 } in_push_constants;
 
 layout(binding = 0) uniform UniformBuffer
@@ -17,6 +17,18 @@ layout(binding = 0) uniform UniformBuffer
     vec4 light_color;
 } in_uniform_buffer;
 
+// see render::Renderer::writeModelMatrices()
+layout(std430, binding = 5) readonly buffer ModelMatrices
+{
+    mat4 matrices[];
+} in_model_matrices;
+
+// inverse(transpose(mat3(model))) of every model matrix
+layout(std430, binding = 6) readonly buffer NormalMatrices
+{
+    mat3 matrices[];
+} in_normal_matrices;
+
 layout(location = 0) out vec3 out_pos_world;
 layout(location = 1) out vec3 out_color;
 layout(location = 2) out vec3 out_normal;
@@ -24,11 +36,13 @@ layout(location = 3) out vec2 out_uv;
 
 void main() 
 {
-    const vec4 pos_world_affine = in_push_constants.model * vec4(in_position, 1.0);
+    const mat4 model = in_model_matrices.matrices[in_push_constants.model_index];
+
+    const vec4 pos_world_affine = model * vec4(in_position, 1.0);
 
     gl_Position = in_push_constants.view_projection * pos_world_affine;
     out_color = in_color;
     out_pos_world = pos_world_affine.xyz * pos_world_affine.w;
-    out_normal = inverse(transpose(mat3(in_push_constants.model))) * in_normal;
+    out_normal = in_normal_matrices.matrices[in_push_constants.model_index] * in_normal;
     out_uv = in_uv;
 }
\ No newline at end of file
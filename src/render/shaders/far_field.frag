@@ -0,0 +1,22 @@
+#version 460
+
+// written by voxel_march.comp, see render::FarField
+layout(binding = 3, rgba16f) uniform readonly image2D in_far_field_color;
+layout(binding = 4, r32f) uniform readonly image2D in_far_field_depth;
+
+layout(location = 0) out vec4 out_color;
+
+void main()
+{
+    const ivec2 pixel = ivec2(gl_FragCoord.xy);
+    const float depth = imageLoad(in_far_field_depth, pixel).r;
+
+    // nothing was hit, the clear color stays
+    if (depth >= 1.0)
+    {
+        discard;
+    }
+
+    out_color    = imageLoad(in_far_field_color, pixel);
+    gl_FragDepth = depth;
+}
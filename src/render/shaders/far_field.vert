@@ -0,0 +1,9 @@
+#version 460
+
+// one triangle covering the screen, counter clockwise like every front face
+void main()
+{
+    const vec2 corner = vec2(gl_VertexIndex & 2, (gl_VertexIndex << 1) & 2);
+
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
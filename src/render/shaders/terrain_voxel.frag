@@ -4,11 +4,15 @@ layout(location = 0) in vec3 in_pos_world;
 layout(location = 1) in vec3 in_color;
 layout(location = 2) in vec3 in_normal;
 layout(location = 3) in vec2 in_uv;
+// baked by the mesher, 0 fully occluded to 1 open
+layout(location = 4) in float in_occlusion;
+// sky and block light, 0 dark to 1 full strength
+layout(location = 5) in vec2 in_light;
 
 layout(push_constant) uniform PushConstants
 {
     mat4 view_projection;
-    mat4 model;
+    uint model_index;
 } in_push_constants;
 
 layout(binding = 0) uniform UniformBuffer
@@ -22,8 +26,23 @@ layout(binding = 1) uniform sampler2D in_texture_sampler;
 layout(location = 0) out vec4 out_color;
 
 const vec4 ambient_light = vec4(1.0, 1.0, 1.0, 0.01);
+const vec3 sun_direction = normalize(vec3(0.4, 1.0, 0.25));
+const vec3 block_light_color = vec3(1.0, 0.82, 0.6);
+
+// every level of light lost dims by the same factor, never to pitch black
+float getBrightness(float level)
+{
+    return max(pow(0.8, 15.0 * (1.0 - level)), 0.05);
+}
 
 void main() 
 {
-    out_color = vec4(in_color, 1.0);
+    // flat colored voxel faces are unreadable without some shading
+    const float diffuse = max(dot(normalize(in_normal), sun_direction), 0.0);
+    const float ambient = mix(0.4, 1.0, in_occlusion);
+    // only sky light sees the sun
+    const vec3  sky     = vec3(getBrightness(in_light.x) * (0.45 + 0.55 * diffuse));
+    const vec3  block   = block_light_color * (in_light.y > 0.0 ? getBrightness(in_light.y) : 0.0);
+
+    out_color = vec4(in_color * max(sky, block) * ambient, 1.0);
 }
\ No newline at end of file
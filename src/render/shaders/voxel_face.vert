@@ -0,0 +1,111 @@
+#version 460
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 view_projection;
+    uint model_index;
+} in_push_constants;
+
+layout(binding = 0) uniform UniformBuffer
+{
+    vec3 light_position;
+    vec4 light_color;
+} in_uniform_buffer;
+
+// see render::Renderer::writeModelMatrices()
+layout(std430, binding = 5) readonly buffer ModelMatrices
+{
+    mat4 matrices[];
+} in_model_matrices;
+
+// render::VoxelFace, see gpu_structs.hpp for the bit layout
+struct VoxelFace
+{
+    uint position_size_face;
+    uint voxel_occlusion;
+};
+
+layout(std430, binding = 2) readonly buffer VoxelFaces
+{
+    VoxelFace faces[];
+} in_voxel_faces;
+
+layout(location = 0) out vec3 out_pos_world;
+layout(location = 1) out vec3 out_color;
+layout(location = 2) out vec3 out_normal;
+layout(location = 3) out vec2 out_uv;
+layout(location = 4) out float out_occlusion;
+// sky and block light in front of the face, 0 to 1
+layout(location = 5) out vec2 out_light;
+
+// corners of a face in (u, v), u x v is the positive normal so 0 1 2 3
+// wind counter clockwise seen from the positive side and negative faces
+// take them in the opposite order. Flipped quads rotate every index by one,
+// which splits them along the 1-3 diagonal with the same winding
+const uvec2 corners[4] = uvec2[4](uvec2(0u, 0u), uvec2(1u, 0u), uvec2(1u, 1u), uvec2(0u, 1u));
+const uint positive_winding[6] = uint[6](0u, 1u, 2u, 0u, 2u, 3u);
+const uint negative_winding[6] = uint[6](0u, 2u, 1u, 0u, 3u, 2u);
+
+// same as world::getVoxelColor
+vec3 getVoxelColor(uint voxel)
+{
+    switch (voxel)
+    {
+        case 1u: return vec3(0.45, 0.45, 0.47);
+        case 2u: return vec3(0.47, 0.33, 0.22);
+        case 3u: return vec3(0.30, 0.58, 0.22);
+        case 12u: return vec3(1.00, 0.86, 0.55);
+        default: break;
+    }
+
+    const uint hash = voxel * 2654435761u;
+
+    return 0.25 + 0.75 * vec3((uvec3(hash >> 8, hash >> 16, hash >> 24) & 0xFFu)) / 255.0;
+}
+
+void main()
+{
+    // draws start at their range's first face times six, which
+    // gl_VertexIndex counts from
+    const uint      vertex = uint(gl_VertexIndex);
+    const VoxelFace face   = in_voxel_faces.faces[vertex / 6u];
+
+    const uvec3 voxel_position = uvec3(
+        face.position_size_face,
+        face.position_size_face >> 5,
+        face.position_size_face >> 10) & 31u;
+    const uvec2 size        = (uvec2(face.position_size_face >> 15, face.position_size_face >> 20) & 31u) + 1u;
+    const uint  direction   = (face.position_size_face >> 25) & 7u;
+    const bool  is_positive = (direction & 1u) == 0u;
+
+    // same axes as world::getFaceAxes
+    const uint normal_axis = direction / 2u;
+    const uint u_axis      = (normal_axis + 1u) % 3u;
+    const uint v_axis      = (normal_axis + 2u) % 3u;
+
+    const uint  flip         = (face.voxel_occlusion >> 24) & 1u;
+    const uint  corner_index = ((is_positive ? positive_winding[vertex % 6u] : negative_winding[vertex % 6u]) + flip) % 4u;
+    const uvec2 corner       = corners[corner_index];
+
+    // positive faces sit on the far side of their voxel
+    vec3 position = vec3(voxel_position);
+    position[normal_axis] += is_positive ? 1.0 : 0.0;
+    position[u_axis]      += float(corner.x * size.x);
+    position[v_axis]      += float(corner.y * size.y);
+
+    vec3 normal = vec3(0.0);
+    normal[normal_axis] = is_positive ? 1.0 : -1.0;
+
+    const mat4 model = in_model_matrices.matrices[in_push_constants.model_index];
+
+    const vec4 pos_world_affine = model * vec4(position, 1.0);
+
+    gl_Position = in_push_constants.view_projection * pos_world_affine;
+    out_color = getVoxelColor(face.voxel_occlusion & 0xFFFFu);
+    out_pos_world = pos_world_affine.xyz * pos_world_affine.w;
+    // chunks are only ever translated and uniformly scaled
+    out_normal = mat3(model) * normal;
+    out_uv = vec2(corner * size);
+    out_occlusion = float((face.voxel_occlusion >> (16u + 2u * corner_index)) & 3u) / 3.0;
+    out_light = vec2(uvec2(face.position_size_face >> 28, face.voxel_occlusion >> 28) & 15u) / 15.0;
+}
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cstring>
+
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "voxel_face_arena.hpp"
+
+namespace render
+{
+    VoxelFaceArena::Allocation::Allocation(VoxelFaceArena& arena_, std::size_t first_, std::size_t count_)
+        : arena {&arena_}
+        , first {first_}
+        , count {count_}
+    {}
+
+    VoxelFaceArena::Allocation::~Allocation()
+    {
+        if (this->arena != nullptr)
+        {
+            this->arena->release(this->first, this->count);
+        }
+    }
+
+    VoxelFaceArena::Allocation::Allocation(Allocation&& other)
+        : arena {other.arena}
+        , first {other.first}
+        , count {other.count}
+    {
+        other.arena = nullptr;
+        other.count = 0;
+    }
+
+    VoxelFaceArena::Allocation& VoxelFaceArena::Allocation::operator=(Allocation&& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        // the range being replaced would otherwise leak
+        if (this->arena != nullptr)
+        {
+            this->arena->release(this->first, this->count);
+        }
+
+        this->arena = other.arena;
+        this->first = other.first;
+        this->count = other.count;
+
+        other.arena = nullptr;
+        other.count = 0;
+
+        return *this;
+    }
+
+    std::size_t VoxelFaceArena::Allocation::getFirst() const
+    {
+        return this->first;
+    }
+
+    std::size_t VoxelFaceArena::Allocation::getCount() const
+    {
+        return this->count;
+    }
+
+    VoxelFaceArena::VoxelFaceArena(VmaAllocator allocator, std::size_t capacityFaces)
+        : buffer {
+            allocator,
+            capacityFaces * sizeof(VoxelFace),
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            vk::MemoryPropertyFlagBits::eDeviceLocal |
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent
+        }
+        , capacity {capacityFaces}
+        , used_faces {0}
+        , free_ranges {{0, capacityFaces}}
+    {}
+
+    auto VoxelFaceArena::allocate(std::span<const VoxelFace> faces)
+        -> std::optional<Allocation>
+    {
+        PROFILE_SCOPE("VoxelFaceArena::allocate");
+
+        seb::assertFatal(!faces.empty(), "Tried to allocate an empty range of faces");
+
+        const auto range = std::ranges::find_if(this->free_ranges, [&](const auto& freeRange)
+        {
+            return freeRange.second >= faces.size();
+        });
+
+        if (range == this->free_ranges.end())
+        {
+            return std::nullopt;
+        }
+
+        const auto [first, count] = *range;
+        this->free_ranges.erase(range);
+
+        if (count > faces.size())
+        {
+            this->free_ranges.emplace(first + faces.size(), count - faces.size());
+        }
+
+        this->used_faces += faces.size();
+
+        // persistently mapped and coherent, nothing has to be flushed
+        std::memcpy(
+            static_cast<std::byte*>(this->buffer.getMappedPtr()) + first * sizeof(VoxelFace),
+            faces.data(),
+            faces.size_bytes());
+
+        return Allocation {*this, first, faces.size()};
+    }
+
+    const Buffer& VoxelFaceArena::getBuffer() const
+    {
+        return this->buffer;
+    }
+
+    std::size_t VoxelFaceArena::getCapacity() const
+    {
+        return this->capacity;
+    }
+
+    std::size_t VoxelFaceArena::getUsedFaces() const
+    {
+        return this->used_faces;
+    }
+
+    void VoxelFaceArena::release(std::size_t first, std::size_t count)
+    {
+        this->used_faces -= count;
+
+        auto [released, isInserted] = this->free_ranges.emplace(first, count);
+        seb::assertFatal(isInserted, "Released face range {} twice", first);
+
+        // merge with the free ranges right after and right before it
+        if (const auto next = std::next(released);
+            next != this->free_ranges.end() && released->first + released->second == next->first)
+        {
+            released->second += next->second;
+            this->free_ranges.erase(next);
+        }
+
+        if (released != this->free_ranges.begin())
+        {
+            if (const auto previous = std::prev(released); previous->first + previous->second == released->first)
+            {
+                previous->second += released->second;
+                this->free_ranges.erase(released);
+            }
+        }
+    }
+} // namespace render
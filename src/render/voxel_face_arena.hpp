@@ -0,0 +1,74 @@
+#ifndef SRC_RENDER_VOXEL__FACE__ARENA_HPP
+#define SRC_RENDER_VOXEL__FACE__ARENA_HPP
+
+#include <map>
+#include <optional>
+#include <span>
+
+#include "vulkan/buffer.hpp"
+#include "vulkan/gpu_structs.hpp"
+
+namespace render
+{
+    /// @brief One storage buffer that the faces of every voxel Object are
+    /// suballocated from, bound once for the whole frame. A draw picks its
+    /// range through firstVertex, six vertices per face.
+    ///
+    /// Ranges are first fit from a free list that merges neighbours as
+    /// they're released. The buffer never grows, allocating past its
+    /// capacity fails
+    class VoxelFaceArena
+    {
+    public:
+        /// @brief A range of faces, handed back to the arena on destruction.
+        /// Objects holding one are retired like any other, so a range is
+        /// never reused while a frame in flight still draws it
+        class Allocation
+        {
+        public:
+            Allocation(VoxelFaceArena&, std::size_t first, std::size_t count);
+            ~Allocation();
+
+            Allocation(const Allocation&)            = delete;
+            Allocation(Allocation&&);
+            Allocation& operator=(const Allocation&) = delete;
+            Allocation& operator=(Allocation&&);
+
+            [[nodiscard]] std::size_t getFirst() const;
+            [[nodiscard]] std::size_t getCount() const;
+
+        private:
+            VoxelFaceArena* arena;
+            std::size_t     first;
+            std::size_t     count;
+        }; // class Allocation
+
+        VoxelFaceArena(VmaAllocator, std::size_t capacityFaces);
+        ~VoxelFaceArena() = default;
+
+        VoxelFaceArena(const VoxelFaceArena&)            = delete;
+        VoxelFaceArena(VoxelFaceArena&&)                 = delete;
+        VoxelFaceArena& operator=(const VoxelFaceArena&) = delete;
+        VoxelFaceArena& operator=(VoxelFaceArena&&)      = delete;
+
+        /// @brief Copies @param faces into a free range, empty when there's
+        /// no range large enough left
+        [[nodiscard]] std::optional<Allocation> allocate(std::span<const VoxelFace> faces);
+
+        [[nodiscard]] const Buffer& getBuffer() const;
+        [[nodiscard]] std::size_t getCapacity() const;
+        [[nodiscard]] std::size_t getUsedFaces() const;
+
+    private:
+        void release(std::size_t first, std::size_t count);
+
+        Buffer      buffer;
+        std::size_t capacity;
+        std::size_t used_faces;
+
+        // first face -> count, never adjacent to each other
+        std::map<std::size_t, std::size_t> free_ranges;
+    }; // class VoxelFaceArena
+} // namespace render
+
+#endif // SRC_RENDER_VOXEL__FACE__ARENA_HPP
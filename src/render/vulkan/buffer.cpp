@@ -83,7 +83,19 @@ namespace render
             this->allocator == other.allocator,
             "Allocators were not the same"
         );
-        
+
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        // the buffer being replaced would otherwise leak
+        if (this->mapped_ptr)
+        {
+            vmaUnmapMemory(this->allocator, this->allocation);
+        }
+        vmaDestroyBuffer(this->allocator, this->buffer, this->allocation);
+
         this->buffer     = other.buffer;
         this->allocation = other.allocation;
         this->usage      = other.usage;
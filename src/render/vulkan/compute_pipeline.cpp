@@ -0,0 +1,124 @@
+#include <sebib/seblog.hpp>
+
+#include "gpu_structs.hpp"
+
+#include "compute_pipeline.hpp"
+
+namespace render
+{
+    ComputePipeline::ComputePipeline(vk::Device device, vk::UniqueShaderModule computeShader, std::string name_)
+        : name {std::move(name_)}
+    {
+        const vk::PipelineShaderStageCreateInfo computeCreateInfo {
+            .sType               {vk::StructureType::ePipelineShaderStageCreateInfo},
+            .pNext               {nullptr},
+            .flags               {},
+            .stage               {vk::ShaderStageFlagBits::eCompute},
+            .module              {*computeShader},
+            .pName               {"main"},
+            .pSpecializationInfo {nullptr},
+        };
+
+        const vk::PushConstantRange pushConstantsInformation {
+            .stageFlags {vk::ShaderStageFlagBits::eCompute},
+            .offset     {0},
+            .size       {sizeof(FarFieldPushConstants)},
+        };
+
+        const std::array<vk::DescriptorSetLayoutBinding, 3> descriptorSetBindings
+        {
+            // the brickmap
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {0},
+                .descriptorType     {vk::DescriptorType::eStorageBuffer},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eCompute},
+                .pImmutableSamplers {nullptr},
+            },
+            // color
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {1},
+                .descriptorType     {vk::DescriptorType::eStorageImage},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eCompute},
+                .pImmutableSamplers {nullptr},
+            },
+            // depth
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {2},
+                .descriptorType     {vk::DescriptorType::eStorageImage},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eCompute},
+                .pImmutableSamplers {nullptr},
+            },
+        };
+
+        const vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutInfo
+        {
+            .sType        {vk::StructureType::eDescriptorSetLayoutCreateInfo},
+            .pNext        {nullptr},
+            .flags        {},
+            .bindingCount {descriptorSetBindings.size()},
+            .pBindings    {descriptorSetBindings.data()},
+        };
+
+        this->descriptor_layout = device.createDescriptorSetLayoutUnique(descriptorSetLayoutInfo);
+
+        const vk::PipelineLayoutCreateInfo pipelineLayoutInfo {
+            .sType                  {vk::StructureType::ePipelineLayoutCreateInfo},
+            .pNext                  {nullptr},
+            .flags                  {},
+            .setLayoutCount         {1},
+            .pSetLayouts            {&*this->descriptor_layout},
+            .pushConstantRangeCount {1},
+            .pPushConstantRanges    {&pushConstantsInformation},
+        };
+
+        this->layout = device.createPipelineLayoutUnique(pipelineLayoutInfo);
+
+        const vk::ComputePipelineCreateInfo computePipelineCreateInfo {
+            .sType              {vk::StructureType::eComputePipelineCreateInfo},
+            .pNext              {nullptr},
+            .flags              {},
+            .stage              {computeCreateInfo},
+            .layout             {*this->layout},
+            .basePipelineHandle {nullptr},
+            .basePipelineIndex  {-1},
+        };
+
+        auto [result, maybeComputePipeline] = device.
+            createComputePipelineUnique(
+                nullptr, computePipelineCreateInfo);
+
+        seb::assertFatal(
+            result == vk::Result::eSuccess,
+            "Failed to create compute pipeline {}",
+            this->name
+        );
+
+        this->pipeline = std::move(maybeComputePipeline);
+    }
+
+    vk::Pipeline ComputePipeline::operator*() const
+    {
+        return *this->pipeline;
+    }
+
+    vk::PipelineLayout ComputePipeline::getLayout() const
+    {
+        return *this->layout;
+    }
+
+    vk::DescriptorSetLayout ComputePipeline::getDescriptorSetLayout() const
+    {
+        return *this->descriptor_layout;
+    }
+
+    const std::string& ComputePipeline::getName() const
+    {
+        return this->name;
+    }
+} // namespace render
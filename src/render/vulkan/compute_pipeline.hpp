@@ -0,0 +1,36 @@
+#ifndef SRC_RENDER_VULKAN_COMPUTE__PIPELINE_HPP
+#define SRC_RENDER_VULKAN_COMPUTE__PIPELINE_HPP
+
+#include "includes.hpp"
+
+namespace render
+{
+    /// @brief Pipeline's counterpart for compute shaders. Shaders are loaded
+    /// with Pipeline::createShaderFromFile(), the layout is voxel_march.comp's:
+    /// a storage buffer, two storage images and FarFieldPushConstants
+    class ComputePipeline
+    {
+    public:
+        ComputePipeline(vk::Device, vk::UniqueShaderModule computeShader, std::string name);
+        ~ComputePipeline()                                 = default;
+
+        ComputePipeline()                                  = delete;
+        ComputePipeline(const ComputePipeline&)            = delete;
+        ComputePipeline(ComputePipeline&&)                 = delete;
+        ComputePipeline& operator=(const ComputePipeline&) = delete;
+        ComputePipeline& operator=(ComputePipeline&&)      = delete;
+
+        [[nodiscard]] vk::Pipeline operator*() const;
+        [[nodiscard]] vk::PipelineLayout getLayout() const;
+        [[nodiscard]] vk::DescriptorSetLayout getDescriptorSetLayout() const;
+        [[nodiscard]] const std::string& getName() const;
+
+    private:
+        vk::UniqueDescriptorSetLayout descriptor_layout;
+        vk::UniquePipelineLayout      layout;
+        vk::UniquePipeline            pipeline;
+        std::string                   name;
+    }; // class ComputePipeline
+} // namespace render
+
+#endif // SRC_RENDER_VULKAN_COMPUTE__PIPELINE_HPP
@@ -6,11 +6,12 @@ namespace render
     DescriptorPool::DescriptorPool(
         vk::Device device_, 
         vk::DescriptorSetLayout layout_,
+        std::size_t numberOfSets,
         const std::vector<vk::DescriptorPoolSize>& pools
     )
         : device {device_}
         , layout {layout_}
-        , number_of_sets {pools.size()}
+        , number_of_sets {numberOfSets}
     {    
         const vk::DescriptorPoolCreateInfo poolCreateInfo
         {
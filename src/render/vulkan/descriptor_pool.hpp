@@ -10,9 +10,11 @@ namespace render
     {
     public:
 
+        /// @param numberOfSets sets of @param layout allocate() returns
         DescriptorPool(
             vk::Device, 
             vk::DescriptorSetLayout,
+            std::size_t numberOfSets,
             const std::vector<vk::DescriptorPoolSize>&
         );
         ~DescriptorPool()                                = default;
@@ -2,7 +2,7 @@
 
 #include "device.hpp"
 
-std::uint32_t findIndexOfGraphicsAndPresentQueue(vk::PhysicalDevice pD, vk::SurfaceKHR surface)
+std::uint32_t findIndexOfGraphicsAndPresentQueue(vk::PhysicalDevice pD, std::optional<vk::SurfaceKHR> surface)
 {
     std::uint32_t idx = 0;
 
@@ -18,7 +18,7 @@ std::uint32_t findIndexOfGraphicsAndPresentQueue(vk::PhysicalDevice pD, vk::Surf
             continue;
         }
 
-        if (!pD.getSurfaceSupportKHR(idx, surface))
+        if (surface.has_value() && !pD.getSurfaceSupportKHR(idx, *surface))
         {
             continue;
         }
@@ -55,7 +55,7 @@ vk::PhysicalDevice findBestDevice(const std::vector<vk::PhysicalDevice>& devices
 
 namespace render
 {
-    Device::Device(vk::Instance instance, vk::SurfaceKHR drawSurface)
+    Device::Device(vk::Instance instance, std::optional<vk::SurfaceKHR> drawSurface)
     {
         this->physical_device = findBestDevice(instance.enumeratePhysicalDevices());
         
@@ -74,13 +74,17 @@ namespace render
             }
         };
 
-        const std::vector<const char*> DeviceExtensions {
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+        std::vector<const char*> DeviceExtensions {
             #ifdef __APPLE__
                 VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME,
             #endif // __APPLE__
         };
 
+        if (drawSurface.has_value())
+        {
+            DeviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+
         vk::PhysicalDeviceFeatures deviceFeatures = {};
         deviceFeatures.samplerAnisotropy = true;
         deviceFeatures.fillModeNonSolid = true;
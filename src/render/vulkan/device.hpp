@@ -1,6 +1,8 @@
 #ifndef SRC_RENDER_VULKAN_DEVICE_HPP
 #define SRC_RENDER_VULKAN_DEVICE_HPP
 
+#include <optional>
+
 #include "includes.hpp"
 
 namespace render
@@ -11,7 +13,9 @@ namespace render
     {
     public:
     
-        Device(vk::Instance, vk::SurfaceKHR);
+        /// @param drawSurface the surface the render queue must be able to
+        /// present to, std::nullopt when rendering headless
+        Device(vk::Instance, std::optional<vk::SurfaceKHR> drawSurface);
         ~Device()                        = default;
 
         Device()                         = delete;
@@ -1,6 +1,8 @@
 #ifndef SRC_RENDER_GPU__STRUCTS_HPP
 #define SRC_RENDER_GPU__STRUCTS_HPP
 
+#include <cstddef>
+
 #include "includes.hpp"
 
 #pragma GCC diagnostic push
@@ -51,11 +53,54 @@ namespace render
 
     using Index = std::uint32_t;
 
+    /// @brief One quad of voxel faces, pulled out of a storage buffer by
+    /// voxel_face.vert six vertices at a time, so voxel objects need
+    /// neither vertex nor index buffers. Positions are chunk local, the
+    /// draw's model matrix places the chunk.
+    struct VoxelFace
+    {
+        // bits 0-14: x, y, z of the voxel holding the minimum corner, 5 each
+        // bits 15-24: width - 1, height - 1 along the face's axes, 5 each
+        // bits 25-27: world::Face
+        // bits 28-31: sky light in front of the face
+        std::uint32_t position_size_face;
+        // bits 0-15: the voxel
+        // bits 16-23: ambient occlusion of each corner, 2 bits from 0, fully
+        // occluded, to 3, open
+        // bit 24: split the quad along the 1-3 diagonal instead of 0-2
+        // bits 28-31: block light in front of the face
+        std::uint32_t voxel_occlusion;
+
+        [[nodiscard]] bool operator==(const VoxelFace&) const = default;
+    };
+    static_assert(sizeof(VoxelFace) == 8);
+
+    /// @brief inverse(transpose(mat3(model))), laid out like a std430 mat3,
+    /// every column padded to a vec4
+    using NormalMatrix = glm::mat3x4;
+    static_assert(sizeof(NormalMatrix) == 48);
+
     struct PushConstants
     {
-        glm::mat4 view_projection;
-        glm::mat4 model;
+        glm::mat4     view_projection;
+        // of the object's matrices in the model and normal matrix buffers
+        std::uint32_t model_index;
+    };
+    // the offsets the shaders' push_constant blocks give them
+    static_assert(offsetof(PushConstants, model_index) == 64);
+
+    /// @brief What voxel_march.comp needs besides the brickmap, within the
+    /// 128 bytes every device has for push constants
+    struct FarFieldPushConstants
+    {
+        glm::mat4 inverse_view_projection;
+        // the view projection's z and w rows, turn hits into depth
+        glm::vec4 depth_row;
+        glm::vec4 w_row;
+        // w: how far from the camera rays start
+        glm::vec4 camera_position;
     };
+    static_assert(sizeof(FarFieldPushConstants) <= 128);
 
     struct UniformBuffer
     {
@@ -158,6 +158,20 @@ namespace render
 
 
     void Image2D::copyFromBuffer(vk::CommandBuffer commandBuffer, const Buffer& buffer) const
+    {
+        const vk::BufferImageCopy region = this->getBufferCopy(buffer);
+
+        commandBuffer.copyBufferToImage(*buffer, this->image, this->layout, region);
+    }
+
+    void Image2D::copyToBuffer(vk::CommandBuffer commandBuffer, const Buffer& buffer) const
+    {
+        const vk::BufferImageCopy region = this->getBufferCopy(buffer);
+
+        commandBuffer.copyImageToBuffer(this->image, this->layout, *buffer, region);
+    }
+
+    vk::BufferImageCopy Image2D::getBufferCopy(const Buffer& buffer) const
     {
         std::size_t size_of_format;
         switch (this->format)
@@ -165,9 +179,15 @@ namespace render
             case vk::Format::eR32G32B32A32Sfloat:
                 size_of_format = 16;
                 break;
+            case vk::Format::eR16G16B16A16Sfloat:
+                size_of_format = 8;
+                break;
             case vk::Format::eR8G8B8A8Srgb:
                 size_of_format = 4;
                 break;
+            case vk::Format::eR32Sfloat:
+                size_of_format = 4;
+                break;
             case vk::Format::eD32Sfloat:
                 size_of_format = 4;
                 break;
@@ -184,36 +204,30 @@ namespace render
             buffer.sizeBytes()
         );
 
-        const std::array<vk::BufferImageCopy, 1> region
+        return vk::BufferImageCopy
         {
-            vk::BufferImageCopy
-            {
-                .bufferOffset      {0},
-                .bufferRowLength   {0},
-                .bufferImageHeight {0},
-                .imageSubresource  {
-                    vk::ImageSubresourceLayers
-                    {
-                        .aspectMask     {this->aspect},
-                        .mipLevel       {0},
-                        .baseArrayLayer {0},
-                        .layerCount     {1},
-                    }
-                },
-                .imageOffset       {},
-                .imageExtent       {
-                    vk::Extent3D
-                    {
-                        .width  {this->extent.width},
-                        .height {this->extent.height},
-                        .depth  {1}
-                    }
+            .bufferOffset      {0},
+            .bufferRowLength   {0},
+            .bufferImageHeight {0},
+            .imageSubresource  {
+                vk::ImageSubresourceLayers
+                {
+                    .aspectMask     {this->aspect},
+                    .mipLevel       {0},
+                    .baseArrayLayer {0},
+                    .layerCount     {1},
+                }
+            },
+            .imageOffset       {},
+            .imageExtent       {
+                vk::Extent3D
+                {
+                    .width  {this->extent.width},
+                    .height {this->extent.height},
+                    .depth  {1}
                 }
             }
         };
-
-        commandBuffer.copyBufferToImage(*buffer, this->image, this->layout, region);
-
     }
     
 } // namespace render
\ No newline at end of file
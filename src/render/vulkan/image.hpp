@@ -30,8 +30,13 @@ namespace render
             vk::PipelineStageFlags sourceStage, vk::PipelineStageFlags destinationStage,
             vk::AccessFlags sourceAccess, vk::AccessFlags destinationAccess);
         void copyFromBuffer(vk::CommandBuffer, const Buffer&) const;
+        /// @brief Every texel, row by row, in the image's current layout
+        void copyToBuffer(vk::CommandBuffer, const Buffer&) const;
 
     private:
+        /// @brief The whole image, @param buffer has to be exactly its size
+        [[nodiscard]] vk::BufferImageCopy getBufferCopy(const Buffer& buffer) const;
+
         vk::Image            image;
         vk::Extent2D         extent;
         vk::ImageAspectFlags aspect;
@@ -85,7 +85,7 @@
 
 namespace render
 {
-    Instance::Instance(PFN_vkGetInstanceProcAddr dynVkGetInstanceProcAddr)
+    Instance::Instance(PFN_vkGetInstanceProcAddr dynVkGetInstanceProcAddr, bool enablePresentation)
         : dyn_vk_get_instance_proc_addr {dynVkGetInstanceProcAddr}
     {
         const vk::DebugUtilsMessengerCreateInfoEXT debugMessengerCreateInfo
@@ -142,7 +142,7 @@ namespace render
         }();
 
         const std::vector<const char*> instanceExtensions =
-        []{
+        [enablePresentation]{
             std::vector<const char*> temp {}; 
 
             #ifdef __APPLE__
@@ -155,12 +155,15 @@ namespace render
                 temp.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
             #endif // VULKAN_INSTANCE_ENABLE_VALIDATION_LAYERS
 
-            auto vkfwRequiredExtensions = vkfw::getRequiredInstanceExtensions();
-            temp.insert(
-                temp.end(),
-                vkfwRequiredExtensions.begin(),
-                vkfwRequiredExtensions.end()
-            );
+            if (enablePresentation)
+            {
+                auto vkfwRequiredExtensions = vkfw::getRequiredInstanceExtensions();
+                temp.insert(
+                    temp.end(),
+                    vkfwRequiredExtensions.begin(),
+                    vkfwRequiredExtensions.end()
+                );
+            }
 
             return temp;
         }();
@@ -10,7 +10,9 @@ namespace render
     {
     public:
 
-        Instance(PFN_vkGetInstanceProcAddr);
+        /// @param enablePresentation requests the window system extensions,
+        /// false for headless rendering where no display is available
+        Instance(PFN_vkGetInstanceProcAddr, bool enablePresentation);
         ~Instance();
 
         Instance()                           = delete;
@@ -2,6 +2,8 @@
 
 #include <sebib/seblog.hpp>
 
+#include <util/profiler.hpp>
+
 #include "gpu_structs.hpp"
 
 #include "pipeline.hpp"
@@ -40,11 +42,15 @@ namespace render
 {
     vk::UniqueShaderModule Pipeline::createShaderFromFile(vk::Device device, const std::string& filePath)
     {
+        PROFILE_SCOPE("Pipeline::createShaderFromFile");
+
         return createShaderModuleFromSPIRV(device, loadFileAsBytes(filePath));
     }    
     
     Pipeline::Pipeline(vk::Device device, vk::RenderPass renderPass, vk::Extent2D swapchainExtent,
-        vk::UniqueShaderModule vertexShader, vk::UniqueShaderModule fragmentShader)
+        vk::UniqueShaderModule vertexShader, vk::UniqueShaderModule fragmentShader,
+        VertexInput vertexInput, std::string name_)
+        : name {std::move(name_)}
     {
         const vk::PipelineShaderStageCreateInfo vertexCreateInfo {
             .sType               {vk::StructureType::ePipelineShaderStageCreateInfo},
@@ -71,16 +77,18 @@ namespace render
             fragmentCreateInfo
         };
 
+        const bool hasAttributes = vertexInput == VertexInput::Attributes;
+
         const vk::PipelineVertexInputStateCreateInfo pipeVertexCreateInfo {
             .sType                           {
                 vk::StructureType::ePipelineVertexInputStateCreateInfo},
             .pNext                           {nullptr},
             .flags                           {},
-            .vertexBindingDescriptionCount   {1},
-            .pVertexBindingDescriptions      {Vertex::getBindingDescription()},
+            .vertexBindingDescriptionCount   {hasAttributes ? 1U : 0U},
+            .pVertexBindingDescriptions      {hasAttributes ? Vertex::getBindingDescription() : nullptr},
             .vertexAttributeDescriptionCount {
-                static_cast<std::uint32_t>(Vertex::getAttributeDescriptions()->size())},
-            .pVertexAttributeDescriptions    {Vertex::getAttributeDescriptions()->data()},
+                hasAttributes ? static_cast<std::uint32_t>(Vertex::getAttributeDescriptions()->size()) : 0U},
+            .pVertexAttributeDescriptions    {hasAttributes ? Vertex::getAttributeDescriptions()->data() : nullptr},
         };
 
         const vk::PipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo {
@@ -176,7 +184,7 @@ namespace render
             .size       {sizeof(PushConstants)},
         };
 
-        const std::array<vk::DescriptorSetLayoutBinding, 2> descriptorSetBindings
+        const std::array<vk::DescriptorSetLayoutBinding, 7> descriptorSetBindings
         {
             vk::DescriptorSetLayoutBinding
             {
@@ -193,7 +201,51 @@ namespace render
                 .descriptorCount    {1},
                 .stageFlags         {vk::ShaderStageFlagBits::eFragment},
                 .pImmutableSamplers {nullptr},
-            }
+            },
+            // voxel faces, see VoxelFaceArena
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {2},
+                .descriptorType     {vk::DescriptorType::eStorageBuffer},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eVertex},
+                .pImmutableSamplers {nullptr},
+            },
+            // far field color and depth, see FarField
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {3},
+                .descriptorType     {vk::DescriptorType::eStorageImage},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eFragment},
+                .pImmutableSamplers {nullptr},
+            },
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {4},
+                .descriptorType     {vk::DescriptorType::eStorageImage},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eFragment},
+                .pImmutableSamplers {nullptr},
+            },
+            // model matrices, see Renderer::writeModelMatrices()
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {5},
+                .descriptorType     {vk::DescriptorType::eStorageBuffer},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eVertex},
+                .pImmutableSamplers {nullptr},
+            },
+            // their normal matrices
+            vk::DescriptorSetLayoutBinding
+            {
+                .binding            {6},
+                .descriptorType     {vk::DescriptorType::eStorageBuffer},
+                .descriptorCount    {1},
+                .stageFlags         {vk::ShaderStageFlagBits::eVertex},
+                .pImmutableSamplers {nullptr},
+            },
         };
         
 
@@ -286,4 +338,9 @@ namespace render
         return *this->descriptor_layout;
     }
 
+    const std::string& Pipeline::getName() const
+    {
+        return this->name;
+    }
+
 } // namespace render
\ No newline at end of file
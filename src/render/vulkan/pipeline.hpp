@@ -9,10 +9,19 @@ namespace render
     {
     public:
         static vk::UniqueShaderModule createShaderFromFile(vk::Device, const std::string& filePath);
+        /// @brief Where the vertex shader gets its vertices from
+        enum class VertexInput
+        {
+            // render::Vertex attributes out of the bound vertex buffer
+            Attributes,
+            // nothing bound, the shader reads storage buffers by gl_VertexIndex
+            Pulled,
+        };
     public:
     
         Pipeline(vk::Device, vk::RenderPass, vk::Extent2D swapchainExtent,
-            vk::UniqueShaderModule vertexShader, vk::UniqueShaderModule fragmentShader);
+            vk::UniqueShaderModule vertexShader, vk::UniqueShaderModule fragmentShader,
+            VertexInput, std::string name);
         ~Pipeline()                          = default;
 
         Pipeline()                           = delete;
@@ -24,11 +33,13 @@ namespace render
         [[nodiscard]] vk::Pipeline operator*() const;
         [[nodiscard]] vk::PipelineLayout getLayout() const;
         [[nodiscard]] vk::DescriptorSetLayout getDescriptorSetLayout() const;
+        [[nodiscard]] const std::string& getName() const;
             
     private:
         vk::UniqueDescriptorSetLayout descriptor_layout;
         vk::UniquePipelineLayout      layout;
         vk::UniquePipeline            pipeline;
+        std::string                   name;
     }; // class Pipeline
 } // namespace render
 
@@ -5,19 +5,20 @@
 namespace render
 {
 
-    RenderPass::RenderPass(vk::Device device, const Swapchain& swapchain, const Image2D& depthBuffer)
+    RenderPass::RenderPass(vk::Device device, vk::Format colorFormat,
+        vk::ImageLayout colorFinalLayout, const Image2D& depthBuffer)
     {
         std::array<vk::AttachmentDescription, 2> attachments {
             vk::AttachmentDescription {
                 .flags          {},
-                .format         {swapchain.getSurfaceFormat().format},
+                .format         {colorFormat},
                 .samples        {vk::SampleCountFlagBits::e1},
                 .loadOp         {vk::AttachmentLoadOp::eClear},
                 .storeOp        {vk::AttachmentStoreOp::eStore},
                 .stencilLoadOp  {vk::AttachmentLoadOp::eDontCare},
                 .stencilStoreOp {vk::AttachmentStoreOp::eDontCare},
                 .initialLayout  {vk::ImageLayout::eUndefined},
-                .finalLayout    {vk::ImageLayout::ePresentSrcKHR},
+                .finalLayout    {colorFinalLayout},
             },
 
             vk::AttachmentDescription {
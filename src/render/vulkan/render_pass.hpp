@@ -3,7 +3,6 @@
 
 #include "includes.hpp"
 
-#include "swapchain.hpp"
 #include "image.hpp"
 
 namespace render
@@ -13,7 +12,10 @@ namespace render
     {
     public:
 
-        RenderPass(vk::Device, const Swapchain&, const Image2D& depthBuffer);
+        /// @param colorFinalLayout is ePresentSrcKHR when rendering to a
+        /// swapchain and eTransferSrcOptimal when rendering offscreen
+        RenderPass(vk::Device, vk::Format colorFormat, vk::ImageLayout colorFinalLayout,
+            const Image2D& depthBuffer);
         ~RenderPass()                            = default;
 
         RenderPass()                             = delete;
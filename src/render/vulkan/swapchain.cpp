@@ -4,7 +4,8 @@
 
 namespace render
 {
-    Swapchain::Swapchain(const Device& device, vk::SurfaceKHR surface, vk::Extent2D extent_)
+    Swapchain::Swapchain(const Device& device, vk::SurfaceKHR surface, vk::Extent2D extent_,
+        PresentPolicy policy)
         : extent {extent_} // TODO: do we need this extent?
     {
         const vk::SurfaceFormatKHR idealSurfaceFormat
@@ -44,15 +45,49 @@ namespace render
 
         const std::vector<vk::PresentModeKHR> availablePresentModes =
             device.asPhysicalDevice().getSurfacePresentModesKHR(surface);
-        const vk::PresentModeKHR selectedPresentMode = std::find(
+        const vk::PresentModeKHR desiredPresentMode = [&]
+        {
+            switch (policy.mode)
+            {
+                case PresentMode::Immediate:   return vk::PresentModeKHR::eImmediate;
+                case PresentMode::Mailbox:     return vk::PresentModeKHR::eMailbox;
+                case PresentMode::Fifo:        return vk::PresentModeKHR::eFifo;
+                case PresentMode::FifoRelaxed: return vk::PresentModeKHR::eFifoRelaxed;
+            }
+            seb::panic("Unimplemented present mode");
+        }();
+
+        if (std::find(
                 availablePresentModes.cbegin(), 
                 availablePresentModes.cend(), 
-                vk::PresentModeKHR::eMailbox
-            ) != availablePresentModes.cend()
-            ? vk::PresentModeKHR::eMailbox
-            : vk::PresentModeKHR::eFifo;
+                desiredPresentMode
+            ) != availablePresentModes.cend())
+        {
+            this->present_mode = desiredPresentMode;
+        }
+        else
+        {
+            seb::logWarn("Present mode {} unavailable, falling back to Fifo",
+                vk::to_string(desiredPresentMode));
+            this->present_mode = vk::PresentModeKHR::eFifo;
+        }
+
+        // maxImageCount == 0 means there is no upper limit
+        const std::uint32_t maxImageCount = surfaceCapabilities.maxImageCount == 0
+            ? std::numeric_limits<std::uint32_t>::max()
+            : surfaceCapabilities.maxImageCount;
+        const std::uint32_t imageCount = std::clamp(
+            policy.image_count.value_or(surfaceCapabilities.minImageCount + 1),
+            surfaceCapabilities.minImageCount,
+            maxImageCount
+        );
+
+        if (policy.image_count.has_value() && *policy.image_count != imageCount)
+        {
+            seb::logWarn("Requested {} swapchain images, clamped to {}",
+                *policy.image_count, imageCount);
+        }
 
-        
         const std::array<std::uint32_t, 1> QueueFamilyIndicies {device.getRenderComputeTransferIndex()};
         const vk::SwapchainCreateInfoKHR SwapchainCreateInfoKHR
         {
@@ -60,11 +95,7 @@ namespace render
             .pNext   {nullptr},
             .flags   {},
             .surface {surface},
-            .minImageCount { // PERF: what
-                surfaceCapabilities.maxImageCount == 0 
-                ? surfaceCapabilities.minImageCount + 1
-                : surfaceCapabilities.maxImageCount
-            },
+            .minImageCount         {imageCount},
             .imageFormat           {this->format.format},
             .imageColorSpace       {this->format.colorSpace},
             .imageExtent           {this->extent},
@@ -75,7 +106,7 @@ namespace render
             .pQueueFamilyIndices   {QueueFamilyIndicies.data()},
             .preTransform          {surfaceCapabilities.currentTransform},
             .compositeAlpha        {vk::CompositeAlphaFlagBitsKHR::eOpaque},
-            .presentMode           {selectedPresentMode},
+            .presentMode           {this->present_mode},
             .clipped               {true},
             .oldSwapchain          {nullptr}
         };
@@ -133,6 +164,11 @@ namespace render
         return this->format;
     }
 
+    vk::PresentModeKHR Swapchain::getPresentMode() const
+    {
+        return this->present_mode;
+    }
+
     auto Swapchain::getImageViews() const
         -> const std::vector<vk::UniqueImageView>&
     {
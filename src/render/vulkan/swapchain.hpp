@@ -1,17 +1,37 @@
 #ifndef SRC_RENDER_VULKAN_SWAPCHAIN_HPP
 #define SRC_RENDER_VULKAN_SWAPCHAIN_HPP
 
+#include <optional>
+
 #include "includes.hpp"
 
 #include "device.hpp"
 
 namespace render
 {
+    enum class PresentMode
+    {
+        Immediate,   // uncapped, may tear; used for throughput benchmarks
+        Mailbox,     // uncapped, no tearing
+        Fifo,        // vsync, always available
+        FifoRelaxed, // vsync, tears when a frame is late
+    };
+
+    /// @brief How the swapchain should present images.
+    /// If @param mode isn't supported by the surface Fifo is used instead.
+    /// @param image_count is clamped to the surface's supported range,
+    /// std::nullopt picks the minimum + 1
+    struct PresentPolicy
+    {
+        PresentMode                  mode;
+        std::optional<std::uint32_t> image_count;
+    };
+
     class Swapchain
     {
     public:
 
-        Swapchain(const Device&, vk::SurfaceKHR, vk::Extent2D);
+        Swapchain(const Device&, vk::SurfaceKHR, vk::Extent2D, PresentPolicy);
         ~Swapchain()                           = default;
 
         Swapchain()                            = delete;
@@ -26,12 +46,15 @@ namespace render
 
         [[nodiscard]] vk::SurfaceFormatKHR getSurfaceFormat() const;
 
+        [[nodiscard]] vk::PresentModeKHR getPresentMode() const;
+
         [[nodiscard]] auto getImageViews() const
             -> const std::vector<vk::UniqueImageView>&;
 
     private:
         vk::Extent2D           extent;
         vk::SurfaceFormatKHR   format;
+        vk::PresentModeKHR     present_mode;
         vk::UniqueSwapchainKHR swapchain;
 
         std::vector<vk::Image> images;
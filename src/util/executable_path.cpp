@@ -0,0 +1,61 @@
+#include <array>
+#include <cstdint>
+#include <system_error>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#elif defined(__APPLE__)
+    #include <mach-o/dyld.h>
+#endif
+
+#include <sebib/seblog.hpp>
+
+#include "executable_path.hpp"
+
+namespace
+{
+    /// @brief Empty if the platform can't tell
+    std::filesystem::path getExecutablePath()
+    {
+#if defined(_WIN32)
+        std::array<wchar_t, 32768> path {};
+        const DWORD length = GetModuleFileNameW(nullptr, path.data(), static_cast<DWORD>(path.size()));
+
+        return length == 0 || length == path.size() ? std::filesystem::path {} : std::filesystem::path {path.data()};
+#elif defined(__APPLE__)
+        std::array<char, 4096> path {};
+        auto size = static_cast<std::uint32_t>(path.size());
+
+        return _NSGetExecutablePath(path.data(), &size) == 0 ? std::filesystem::path {path.data()}
+                                                             : std::filesystem::path {};
+#else
+        std::error_code error {};
+        std::filesystem::path path = std::filesystem::read_symlink("/proc/self/exe", error);
+
+        return error ? std::filesystem::path {} : path;
+#endif
+    }
+} // namespace
+
+namespace util
+{
+    std::filesystem::path getExecutableDirectory()
+    {
+        const std::filesystem::path path = getExecutablePath();
+
+        if (path.empty())
+        {
+            seb::logWarn("Couldn't find the executable, using the current directory instead");
+
+            return std::filesystem::current_path();
+        }
+
+        // macOS may hand back a path through symlinks or with ./ in it
+        std::error_code error {};
+        const std::filesystem::path resolved = std::filesystem::weakly_canonical(path, error);
+
+        return (error ? path : resolved).parent_path();
+    }
+} // namespace util
@@ -0,0 +1,14 @@
+#ifndef SRC_UTIL_EXECUTABLE__PATH_HPP
+#define SRC_UTIL_EXECUTABLE__PATH_HPP
+
+#include <filesystem>
+
+namespace util
+{
+    /// @brief The directory of the running executable, for files that belong
+    /// with the build rather than wherever it was launched from. The current
+    /// directory where the platform can't tell
+    [[nodiscard]] std::filesystem::path getExecutableDirectory();
+} // namespace util
+
+#endif // SRC_UTIL_EXECUTABLE__PATH_HPP
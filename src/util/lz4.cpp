@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "lz4.hpp"
+
+namespace
+{
+    constexpr std::size_t MinMatch = 4;
+    // the format requires the last 5 bytes to be literals and the last
+    // match to start at least 12 bytes before the end
+    constexpr std::size_t LastLiterals   = 5;
+    constexpr std::size_t MatchFindLimit = 12;
+    constexpr std::size_t MaxOffset      = 65535;
+    constexpr std::size_t TokenMax       = 15;
+
+    constexpr std::uint32_t HashLog = 12;
+
+    std::uint32_t read32(const std::byte* data)
+    {
+        std::uint32_t value = 0;
+        std::memcpy(&value, data, sizeof(value));
+
+        return value;
+    }
+
+    std::uint32_t hashSequence(std::uint32_t sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - HashLog);
+    }
+
+    /// @brief The part of a length that didn't fit in its token nibble
+    void writeLength(std::vector<std::byte>& out, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            out.push_back(std::byte {255});
+        }
+
+        out.push_back(static_cast<std::byte>(length));
+    }
+
+    void writeSequence(
+        std::vector<std::byte>& out,
+        std::span<const std::byte> literals,
+        std::size_t offset,
+        std::size_t matchLength)
+    {
+        const bool        isLast    = matchLength == 0;
+        const std::size_t matchCode = isLast ? 0 : matchLength - MinMatch;
+
+        out.push_back(static_cast<std::byte>(
+            (std::min(literals.size(), TokenMax) << 4) | std::min(matchCode, TokenMax)));
+
+        if (literals.size() >= TokenMax)
+        {
+            writeLength(out, literals.size() - TokenMax);
+        }
+
+        out.insert(out.end(), literals.begin(), literals.end());
+
+        if (isLast)
+        {
+            return;
+        }
+
+        out.push_back(static_cast<std::byte>(offset & 0xFF));
+        out.push_back(static_cast<std::byte>(offset >> 8));
+
+        if (matchCode >= TokenMax)
+        {
+            writeLength(out, matchCode - TokenMax);
+        }
+    }
+} // namespace
+
+namespace util::lz4
+{
+    std::vector<std::byte> compress(std::span<const std::byte> source)
+    {
+        std::vector<std::byte> out {};
+        out.reserve(source.size() + source.size() / 255 + 16);
+
+        const std::byte*  data   = source.data();
+        const std::size_t size   = source.size();
+        std::size_t       anchor = 0;
+
+        if (size > MatchFindLimit)
+        {
+            // last position + 1 of each hashed 4 byte sequence, 0 when empty
+            std::array<std::uint32_t, std::size_t {1} << HashLog> table {};
+
+            const std::size_t matchEnd = size - LastLiterals;
+            std::size_t       position = 0;
+
+            while (position < size - MatchFindLimit)
+            {
+                const std::uint32_t sequence  = read32(data + position);
+                std::uint32_t&      slot      = table[hashSequence(sequence)];
+                const std::size_t   candidate = slot;
+
+                slot = static_cast<std::uint32_t>(position + 1);
+
+                if (candidate == 0
+                    || position + 1 - candidate > MaxOffset
+                    || read32(data + candidate - 1) != sequence)
+                {
+                    // step further the longer nothing has matched
+                    position += 1 + ((position - anchor) >> 6);
+                    continue;
+                }
+
+                const std::size_t matchStart = candidate - 1;
+                std::size_t       length     = MinMatch;
+
+                while (position + length < matchEnd && data[matchStart + length] == data[position + length])
+                {
+                    ++length;
+                }
+
+                writeSequence(out, source.subspan(anchor, position - anchor), position - matchStart, length);
+
+                position += length;
+                anchor    = position;
+            }
+        }
+
+        writeSequence(out, source.subspan(anchor), 0, 0);
+
+        return out;
+    }
+
+    bool decompress(std::span<const std::byte> compressed, std::span<std::byte> out)
+    {
+        std::size_t in      = 0;
+        std::size_t written = 0;
+
+        const auto readLength = [&](std::size_t& length)
+        {
+            while (in < compressed.size())
+            {
+                const auto extra = std::to_integer<std::size_t>(compressed[in++]);
+                length += extra;
+
+                if (extra != 255)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+        while (in < compressed.size())
+        {
+            const auto token = std::to_integer<std::size_t>(compressed[in++]);
+
+            std::size_t literals = token >> 4;
+
+            if (literals == TokenMax && !readLength(literals))
+            {
+                return false;
+            }
+
+            if (literals > compressed.size() - in || literals > out.size() - written)
+            {
+                return false;
+            }
+
+            if (literals != 0)
+            {
+                std::memcpy(out.data() + written, compressed.data() + in, literals);
+            }
+            in      += literals;
+            written += literals;
+
+            // only the last sequence ends without a match
+            if (in == compressed.size())
+            {
+                break;
+            }
+
+            if (compressed.size() - in < 2)
+            {
+                return false;
+            }
+
+            const std::size_t offset = std::to_integer<std::size_t>(compressed[in])
+                | (std::to_integer<std::size_t>(compressed[in + 1]) << 8);
+            in += 2;
+
+            std::size_t length = (token & TokenMax) + MinMatch;
+
+            if ((token & TokenMax) == TokenMax && !readLength(length))
+            {
+                return false;
+            }
+
+            if (offset == 0 || offset > written || length > out.size() - written)
+            {
+                return false;
+            }
+
+            if (offset >= length)
+            {
+                std::memcpy(out.data() + written, out.data() + written - offset, length);
+            }
+            else
+            {
+                // overlapping, repeats the last offset bytes
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    out[written + i] = out[written + i - offset];
+                }
+            }
+
+            written += length;
+        }
+
+        return written == out.size();
+    }
+} // namespace util::lz4
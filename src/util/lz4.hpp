@@ -0,0 +1,21 @@
+#ifndef SRC_UTIL_LZ4_HPP
+#define SRC_UTIL_LZ4_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/// Compression in the LZ4 block format.
+/// A greedy single probe matcher, it trades ratio for speed the same way
+/// LZ4's default level does and its output decodes with any LZ4 block
+/// decoder. The size of the original data isn't stored, callers keep it.
+namespace util::lz4
+{
+    [[nodiscard]] std::vector<std::byte> compress(std::span<const std::byte> source);
+
+    /// @brief Decodes @param compressed into exactly @param out's size
+    /// bytes, false if the data is malformed or decodes to any other size
+    [[nodiscard]] bool decompress(std::span<const std::byte> compressed, std::span<std::byte> out);
+} // namespace util::lz4
+
+#endif // SRC_UTIL_LZ4_HPP
@@ -0,0 +1,297 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <x86intrin.h>
+    #define PROFILER_USE_RDTSC
+#endif
+
+#include <fmt/format.h>
+
+#include <sebib/seblog.hpp>
+
+#include "profiler.hpp"
+
+namespace
+{
+    struct Event
+    {
+        const char*   name;
+        std::uint64_t start_ticks;
+        std::uint64_t end_ticks;
+    };
+
+    /// Events are written without locking, a block is only ever appended to
+    /// by its owning thread and readers only look at the first `count` events
+    struct EventBlock
+    {
+        constexpr static std::size_t Capacity = 4096;
+        // per thread, about 6 MiB, the oldest block is reused after that
+        constexpr static std::size_t MaxBlocks = 64;
+
+        std::array<Event, Capacity> events;
+        std::atomic<std::size_t>    count {0};
+    };
+
+    struct ThreadBuffer
+    {
+        std::uint32_t thread_id;
+
+        // guards the block list and the thread name, not the events
+        std::mutex                               lock;
+        std::string                              thread_name;
+        std::vector<std::unique_ptr<EventBlock>> blocks;
+        EventBlock*                              current_block;
+
+        // the owning thread may still be writing to the current block so
+        // clear() only hides its first events instead of freeing it
+        std::size_t cleared_events;
+        // lost to reused blocks since the last clear()
+        std::size_t overwritten_events;
+    };
+
+    struct Registry
+    {
+        std::mutex                                 lock;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        // pairs of ticks and wall time used to convert ticks to microseconds
+        const std::uint64_t                         epoch_ticks {util::readProfilerTicks()};
+        const std::chrono::steady_clock::time_point epoch_time  {std::chrono::steady_clock::now()};
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry {};
+        return registry;
+    }
+
+    // Fixes the epoch at startup, before any zone can begin
+    [[maybe_unused]] const Registry& StartupRegistry = getRegistry();
+
+    ThreadBuffer* registerThread()
+    {
+        Registry& registry = getRegistry();
+        std::unique_lock lock {registry.lock};
+
+        // buffers live as long as the registry so zones from threads that
+        // have already exited still show up in dumps
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->thread_id          = static_cast<std::uint32_t>(registry.buffers.size());
+        buffer->thread_name        = fmt::format("Thread {}", buffer->thread_id);
+        buffer->blocks.push_back(std::make_unique<EventBlock>());
+        buffer->current_block      = buffer->blocks.back().get();
+        buffer->cleared_events     = 0;
+        buffer->overwritten_events = 0;
+
+        registry.buffers.push_back(std::move(buffer));
+
+        return registry.buffers.back().get();
+    }
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        // constant initialized so access doesn't need a guard
+        thread_local ThreadBuffer* buffer = nullptr;
+
+        if (buffer == nullptr) [[unlikely]]
+        {
+            buffer = registerThread();
+        }
+
+        return *buffer;
+    }
+
+    std::string escapeJson(std::string_view string)
+    {
+        std::string escaped;
+        escaped.reserve(string.size());
+
+        for (const char c : string)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+                escaped += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                escaped += fmt::format("\\u{:04x}", static_cast<unsigned int>(c));
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+
+        return escaped;
+    }
+} // namespace
+
+namespace util
+{
+    std::uint64_t readProfilerTicks()
+    {
+        #ifdef PROFILER_USE_RDTSC
+            return __rdtsc();
+        #else
+            return static_cast<std::uint64_t>(
+                std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif // PROFILER_USE_RDTSC
+    }
+
+    ProfileZone::~ProfileZone()
+    {
+        const std::uint64_t endTicks = readProfilerTicks();
+        ThreadBuffer& buffer = getThreadBuffer();
+
+        std::size_t index = buffer.current_block->count.load(std::memory_order_relaxed);
+
+        if (index == EventBlock::Capacity) [[unlikely]]
+        {
+            std::unique_lock lock {buffer.lock};
+
+            if (buffer.blocks.size() < EventBlock::MaxBlocks)
+            {
+                buffer.blocks.push_back(std::make_unique<EventBlock>());
+            }
+            else
+            {
+                // keeps the latest zones, a session left running can't grow
+                // without bound
+                std::unique_ptr<EventBlock> oldest = std::move(buffer.blocks.front());
+                buffer.blocks.erase(buffer.blocks.begin());
+
+                buffer.overwritten_events +=
+                    oldest->count.load(std::memory_order_relaxed) - buffer.cleared_events;
+                buffer.cleared_events = 0;
+                oldest->count.store(0, std::memory_order_relaxed);
+
+                buffer.blocks.push_back(std::move(oldest));
+            }
+
+            buffer.current_block = buffer.blocks.back().get();
+            index = 0;
+        }
+
+        buffer.current_block->events[index] = Event {
+            .name        {this->name},
+            .start_ticks {this->start_ticks},
+            .end_ticks   {endTicks},
+        };
+        buffer.current_block->count.store(index + 1, std::memory_order_release);
+    }
+
+    namespace profiler
+    {
+        void setThreadName(std::string name)
+        {
+            ThreadBuffer& buffer = getThreadBuffer();
+
+            std::unique_lock lock {buffer.lock};
+            buffer.thread_name = std::move(name);
+        }
+
+        void dumpChromeTrace(const std::string& filepath)
+        {
+            #ifndef DYNAMO_PROFILING
+                seb::logWarn("Dumping a trace from a build without DYNAMO_PROFILING, it will be empty");
+            #endif // DYNAMO_PROFILING
+
+            Registry& registry = getRegistry();
+            std::unique_lock registryLock {registry.lock};
+
+            // Measured now rather than assumed so it works on any tsc frequency
+            const double ticksPerMicrosecond =
+                static_cast<double>(readProfilerTicks() - registry.epoch_ticks) /
+                std::chrono::duration<double, std::micro> {
+                    std::chrono::steady_clock::now() - registry.epoch_time
+                }.count();
+
+            const auto toMicroseconds = [&](std::uint64_t ticks) -> double
+            {
+                return static_cast<double>(static_cast<std::int64_t>(ticks - registry.epoch_ticks)) /
+                    ticksPerMicrosecond;
+            };
+
+            std::ofstream fileStream {filepath, std::ios::out | std::ios::trunc};
+            seb::assertFatal(fileStream.is_open(), "Failed to open trace file [{}]", filepath);
+
+            fileStream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+            bool isFirstEvent = true;
+            std::size_t numberOfEvents = 0;
+            std::size_t overwrittenEvents = 0;
+            const auto writeEvent = [&](const std::string& event)
+            {
+                fileStream << (isFirstEvent ? "" : ",\n") << event;
+                isFirstEvent = false;
+            };
+
+            for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers)
+            {
+                std::unique_lock bufferLock {buffer->lock};
+
+                writeEvent(fmt::format(
+                    R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{}"}}}})",
+                    buffer->thread_id,
+                    escapeJson(buffer->thread_name)
+                ));
+
+                overwrittenEvents += buffer->overwritten_events;
+
+                for (std::size_t b = 0; b < buffer->blocks.size(); ++b)
+                {
+                    const EventBlock& block = *buffer->blocks.at(b);
+                    const std::size_t count = block.count.load(std::memory_order_acquire);
+                    const std::size_t first = b == 0 ? buffer->cleared_events : 0;
+
+                    for (std::size_t i = first; i < count; ++i)
+                    {
+                        const Event& e = block.events.at(i);
+
+                        writeEvent(fmt::format(
+                            R"({{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                            escapeJson(e.name),
+                            buffer->thread_id,
+                            toMicroseconds(e.start_ticks),
+                            toMicroseconds(e.end_ticks) - toMicroseconds(e.start_ticks)
+                        ));
+                    }
+
+                    numberOfEvents += count - std::min(first, count);
+                }
+            }
+
+            fileStream << "\n]}\n";
+
+            seb::logLog("Wrote {} profiler zones to {}", numberOfEvents, filepath);
+
+            if (overwrittenEvents != 0)
+            {
+                seb::logWarn("{} older zones were overwritten, only the latest are kept", overwrittenEvents);
+            }
+        }
+
+        void clear()
+        {
+            Registry& registry = getRegistry();
+            std::unique_lock registryLock {registry.lock};
+
+            for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers)
+            {
+                std::unique_lock bufferLock {buffer->lock};
+
+                buffer->blocks.erase(buffer->blocks.begin(), buffer->blocks.end() - 1);
+                buffer->cleared_events     = buffer->blocks.front()->count.load(std::memory_order_acquire);
+                buffer->overwritten_events = 0;
+            }
+        }
+    } // namespace profiler
+} // namespace util
@@ -0,0 +1,63 @@
+#ifndef SRC_UTIL_PROFILER_HPP
+#define SRC_UTIL_PROFILER_HPP
+
+#include <cstdint>
+#include <string>
+
+/// CPU instrumentation zones.
+/// PROFILE_SCOPE("name") times the rest of the enclosing scope into a buffer
+/// owned by the calling thread, dumpChromeTrace writes every thread's zones
+/// in the Chrome / Perfetto trace event format. Each thread keeps only its
+/// latest quarter million or so zones, older ones are overwritten. Names
+/// must be string literals, they are stored as pointers.
+/// Building without DYNAMO_PROFILING compiles every zone out entirely.
+#ifdef DYNAMO_PROFILING
+    #define PROFILE_CONCATENATE_IMPL(a, b) a##b
+    #define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_IMPL(a, b)
+    #define PROFILE_SCOPE(name) \
+        const ::util::ProfileZone PROFILE_CONCATENATE(profile_zone_, __LINE__) {name}
+#else
+    #define PROFILE_SCOPE(name) static_cast<void>(0)
+#endif // DYNAMO_PROFILING
+
+namespace util
+{
+    /// @brief Raw timestamp, rdtsc on x86-64 and steady_clock elsewhere
+    [[nodiscard]] std::uint64_t readProfilerTicks();
+
+    class ProfileZone
+    {
+    public:
+
+        explicit ProfileZone(const char* name_)
+            : name        {name_}
+            , start_ticks {readProfilerTicks()}
+        {}
+        ~ProfileZone();
+
+        ProfileZone()                              = delete;
+        ProfileZone(const ProfileZone&)            = delete;
+        ProfileZone(ProfileZone&&)                 = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+        ProfileZone& operator=(ProfileZone&&)      = delete;
+
+    private:
+        const char*   name;
+        std::uint64_t start_ticks;
+    }; // class ProfileZone
+
+    namespace profiler
+    {
+        /// @brief Label for the calling thread in dumped traces
+        void setThreadName(std::string);
+
+        /// @brief Writes all recorded zones to @param filepath, loadable by
+        /// chrome://tracing and ui.perfetto.dev
+        void dumpChromeTrace(const std::string& filepath);
+
+        /// @brief Discards all recorded zones
+        void clear();
+    } // namespace profiler
+} // namespace util
+
+#endif // SRC_UTIL_PROFILER_HPP
@@ -0,0 +1,85 @@
+#ifndef SRC_UTIL_TRIPLE__BUFFER_HPP
+#define SRC_UTIL_TRIPLE__BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace util
+{
+    /// @brief Hands whole values from one writer thread to one reader thread
+    /// without either ever waiting on the other.
+    ///
+    /// The writer fills the back buffer and publishes it, swapping it with
+    /// the middle one. The reader swaps the middle buffer for its front one
+    /// whenever something new was published. Values published in between
+    /// two acquire() are skipped, never torn, and buffers are reused rather
+    /// than reallocated, so the writer finds its previous contents in the
+    /// back buffer two publishes later.
+    template<class T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer()
+            : buffers {}
+            , back {0}
+            , middle {1}
+            , front {2}
+        {}
+        ~TripleBuffer() = default;
+
+        TripleBuffer(const TripleBuffer&)            = delete;
+        TripleBuffer(TripleBuffer&&)                 = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(TripleBuffer&&)      = delete;
+
+        /// @brief Writer only
+        [[nodiscard]] T& getBack()
+        {
+            return this->buffers[this->back];
+        }
+
+        /// @brief Writer only, the back buffer becomes the newest value
+        void publish()
+        {
+            const std::uint8_t reclaimed = this->middle.exchange(
+                static_cast<std::uint8_t>(this->back | FreshBit), std::memory_order_acq_rel);
+
+            this->back = static_cast<std::uint8_t>(reclaimed & IndexMask);
+        }
+
+        /// @brief Reader only, true if a newer value was published since the
+        /// last call and is now the front buffer
+        bool acquire()
+        {
+            if ((this->middle.load(std::memory_order_relaxed) & FreshBit) == 0)
+            {
+                return false;
+            }
+
+            const std::uint8_t acquired = this->middle.exchange(this->front, std::memory_order_acq_rel);
+
+            this->front = static_cast<std::uint8_t>(acquired & IndexMask);
+
+            return true;
+        }
+
+        /// @brief Reader only
+        [[nodiscard]] const T& getFront() const
+        {
+            return this->buffers[this->front];
+        }
+
+    private:
+        constexpr static std::uint8_t IndexMask = 0b011;
+        // set in middle from publish() until acquire()
+        constexpr static std::uint8_t FreshBit  = 0b100;
+
+        std::array<T, 3>          buffers;
+        std::uint8_t              back;
+        std::atomic<std::uint8_t> middle;
+        std::uint8_t              front;
+    }; // class TripleBuffer
+} // namespace util
+
+#endif // SRC_UTIL_TRIPLE__BUFFER_HPP
@@ -0,0 +1,129 @@
+#include <algorithm>
+
+#include "profiler.hpp"
+#include "worker_pool.hpp"
+
+namespace util
+{
+    WorkerPool::WorkerPool(std::size_t workerCount)
+    {
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            this->workers.emplace_back([this](std::stop_token stopToken)
+            {
+                this->work(stopToken);
+            });
+        }
+    }
+
+    void WorkerPool::run(std::size_t tasks, const std::function<void(std::size_t)>& task)
+    {
+        if (this->workers.empty() || tasks <= 1)
+        {
+            for (std::size_t i = 0; i < tasks; ++i)
+            {
+                task(i);
+            }
+
+            return;
+        }
+
+        Job job {
+            .task             {&task},
+            .tasks            {tasks},
+            .next_task        {0},
+            .unfinished_tasks {tasks},
+            .active_workers   {0},
+        };
+
+        {
+            std::lock_guard lock {this->mutex};
+            this->jobs.push_back(&job);
+        }
+
+        this->job_started.notify_all();
+        this->drain(job);
+
+        std::unique_lock lock {this->mutex};
+
+        // workers still inside drain() would read the job after it's gone
+        this->job_finished.wait(lock, [&]
+        {
+            return job.unfinished_tasks == 0 && job.active_workers == 0;
+        });
+
+        this->jobs.erase(std::ranges::find(this->jobs, &job));
+    }
+
+    std::size_t WorkerPool::getWorkerCount() const
+    {
+        return this->workers.size();
+    }
+
+    void WorkerPool::drain(Job& job)
+    {
+        while (true)
+        {
+            const std::size_t i = job.next_task.fetch_add(1);
+
+            if (i >= job.tasks)
+            {
+                return;
+            }
+
+            (*job.task)(i);
+
+            std::lock_guard lock {this->mutex};
+
+            if (--job.unfinished_tasks == 0)
+            {
+                this->job_finished.notify_all();
+            }
+        }
+    }
+
+    WorkerPool::Job* WorkerPool::findJob() const
+    {
+        const auto found = std::ranges::find_if(this->jobs, [](const Job* job)
+        {
+            return job->next_task.load() < job->tasks;
+        });
+
+        return found == this->jobs.end() ? nullptr : *found;
+    }
+
+    void WorkerPool::work(std::stop_token stopToken)
+    {
+        profiler::setThreadName("Workers");
+
+        while (true)
+        {
+            Job* job = nullptr;
+            {
+                std::unique_lock lock {this->mutex};
+
+                const bool isStarted = this->job_started.wait(lock, stopToken, [&]
+                {
+                    job = this->findJob();
+                    return job != nullptr;
+                });
+
+                if (!isStarted)
+                {
+                    return;
+                }
+
+                ++job->active_workers;
+            }
+
+            this->drain(*job);
+
+            {
+                std::lock_guard lock {this->mutex};
+                --job->active_workers;
+            }
+
+            this->job_finished.notify_all();
+        }
+    }
+} // namespace util
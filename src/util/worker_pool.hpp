@@ -0,0 +1,70 @@
+#ifndef SRC_UTIL_WORKER__POOL_HPP
+#define SRC_UTIL_WORKER__POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+    /// @brief Threads shared by everything that splits its work into
+    /// independent tasks and waits for all of them, one pool for the whole
+    /// process rather than one per subsystem.
+    ///
+    /// Every call to run() is a job. The calling thread takes tasks of its
+    /// own job alongside the workers and returns once every task finished.
+    /// Several threads may run jobs at once, idle workers join the oldest
+    /// job with tasks left, so the cores are never oversubscribed.
+    class WorkerPool
+    {
+    public:
+        /// @param workers threads besides the ones calling run()
+        explicit WorkerPool(std::size_t workers);
+        ~WorkerPool() = default;
+
+        WorkerPool(const WorkerPool&)            = delete;
+        WorkerPool(WorkerPool&&)                 = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        WorkerPool& operator=(WorkerPool&&)      = delete;
+
+        /// @brief Calls @param task with every index below @param tasks, on
+        /// the workers and the calling thread, several at once
+        void run(std::size_t tasks, const std::function<void(std::size_t)>& task);
+
+        [[nodiscard]] std::size_t getWorkerCount() const;
+
+    private:
+        struct Job
+        {
+            const std::function<void(std::size_t)>* task;
+            std::size_t                              tasks;
+            std::atomic<std::size_t>                 next_task;
+            std::size_t                              unfinished_tasks;
+            std::size_t                              active_workers;
+        };
+
+        /// @brief Runs the job's tasks until none are left to take
+        void drain(Job&);
+        /// @brief The oldest job with tasks left, nullptr if there is none.
+        /// The mutex must be held
+        [[nodiscard]] Job* findJob() const;
+
+        void work(std::stop_token);
+
+        mutable std::mutex          mutex;
+        std::condition_variable_any job_started;
+        std::condition_variable_any job_finished;
+        // jobs being run, oldest first
+        std::vector<Job*>           jobs;
+
+        // last, so the workers are joined before anything they touch is destroyed
+        std::vector<std::jthread> workers;
+    }; // class WorkerPool
+} // namespace util
+
+#endif // SRC_UTIL_WORKER__POOL_HPP
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif // __AVX2__
+
+#include <util/profiler.hpp>
+
+#include "binary_mesher.hpp"
+
+namespace
+{
+    using world::Voxel;
+
+    constexpr std::size_t Padded = world::PaddedChunk::Extent;
+    constexpr std::size_t Extent = world::ChunkExtent;
+
+    // + 4 so the AVX2 paths can run over the end of the last row
+    using Columns = std::array<std::uint64_t, Padded * Padded + 4>;
+
+    /// Bit i of every column is padded coordinate i along the column's axis
+    /// x columns are indexed [z][y], y columns [z][x] and z columns [y][x]
+    /// so that the two scattered axes are contiguous in x
+    struct Occupancy
+    {
+        Columns x;
+        Columns y;
+        Columns z;
+    };
+
+    /// @brief Bit i set if voxel i of the 34 voxel @param row isn't air
+    std::uint64_t getOccupiedMask(const Voxel* row)
+    {
+#if defined(__AVX2__)
+        const __m256i zero  = _mm256_setzero_si256();
+        const __m256i first = _mm256_cmpeq_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row)), zero);
+        const __m256i second = _mm256_cmpeq_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + 16)), zero);
+
+        // packs interleaves 128 bit lanes, the permute puts them back in order
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(first, second), 0b11011000);
+        const auto air = static_cast<std::uint32_t>(_mm256_movemask_epi8(packed));
+
+        std::uint64_t mask = static_cast<std::uint64_t>(~air);
+#else
+        std::uint64_t mask = 0;
+
+        for (std::size_t i = 0; i < 32; ++i)
+        {
+            mask |= static_cast<std::uint64_t>(row[i] != world::AirVoxel) << i;
+        }
+#endif // __AVX2__
+
+        mask |= static_cast<std::uint64_t>(row[32] != world::AirVoxel) << 32;
+        mask |= static_cast<std::uint64_t>(row[33] != world::AirVoxel) << 33;
+
+        return mask;
+    }
+
+    /// @brief ORs bit @param bit into columns[x] for every x set in @param mask
+    void scatterBit(std::uint64_t* columns, std::uint64_t mask, std::uint64_t bit)
+    {
+#if defined(__AVX2__)
+        const __m256i broadcast = _mm256_set1_epi64x(static_cast<std::int64_t>(mask));
+        const __m256i one       = _mm256_set1_epi64x(1);
+        const __m256i shift     = _mm256_set1_epi64x(static_cast<std::int64_t>(bit));
+        __m256i       offsets   = _mm256_setr_epi64x(0, 1, 2, 3);
+
+        for (std::size_t x = 0; x < Padded; x += 4)
+        {
+            const __m256i bits = _mm256_sllv_epi64(
+                _mm256_and_si256(_mm256_srlv_epi64(broadcast, offsets), one), shift);
+            __m256i* target = reinterpret_cast<__m256i*>(columns + x);
+
+            _mm256_storeu_si256(target, _mm256_or_si256(_mm256_loadu_si256(target), bits));
+            offsets = _mm256_add_epi64(offsets, _mm256_set1_epi64x(4));
+        }
+#else
+        while (mask != 0)
+        {
+            columns[std::countr_zero(mask)] |= std::uint64_t {1} << bit;
+            mask &= mask - 1;
+        }
+#endif // __AVX2__
+    }
+
+    void buildOccupancy(Occupancy& occupancy, std::span<const Voxel> voxels)
+    {
+        occupancy.y.fill(0);
+        occupancy.z.fill(0);
+
+        for (std::size_t y = 0; y < Padded; ++y)
+        {
+            for (std::size_t z = 0; z < Padded; ++z)
+            {
+                const std::uint64_t mask = getOccupiedMask(voxels.data() + (y * Padded + z) * Padded);
+
+                occupancy.x[z * Padded + y] = mask;
+
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                scatterBit(occupancy.y.data() + z * Padded, mask, y);
+                scatterBit(occupancy.z.data() + y * Padded, mask, z);
+            }
+        }
+    }
+
+    /// @brief Writes the visible faces of every column, bit s is local
+    /// slice s. Positive faces have air at +1 along the column, negative at -1
+    void cullFaces(const Columns& columns, Columns& positive, Columns& negative)
+    {
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        const __m256i interior = _mm256_set1_epi64x(0xFFFFFFFF);
+
+        for (; i + 4 <= Padded * Padded; i += 4)
+        {
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.data() + i));
+
+            const __m256i p = _mm256_andnot_si256(_mm256_srli_epi64(c, 1), c);
+            const __m256i n = _mm256_andnot_si256(_mm256_slli_epi64(c, 1), c);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(positive.data() + i),
+                _mm256_and_si256(_mm256_srli_epi64(p, 1), interior));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(negative.data() + i),
+                _mm256_and_si256(_mm256_srli_epi64(n, 1), interior));
+        }
+#endif // __AVX2__
+
+        for (; i < Padded * Padded; ++i)
+        {
+            const std::uint64_t c = columns[i];
+
+            positive[i] = ((c & ~(c >> 1)) >> 1) & 0xFFFFFFFF;
+            negative[i] = ((c & ~(c << 1)) >> 1) & 0xFFFFFFFF;
+        }
+    }
+
+    struct MaterialPlane
+    {
+        Voxel                               voxel;
+        world::FaceOcclusion                occlusion;
+        world::PackedLight                  light;
+        std::array<std::uint32_t, Extent>   rows;
+    };
+
+    /// @brief The canonical greedy merge of meshGreedy on bit rows of a
+    /// single material, occlusion and light, consumes @param plane
+    void mergePlane(MaterialPlane& plane, world::Face face, std::size_t slice,
+        std::vector<world::GreedyQuad>& quads)
+    {
+        for (std::size_t v = 0; v < Extent; ++v)
+        {
+            while (plane.rows[v] != 0)
+            {
+                const std::uint32_t row   = plane.rows[v];
+                const auto          u     = static_cast<std::uint32_t>(std::countr_zero(row));
+                const auto          width = static_cast<std::uint32_t>(std::countr_one(row >> u));
+                const std::uint32_t run   = (width == 32 ? ~std::uint32_t {0} : (std::uint32_t {1} << width) - 1) << u;
+
+                std::size_t height = 1;
+                while (v + height < Extent && (plane.rows[v + height] & run) == run)
+                {
+                    plane.rows[v + height] &= ~run;
+                    ++height;
+                }
+
+                plane.rows[v] &= ~run;
+
+                quads.push_back(world::GreedyQuad {
+                    .face      {face},
+                    .slice     {static_cast<std::uint8_t>(slice)},
+                    .u         {static_cast<std::uint8_t>(u)},
+                    .v         {static_cast<std::uint8_t>(v)},
+                    .width     {static_cast<std::uint8_t>(width)},
+                    .height    {static_cast<std::uint8_t>(height)},
+                    .voxel     {plane.voxel},
+                    .occlusion {plane.occlusion},
+                    .light     {plane.light},
+                });
+            }
+        }
+    }
+} // namespace
+
+namespace world
+{
+    std::vector<GreedyQuad> meshBinary(const PaddedChunk& chunk, AmbientOcclusion ambientOcclusion)
+    {
+        PROFILE_SCOPE("meshBinary");
+
+        const std::span<const Voxel>       voxels = chunk.getVoxels();
+        const std::span<const PackedLight> lights = chunk.getLight();
+
+        Occupancy occupancy;
+        buildOccupancy(occupancy, voxels);
+
+        std::vector<GreedyQuad> quads {};
+        std::vector<MaterialPlane> materials {};
+
+        Columns positive;
+        Columns negative;
+
+        // [slice][v], bit u
+        std::array<std::array<std::uint32_t, Extent>, Extent> planes;
+
+        for (std::int32_t axis = 0; axis < 3; ++axis)
+        {
+            const Columns& columns = axis == 0 ? occupancy.x : axis == 1 ? occupancy.y : occupancy.z;
+            cullFaces(columns, positive, negative);
+
+            for (const Face face : {static_cast<Face>(2 * axis), static_cast<Face>(2 * axis + 1)})
+            {
+                const FaceAxes axes = getFaceAxes(face);
+                const Columns& faces = isPositive(face) ? positive : negative;
+
+                // see Occupancy for why y columns are transposed
+                const std::size_t uColumnStride = axis == 1 ? Padded : 1;
+                const std::size_t vColumnStride = axis == 1 ? 1 : Padded;
+
+                for (auto& plane : planes)
+                {
+                    plane.fill(0);
+                }
+
+                for (std::size_t v = 0; v < Extent; ++v)
+                {
+                    for (std::size_t u = 0; u < Extent; ++u)
+                    {
+                        std::uint64_t column = faces[(u + 1) * uColumnStride + (v + 1) * vColumnStride];
+
+                        while (column != 0)
+                        {
+                            planes[static_cast<std::size_t>(std::countr_zero(column))][v] |= std::uint32_t {1} << u;
+                            column &= column - 1;
+                        }
+                    }
+                }
+
+                const std::size_t normalStride = PaddedChunk::getStride(axes.normal);
+                const std::size_t uStride      = PaddedChunk::getStride(axes.u);
+                const std::size_t vStride      = PaddedChunk::getStride(axes.v);
+
+                for (std::size_t slice = 0; slice < Extent; ++slice)
+                {
+                    const std::size_t sliceBase = PaddedChunk::toPaddedIndex({0, 0, 0}) + slice * normalStride;
+                    materials.clear();
+
+                    // split the plane by material, occlusion and light
+                    for (std::size_t v = 0; v < Extent; ++v)
+                    {
+                        std::uint32_t row = planes[slice][v];
+
+                        while (row != 0)
+                        {
+                            const auto        u     = static_cast<std::size_t>(std::countr_zero(row));
+                            const std::size_t index = sliceBase + u * uStride + v * vStride;
+                            const Voxel       voxel = voxels[index];
+
+                            const std::size_t air = isPositive(face) ? index + normalStride : index - normalStride;
+
+                            const FaceOcclusion occlusion = ambientOcclusion == AmbientOcclusion::Bake
+                                ? getFaceOcclusion(voxels, air, uStride, vStride)
+                                : OpenFaceOcclusion;
+                            const PackedLight light = lights.empty() ? OpenSkyLight : lights[air];
+
+                            auto material = std::ranges::find_if(materials, [&](const MaterialPlane& m)
+                            {
+                                return m.voxel == voxel && m.occlusion == occlusion && m.light == light;
+                            });
+                            if (material == materials.end())
+                            {
+                                materials.push_back(MaterialPlane {
+                                    .voxel     {voxel},
+                                    .occlusion {occlusion},
+                                    .light     {light},
+                                    .rows      {},
+                                });
+                                material = materials.end() - 1;
+                            }
+
+                            material->rows[v] |= std::uint32_t {1} << u;
+                            row &= row - 1;
+                        }
+                    }
+
+                    for (MaterialPlane& material : materials)
+                    {
+                        mergePlane(material, face, slice, quads);
+                    }
+                }
+            }
+        }
+
+        return quads;
+    }
+} // namespace world
@@ -0,0 +1,22 @@
+#ifndef SRC_WORLD_BINARY__MESHER_HPP
+#define SRC_WORLD_BINARY__MESHER_HPP
+
+#include <vector>
+
+#include "greedy_mesher.hpp"
+
+namespace world
+{
+    /// @brief Same output as meshGreedy, up to quad order, computed on bit
+    /// masks instead of voxels.
+    ///
+    /// Occupancy along every axis is kept as one 64 bit column per padded
+    /// row, visible faces are a column and'ed with its own negated
+    /// neighbour shift, and merging runs on 32 bit rows of one material,
+    /// occlusion and light at a time using count trailing zeros. Column building and
+    /// face culling use AVX2 when the compiler targets it.
+    [[nodiscard]] std::vector<GreedyQuad> meshBinary(
+        const PaddedChunk&, AmbientOcclusion = AmbientOcclusion::Bake);
+} // namespace world
+
+#endif // SRC_WORLD_BINARY__MESHER_HPP
@@ -0,0 +1,595 @@
+#include <algorithm>
+
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "brickmap.hpp"
+
+namespace
+{
+    using world::Brickmap;
+    using world::ChunkCoordinate;
+    using world::LocalPosition;
+    using world::WorldPosition;
+
+    /// @brief Where @param octant of a node starts, children span
+    /// 2^@param childLevel chunks
+    ChunkCoordinate getOctantOffset(std::size_t octant, std::int32_t childLevel)
+    {
+        const std::int32_t size = 1 << childLevel;
+
+        return {
+            (octant & 1) != 0 ? size : 0,
+            (octant & 2) != 0 ? size : 0,
+            (octant & 4) != 0 ? size : 0,
+        };
+    }
+
+    /// @brief Brick slot of a grid, ordered like toLinearIndex
+    std::size_t toSlotIndex(LocalPosition brick)
+    {
+        return static_cast<std::size_t>(
+            brick.x | brick.z * Brickmap::BricksPerChunk | brick.y * Brickmap::BricksPerChunk * Brickmap::BricksPerChunk);
+    }
+
+    std::size_t toBitIndex(LocalPosition inBrick)
+    {
+        return static_cast<std::size_t>(
+            inBrick.x | inBrick.z * Brickmap::BrickExtent | inBrick.y * Brickmap::BrickExtent * Brickmap::BrickExtent);
+    }
+
+    /// @brief The position of @param local inside of its brick
+    LocalPosition toInBrickPosition(LocalPosition local)
+    {
+        return {
+            local.x % Brickmap::BrickExtent,
+            local.y % Brickmap::BrickExtent,
+            local.z % Brickmap::BrickExtent,
+        };
+    }
+
+    /// @brief Whether the boxes [@param min, @param max] and [@param first,
+    /// @param last] share a voxel
+    bool isOverlapping(WorldPosition min, WorldPosition max, WorldPosition first, WorldPosition last)
+    {
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            if (max[axis] < first[axis] || min[axis] > last[axis])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool isSet(const Brickmap::Brick& brick, std::size_t bit)
+    {
+        return (brick.occupancy[bit / 32] >> (bit % 32) & 1U) != 0;
+    }
+
+    /// @brief Fills @param grid from every voxel of a chunk, returns the
+    /// bricks that have to be allocated for it by slot
+    void buildGrid(
+        std::span<const world::Voxel, world::ChunkVolume> voxels,
+        std::array<std::uint32_t, Brickmap::BrickSlots>& grid,
+        std::vector<std::pair<std::size_t, Brickmap::Brick>>& bricks)
+    {
+        for (std::int32_t by = 0; by < Brickmap::BricksPerChunk; ++by)
+        {
+            for (std::int32_t bz = 0; bz < Brickmap::BricksPerChunk; ++bz)
+            {
+                for (std::int32_t bx = 0; bx < Brickmap::BricksPerChunk; ++bx)
+                {
+                    const LocalPosition brickPosition {bx, by, bz};
+                    const LocalPosition first = brickPosition * Brickmap::BrickExtent;
+
+                    Brickmap::Brick brick {};
+                    std::size_t     solid = 0;
+
+                    // top down, so the first solid voxel found is the topmost
+                    for (std::int32_t y = Brickmap::BrickExtent - 1; y >= 0; --y)
+                    {
+                        for (std::int32_t z = 0; z < Brickmap::BrickExtent; ++z)
+                        {
+                            for (std::int32_t x = 0; x < Brickmap::BrickExtent; ++x)
+                            {
+                                const world::Voxel voxel = voxels[world::toLinearIndex(first + LocalPosition {x, y, z})];
+
+                                if (voxel == world::AirVoxel)
+                                {
+                                    continue;
+                                }
+
+                                const std::size_t bit = toBitIndex({x, y, z});
+                                brick.occupancy[bit / 32] |= 1U << (bit % 32);
+
+                                if (solid == 0)
+                                {
+                                    brick.voxel = voxel;
+                                }
+
+                                ++solid;
+                            }
+                        }
+                    }
+
+                    std::uint32_t& slot = grid[toSlotIndex(brickPosition)];
+
+                    if (solid == 0)
+                    {
+                        slot = Brickmap::EmptySlot;
+                    }
+                    else if (solid == Brickmap::BrickVolume)
+                    {
+                        // drawn as one voxel either way
+                        slot = Brickmap::SolidSlotBit | brick.voxel;
+                    }
+                    else
+                    {
+                        bricks.emplace_back(toSlotIndex(brickPosition), brick);
+                    }
+                }
+            }
+        }
+    }
+} // namespace
+
+namespace world
+{
+    Brickmap::Brickmap()
+        : root {0}
+        , depth {0}
+        , origin {0, 0, 0}
+        , chunks {0}
+    {}
+
+    void Brickmap::setChunk(ChunkCoordinate coordinate, const Chunk& chunk)
+    {
+        PROFILE_SCOPE("Brickmap::setChunk");
+
+        const std::optional<Voxel> uniform = chunk.getUniformVoxel();
+
+        if (uniform == AirVoxel)
+        {
+            this->removeChunk(coordinate);
+            return;
+        }
+
+        this->growToInclude(coordinate);
+
+        std::uint32_t   node       = this->root;
+        ChunkCoordinate nodeOrigin = this->origin;
+
+        for (std::int32_t level = this->depth; level > 1; --level)
+        {
+            const std::size_t octant = getOctant(nodeOrigin, level, coordinate);
+
+            if (this->nodes.entries[node - 1].children[octant] == 0)
+            {
+                // allocating may move the node being written to
+                const std::uint32_t child = this->nodes.allocate(Node {}) + 1;
+                this->nodes.entries[node - 1].children[octant] = child;
+            }
+
+            node = this->nodes.entries[node - 1].children[octant];
+            nodeOrigin += getOctantOffset(octant, level - 1);
+        }
+
+        std::uint32_t& gridSlot = this->nodes.entries[node - 1].children[getOctant(nodeOrigin, 1, coordinate)];
+
+        if (gridSlot == 0)
+        {
+            gridSlot = this->grids.allocate(Grid {}) + 1;
+            ++this->chunks;
+        }
+        else
+        {
+            this->freeBricks(this->grids.entries[gridSlot - 1]);
+        }
+
+        Grid& grid = this->grids.entries[gridSlot - 1];
+
+        if (uniform.has_value())
+        {
+            grid.fill(SolidSlotBit | *uniform);
+            return;
+        }
+
+        std::vector<Voxel> unpacked (ChunkVolume);
+        chunk.unpack(std::span<Voxel, ChunkVolume> {unpacked.data(), ChunkVolume});
+
+        std::vector<std::pair<std::size_t, Brick>> newBricks {};
+        buildGrid(std::span<const Voxel, ChunkVolume> {unpacked.data(), ChunkVolume}, grid, newBricks);
+
+        for (const auto& [slot, brick] : newBricks)
+        {
+            grid[slot] = this->bricks.allocate(brick) + 1;
+        }
+    }
+
+    void Brickmap::removeChunk(ChunkCoordinate coordinate)
+    {
+        if (this->root == 0 || !this->isInside(coordinate))
+        {
+            return;
+        }
+
+        // every node on the way down and the octant taken out of it
+        std::vector<std::pair<std::uint32_t, std::size_t>> path {};
+
+        std::uint32_t   node       = this->root;
+        ChunkCoordinate nodeOrigin = this->origin;
+
+        for (std::int32_t level = this->depth; level >= 1; --level)
+        {
+            const std::size_t octant = getOctant(nodeOrigin, level, coordinate);
+            path.emplace_back(node, octant);
+
+            node = this->nodes.entries[node - 1].children[octant];
+
+            if (node == 0)
+            {
+                return;
+            }
+
+            nodeOrigin += getOctantOffset(octant, level - 1);
+        }
+
+        // node is now the grid
+        this->freeBricks(this->grids.entries[node - 1]);
+        this->grids.release(node - 1);
+        --this->chunks;
+
+        // nodes left without children go too, bottom up
+        for (auto step = path.rbegin(); step != path.rend(); ++step)
+        {
+            Node& parent = this->nodes.entries[step->first - 1];
+            parent.children[step->second] = 0;
+
+            if (std::ranges::any_of(parent.children, [](std::uint32_t child) { return child != 0; }))
+            {
+                return;
+            }
+
+            this->nodes.release(step->first - 1);
+        }
+
+        this->root  = 0;
+        this->depth = 0;
+    }
+
+    bool Brickmap::isSolid(WorldPosition position) const
+    {
+        const std::uint32_t slot = this->getSlot(position);
+
+        if (slot == EmptySlot || (slot & SolidSlotBit) != 0)
+        {
+            return slot != EmptySlot;
+        }
+
+        return isSet(this->bricks.entries[slot - 1], toBitIndex(toInBrickPosition(toLocalPosition(position))));
+    }
+
+    Voxel Brickmap::getVoxel(WorldPosition position) const
+    {
+        const std::uint32_t slot = this->getSlot(position);
+
+        if (slot == EmptySlot)
+        {
+            return AirVoxel;
+        }
+
+        if ((slot & SolidSlotBit) != 0)
+        {
+            return static_cast<Voxel>(slot & ~SolidSlotBit);
+        }
+
+        const Brick& brick = this->bricks.entries[slot - 1];
+
+        return isSet(brick, toBitIndex(toInBrickPosition(toLocalPosition(position))))
+            ? static_cast<Voxel>(brick.voxel)
+            : AirVoxel;
+    }
+
+    bool Brickmap::isEmpty(WorldPosition min, WorldPosition max) const
+    {
+        if (this->root == 0)
+        {
+            return true;
+        }
+
+        return this->isNodeEmpty(this->root, this->depth, this->origin, glm::min(min, max), glm::max(min, max));
+    }
+
+    std::size_t Brickmap::getGpuWordCount() const
+    {
+        return GpuHeaderWords
+            + this->nodes.entries.size() * 8
+            + this->grids.entries.size() * BrickSlots
+            + this->bricks.entries.size() * (BrickVolume / 32 + 1);
+    }
+
+    void Brickmap::writeGpuWords(std::span<std::uint32_t> words) const
+    {
+        PROFILE_SCOPE("Brickmap::writeGpuWords");
+
+        seb::assertFatal(
+            words.size() >= this->getGpuWordCount(),
+            "Brickmap needs {} words, got {}",
+            this->getGpuWordCount(),
+            words.size());
+
+        const std::size_t nodeOffset  = GpuHeaderWords;
+        const std::size_t gridOffset  = nodeOffset + this->nodes.entries.size() * 8;
+        const std::size_t brickOffset = gridOffset + this->grids.entries.size() * BrickSlots;
+
+        const std::array<std::uint32_t, GpuHeaderWords> header {
+            this->root,
+            static_cast<std::uint32_t>(this->depth),
+            static_cast<std::uint32_t>(this->origin.x),
+            static_cast<std::uint32_t>(this->origin.y),
+            static_cast<std::uint32_t>(this->origin.z),
+            static_cast<std::uint32_t>(nodeOffset),
+            static_cast<std::uint32_t>(gridOffset),
+            static_cast<std::uint32_t>(brickOffset),
+        };
+
+        auto out = std::ranges::copy(header, words.begin()).out;
+
+        for (const Node& node : this->nodes.entries)
+        {
+            out = std::ranges::copy(node.children, out).out;
+        }
+
+        for (const Grid& grid : this->grids.entries)
+        {
+            out = std::ranges::copy(grid, out).out;
+        }
+
+        for (const Brick& brick : this->bricks.entries)
+        {
+            out  = std::ranges::copy(brick.occupancy, out).out;
+            *out++ = brick.voxel;
+        }
+    }
+
+    Brickmap::Statistics Brickmap::getStatistics() const
+    {
+        std::vector<bool> isFree (this->grids.entries.size(), false);
+        for (std::uint32_t index : this->grids.free)
+        {
+            isFree[index] = true;
+        }
+
+        std::size_t solidSlots = 0;
+
+        for (std::size_t i = 0; i < this->grids.entries.size(); ++i)
+        {
+            if (isFree[i])
+            {
+                continue;
+            }
+
+            solidSlots += static_cast<std::size_t>(std::ranges::count_if(this->grids.entries[i], [](std::uint32_t slot)
+            {
+                return (slot & SolidSlotBit) != 0;
+            }));
+        }
+
+        return Statistics {
+            .chunks       {this->chunks},
+            .octree_nodes {this->nodes.getUsedCount()},
+            .octree_depth {this->depth},
+            .bricks       {this->bricks.getUsedCount()},
+            .solid_slots  {solidSlots},
+            .bytes        {this->getGpuWordCount() * sizeof(std::uint32_t)},
+        };
+    }
+
+    std::size_t Brickmap::getOctant(ChunkCoordinate origin, std::int32_t level, ChunkCoordinate chunk)
+    {
+        const ChunkCoordinate offset = chunk - origin;
+        const std::int32_t    shift  = level - 1;
+
+        return static_cast<std::size_t>(
+            (offset.x >> shift & 1) | (offset.y >> shift & 1) << 1 | (offset.z >> shift & 1) << 2);
+    }
+
+    bool Brickmap::isInside(ChunkCoordinate chunk) const
+    {
+        const ChunkCoordinate offset = chunk - this->origin;
+        const std::int32_t    size   = 1 << this->depth;
+
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            if (offset[axis] < 0 || offset[axis] >= size)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<std::uint32_t> Brickmap::findGrid(ChunkCoordinate coordinate) const
+    {
+        if (this->root == 0 || !this->isInside(coordinate))
+        {
+            return std::nullopt;
+        }
+
+        std::uint32_t   node       = this->root;
+        ChunkCoordinate nodeOrigin = this->origin;
+
+        for (std::int32_t level = this->depth; level >= 1; --level)
+        {
+            const std::size_t octant = getOctant(nodeOrigin, level, coordinate);
+
+            node = this->nodes.entries[node - 1].children[octant];
+
+            if (node == 0)
+            {
+                return std::nullopt;
+            }
+
+            nodeOrigin += getOctantOffset(octant, level - 1);
+        }
+
+        return node - 1;
+    }
+
+    std::uint32_t Brickmap::getSlot(WorldPosition position) const
+    {
+        const std::optional<std::uint32_t> grid = this->findGrid(toChunkCoordinate(position));
+
+        if (!grid.has_value())
+        {
+            return EmptySlot;
+        }
+
+        return this->grids.entries[*grid][toSlotIndex(toLocalPosition(position) / BrickExtent)];
+    }
+
+    void Brickmap::growToInclude(ChunkCoordinate chunk)
+    {
+        if (this->root == 0)
+        {
+            this->root   = this->nodes.allocate(Node {}) + 1;
+            this->depth  = 1;
+            this->origin = {chunk.x & ~1, chunk.y & ~1, chunk.z & ~1};
+        }
+
+        // each new root keeps the old one as the octant nearest to chunk
+        while (!this->isInside(chunk))
+        {
+            const std::int32_t size   = 1 << this->depth;
+            std::size_t        octant = 0;
+
+            for (glm::length_t axis = 0; axis < 3; ++axis)
+            {
+                if (chunk[axis] < this->origin[axis])
+                {
+                    this->origin[axis] -= size;
+                    octant |= std::size_t {1} << axis;
+                }
+            }
+
+            Node newRoot {};
+            newRoot.children[octant] = this->root;
+
+            this->root = this->nodes.allocate(newRoot) + 1;
+            ++this->depth;
+
+            seb::assertFatal(this->depth < 31, "Brickmap octree is too deep");
+        }
+    }
+
+    void Brickmap::freeBricks(Grid& grid)
+    {
+        for (std::uint32_t& slot : grid)
+        {
+            if (slot != EmptySlot && (slot & SolidSlotBit) == 0)
+            {
+                this->bricks.release(slot - 1);
+            }
+
+            slot = EmptySlot;
+        }
+    }
+
+    bool Brickmap::isNodeEmpty(
+        std::uint32_t   node,
+        std::int32_t    level,
+        ChunkCoordinate nodeOrigin,
+        WorldPosition   min,
+        WorldPosition   max) const
+    {
+        const WorldPosition first = toWorldPosition(nodeOrigin, {0, 0, 0});
+        const WorldPosition last  = toWorldPosition(nodeOrigin + ChunkCoordinate {1 << level}, {0, 0, 0}) - 1;
+
+        if (!isOverlapping(min, max, first, last))
+        {
+            return true;
+        }
+
+        const std::array<std::uint32_t, 8>& children = this->nodes.entries[node - 1].children;
+
+        for (std::size_t octant = 0; octant < children.size(); ++octant)
+        {
+            if (children[octant] == 0)
+            {
+                continue;
+            }
+
+            const ChunkCoordinate childOrigin = nodeOrigin + getOctantOffset(octant, level - 1);
+
+            const bool isChildEmpty = level == 1
+                ? this->isGridEmpty(this->grids.entries[children[octant] - 1], childOrigin, min, max)
+                : this->isNodeEmpty(children[octant], level - 1, childOrigin, min, max);
+
+            if (!isChildEmpty)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool Brickmap::isGridEmpty(const Grid& grid, ChunkCoordinate coordinate, WorldPosition min, WorldPosition max) const
+    {
+        const WorldPosition chunkOrigin = toWorldPosition(coordinate, {0, 0, 0});
+
+        if (!isOverlapping(min, max, chunkOrigin, chunkOrigin + (ChunkExtent - 1)))
+        {
+            return true;
+        }
+
+        const LocalPosition first = glm::max(min - chunkOrigin, LocalPosition {0});
+        const LocalPosition last  = glm::min(max - chunkOrigin, LocalPosition {ChunkExtent - 1});
+
+        for (std::int32_t by = first.y / BrickExtent; by <= last.y / BrickExtent; ++by)
+        {
+            for (std::int32_t bz = first.z / BrickExtent; bz <= last.z / BrickExtent; ++bz)
+            {
+                for (std::int32_t bx = first.x / BrickExtent; bx <= last.x / BrickExtent; ++bx)
+                {
+                    const LocalPosition brickOrigin = LocalPosition {bx, by, bz} * BrickExtent;
+                    const std::uint32_t slot        = grid[toSlotIndex({bx, by, bz})];
+
+                    if (slot == EmptySlot)
+                    {
+                        continue;
+                    }
+
+                    if ((slot & SolidSlotBit) != 0)
+                    {
+                        return false;
+                    }
+
+                    const Brick&        brick   = this->bricks.entries[slot - 1];
+                    const LocalPosition inFirst = glm::max(first - brickOrigin, LocalPosition {0});
+                    const LocalPosition inLast  = glm::min(last - brickOrigin, LocalPosition {BrickExtent - 1});
+
+                    for (std::int32_t y = inFirst.y; y <= inLast.y; ++y)
+                    {
+                        for (std::int32_t z = inFirst.z; z <= inLast.z; ++z)
+                        {
+                            for (std::int32_t x = inFirst.x; x <= inLast.x; ++x)
+                            {
+                                if (isSet(brick, toBitIndex({x, y, z})))
+                                {
+                                    return false;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+} // namespace world
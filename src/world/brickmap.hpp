@@ -0,0 +1,171 @@
+#ifndef SRC_WORLD_BRICKMAP_HPP
+#define SRC_WORLD_BRICKMAP_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "chunk.hpp"
+#include "voxel.hpp"
+
+namespace world
+{
+    /// @brief Which voxels of every loaded chunk are solid, compact enough
+    /// to keep the whole world in one GPU storage buffer, for drawing far
+    /// away terrain and answering spatial queries without the chunks.
+    ///
+    /// Three levels:
+    /// - a sparse octree over chunk coordinates whose leaves are chunks. It
+    ///   grows upwards whenever a chunk outside of it is added
+    /// - a grid per chunk of BricksPerChunk³ brick slots, each empty, solid
+    ///   and drawn as a single voxel or pointing at a brick
+    /// - bricks, a bit per voxel of a BrickExtent³ cube plus the voxel it
+    ///   is drawn as
+    ///
+    /// Air chunks and bricks store nothing and solid bricks only their
+    /// slot. setChunk() and removeChunk() only touch the chunk's grid,
+    /// its bricks and its path through the octree.
+    class Brickmap
+    {
+    public:
+        constexpr static std::int32_t BrickExtent    = 8;
+        constexpr static std::int32_t BricksPerChunk = ChunkExtent / BrickExtent;
+        constexpr static std::size_t  BrickSlots     = BricksPerChunk * BricksPerChunk * BricksPerChunk;
+        constexpr static std::size_t  BrickVolume    = BrickExtent * BrickExtent * BrickExtent;
+
+        /// @brief Brick slot values, anything else is a brick's index + 1
+        constexpr static std::uint32_t EmptySlot    = 0;
+        constexpr static std::uint32_t SolidSlotBit = 1U << 31;
+
+        /// @brief Bits are indexed like toLinearIndex, x fastest, then z,
+        /// then y
+        struct Brick
+        {
+            std::array<std::uint32_t, BrickVolume / 32> occupancy;
+            // the topmost solid voxel, what the brick looks like from above
+            std::uint32_t voxel;
+        };
+
+        struct Statistics
+        {
+            std::size_t  chunks;
+            std::size_t  octree_nodes;
+            std::int32_t octree_depth;
+            std::size_t  bricks;
+            std::size_t  solid_slots;
+            // every pool including free entries, as uploaded
+            std::size_t  bytes;
+        };
+
+        Brickmap();
+        ~Brickmap() = default;
+
+        Brickmap(const Brickmap&)            = delete;
+        Brickmap(Brickmap&&)                 = delete;
+        Brickmap& operator=(const Brickmap&) = delete;
+        Brickmap& operator=(Brickmap&&)      = delete;
+
+        /// @brief Replaces what is stored for the chunk at @param coordinate
+        void setChunk(ChunkCoordinate coordinate, const Chunk&);
+        void removeChunk(ChunkCoordinate);
+
+        [[nodiscard]] bool isSolid(WorldPosition) const;
+        /// @brief The voxel its brick is drawn as, air if it isn't solid
+        [[nodiscard]] Voxel getVoxel(WorldPosition) const;
+        /// @brief True if nothing in [@param min, @param max] is solid, empty
+        /// octants and bricks are skipped whole
+        [[nodiscard]] bool isEmpty(WorldPosition min, WorldPosition max) const;
+
+        /// @brief Everything as one array of 32 bit words:
+        ///
+        /// - 8 words of header: the root node's index + 1 (0 if nothing is
+        ///   stored), the octree's depth, the x y z of its minimum chunk and
+        ///   the offsets of the node, grid and brick arrays
+        /// - nodes of 8 words, one per octant ordered x | y << 1 | z << 2,
+        ///   each a node's index + 1 or, a level above the chunks, a grid's
+        ///   index + 1, 0 if the octant is empty
+        /// - grids of BrickSlots brick slots, ordered like toLinearIndex
+        /// - bricks of BrickVolume / 32 + 1 words, laid out like Brick
+        ///
+        /// Free entries are written too, nothing reachable points at them
+        [[nodiscard]] std::size_t getGpuWordCount() const;
+        void writeGpuWords(std::span<std::uint32_t> words) const;
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        constexpr static std::size_t GpuHeaderWords = 8;
+
+        struct Node
+        {
+            std::array<std::uint32_t, 8> children;
+        };
+        using Grid = std::array<std::uint32_t, BrickSlots>;
+
+        /// @brief The octant of the node at @param level spanning from
+        /// @param origin that holds @param chunk
+        [[nodiscard]] static std::size_t getOctant(ChunkCoordinate origin, std::int32_t level, ChunkCoordinate chunk);
+        [[nodiscard]] bool isInside(ChunkCoordinate) const;
+        /// @brief Index of the chunk's grid, nullopt if it has none
+        [[nodiscard]] std::optional<std::uint32_t> findGrid(ChunkCoordinate) const;
+        [[nodiscard]] std::uint32_t getSlot(WorldPosition) const;
+        /// @brief Grows the octree until it spans @param chunk
+        void growToInclude(ChunkCoordinate chunk);
+        void freeBricks(Grid&);
+
+        [[nodiscard]] bool isNodeEmpty(
+            std::uint32_t node,
+            std::int32_t level,
+            ChunkCoordinate origin,
+            WorldPosition min,
+            WorldPosition max) const;
+        [[nodiscard]] bool isGridEmpty(
+            const Grid&, ChunkCoordinate coordinate, WorldPosition min, WorldPosition max) const;
+
+        template<class T>
+        struct Pool
+        {
+            std::vector<T>             entries;
+            std::vector<std::uint32_t> free;
+
+            [[nodiscard]] std::uint32_t allocate(const T& value)
+            {
+                if (!this->free.empty())
+                {
+                    const std::uint32_t index = this->free.back();
+                    this->free.pop_back();
+                    this->entries[index] = value;
+                    return index;
+                }
+
+                this->entries.push_back(value);
+                return static_cast<std::uint32_t>(this->entries.size() - 1);
+            }
+
+            void release(std::uint32_t index)
+            {
+                this->free.push_back(index);
+            }
+
+            [[nodiscard]] std::size_t getUsedCount() const
+            {
+                return this->entries.size() - this->free.size();
+            }
+        };
+
+        Pool<Node>  nodes;
+        Pool<Grid>  grids;
+        Pool<Brick> bricks;
+
+        // index + 1, 0 while nothing is stored
+        std::uint32_t   root;
+        // the root spans 2^depth chunks along each axis from origin
+        std::int32_t    depth;
+        ChunkCoordinate origin;
+        std::size_t     chunks;
+    }; // class Brickmap
+} // namespace world
+
+#endif // SRC_WORLD_BRICKMAP_HPP
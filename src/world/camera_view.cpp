@@ -0,0 +1,58 @@
+#include "camera_view.hpp"
+
+namespace world
+{
+    ChunkPrioritizer::ChunkPrioritizer(const CameraView& view)
+        : position {view.position}
+    {
+        const glm::mat4& m = view.view_projection;
+
+        const auto row = [&](glm::length_t i)
+        {
+            return glm::vec4 {m[0][i], m[1][i], m[2][i], m[3][i]};
+        };
+
+        // rows of a Vulkan clip space matrix, z is in [0, w]
+        this->planes = {
+            row(3) + row(0),
+            row(3) - row(0),
+            row(3) + row(1),
+            row(3) - row(1),
+            row(2),
+            row(3) - row(2),
+        };
+    }
+
+    float ChunkPrioritizer::getPriority(ChunkCoordinate coordinate) const
+    {
+        const glm::vec3 center = glm::vec3 {toWorldPosition(coordinate, {0, 0, 0})}
+            + static_cast<float>(ChunkExtent) * 0.5f;
+        const glm::vec3 offset = center - this->position;
+        const float     distance = glm::dot(offset, offset);
+
+        return this->isInFrustum(coordinate) ? distance : distance * 4.0f;
+    }
+
+    bool ChunkPrioritizer::isInFrustum(ChunkCoordinate coordinate) const
+    {
+        const glm::vec3 min {toWorldPosition(coordinate, {0, 0, 0})};
+        const glm::vec3 max = min + static_cast<float>(ChunkExtent);
+
+        for (const glm::vec4& plane : this->planes)
+        {
+            // the corner furthest along the plane's normal
+            const glm::vec3 corner {
+                plane.x >= 0.0f ? max.x : min.x,
+                plane.y >= 0.0f ? max.y : min.y,
+                plane.z >= 0.0f ? max.z : min.z,
+            };
+
+            if (glm::dot(glm::vec3 {plane}, corner) + plane.w < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+} // namespace world
@@ -0,0 +1,44 @@
+#ifndef SRC_WORLD_CAMERA__VIEW_HPP
+#define SRC_WORLD_CAMERA__VIEW_HPP
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include "voxel.hpp"
+
+namespace world
+{
+    /// @brief Where the player is looking, everything that does per chunk
+    /// work favours chunks inside the frustum and close to the position
+    struct CameraView
+    {
+        glm::vec3 position;
+        glm::mat4 view_projection;
+    };
+
+    /// @brief Orders chunks for loading and meshing, lower is more urgent
+    class ChunkPrioritizer
+    {
+    public:
+        explicit ChunkPrioritizer(const CameraView&);
+        ~ChunkPrioritizer() = default;
+
+        ChunkPrioritizer(const ChunkPrioritizer&)            = default;
+        ChunkPrioritizer(ChunkPrioritizer&&)                 = default;
+        ChunkPrioritizer& operator=(const ChunkPrioritizer&) = default;
+        ChunkPrioritizer& operator=(ChunkPrioritizer&&)      = default;
+
+        /// @brief Squared distance from the camera to the chunk's center,
+        /// chunks outside the frustum count as twice as far away
+        [[nodiscard]] float getPriority(ChunkCoordinate) const;
+        [[nodiscard]] bool isInFrustum(ChunkCoordinate) const;
+
+    private:
+        glm::vec3 position;
+        // (normal, distance) with normals pointing inwards
+        std::array<glm::vec4, 6> planes;
+    }; // class ChunkPrioritizer
+} // namespace world
+
+#endif // SRC_WORLD_CAMERA__VIEW_HPP
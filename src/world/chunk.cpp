@@ -0,0 +1,448 @@
+#include <algorithm>
+#include <bit>
+
+#include <sebib/seblog.hpp>
+
+#include "chunk.hpp"
+
+namespace
+{
+    constexpr std::uint32_t WordBitsLog2 = 6;
+
+    /// @brief log2 of the narrowest supported index width that can address
+    /// @param entries palette entries
+    std::uint32_t indexBitsLog2For(std::size_t entries)
+    {
+        std::uint32_t bitsLog2 = 0;
+
+        while ((std::size_t {1} << (std::size_t {1} << bitsLog2)) < entries)
+        {
+            ++bitsLog2;
+        }
+
+        return bitsLog2;
+    }
+} // namespace
+
+namespace world
+{
+    Chunk::Chunk(Voxel fill_)
+        : indices               {}
+        , index_bits_log2       {0}
+        , palette               {}
+        , palette_references    {}
+        , free_palette_entries  {}
+        , used_palette_entries  {0}
+        , sets_since_repack     {0}
+        , palette_lookup        {}
+    {
+        this->fill(fill_);
+    }
+
+    Voxel Chunk::get(LocalPosition position) const
+    {
+        if (this->indices.empty())
+        {
+            return this->palette.front();
+        }
+
+        return this->palette[this->readIndex(toLinearIndex(position))];
+    }
+
+    void Chunk::set(LocalPosition position, Voxel voxel)
+    {
+        const std::size_t linearIndex = toLinearIndex(position);
+
+        if (this->indices.empty())
+        {
+            if (this->palette.front() == voxel)
+            {
+                return;
+            }
+
+            // uniform -> 1 bit, every existing voxel is index 0
+            this->palette.push_back(voxel);
+            this->palette_references = {static_cast<std::uint16_t>(ChunkVolume - 1), 1};
+            this->used_palette_entries = 2;
+            this->sets_since_repack = 1;
+            this->index_bits_log2 = 0;
+            this->indices.assign(ChunkVolume >> WordBitsLog2, 0);
+            this->writeIndex(linearIndex, 1);
+            return;
+        }
+
+        const std::uint32_t oldIndex = this->readIndex(linearIndex);
+
+        if (this->palette[oldIndex] == voxel)
+        {
+            return;
+        }
+
+        ++this->sets_since_repack;
+
+        const std::uint32_t newIndex = this->findOrInsert(voxel);
+
+        // findOrInsert only widens when there are no free entries, so the
+        // repack compacts nothing and oldIndex is still valid
+        this->writeIndex(linearIndex, newIndex);
+        ++this->palette_references[newIndex];
+
+        this->release(oldIndex);
+    }
+
+    void Chunk::fill(Voxel voxel)
+    {
+        this->indices.clear();
+        this->indices.shrink_to_fit();
+        this->index_bits_log2 = 0;
+
+        this->palette = {voxel};
+        this->palette_references = {static_cast<std::uint16_t>(ChunkVolume)};
+        this->free_palette_entries.clear();
+        this->used_palette_entries = 1;
+        this->sets_since_repack = 0;
+
+        this->palette_lookup = decltype(this->palette_lookup) {};
+    }
+
+    void Chunk::unpack(std::span<Voxel, ChunkVolume> out) const
+    {
+        if (this->indices.empty())
+        {
+            std::ranges::fill(out, this->palette.front());
+            return;
+        }
+
+        const std::uint32_t indicesPerWordLog2 = WordBitsLog2 - this->index_bits_log2;
+        const std::uint32_t bits = 1U << this->index_bits_log2;
+        const std::uint64_t mask = (std::uint64_t {1} << bits) - 1;
+
+        std::size_t linearIndex = 0;
+
+        for (std::uint64_t word : this->indices)
+        {
+            for (std::size_t slot = 0; slot < (std::size_t {1} << indicesPerWordLog2); ++slot)
+            {
+                out[linearIndex++] = this->palette[word & mask];
+                word >>= bits;
+            }
+        }
+    }
+
+    void Chunk::pack(std::span<const Voxel, ChunkVolume> voxels)
+    {
+        std::vector<Voxel>                       newPalette {voxels[0]};
+        std::vector<std::uint16_t>               newReferences {0};
+        std::unordered_map<Voxel, std::uint16_t> lookup {};
+        std::vector<std::uint16_t>               paletteIndices (ChunkVolume, 0);
+
+        // generated voxels come in runs, only a change needs a palette search
+        Voxel         runVoxel = voxels[0];
+        std::uint16_t runIndex = 0;
+
+        for (std::size_t i = 0; i < ChunkVolume; ++i)
+        {
+            if (voxels[i] != runVoxel)
+            {
+                runVoxel = voxels[i];
+
+                if (newPalette.size() > LinearSearchLimit)
+                {
+                    const auto [it, isNew] = lookup.try_emplace(runVoxel, static_cast<std::uint16_t>(newPalette.size()));
+                    runIndex = it->second;
+
+                    if (isNew)
+                    {
+                        newPalette.push_back(runVoxel);
+                        newReferences.push_back(0);
+                    }
+                }
+                else if (const auto found = std::ranges::find(newPalette, runVoxel); found != newPalette.end())
+                {
+                    runIndex = static_cast<std::uint16_t>(found - newPalette.begin());
+                }
+                else
+                {
+                    runIndex = static_cast<std::uint16_t>(newPalette.size());
+                    newPalette.push_back(runVoxel);
+                    newReferences.push_back(0);
+
+                    if (newPalette.size() == LinearSearchLimit + 1)
+                    {
+                        for (std::size_t p = 0; p < newPalette.size(); ++p)
+                        {
+                            lookup[newPalette[p]] = static_cast<std::uint16_t>(p);
+                        }
+                    }
+                }
+            }
+
+            ++newReferences[runIndex];
+            paletteIndices[i] = runIndex;
+        }
+
+        if (newPalette.size() == 1)
+        {
+            this->fill(newPalette.front());
+            return;
+        }
+
+        const std::uint32_t newIndexBitsLog2      = indexBitsLog2For(newPalette.size());
+        const std::uint32_t newIndicesPerWordLog2 = WordBitsLog2 - newIndexBitsLog2;
+        std::vector<std::uint64_t> newIndices (ChunkVolume >> newIndicesPerWordLog2, 0);
+
+        for (std::size_t w = 0; w < newIndices.size(); ++w)
+        {
+            std::uint64_t word = 0;
+
+            for (std::size_t slot = 0; slot < (std::size_t {1} << newIndicesPerWordLog2); ++slot)
+            {
+                word |= std::uint64_t {paletteIndices[(w << newIndicesPerWordLog2) | slot]}
+                    << (slot << newIndexBitsLog2);
+            }
+
+            newIndices[w] = word;
+        }
+
+        this->indices              = std::move(newIndices);
+        this->index_bits_log2      = newIndexBitsLog2;
+        this->used_palette_entries = newPalette.size();
+        this->palette              = std::move(newPalette);
+        this->palette_references   = std::move(newReferences);
+        this->free_palette_entries = decltype(this->free_palette_entries) {};
+        this->sets_since_repack    = 0;
+
+        this->rebuildLookup();
+    }
+
+    bool Chunk::isUniform() const
+    {
+        return this->indices.empty();
+    }
+
+    std::optional<Voxel> Chunk::getUniformVoxel() const
+    {
+        if (this->indices.empty())
+        {
+            return this->palette.front();
+        }
+
+        return std::nullopt;
+    }
+
+    std::size_t Chunk::getPaletteSize() const
+    {
+        return this->used_palette_entries;
+    }
+
+    std::uint32_t Chunk::getBitsPerIndex() const
+    {
+        return this->indices.empty() ? 0 : std::uint32_t {1} << this->index_bits_log2;
+    }
+
+    std::size_t Chunk::getMemoryUsage() const
+    {
+        // libstdc++ nodes hold the next pointer, the value and the cached hash
+        constexpr std::size_t LookupNodeSize =
+            sizeof(void*) + sizeof(std::pair<const Voxel, std::uint16_t>) + sizeof(std::size_t);
+
+        return sizeof(Chunk)
+            + this->indices.capacity() * sizeof(std::uint64_t)
+            + this->palette.capacity() * sizeof(Voxel)
+            + this->palette_references.capacity() * sizeof(std::uint16_t)
+            + this->free_palette_entries.capacity() * sizeof(std::uint16_t)
+            + this->palette_lookup.size() * LookupNodeSize
+            + (this->palette_lookup.empty() ? 0 : this->palette_lookup.bucket_count() * sizeof(void*));
+    }
+
+    std::uint32_t Chunk::readIndex(std::size_t linearIndex) const
+    {
+        const std::uint32_t indicesPerWordLog2 = WordBitsLog2 - this->index_bits_log2;
+        const std::size_t   slot  = linearIndex & ((std::size_t {1} << indicesPerWordLog2) - 1);
+        const std::uint64_t mask  = (std::uint64_t {1} << (1U << this->index_bits_log2)) - 1;
+        const std::uint64_t word  = this->indices[linearIndex >> indicesPerWordLog2];
+
+        return static_cast<std::uint32_t>((word >> (slot << this->index_bits_log2)) & mask);
+    }
+
+    void Chunk::writeIndex(std::size_t linearIndex, std::uint32_t paletteIndex)
+    {
+        const std::uint32_t indicesPerWordLog2 = WordBitsLog2 - this->index_bits_log2;
+        const std::size_t   slot  = linearIndex & ((std::size_t {1} << indicesPerWordLog2) - 1);
+        const std::size_t   shift = slot << this->index_bits_log2;
+        const std::uint64_t mask  = (std::uint64_t {1} << (1U << this->index_bits_log2)) - 1;
+
+        std::uint64_t& word = this->indices[linearIndex >> indicesPerWordLog2];
+        word = (word & ~(mask << shift)) | (std::uint64_t {paletteIndex} << shift);
+    }
+
+    std::uint32_t Chunk::findOrInsert(Voxel voxel)
+    {
+        if (this->palette.size() > LinearSearchLimit)
+        {
+            if (const auto it = this->palette_lookup.find(voxel); it != this->palette_lookup.end())
+            {
+                return it->second;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < this->palette.size(); ++i)
+            {
+                if (this->palette[i] == voxel && this->palette_references[i] != 0)
+                {
+                    return static_cast<std::uint32_t>(i);
+                }
+            }
+        }
+
+        std::uint32_t index = 0;
+
+        if (!this->free_palette_entries.empty())
+        {
+            index = this->free_palette_entries.back();
+            this->free_palette_entries.pop_back();
+
+            this->palette[index] = voxel;
+        }
+        else
+        {
+            if (this->palette.size() == (std::size_t {1} << (1U << this->index_bits_log2)))
+            {
+                this->repack(this->index_bits_log2 + 1);
+            }
+
+            index = static_cast<std::uint32_t>(this->palette.size());
+
+            this->palette.push_back(voxel);
+            this->palette_references.push_back(0);
+
+            if (this->palette.size() == LinearSearchLimit + 1)
+            {
+                this->rebuildLookup();
+            }
+        }
+
+        if (this->palette.size() > LinearSearchLimit)
+        {
+            this->palette_lookup[voxel] = static_cast<std::uint16_t>(index);
+        }
+
+        ++this->used_palette_entries;
+
+        return index;
+    }
+
+    void Chunk::release(std::uint32_t paletteIndex)
+    {
+        if (--this->palette_references[paletteIndex] != 0)
+        {
+            return;
+        }
+
+        --this->used_palette_entries;
+
+        if (this->used_palette_entries == 1)
+        {
+            const auto survivor = std::ranges::find_if(this->palette_references,
+                [](std::uint16_t references) { return references != 0; });
+
+            this->fill(this->palette[static_cast<std::size_t>(survivor - this->palette_references.begin())]);
+            return;
+        }
+
+        if (this->palette.size() > LinearSearchLimit)
+        {
+            this->palette_lookup.erase(this->palette[paletteIndex]);
+        }
+        this->free_palette_entries.push_back(static_cast<std::uint16_t>(paletteIndex));
+
+        // A repack touches every voxel, waiting for RepackInterval sets
+        // since the last one keeps set() amortized O(1) even when a chunk
+        // hovers around a width boundary
+        if (this->sets_since_repack < RepackInterval)
+        {
+            return;
+        }
+
+        if (indexBitsLog2For(this->used_palette_entries) < this->index_bits_log2)
+        {
+            this->repack(indexBitsLog2For(this->used_palette_entries));
+            return;
+        }
+
+        // Mostly dead palettes are compacted at the same width so their
+        // lookup tables don't stay at their peak size
+        if (this->free_palette_entries.size() > LinearSearchLimit &&
+            this->free_palette_entries.size() > this->used_palette_entries)
+        {
+            this->repack(this->index_bits_log2);
+        }
+    }
+
+    void Chunk::repack(std::uint32_t newIndexBitsLog2)
+    {
+        seb::assertFatal(newIndexBitsLog2 <= 4, "Palette index would be wider than 16 bits");
+
+        std::vector<std::uint32_t> remap (this->palette.size(), 0);
+        std::vector<Voxel>         newPalette {};
+        std::vector<std::uint16_t> newReferences {};
+        newPalette.reserve(this->used_palette_entries);
+        newReferences.reserve(this->used_palette_entries);
+
+        for (std::size_t i = 0; i < this->palette.size(); ++i)
+        {
+            if (this->palette_references[i] != 0)
+            {
+                remap[i] = static_cast<std::uint32_t>(newPalette.size());
+                newPalette.push_back(this->palette[i]);
+                newReferences.push_back(this->palette_references[i]);
+            }
+        }
+
+        const std::uint32_t newIndicesPerWordLog2 = WordBitsLog2 - newIndexBitsLog2;
+        std::vector<std::uint64_t> newIndices (ChunkVolume >> newIndicesPerWordLog2, 0);
+
+        for (std::size_t w = 0; w < newIndices.size(); ++w)
+        {
+            std::uint64_t word = 0;
+
+            for (std::size_t slot = 0; slot < (std::size_t {1} << newIndicesPerWordLog2); ++slot)
+            {
+                const std::size_t linearIndex = (w << newIndicesPerWordLog2) | slot;
+
+                word |= std::uint64_t {remap[this->readIndex(linearIndex)]} << (slot << newIndexBitsLog2);
+            }
+
+            newIndices[w] = word;
+        }
+
+        this->indices              = std::move(newIndices);
+        this->index_bits_log2      = newIndexBitsLog2;
+        this->palette              = std::move(newPalette);
+        this->palette_references   = std::move(newReferences);
+        this->free_palette_entries = decltype(this->free_palette_entries) {};
+        this->sets_since_repack    = 0;
+
+        this->rebuildLookup();
+    }
+
+    void Chunk::rebuildLookup()
+    {
+        // clear() keeps the bucket array
+        this->palette_lookup = decltype(this->palette_lookup) {};
+
+        if (this->palette.size() <= LinearSearchLimit)
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i < this->palette.size(); ++i)
+        {
+            if (this->palette_references[i] != 0)
+            {
+                this->palette_lookup[this->palette[i]] = static_cast<std::uint16_t>(i);
+            }
+        }
+    }
+} // namespace world
@@ -0,0 +1,88 @@
+#ifndef SRC_WORLD_CHUNK_HPP
+#define SRC_WORLD_CHUNK_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "voxel.hpp"
+
+namespace world
+{
+    /// @brief A ChunkExtent³ cube of voxels stored as a palette of distinct
+    /// voxels plus one bit packed palette index per voxel.
+    ///
+    /// Indices are 1, 2, 4, 8 or 16 bits wide so they never straddle a 64 bit
+    /// word and get / set are a shift and a mask. The width grows as the
+    /// palette fills and shrinks once enough entries stop being referenced.
+    /// A chunk holding a single voxel type stores no indices at all.
+    class Chunk
+    {
+    public:
+
+        explicit Chunk(Voxel fill = AirVoxel);
+        ~Chunk() = default;
+
+        Chunk(const Chunk&)            = default;
+        Chunk(Chunk&&)                 = default;
+        Chunk& operator=(const Chunk&) = default;
+        Chunk& operator=(Chunk&&)      = default;
+
+        [[nodiscard]] Voxel get(LocalPosition) const;
+        void set(LocalPosition, Voxel);
+
+        /// @brief Replaces every voxel, the chunk becomes uniform
+        void fill(Voxel);
+
+        /// @brief Decodes every voxel into @param out, indexed by toLinearIndex
+        void unpack(std::span<Voxel, ChunkVolume> out) const;
+        /// @brief Replaces every voxel with @param voxels, indexed by
+        /// toLinearIndex. The palette and index width are built once instead
+        /// of grown by a set() per voxel
+        void pack(std::span<const Voxel, ChunkVolume> voxels);
+
+        [[nodiscard]] bool isUniform() const;
+        [[nodiscard]] std::optional<Voxel> getUniformVoxel() const;
+
+        /// @brief Number of distinct voxels currently in the chunk
+        [[nodiscard]] std::size_t getPaletteSize() const;
+        /// @brief 0 for uniform chunks
+        [[nodiscard]] std::uint32_t getBitsPerIndex() const;
+        /// @brief Heap and inline bytes owned by this chunk
+        [[nodiscard]] std::size_t getMemoryUsage() const;
+
+    private:
+        // palettes larger than this get a hash map for voxel -> index lookups
+        constexpr static std::size_t LinearSearchLimit = 16;
+        constexpr static std::size_t RepackInterval    = ChunkVolume / 8;
+
+        [[nodiscard]] std::uint32_t readIndex(std::size_t linearIndex) const;
+        void writeIndex(std::size_t linearIndex, std::uint32_t paletteIndex);
+
+        /// @brief Returns the index of @param voxel, adding it to the palette
+        /// and widening the indices if it isn't present
+        [[nodiscard]] std::uint32_t findOrInsert(Voxel);
+        void release(std::uint32_t paletteIndex);
+
+        /// @brief Drops unreferenced palette entries and rewrites every index
+        /// at 2^@param newIndexBitsLog2 bits
+        void repack(std::uint32_t newIndexBitsLog2);
+        void rebuildLookup();
+
+        // empty when uniform, palette.front() is then the only voxel
+        std::vector<std::uint64_t> indices;
+        std::uint32_t              index_bits_log2;
+
+        std::vector<Voxel>         palette;
+        std::vector<std::uint16_t> palette_references;
+        std::vector<std::uint16_t> free_palette_entries;
+        std::size_t                used_palette_entries;
+        std::size_t                sets_since_repack;
+
+        std::unordered_map<Voxel, std::uint16_t> palette_lookup;
+    }; // class Chunk
+} // namespace world
+
+#endif // SRC_WORLD_CHUNK_HPP
@@ -0,0 +1,74 @@
+#include "chunk_cache.hpp"
+
+namespace world
+{
+    ChunkCache::ChunkCache(std::size_t maxBytes)
+        : max_bytes {maxBytes}
+        , bytes {0}
+        , dropped {0}
+    {}
+
+    void ChunkCache::insert(ChunkCoordinate coordinate, Chunk chunk)
+    {
+        // a newer copy replaces the cached one
+        static_cast<void>(this->take(coordinate));
+
+        const std::size_t chunkBytes = chunk.getMemoryUsage();
+
+        this->entries.push_front(Entry {
+            .coordinate {coordinate},
+            .chunk      {std::move(chunk)},
+            .bytes      {chunkBytes},
+        });
+        this->lookup[coordinate] = this->entries.begin();
+        this->bytes += chunkBytes;
+
+        while (this->bytes > this->max_bytes && !this->entries.empty())
+        {
+            const Entry& oldest = this->entries.back();
+
+            this->bytes -= oldest.bytes;
+            this->lookup.erase(oldest.coordinate);
+            this->entries.pop_back();
+            ++this->dropped;
+        }
+    }
+
+    std::optional<Chunk> ChunkCache::take(ChunkCoordinate coordinate)
+    {
+        const auto found = this->lookup.find(coordinate);
+
+        if (found == this->lookup.end())
+        {
+            return std::nullopt;
+        }
+
+        std::optional<Chunk> chunk {std::move(found->second->chunk)};
+
+        this->bytes -= found->second->bytes;
+        this->entries.erase(found->second);
+        this->lookup.erase(found);
+
+        return chunk;
+    }
+
+    bool ChunkCache::contains(ChunkCoordinate coordinate) const
+    {
+        return this->lookup.contains(coordinate);
+    }
+
+    std::size_t ChunkCache::getChunkCount() const
+    {
+        return this->entries.size();
+    }
+
+    std::size_t ChunkCache::getMemoryUsage() const
+    {
+        return this->bytes;
+    }
+
+    std::size_t ChunkCache::getDroppedCount() const
+    {
+        return this->dropped;
+    }
+} // namespace world
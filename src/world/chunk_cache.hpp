@@ -0,0 +1,54 @@
+#ifndef SRC_WORLD_CHUNK__CACHE_HPP
+#define SRC_WORLD_CHUNK__CACHE_HPP
+
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include "chunk.hpp"
+
+namespace world
+{
+    /// @brief Chunks that were streamed out, kept so walking back doesn't
+    /// regenerate them. Holds at most max_bytes of chunks, the least
+    /// recently inserted ones are dropped first.
+    class ChunkCache
+    {
+    public:
+        explicit ChunkCache(std::size_t maxBytes);
+        ~ChunkCache() = default;
+
+        ChunkCache(const ChunkCache&)            = delete;
+        ChunkCache(ChunkCache&&)                 = delete;
+        ChunkCache& operator=(const ChunkCache&) = delete;
+        ChunkCache& operator=(ChunkCache&&)      = delete;
+
+        /// @brief Replaces any chunk already cached at the coordinate
+        void insert(ChunkCoordinate, Chunk);
+        /// @brief Removes and returns the chunk at @param coordinate
+        [[nodiscard]] std::optional<Chunk> take(ChunkCoordinate coordinate);
+        [[nodiscard]] bool contains(ChunkCoordinate) const;
+
+        [[nodiscard]] std::size_t getChunkCount() const;
+        [[nodiscard]] std::size_t getMemoryUsage() const;
+        [[nodiscard]] std::size_t getDroppedCount() const;
+
+    private:
+        struct Entry
+        {
+            ChunkCoordinate coordinate;
+            Chunk           chunk;
+            std::size_t     bytes;
+        };
+
+        std::size_t max_bytes;
+        std::size_t bytes;
+        std::size_t dropped;
+
+        // most recent at the front
+        std::list<Entry> entries;
+        std::unordered_map<ChunkCoordinate, std::list<Entry>::iterator, ChunkCoordinateHash> lookup;
+    }; // class ChunkCache
+} // namespace world
+
+#endif // SRC_WORLD_CHUNK__CACHE_HPP
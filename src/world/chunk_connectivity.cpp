@@ -0,0 +1,228 @@
+#include <algorithm>
+
+#include <util/profiler.hpp>
+
+#include "chunk_connectivity.hpp"
+
+namespace
+{
+    // one row of voxels along x per (y, z), bit x set for air
+    using Row = std::uint32_t;
+    using Rows = std::array<Row, world::ChunkExtent * world::ChunkExtent>;
+
+    static_assert(sizeof(Row) * 8 == world::ChunkExtent);
+
+    constexpr std::int32_t LastRow = world::ChunkExtent - 1;
+    constexpr Row          AllAir  = ~Row {0};
+
+    constexpr std::uint8_t AllFaces = (1U << world::NumberOfFaces) - 1;
+
+    constexpr std::size_t toRowIndex(std::int32_t y, std::int32_t z)
+    {
+        return static_cast<std::size_t>(y * world::ChunkExtent + z);
+    }
+
+    constexpr std::uint8_t toBit(world::Face face)
+    {
+        return static_cast<std::uint8_t>(1U << static_cast<std::uint8_t>(face));
+    }
+
+    /// @brief Grows @param region through @param air until it stops
+    /// changing. Each pass sweeps down and back up the rows and spreads
+    /// along them, so most pockets take only a couple of passes
+    void floodFill(const Rows& air, Rows& region)
+    {
+        const auto grow = [&](std::int32_t y, std::int32_t z) -> bool
+        {
+            const std::size_t i = toRowIndex(y, z);
+
+            Row row = region[i];
+            row |= y > 0 ? region[toRowIndex(y - 1, z)] : 0U;
+            row |= y < LastRow ? region[toRowIndex(y + 1, z)] : 0U;
+            row |= z > 0 ? region[toRowIndex(y, z - 1)] : 0U;
+            row |= z < LastRow ? region[toRowIndex(y, z + 1)] : 0U;
+            row &= air[i];
+
+            // along x, through runs of air
+            for (Row spread = row; ; row = spread)
+            {
+                spread = (row | row << 1 | row >> 1) & air[i];
+
+                if (spread == row)
+                {
+                    break;
+                }
+            }
+
+            const bool hasChanged = row != region[i];
+            region[i] = row;
+            return hasChanged;
+        };
+
+        for (bool hasChanged = true; hasChanged; )
+        {
+            hasChanged = false;
+
+            for (std::int32_t y = 0; y <= LastRow; ++y)
+            {
+                for (std::int32_t z = 0; z <= LastRow; ++z)
+                {
+                    hasChanged |= grow(y, z);
+                }
+            }
+
+            for (std::int32_t y = LastRow; y >= 0; --y)
+            {
+                for (std::int32_t z = LastRow; z >= 0; --z)
+                {
+                    hasChanged |= grow(y, z);
+                }
+            }
+        }
+    }
+
+    /// @brief The faces of the chunk @param region touches
+    std::uint8_t getTouchedFaces(const Rows& region)
+    {
+        Row      anyRow  = 0;
+        unsigned touched = 0;
+
+        for (std::int32_t y = 0; y <= LastRow; ++y)
+        {
+            for (std::int32_t z = 0; z <= LastRow; ++z)
+            {
+                const Row row = region[toRowIndex(y, z)];
+
+                if (row == 0)
+                {
+                    continue;
+                }
+
+                anyRow |= row;
+                touched |= y == 0 ? toBit(world::Face::NegativeY) : 0U;
+                touched |= y == LastRow ? toBit(world::Face::PositiveY) : 0U;
+                touched |= z == 0 ? toBit(world::Face::NegativeZ) : 0U;
+                touched |= z == LastRow ? toBit(world::Face::PositiveZ) : 0U;
+            }
+        }
+
+        touched |= (anyRow & 1) != 0 ? toBit(world::Face::NegativeX) : 0U;
+        touched |= (anyRow >> LastRow) != 0 ? toBit(world::Face::PositiveX) : 0U;
+
+        return static_cast<std::uint8_t>(touched);
+    }
+} // namespace
+
+namespace world
+{
+    ChunkConnectivity::ChunkConnectivity()
+        : reachable {}
+    {
+        this->reachable.fill(AllFaces);
+    }
+
+    ChunkConnectivity ChunkConnectivity::compute(const PaddedChunk& chunk)
+    {
+        PROFILE_SCOPE("ChunkConnectivity::compute");
+
+        Rows air {};
+        bool isAllAir = true;
+        bool isSolid  = true;
+
+        const std::span<const Voxel> voxels = chunk.getVoxels();
+
+        for (std::int32_t y = 0; y < ChunkExtent; ++y)
+        {
+            for (std::int32_t z = 0; z < ChunkExtent; ++z)
+            {
+                // x is contiguous in toPaddedIndex
+                const std::size_t first = PaddedChunk::toPaddedIndex({0, y, z});
+                Row               row   = 0;
+
+                for (std::int32_t x = 0; x < ChunkExtent; ++x)
+                {
+                    row |= static_cast<Row>(voxels[first + static_cast<std::size_t>(x)] == AirVoxel) << x;
+                }
+
+                air[toRowIndex(y, z)] = row;
+                isAllAir &= row == AllAir;
+                isSolid &= row == 0;
+            }
+        }
+
+        ChunkConnectivity connectivity {};
+
+        if (isAllAir)
+        {
+            return connectivity;
+        }
+
+        connectivity.reachable.fill(0);
+
+        if (isSolid)
+        {
+            return connectivity;
+        }
+
+        // only air touching a face can connect anything, so every pocket is
+        // seeded from the chunk's surface and filled once
+        Rows remaining = air;
+
+        for (std::int32_t y = 0; y <= LastRow; ++y)
+        {
+            for (std::int32_t z = 0; z <= LastRow; ++z)
+            {
+                const bool isSurfaceRow = y == 0 || y == LastRow || z == 0 || z == LastRow;
+                const Row  surface      = isSurfaceRow ? AllAir : (Row {1} | Row {1} << LastRow);
+
+                while ((remaining[toRowIndex(y, z)] & surface) != 0)
+                {
+                    const Row seeds = remaining[toRowIndex(y, z)] & surface;
+
+                    Rows region {};
+                    region[toRowIndex(y, z)] = seeds & (~seeds + 1);
+
+                    floodFill(remaining, region);
+
+                    const std::uint8_t touched = getTouchedFaces(region);
+
+                    for (std::size_t face = 0; face < NumberOfFaces; ++face)
+                    {
+                        if ((touched >> face & 1) != 0)
+                        {
+                            connectivity.reachable[face] |= touched;
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < remaining.size(); ++i)
+                    {
+                        remaining[i] &= ~region[i];
+                    }
+                }
+            }
+        }
+
+        return connectivity;
+    }
+
+    bool ChunkConnectivity::isConnected(Face from, Face to) const
+    {
+        return (this->reachable[static_cast<std::size_t>(from)] & toBit(to)) != 0;
+    }
+
+    bool ChunkConnectivity::isOpen() const
+    {
+        return std::ranges::all_of(this->reachable, [](std::uint8_t faces)
+        {
+            return faces == AllFaces;
+        });
+    }
+
+    bool ChunkConnectivity::isClosed() const
+    {
+        return std::ranges::all_of(this->reachable, [](std::uint8_t faces)
+        {
+            return faces == 0;
+        });
+    }
+} // namespace world
@@ -0,0 +1,45 @@
+#ifndef SRC_WORLD_CHUNK__CONNECTIVITY_HPP
+#define SRC_WORLD_CHUNK__CONNECTIVITY_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "greedy_mesher.hpp"
+#include "padded_chunk.hpp"
+
+namespace world
+{
+    /// @brief Which faces of a chunk can see each other through it, two
+    /// faces are connected if one pocket of air touches both.
+    ///
+    /// Unknown chunks should be treated as fully connected, which only ever
+    /// costs draws.
+    class ChunkConnectivity
+    {
+    public:
+        /// @brief Every face connected to every other, what an air chunk is
+        ChunkConnectivity();
+        ~ChunkConnectivity() = default;
+
+        ChunkConnectivity(const ChunkConnectivity&)            = default;
+        ChunkConnectivity(ChunkConnectivity&&)                 = default;
+        ChunkConnectivity& operator=(const ChunkConnectivity&) = default;
+        ChunkConnectivity& operator=(ChunkConnectivity&&)      = default;
+
+        /// @brief Flood fills the air of @param chunk's center, the border
+        /// is ignored
+        [[nodiscard]] static ChunkConnectivity compute(const PaddedChunk& chunk);
+
+        [[nodiscard]] bool isConnected(Face, Face) const;
+        [[nodiscard]] bool isOpen() const;
+        [[nodiscard]] bool isClosed() const;
+
+        [[nodiscard]] bool operator==(const ChunkConnectivity&) const = default;
+
+    private:
+        // bit f of reachable[e] is set if face f can be seen through face e
+        std::array<std::uint8_t, NumberOfFaces> reachable;
+    }; // class ChunkConnectivity
+} // namespace world
+
+#endif // SRC_WORLD_CHUNK__CONNECTIVITY_HPP
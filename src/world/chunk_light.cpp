@@ -0,0 +1,53 @@
+#include "chunk_light.hpp"
+
+namespace world
+{
+    NibbleArray::NibbleArray()
+        : NibbleArray {0}
+    {}
+
+    NibbleArray::NibbleArray(std::uint8_t fill)
+        : uniform_level {fill}
+    {}
+
+    void NibbleArray::set(std::size_t linearIndex, std::uint8_t level)
+    {
+        if (this->nibbles.empty())
+        {
+            if (level == this->uniform_level)
+            {
+                return;
+            }
+
+            // both nibbles of every byte
+            this->nibbles.assign(ChunkVolume / 2, static_cast<std::uint8_t>(this->uniform_level * 0x11));
+        }
+
+        const auto    shift = static_cast<unsigned>(linearIndex % 2 * 4);
+        std::uint8_t& byte  = this->nibbles[linearIndex / 2];
+
+        byte = static_cast<std::uint8_t>((byte & ~(0xFU << shift)) | unsigned {level} << shift);
+    }
+
+    void NibbleArray::fill(std::uint8_t level)
+    {
+        this->nibbles.clear();
+        this->nibbles.shrink_to_fit();
+        this->uniform_level = level;
+    }
+
+    std::optional<std::uint8_t> NibbleArray::getUniformLevel() const
+    {
+        if (!this->nibbles.empty())
+        {
+            return std::nullopt;
+        }
+
+        return this->uniform_level;
+    }
+
+    std::size_t NibbleArray::getMemoryUsage() const
+    {
+        return sizeof(NibbleArray) + this->nibbles.capacity();
+    }
+} // namespace world
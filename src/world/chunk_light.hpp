@@ -0,0 +1,89 @@
+#ifndef SRC_WORLD_CHUNK__LIGHT_HPP
+#define SRC_WORLD_CHUNK__LIGHT_HPP
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "voxel.hpp"
+
+namespace world
+{
+    constexpr std::uint8_t MaxLightLevel = 15;
+
+    /// @brief Sky light in the high nibble, block light in the low one
+    using PackedLight = std::uint8_t;
+    /// @brief What unlit voxels are drawn with, as if under the open sky
+    constexpr PackedLight OpenSkyLight = MaxLightLevel << 4;
+
+    [[nodiscard]] constexpr PackedLight packLight(std::uint8_t sky, std::uint8_t block)
+    {
+        return static_cast<PackedLight>(sky << 4 | block);
+    }
+
+    /// @brief Block light @param voxel gives off, 0 for most
+    [[nodiscard]] constexpr std::uint8_t getLightEmission(Voxel voxel)
+    {
+        return voxel == material::Lamp ? MaxLightLevel : 0;
+    }
+
+    /// @brief One light level in [0, MaxLightLevel] per voxel of a chunk,
+    /// two to a byte and indexed by toLinearIndex.
+    ///
+    /// Like Chunk, an array holding a single level stores nothing, which
+    /// covers chunks of open sky and solid ground.
+    class NibbleArray
+    {
+    public:
+        /// @brief Every level 0
+        NibbleArray();
+        explicit NibbleArray(std::uint8_t fill);
+        ~NibbleArray() = default;
+
+        NibbleArray(const NibbleArray&)            = default;
+        NibbleArray(NibbleArray&&)                 = default;
+        NibbleArray& operator=(const NibbleArray&) = default;
+        NibbleArray& operator=(NibbleArray&&)      = default;
+
+        [[nodiscard]] std::uint8_t get(std::size_t linearIndex) const
+        {
+            if (this->nibbles.empty())
+            {
+                return this->uniform_level;
+            }
+
+            return static_cast<std::uint8_t>(this->nibbles[linearIndex / 2] >> (linearIndex % 2 * 4) & 0xF);
+        }
+        void set(std::size_t linearIndex, std::uint8_t level);
+
+        /// @brief Replaces every level, the array becomes uniform
+        void fill(std::uint8_t level);
+
+        [[nodiscard]] std::optional<std::uint8_t> getUniformLevel() const;
+        /// @brief Heap and inline bytes owned by this array
+        [[nodiscard]] std::size_t getMemoryUsage() const;
+
+    private:
+        // empty while every level is uniform_level
+        std::vector<std::uint8_t> nibbles;
+        std::uint8_t              uniform_level;
+    }; // class NibbleArray
+
+    struct ChunkLight
+    {
+        NibbleArray sky;
+        NibbleArray block;
+
+        [[nodiscard]] PackedLight get(std::size_t linearIndex) const
+        {
+            return packLight(this->sky.get(linearIndex), this->block.get(linearIndex));
+        }
+
+        [[nodiscard]] std::size_t getMemoryUsage() const
+        {
+            return this->sky.getMemoryUsage() + this->block.getMemoryUsage();
+        }
+    };
+} // namespace world
+
+#endif // SRC_WORLD_CHUNK__LIGHT_HPP
@@ -0,0 +1,79 @@
+#include <array>
+
+#include <util/profiler.hpp>
+
+#include "chunk_mesh.hpp"
+
+namespace
+{
+    /// @brief Triangles are split along the diagonal from corner 0 to 2
+    /// unless the other one joins the brighter pair. Interpolating across
+    /// the darker diagonal smears a single occluded corner over half the
+    /// quad, which makes the same occlusion look different under rotation
+    bool shouldFlip(world::FaceOcclusion occlusion)
+    {
+        const auto corner = [&](unsigned i) { return static_cast<unsigned>(occlusion) >> (2 * i) & 3U; };
+
+        return corner(0) + corner(2) < corner(1) + corner(3);
+    }
+} // namespace
+
+namespace world
+{
+    glm::vec3 getVoxelColor(Voxel voxel)
+    {
+        switch (voxel)
+        {
+            case material::Stone: return {0.45f, 0.45f, 0.47f};
+            case material::Dirt:  return {0.47f, 0.33f, 0.22f};
+            case material::Grass: return {0.30f, 0.58f, 0.22f};
+            case material::Lamp:  return {1.00f, 0.86f, 0.55f};
+            default: break;
+        }
+
+        // Anything else gets a stable pseudo random color
+        const std::uint32_t hash = static_cast<std::uint32_t>(voxel) * 2654435761U;
+
+        return {
+            0.25f + 0.75f * static_cast<float>((hash >> 8) & 0xFF) / 255.0f,
+            0.25f + 0.75f * static_cast<float>((hash >> 16) & 0xFF) / 255.0f,
+            0.25f + 0.75f * static_cast<float>((hash >> 24) & 0xFF) / 255.0f,
+        };
+    }
+
+    ChunkMesh buildChunkMesh(std::span<const GreedyQuad> quads)
+    {
+        PROFILE_SCOPE("buildChunkMesh");
+
+        ChunkMesh mesh {};
+        mesh.faces.reserve(quads.size());
+
+        for (const GreedyQuad& quad : quads)
+        {
+            const FaceAxes axes = getFaceAxes(quad.face);
+
+            // the voxel the face belongs to, its near corner in the face's
+            // plane
+            std::array<std::uint32_t, 3> position {};
+            position[static_cast<std::size_t>(axes.normal)] = quad.slice;
+            position[static_cast<std::size_t>(axes.u)]      = quad.u;
+            position[static_cast<std::size_t>(axes.v)]      = quad.v;
+
+            mesh.faces.push_back(render::VoxelFace {
+                .position_size_face {
+                    position[0] | position[1] << 5 | position[2] << 10
+                    | static_cast<std::uint32_t>(quad.width - 1) << 15
+                    | static_cast<std::uint32_t>(quad.height - 1) << 20
+                    | static_cast<std::uint32_t>(quad.face) << 25
+                    | static_cast<std::uint32_t>(quad.light >> 4) << 28},
+                .voxel_occlusion {
+                    std::uint32_t {quad.voxel}
+                    | std::uint32_t {quad.occlusion} << 16
+                    | (shouldFlip(quad.occlusion) ? 1U : 0U) << 24
+                    | static_cast<std::uint32_t>(quad.light & 0xF) << 28},
+            });
+        }
+
+        return mesh;
+    }
+} // namespace world
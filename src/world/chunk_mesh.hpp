@@ -0,0 +1,30 @@
+#ifndef SRC_WORLD_CHUNK__MESH_HPP
+#define SRC_WORLD_CHUNK__MESH_HPP
+
+#include <span>
+#include <vector>
+
+#include <render/vulkan/gpu_structs.hpp>
+
+#include "chunk_connectivity.hpp"
+#include "greedy_mesher.hpp"
+
+namespace world
+{
+    struct ChunkMesh
+    {
+        std::vector<render::VoxelFace> faces;
+        // of the chunk the mesh was built from, fully connected unless set
+        ChunkConnectivity              connectivity;
+    };
+
+    /// @brief What voxel_face.vert colors @param voxel with
+    [[nodiscard]] glm::vec3 getVoxelColor(Voxel);
+
+    /// @brief One packed face per quad, the vertex shader expands each into
+    /// two triangles. Positions are chunk local so the object's transform
+    /// places the chunk in the world
+    [[nodiscard]] ChunkMesh buildChunkMesh(std::span<const GreedyQuad>);
+} // namespace world
+
+#endif // SRC_WORLD_CHUNK__MESH_HPP
@@ -0,0 +1,386 @@
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "chunk_streamer.hpp"
+
+namespace
+{
+    std::int64_t getHorizontalDistanceSquared(world::ChunkCoordinate a, world::ChunkCoordinate b)
+    {
+        const std::int64_t dx = a.x - b.x;
+        const std::int64_t dz = a.z - b.z;
+
+        return dx * dx + dz * dz;
+    }
+} // namespace
+
+namespace world
+{
+    ChunkStreamer::ChunkStreamer(
+        StreamingSettings settings_,
+        Generator generator_,
+        std::size_t workerCount,
+        RegionStore* store_)
+        : settings {settings_}
+        , generator {std::move(generator_)}
+        , cache {settings_.max_cached_bytes}
+        , store {store_}
+        , missing {0}
+        , resident_chunks {0}
+        , resident_bytes {0}
+        , generated_total {0}
+        , cache_hits_total {0}
+        , loaded_from_disk_total {0}
+        , saved_total {0}
+        , evicted_total {0}
+        , limit_evictions_total {0}
+        , finished_from_disk {0}
+    {
+        seb::assertFatal(
+            this->settings.unload_radius >= this->settings.load_radius,
+            "Unload radius {} is inside the load radius {}",
+            this->settings.unload_radius,
+            this->settings.load_radius);
+
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            this->workers.emplace_back([this, i](std::stop_token stopToken)
+            {
+                util::profiler::setThreadName(fmt::format("Generator {}", i));
+                this->work(stopToken);
+            });
+        }
+    }
+
+    ChunkStreamer::Changes ChunkStreamer::update(VoxelStorage& storage, const CameraView& view)
+    {
+        PROFILE_SCOPE("ChunkStreamer::update");
+
+        Changes changes {};
+
+        const ChunkPrioritizer prioritizer {view};
+        const ChunkCoordinate  center = toChunkCoordinate(WorldPosition {glm::floor(view.position)});
+
+        const std::int64_t loadRadiusSquared =
+            std::int64_t {this->settings.load_radius} * this->settings.load_radius;
+        const std::int64_t unloadRadiusSquared =
+            std::int64_t {this->settings.unload_radius} * this->settings.unload_radius;
+
+        // Finished generation, chunks that are out of range by now are still
+        // worth keeping around
+        std::vector<std::pair<ChunkCoordinate, Chunk>> generated {};
+        {
+            std::lock_guard lock {this->mutex};
+            generated.swap(this->finished);
+
+            this->loaded_from_disk_total += std::exchange(this->finished_from_disk, 0);
+        }
+
+        for (auto& [coordinate, chunk] : generated)
+        {
+            this->generating.erase(coordinate);
+            ++this->generated_total;
+
+            if (getHorizontalDistanceSquared(coordinate, center) <= unloadRadiusSquared
+                && storage.getChunk(coordinate) == nullptr)
+            {
+                storage.insertChunk(coordinate, std::move(chunk));
+                changes.loaded.push_back(coordinate);
+            }
+            else
+            {
+                this->cache.insert(coordinate, std::move(chunk));
+            }
+        }
+
+        // Residents past the unload radius go, the rest are ordered furthest
+        // first in case the limits need room
+        struct Resident
+        {
+            std::int64_t    distance;
+            ChunkCoordinate coordinate;
+            std::size_t     bytes;
+        };
+
+        std::vector<Resident>        residents {};
+        std::vector<ChunkCoordinate> outOfRange {};
+        std::size_t                  residentBytes = 0;
+
+        storage.forEachChunk([&](ChunkCoordinate coordinate, const Chunk& chunk)
+        {
+            const std::int64_t distance = getHorizontalDistanceSquared(coordinate, center);
+
+            if (distance > unloadRadiusSquared)
+            {
+                outOfRange.push_back(coordinate);
+                return;
+            }
+
+            residents.push_back(Resident {
+                .distance   {distance},
+                .coordinate {coordinate},
+                .bytes      {chunk.getMemoryUsage()},
+            });
+            residentBytes += residents.back().bytes;
+        });
+
+        for (ChunkCoordinate coordinate : outOfRange)
+        {
+            this->evict(storage, coordinate, changes);
+        }
+
+        std::ranges::sort(residents, std::ranges::greater {}, &Resident::distance);
+
+        auto        furthest      = residents.begin();
+        std::size_t residentCount = residents.size();
+
+        const auto isAtLimit = [&]
+        {
+            return residentCount + this->generating.size() >= this->settings.max_resident_chunks
+                || residentBytes >= this->settings.max_resident_bytes;
+        };
+
+        const auto evictFurthest = [&]
+        {
+            residentBytes -= furthest->bytes;
+            --residentCount;
+            ++this->limit_evictions_total;
+
+            this->evict(storage, furthest->coordinate, changes);
+            ++furthest;
+        };
+
+        // edits can grow residents past the limits without anything loading
+        while (furthest != residents.end()
+            && (residentCount > this->settings.max_resident_chunks
+                || residentBytes > this->settings.max_resident_bytes))
+        {
+            evictFurthest();
+        }
+
+        // Missing chunks in range, best first
+        struct Candidate
+        {
+            float           priority;
+            std::int64_t    distance;
+            ChunkCoordinate coordinate;
+        };
+
+        std::vector<Candidate> candidates {};
+        const std::int32_t radius = this->settings.load_radius;
+
+        for (std::int32_t dz = -radius; dz <= radius; ++dz)
+        {
+            for (std::int32_t dx = -radius; dx <= radius; ++dx)
+            {
+                const std::int64_t distance = std::int64_t {dx} * dx + std::int64_t {dz} * dz;
+
+                if (distance > loadRadiusSquared)
+                {
+                    continue;
+                }
+
+                for (std::int32_t y = this->settings.min_chunk_y; y < this->settings.max_chunk_y; ++y)
+                {
+                    const ChunkCoordinate coordinate {center.x + dx, y, center.z + dz};
+
+                    if (storage.getChunk(coordinate) != nullptr || this->generating.contains(coordinate))
+                    {
+                        continue;
+                    }
+
+                    candidates.push_back(Candidate {
+                        .priority   {prioritizer.getPriority(coordinate)},
+                        .distance   {distance},
+                        .coordinate {coordinate},
+                    });
+                }
+            }
+        }
+
+        std::ranges::sort(candidates, {}, &Candidate::priority);
+
+        std::vector<ChunkCoordinate> newJobs {};
+        this->missing = 0;
+
+        for (const Candidate& candidate : candidates)
+        {
+            const bool isCached = this->cache.contains(candidate.coordinate);
+
+            if (!isCached && this->generating.size() >= this->settings.max_generating)
+            {
+                ++this->missing;
+                continue;
+            }
+
+            // only strictly further chunks make room, equally far ones would
+            // just trade places every tick
+            while (isAtLimit() && furthest != residents.end() && furthest->distance > candidate.distance)
+            {
+                evictFurthest();
+            }
+
+            if (isAtLimit())
+            {
+                break;
+            }
+
+            if (isCached)
+            {
+                Chunk             chunk      = *this->cache.take(candidate.coordinate);
+                const std::size_t chunkBytes = chunk.getMemoryUsage();
+
+                // the byte limit is only checked against what is already
+                // resident above, this chunk's size is known now
+                while (residentBytes + chunkBytes > this->settings.max_resident_bytes
+                    && furthest != residents.end() && furthest->distance > candidate.distance)
+                {
+                    evictFurthest();
+                }
+
+                if (residentBytes + chunkBytes > this->settings.max_resident_bytes)
+                {
+                    this->cache.insert(candidate.coordinate, std::move(chunk));
+                    break;
+                }
+
+                residentBytes += chunkBytes;
+                ++residentCount;
+                ++this->cache_hits_total;
+
+                storage.insertChunk(candidate.coordinate, std::move(chunk));
+                changes.loaded.push_back(candidate.coordinate);
+            }
+            else
+            {
+                this->generating.insert(candidate.coordinate);
+                newJobs.push_back(candidate.coordinate);
+            }
+        }
+
+        this->resident_chunks = residentCount;
+        this->resident_bytes  = residentBytes;
+
+        if (!newJobs.empty())
+        {
+            {
+                std::lock_guard lock {this->mutex};
+                this->jobs.insert(this->jobs.end(), newJobs.cbegin(), newJobs.cend());
+            }
+
+            this->job_available.notify_all();
+        }
+
+        return changes;
+    }
+
+    bool ChunkStreamer::isSettled() const
+    {
+        return this->missing == 0 && this->generating.empty();
+    }
+
+    ChunkStreamer::Statistics ChunkStreamer::getStatistics() const
+    {
+        return Statistics {
+            .resident_chunks          {this->resident_chunks},
+            .resident_bytes           {this->resident_bytes},
+            .cached_chunks            {this->cache.getChunkCount()},
+            .cached_bytes             {this->cache.getMemoryUsage()},
+            .generating               {this->generating.size()},
+            .generated_total          {this->generated_total},
+            .loaded_from_disk_total   {this->loaded_from_disk_total},
+            .saved_total              {this->saved_total},
+            .cache_hits_total         {this->cache_hits_total},
+            .evicted_total            {this->evicted_total},
+            .dropped_from_cache_total {this->cache.getDroppedCount()},
+            .limit_evictions_total    {this->limit_evictions_total},
+        };
+    }
+
+    const StreamingSettings& ChunkStreamer::getSettings() const
+    {
+        return this->settings;
+    }
+
+    void ChunkStreamer::markModified(ChunkCoordinate coordinate)
+    {
+        if (this->store != nullptr)
+        {
+            this->modified.insert(coordinate);
+        }
+    }
+
+    void ChunkStreamer::saveModified(const VoxelStorage& storage)
+    {
+        for (ChunkCoordinate coordinate : this->modified)
+        {
+            if (const Chunk* const chunk = storage.getChunk(coordinate); chunk != nullptr)
+            {
+                this->store->save(coordinate, *chunk);
+                ++this->saved_total;
+            }
+        }
+
+        this->modified.clear();
+    }
+
+    void ChunkStreamer::evict(VoxelStorage& storage, ChunkCoordinate coordinate, Changes& changes)
+    {
+        if (std::optional<Chunk> chunk = storage.removeChunk(coordinate); chunk.has_value())
+        {
+            // the cached copy can be dropped at any time, the saved one can't
+            if (this->modified.erase(coordinate) != 0)
+            {
+                this->store->save(coordinate, *chunk);
+                ++this->saved_total;
+            }
+
+            this->cache.insert(coordinate, std::move(*chunk));
+            changes.evicted.push_back(coordinate);
+            ++this->evicted_total;
+        }
+    }
+
+    void ChunkStreamer::work(std::stop_token stopToken)
+    {
+        while (true)
+        {
+            ChunkCoordinate coordinate;
+            {
+                std::unique_lock lock {this->mutex};
+
+                if (!this->job_available.wait(lock, stopToken, [this] { return !this->jobs.empty(); }))
+                {
+                    return;
+                }
+
+                coordinate = this->jobs.front();
+                this->jobs.pop_front();
+            }
+
+            std::optional<Chunk> chunk =
+                this->store != nullptr ? this->store->load(coordinate) : std::nullopt;
+            const bool isFromDisk = chunk.has_value();
+
+            if (!isFromDisk)
+            {
+                PROFILE_SCOPE("ChunkStreamer::generate");
+                chunk = this->generator(coordinate);
+            }
+
+            {
+                std::lock_guard lock {this->mutex};
+                this->finished.emplace_back(coordinate, std::move(*chunk));
+
+                if (isFromDisk)
+                {
+                    ++this->finished_from_disk;
+                }
+            }
+        }
+    }
+} // namespace world
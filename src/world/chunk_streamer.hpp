@@ -0,0 +1,138 @@
+#ifndef SRC_WORLD_CHUNK__STREAMER_HPP
+#define SRC_WORLD_CHUNK__STREAMER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "camera_view.hpp"
+#include "chunk_cache.hpp"
+#include "region_store.hpp"
+#include "voxel_storage.hpp"
+
+namespace world
+{
+    struct StreamingSettings
+    {
+        // horizontal, in chunks around the camera's chunk
+        std::int32_t load_radius;
+        // resident chunks further out than this are evicted, the gap to
+        // load_radius keeps chunks on the edge from loading and unloading
+        // every time the camera crosses a chunk border
+        std::int32_t unload_radius;
+        // chunk layers that are ever loaded, [min, max)
+        std::int32_t min_chunk_y;
+        std::int32_t max_chunk_y;
+
+        std::size_t max_resident_chunks;
+        std::size_t max_resident_bytes;
+        std::size_t max_cached_bytes;
+        // generation jobs queued or running at once
+        std::size_t max_generating;
+    };
+
+    /// @brief Keeps the chunks around the camera resident in a VoxelStorage.
+    ///
+    /// Missing chunks are taken from the ChunkCache, or loaded from the
+    /// RegionStore or generated on worker threads, nearest and inside the
+    /// frustum first. Chunks past unload_radius are moved to the cache, and
+    /// when the resident limits are hit the furthest chunks are evicted to
+    /// make room for nearer ones. Evicted chunks marked modified are saved
+    /// to the store first, unmodified ones can always be generated again.
+    class ChunkStreamer
+    {
+    public:
+        /// @brief Called on the worker threads
+        using Generator = std::function<Chunk(ChunkCoordinate)>;
+
+        /// @brief What update() changed in the storage, callers remesh around
+        /// these and free the meshes of evicted chunks
+        struct Changes
+        {
+            std::vector<ChunkCoordinate> loaded;
+            std::vector<ChunkCoordinate> evicted;
+        };
+
+        struct Statistics
+        {
+            std::size_t resident_chunks;
+            std::size_t resident_bytes;
+            std::size_t cached_chunks;
+            std::size_t cached_bytes;
+            std::size_t generating;
+
+            std::size_t generated_total;
+            // part of generated_total, read back from the store
+            std::size_t loaded_from_disk_total;
+            std::size_t saved_total;
+            std::size_t cache_hits_total;
+            std::size_t evicted_total;
+            std::size_t dropped_from_cache_total;
+            // evictions forced by max_resident_chunks or max_resident_bytes
+            std::size_t limit_evictions_total;
+        };
+
+        /// @param store may be null, then nothing is saved or loaded
+        ChunkStreamer(StreamingSettings, Generator, std::size_t workers, RegionStore* store = nullptr);
+        ~ChunkStreamer() = default;
+
+        ChunkStreamer(const ChunkStreamer&)            = delete;
+        ChunkStreamer(ChunkStreamer&&)                 = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+        ChunkStreamer& operator=(ChunkStreamer&&)      = delete;
+
+        /// @brief Inserts finished chunks, evicts and requests new ones
+        [[nodiscard]] Changes update(VoxelStorage&, const CameraView&);
+
+        /// @brief The resident chunk at @param coordinate was edited and is
+        /// saved when it's evicted
+        void markModified(ChunkCoordinate coordinate);
+        /// @brief Saves every modified resident chunk now, without evicting
+        void saveModified(const VoxelStorage&);
+
+        /// @brief Nothing in range is missing or being generated
+        [[nodiscard]] bool isSettled() const;
+        [[nodiscard]] Statistics getStatistics() const;
+        [[nodiscard]] const StreamingSettings& getSettings() const;
+
+    private:
+        void evict(VoxelStorage&, ChunkCoordinate, Changes&);
+        void work(std::stop_token);
+
+        StreamingSettings settings;
+        Generator         generator;
+        ChunkCache        cache;
+        RegionStore*      store;
+
+        // owning thread only
+        std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> generating;
+        std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> modified;
+        std::size_t missing;
+        std::size_t resident_chunks;
+        std::size_t resident_bytes;
+        std::size_t generated_total;
+        std::size_t cache_hits_total;
+        std::size_t loaded_from_disk_total;
+        std::size_t saved_total;
+        std::size_t evicted_total;
+        std::size_t limit_evictions_total;
+
+        // shared with the workers
+        std::mutex                                         mutex;
+        std::condition_variable_any                        job_available;
+        std::deque<ChunkCoordinate>                        jobs;
+        std::vector<std::pair<ChunkCoordinate, Chunk>>     finished;
+        std::size_t                                        finished_from_disk;
+
+        // last, so the workers are joined before anything they touch is destroyed
+        std::vector<std::jthread> workers;
+    }; // class ChunkStreamer
+} // namespace world
+
+#endif // SRC_WORLD_CHUNK__STREAMER_HPP
@@ -0,0 +1,172 @@
+#include <atomic>
+#include <bit>
+
+#include "entity_store.hpp"
+
+namespace world
+{
+    void EntityStore::destroy(Entity entity)
+    {
+        seb::assertFatal(this->isAlive(entity), "Destroyed an entity twice");
+
+        Slot& slot = this->slots[entity.index];
+
+        this->removeRow(slot.archetype, slot.row);
+
+        // every handle to it is stale from here on
+        ++slot.generation;
+        this->free_slots.push_back(entity.index);
+    }
+
+    bool EntityStore::isAlive(Entity entity) const
+    {
+        return entity.index < this->slots.size() && this->slots[entity.index].generation == entity.generation;
+    }
+
+    std::vector<std::size_t> EntityStore::getMatchingArchetypes(ComponentMask mask) const
+    {
+        std::vector<std::size_t> matching {};
+
+        for (std::size_t i = 0; i < this->archetypes.size(); ++i)
+        {
+            if ((this->archetypes[i].mask & mask) == mask)
+            {
+                matching.push_back(i);
+            }
+        }
+
+        return matching;
+    }
+
+    std::size_t EntityStore::getArchetypeSize(std::size_t archetype) const
+    {
+        return this->archetypes[archetype].entities.size();
+    }
+
+    std::size_t EntityStore::getEntityCount() const
+    {
+        return this->slots.size() - this->free_slots.size();
+    }
+
+    EntityStore::Statistics EntityStore::getStatistics() const
+    {
+        return Statistics {
+            .entities   {this->getEntityCount()},
+            .archetypes {this->archetypes.size()},
+            .free_slots {this->free_slots.size()},
+        };
+    }
+
+    std::size_t EntityStore::allocateComponentId()
+    {
+        static std::atomic<std::size_t> nextId {0};
+
+        const std::size_t id = nextId.fetch_add(1);
+
+        seb::assertFatal(id < MaxComponentTypes, "More than {} component types", MaxComponentTypes);
+
+        return id;
+    }
+
+    std::uint32_t EntityStore::findArchetype(ComponentMask mask) const
+    {
+        const auto found = this->archetype_indices.find(mask);
+
+        return found == this->archetype_indices.end() ? NoArchetype : found->second;
+    }
+
+    std::uint32_t EntityStore::insertArchetype(Archetype archetype)
+    {
+        const auto index = static_cast<std::uint32_t>(this->archetypes.size());
+
+        this->archetype_indices[archetype.mask] = index;
+        this->archetypes.push_back(std::move(archetype));
+
+        return index;
+    }
+
+    std::uint32_t EntityStore::getArchetypeLike(ComponentMask mask, std::uint32_t source)
+    {
+        if (const std::uint32_t existing = this->findArchetype(mask); existing != NoArchetype)
+        {
+            return existing;
+        }
+
+        Archetype archetype {.mask {mask}, .entities {}, .columns {}};
+
+        for (ComponentMask bits = mask; bits != 0; bits &= bits - 1)
+        {
+            const auto id = static_cast<std::size_t>(std::countr_zero(bits));
+
+            if (const std::unique_ptr<ColumnBase>& column = this->archetypes[source].columns[id]; column != nullptr)
+            {
+                archetype.columns[id] = column->makeEmpty();
+            }
+        }
+
+        return this->insertArchetype(std::move(archetype));
+    }
+
+    Entity EntityStore::allocateSlot(std::uint32_t archetype, std::size_t row)
+    {
+        std::uint32_t index = 0;
+
+        if (this->free_slots.empty())
+        {
+            index = static_cast<std::uint32_t>(this->slots.size());
+            this->slots.push_back(Slot {.generation {0}, .archetype {0}, .row {0}});
+        }
+        else
+        {
+            index = this->free_slots.back();
+            this->free_slots.pop_back();
+        }
+
+        Slot& slot     = this->slots[index];
+        slot.archetype = archetype;
+        slot.row       = static_cast<std::uint32_t>(row);
+
+        return Entity {.index {index}, .generation {slot.generation}};
+    }
+
+    void EntityStore::moveRow(Entity entity, std::uint32_t target)
+    {
+        Slot&               slot   = this->slots[entity.index];
+        const std::uint32_t source = slot.archetype;
+        const std::uint32_t row    = slot.row;
+        Archetype&          from   = this->archetypes[source];
+        Archetype&          to     = this->archetypes[target];
+
+        for (ComponentMask shared = from.mask & to.mask; shared != 0; shared &= shared - 1)
+        {
+            const auto id = static_cast<std::size_t>(std::countr_zero(shared));
+
+            from.columns[id]->moveRowTo(row, *to.columns[id]);
+        }
+
+        slot.archetype = target;
+        slot.row       = static_cast<std::uint32_t>(to.entities.size());
+        to.entities.push_back(entity);
+
+        // the moved from husks go with the row
+        this->removeRow(source, row);
+    }
+
+    void EntityStore::removeRow(std::uint32_t archetypeIndex, std::size_t row)
+    {
+        Archetype& archetype = this->archetypes[archetypeIndex];
+
+        for (ComponentMask bits = archetype.mask; bits != 0; bits &= bits - 1)
+        {
+            archetype.columns[static_cast<std::size_t>(std::countr_zero(bits))]->swapRemove(row);
+        }
+
+        if (row != archetype.entities.size() - 1)
+        {
+            archetype.entities[row] = archetype.entities.back();
+            this->slots[archetype.entities[row].index].row = static_cast<std::uint32_t>(row);
+        }
+
+        archetype.entities.pop_back();
+    }
+} // namespace world
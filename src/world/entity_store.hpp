@@ -0,0 +1,345 @@
+#ifndef SRC_WORLD_ENTITY__STORE_HPP
+#define SRC_WORLD_ENTITY__STORE_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sebib/seblog.hpp>
+
+namespace world
+{
+    /// @brief A handle to an entity of an EntityStore. It stays valid as the
+    /// entity gains and loses components and goes stale once the entity is
+    /// destroyed, even after its slot is reused
+    struct Entity
+    {
+        std::uint32_t index;
+        std::uint32_t generation;
+
+        [[nodiscard]] bool operator==(const Entity&) const = default;
+    };
+
+    /// @brief Bit per component type, see EntityStore::getComponentMask()
+    using ComponentMask = std::uint64_t;
+
+    /// @brief Entities and their components, grouped into archetypes by the
+    /// set of component types they have.
+    ///
+    /// Every archetype keeps one contiguous array per component type, its
+    /// rows parallel across them, so a query walks each matching
+    /// archetype's arrays front to back and never loads a component it
+    /// didn't ask for. Destroying an entity moves its archetype's last row
+    /// into its place, adding or removing a component moves the entity's row
+    /// to another archetype. Handles go through a slot per entity and
+    /// survive both, pointers and references to components don't.
+    ///
+    /// Any movable type is a component, up to MaxComponentTypes of them
+    /// across the program. Only forEachInRange() over disjoint components
+    /// may run on several threads at once, see SystemScheduler.
+    class EntityStore
+    {
+    public:
+        constexpr static std::size_t MaxComponentTypes = 64;
+
+        struct Statistics
+        {
+            std::size_t entities;
+            std::size_t archetypes;
+            // slots of destroyed entities waiting to be reused
+            std::size_t free_slots;
+        };
+
+        EntityStore()  = default;
+        ~EntityStore() = default;
+
+        EntityStore(const EntityStore&)            = delete;
+        EntityStore(EntityStore&&)                 = delete;
+        EntityStore& operator=(const EntityStore&) = delete;
+        EntityStore& operator=(EntityStore&&)      = delete;
+
+        /// @brief Ids are handed out in the order types are first used
+        template<class Component>
+        [[nodiscard]] static std::size_t getComponentId()
+        {
+            static_assert(!std::is_const_v<Component> && !std::is_reference_v<Component>);
+
+            static const std::size_t id = allocateComponentId();
+
+            return id;
+        }
+
+        /// @brief Constness is ignored
+        template<class... Components>
+        [[nodiscard]] static ComponentMask getComponentMask()
+        {
+            return ((ComponentMask {1} << getComponentId<std::remove_const_t<Components>>()) | ... | ComponentMask {0});
+        }
+
+        /// @brief An entity with exactly @param components
+        template<class... Components>
+        Entity create(Components... components)
+        {
+            const ComponentMask mask = getComponentMask<Components...>();
+
+            seb::assertFatal(
+                static_cast<std::size_t>(std::popcount(mask)) == sizeof...(Components),
+                "Created an entity with the same component twice");
+
+            std::uint32_t archetypeIndex = this->findArchetype(mask);
+
+            if (archetypeIndex == NoArchetype)
+            {
+                Archetype archetype {.mask {mask}, .entities {}, .columns {}};
+                ((archetype.columns[getComponentId<Components>()] = std::make_unique<Column<Components>>()), ...);
+
+                archetypeIndex = this->insertArchetype(std::move(archetype));
+            }
+
+            Archetype&   archetype = this->archetypes[archetypeIndex];
+            const Entity entity    = this->allocateSlot(archetypeIndex, archetype.entities.size());
+
+            archetype.entities.push_back(entity);
+            (getColumn<Components>(archetype).values.push_back(std::move(components)), ...);
+
+            return entity;
+        }
+
+        /// @brief The last row of the entity's archetype takes its place
+        void destroy(Entity);
+        /// @brief False once @param entity was destroyed
+        [[nodiscard]] bool isAlive(Entity entity) const;
+
+        /// @brief nullptr for stale handles and entities without the component
+        template<class Component>
+        [[nodiscard]] Component* get(Entity entity)
+        {
+            if (!this->isAlive(entity))
+            {
+                return nullptr;
+            }
+
+            const Slot& slot      = this->slots[entity.index];
+            Archetype&  archetype = this->archetypes[slot.archetype];
+
+            if ((archetype.mask & getComponentMask<Component>()) == 0)
+            {
+                return nullptr;
+            }
+
+            return &getColumn<Component>(archetype).values[slot.row];
+        }
+
+        template<class Component>
+        [[nodiscard]] const Component* get(Entity entity) const
+        {
+            return const_cast<EntityStore&>(*this).get<Component>(entity);
+        }
+
+        /// @brief Moves the entity to the archetype with @param component
+        /// too, or overwrites the one it already has
+        template<class Component>
+        void add(Entity entity, Component component)
+        {
+            seb::assertFatal(this->isAlive(entity), "Added a component to a destroyed entity");
+
+            if (Component* existing = this->get<Component>(entity); existing != nullptr)
+            {
+                *existing = std::move(component);
+                return;
+            }
+
+            const std::size_t   id     = getComponentId<Component>();
+            const std::uint32_t source = this->slots[entity.index].archetype;
+            const std::uint32_t target =
+                this->getArchetypeLike(this->archetypes[source].mask | getComponentMask<Component>(), source);
+
+            if (this->archetypes[target].columns[id] == nullptr)
+            {
+                this->archetypes[target].columns[id] = std::make_unique<Column<Component>>();
+            }
+
+            this->moveRow(entity, target);
+            getColumn<Component>(this->archetypes[target]).values.push_back(std::move(component));
+        }
+
+        /// @brief Moves the entity to the archetype without the component,
+        /// entities without it are left alone
+        template<class Component>
+        void remove(Entity entity)
+        {
+            seb::assertFatal(this->isAlive(entity), "Removed a component from a destroyed entity");
+
+            const std::uint32_t source = this->slots[entity.index].archetype;
+            const ComponentMask mask   = this->archetypes[source].mask;
+
+            if ((mask & getComponentMask<Component>()) != 0)
+            {
+                this->moveRow(entity, this->getArchetypeLike(mask & ~getComponentMask<Component>(), source));
+            }
+        }
+
+        /// @brief Calls @param function with the Components... of every
+        /// entity that has at least those, archetype by archetype. Components
+        /// that are only read should be const
+        template<class... Components, class Function>
+        void forEach(Function&& function)
+        {
+            const ComponentMask mask = getComponentMask<Components...>();
+
+            for (std::size_t i = 0; i < this->archetypes.size(); ++i)
+            {
+                if ((this->archetypes[i].mask & mask) == mask)
+                {
+                    this->forEachInRange<Components...>(i, 0, this->archetypes[i].entities.size(), function);
+                }
+            }
+        }
+
+        template<class... Components, class Function>
+        void forEach(Function&& function) const
+        {
+            static_assert((std::is_const_v<Components> && ...), "Const stores only hand out const components");
+
+            const_cast<EntityStore&>(*this).forEach<Components...>(std::forward<Function>(function));
+        }
+
+        /// @brief forEach() over rows [@param begin, @param end) of one
+        /// archetype that matches, see getMatchingArchetypes()
+        template<class... Components, class Function>
+        void forEachInRange(std::size_t archetypeIndex, std::size_t begin, std::size_t end, Function& function)
+        {
+            Archetype& archetype = this->archetypes[archetypeIndex];
+
+            seb::assertFatal(
+                (archetype.mask & getComponentMask<Components...>()) == getComponentMask<Components...>(),
+                "Iterated an archetype without every component of the query");
+
+            callForRows(
+                begin,
+                end,
+                function,
+                static_cast<Components*>(getColumn<std::remove_const_t<Components>>(archetype).values.data())...);
+        }
+
+        /// @brief Indices of the archetypes with at least @param mask
+        [[nodiscard]] std::vector<std::size_t> getMatchingArchetypes(ComponentMask mask) const;
+        [[nodiscard]] std::size_t getArchetypeSize(std::size_t archetype) const;
+
+        [[nodiscard]] std::size_t getEntityCount() const;
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        constexpr static std::uint32_t NoArchetype = std::numeric_limits<std::uint32_t>::max();
+
+        class ColumnBase
+        {
+        public:
+            ColumnBase()          = default;
+            virtual ~ColumnBase() = default;
+
+            ColumnBase(const ColumnBase&)            = delete;
+            ColumnBase(ColumnBase&&)                 = delete;
+            ColumnBase& operator=(const ColumnBase&) = delete;
+            ColumnBase& operator=(ColumnBase&&)      = delete;
+
+            /// @brief A column of the same type without any rows
+            [[nodiscard]] virtual std::unique_ptr<ColumnBase> makeEmpty() const = 0;
+            /// @brief Appends @param row to @param target, a column of the
+            /// same type, leaving a moved from value behind
+            virtual void moveRowTo(std::size_t row, ColumnBase& target) = 0;
+            /// @brief Moves the last row into @param row
+            virtual void swapRemove(std::size_t row) = 0;
+        };
+
+        template<class Component>
+        class Column final : public ColumnBase
+        {
+        public:
+            [[nodiscard]] std::unique_ptr<ColumnBase> makeEmpty() const override
+            {
+                return std::make_unique<Column>();
+            }
+
+            void moveRowTo(std::size_t row, ColumnBase& target) override
+            {
+                static_cast<Column&>(target).values.push_back(std::move(this->values[row]));
+            }
+
+            void swapRemove(std::size_t row) override
+            {
+                if (row != this->values.size() - 1)
+                {
+                    this->values[row] = std::move(this->values.back());
+                }
+
+                this->values.pop_back();
+            }
+
+            std::vector<Component> values;
+        };
+
+        struct Archetype
+        {
+            ComponentMask       mask;
+            // parallel to every column
+            std::vector<Entity> entities;
+            // by component id, null for those the archetype doesn't have
+            std::array<std::unique_ptr<ColumnBase>, MaxComponentTypes> columns;
+        };
+
+        /// @brief Where an entity's components are, generation is bumped
+        /// every time the slot's entity is destroyed
+        struct Slot
+        {
+            std::uint32_t generation;
+            std::uint32_t archetype;
+            std::uint32_t row;
+        };
+
+        [[nodiscard]] static std::size_t allocateComponentId();
+
+        template<class Component>
+        [[nodiscard]] static Column<Component>& getColumn(Archetype& archetype)
+        {
+            return static_cast<Column<Component>&>(*archetype.columns[getComponentId<Component>()]);
+        }
+
+        /// @brief One loop over raw arrays, the compiler sees every column
+        /// at once
+        template<class Function, class... Components>
+        static void callForRows(std::size_t begin, std::size_t end, Function& function, Components*... columns)
+        {
+            for (std::size_t row = begin; row < end; ++row)
+            {
+                function(columns[row]...);
+            }
+        }
+
+        [[nodiscard]] std::uint32_t findArchetype(ComponentMask) const;
+        [[nodiscard]] std::uint32_t insertArchetype(Archetype);
+        /// @brief The archetype with @param mask, created with empty columns
+        /// like those of @param source where they share components
+        [[nodiscard]] std::uint32_t getArchetypeLike(ComponentMask mask, std::uint32_t source);
+        [[nodiscard]] Entity allocateSlot(std::uint32_t archetype, std::size_t row);
+        /// @brief Moves every component the entity's archetype shares with
+        /// @param target over, the rest are dropped
+        void moveRow(Entity, std::uint32_t target);
+        /// @brief Swaps @param row out of @param archetype, fixing up the
+        /// slot of the entity that took its place
+        void removeRow(std::uint32_t archetype, std::size_t row);
+
+        std::vector<Archetype>                           archetypes;
+        std::unordered_map<ComponentMask, std::uint32_t> archetype_indices;
+        std::vector<Slot>                                slots;
+        std::vector<std::uint32_t>                       free_slots;
+    }; // class EntityStore
+} // namespace world
+
+#endif // SRC_WORLD_ENTITY__STORE_HPP
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <array>
+
+#include <util/profiler.hpp>
+
+#include "greedy_mesher.hpp"
+
+namespace world
+{
+    std::vector<GreedyQuad> meshGreedy(const PaddedChunk& chunk, AmbientOcclusion ambientOcclusion)
+    {
+        PROFILE_SCOPE("meshGreedy");
+
+        constexpr std::size_t Extent = ChunkExtent;
+
+        const std::span<const Voxel>       voxels = chunk.getVoxels();
+        const std::span<const PackedLight> lights = chunk.getLight();
+
+        // a face's voxel in the low bits, then its occlusion and its light,
+        // 0 for no face since air never has one
+        using Key = std::uint32_t;
+        constexpr Key NoFace = 0;
+
+        static_assert(sizeof(Voxel) == 2 && sizeof(FaceOcclusion) == 1 && sizeof(PackedLight) == 1);
+
+        std::vector<GreedyQuad> quads {};
+        std::array<Key, Extent * Extent> mask;
+
+        for (std::size_t f = 0; f < NumberOfFaces; ++f)
+        {
+            const Face     face = static_cast<Face>(f);
+            const FaceAxes axes = getFaceAxes(face);
+
+            const std::size_t normalStride = PaddedChunk::getStride(axes.normal);
+            const std::size_t uStride      = PaddedChunk::getStride(axes.u);
+            const std::size_t vStride      = PaddedChunk::getStride(axes.v);
+
+            // the neighbour that has to be air for the face to be visible
+            const std::ptrdiff_t facing = isPositive(face)
+                ? static_cast<std::ptrdiff_t>(normalStride)
+                : -static_cast<std::ptrdiff_t>(normalStride);
+
+            for (std::size_t slice = 0; slice < Extent; ++slice)
+            {
+                const std::size_t sliceBase = PaddedChunk::toPaddedIndex({0, 0, 0}) + slice * normalStride;
+                bool isEmpty = true;
+
+                for (std::size_t v = 0; v < Extent; ++v)
+                {
+                    for (std::size_t u = 0; u < Extent; ++u)
+                    {
+                        const std::size_t index = sliceBase + u * uStride + v * vStride;
+                        const Voxel voxel = voxels[index];
+                        const auto  air   = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) + facing);
+
+                        Key key = NoFace;
+
+                        if (voxel != AirVoxel && voxels[air] == AirVoxel)
+                        {
+                            const FaceOcclusion occlusion = ambientOcclusion == AmbientOcclusion::Bake
+                                ? getFaceOcclusion(voxels, air, uStride, vStride)
+                                : OpenFaceOcclusion;
+
+                            const PackedLight light = lights.empty() ? OpenSkyLight : lights[air];
+
+                            key = Key {voxel} | Key {occlusion} << 16 | Key {light} << 24;
+                        }
+
+                        mask[v * Extent + u] = key;
+                        isEmpty &= key == NoFace;
+                    }
+                }
+
+                if (isEmpty)
+                {
+                    continue;
+                }
+
+                for (std::size_t v = 0; v < Extent; ++v)
+                {
+                    std::size_t u = 0;
+
+                    while (u < Extent)
+                    {
+                        const Key key = mask[v * Extent + u];
+
+                        if (key == NoFace)
+                        {
+                            ++u;
+                            continue;
+                        }
+
+                        std::size_t width = 1;
+                        while (u + width < Extent && mask[v * Extent + u + width] == key)
+                        {
+                            ++width;
+                        }
+
+                        std::size_t height = 1;
+                        while (v + height < Extent)
+                        {
+                            const auto row = mask.cbegin() + static_cast<std::ptrdiff_t>((v + height) * Extent + u);
+
+                            if (!std::all_of(row, row + static_cast<std::ptrdiff_t>(width),
+                                [key](Key m) { return m == key; }))
+                            {
+                                break;
+                            }
+
+                            ++height;
+                        }
+
+                        for (std::size_t dv = 0; dv < height; ++dv)
+                        {
+                            const auto row = mask.begin() + static_cast<std::ptrdiff_t>((v + dv) * Extent + u);
+                            std::fill(row, row + static_cast<std::ptrdiff_t>(width), NoFace);
+                        }
+
+                        quads.push_back(GreedyQuad {
+                            .face      {face},
+                            .slice     {static_cast<std::uint8_t>(slice)},
+                            .u         {static_cast<std::uint8_t>(u)},
+                            .v         {static_cast<std::uint8_t>(v)},
+                            .width     {static_cast<std::uint8_t>(width)},
+                            .height    {static_cast<std::uint8_t>(height)},
+                            .voxel     {static_cast<Voxel>(key & 0xFFFF)},
+                            .occlusion {static_cast<FaceOcclusion>(key >> 16 & 0xFF)},
+                            .light     {static_cast<PackedLight>(key >> 24)},
+                        });
+
+                        u += width;
+                    }
+                }
+            }
+        }
+
+        return quads;
+    }
+} // namespace world
@@ -0,0 +1,134 @@
+#ifndef SRC_WORLD_GREEDY__MESHER_HPP
+#define SRC_WORLD_GREEDY__MESHER_HPP
+
+#include <compare>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "chunk_light.hpp"
+#include "padded_chunk.hpp"
+
+namespace world
+{
+    enum class Face : std::uint8_t
+    {
+        PositiveX = 0,
+        NegativeX = 1,
+        PositiveY = 2,
+        NegativeY = 3,
+        PositiveZ = 4,
+        NegativeZ = 5,
+    };
+    constexpr std::size_t NumberOfFaces = 6;
+
+    /// @brief The axes of a face's plane, chosen so that u × v points along
+    /// the face's positive normal axis
+    struct FaceAxes
+    {
+        std::int32_t normal;
+        std::int32_t u;
+        std::int32_t v;
+    };
+
+    [[nodiscard]] constexpr FaceAxes getFaceAxes(Face face)
+    {
+        switch (face)
+        {
+            case Face::PositiveX: case Face::NegativeX: return {.normal {0}, .u {1}, .v {2}};
+            case Face::PositiveY: case Face::NegativeY: return {.normal {1}, .u {2}, .v {0}};
+            case Face::PositiveZ: case Face::NegativeZ: return {.normal {2}, .u {0}, .v {1}};
+        }
+
+        return {.normal {0}, .u {1}, .v {2}};
+    }
+
+    [[nodiscard]] constexpr bool isPositive(Face face)
+    {
+        return (static_cast<std::uint8_t>(face) & 1) == 0;
+    }
+
+    /// @brief The unit vector @param face points along
+    [[nodiscard]] constexpr glm::i32vec3 getFaceNormal(Face face)
+    {
+        glm::i32vec3 normal {0, 0, 0};
+        normal[getFaceAxes(face).normal] = isPositive(face) ? 1 : -1;
+
+        return normal;
+    }
+
+    /// @brief Ambient occlusion of every corner of a face, 2 bits each from
+    /// 0, fully occluded, to 3, open. Corners are ordered (0, 0) (1, 0)
+    /// (1, 1) (0, 1) in the face's (u, v)
+    using FaceOcclusion = std::uint8_t;
+    constexpr FaceOcclusion OpenFaceOcclusion = 0xFF;
+
+    enum class AmbientOcclusion : bool
+    {
+        /// @brief Every corner open, faces merge on the voxel alone
+        Ignore,
+        Bake,
+    };
+
+    /// @brief Classic voxel ambient occlusion of a face whose air neighbour
+    /// is at @param facing, a toPaddedIndex of @param voxels. Each corner
+    /// looks at the two voxels beside it and the one diagonal to it in the
+    /// air's layer, two sides occlude fully whatever the diagonal is
+    [[nodiscard]] inline FaceOcclusion getFaceOcclusion(
+        std::span<const Voxel> voxels, std::size_t facing, std::size_t uStride, std::size_t vStride)
+    {
+        const auto isSolid = [&](std::size_t index) -> unsigned
+        {
+            return voxels[index] != AirVoxel ? 1U : 0U;
+        };
+
+        const unsigned uMinus = isSolid(facing - uStride);
+        const unsigned uPlus  = isSolid(facing + uStride);
+        const unsigned vMinus = isSolid(facing - vStride);
+        const unsigned vPlus  = isSolid(facing + vStride);
+
+        const auto corner = [](unsigned side1, unsigned side2, unsigned diagonal) -> unsigned
+        {
+            return side1 != 0 && side2 != 0 ? 0U : 3U - (side1 + side2 + diagonal);
+        };
+
+        return static_cast<FaceOcclusion>(
+            corner(uMinus, vMinus, isSolid(facing - uStride - vStride))
+            | corner(uPlus, vMinus, isSolid(facing + uStride - vStride)) << 2
+            | corner(uPlus, vPlus, isSolid(facing + uStride + vStride)) << 4
+            | corner(uMinus, vPlus, isSolid(facing - uStride + vStride)) << 6);
+    }
+
+    /// @brief A width x height rectangle of identical faces. (u, v) is the
+    /// minimum corner and slice the voxel layer along the normal axis the
+    /// faces belong to, all in chunk local voxels. Every face of a quad has
+    /// the same occlusion and light, so the quad's corners take them as is.
+    /// light is that of the air in front of the faces
+    struct GreedyQuad
+    {
+        Face          face;
+        std::uint8_t  slice;
+        std::uint8_t  u;
+        std::uint8_t  v;
+        std::uint8_t  width;
+        std::uint8_t  height;
+        Voxel         voxel;
+        FaceOcclusion occlusion;
+        PackedLight   light;
+
+        [[nodiscard]] auto operator<=>(const GreedyQuad&) const = default;
+    };
+
+    /// @brief Emits every solid voxel face that touches air, merged into
+    /// maximal rectangles of the same voxel, occlusion and light. Chunks
+    /// that aren't lit are lit as OpenSkyLight.
+    ///
+    /// Merging is canonical: in each slice rows are scanned in increasing v
+    /// and u, a quad starts at the first unmerged face, extends along u as
+    /// far as it can and then along v while whole rows match. Other meshers
+    /// following the same rule produce exactly the same quads.
+    [[nodiscard]] std::vector<GreedyQuad> meshGreedy(
+        const PaddedChunk&, AmbientOcclusion = AmbientOcclusion::Bake);
+} // namespace world
+
+#endif // SRC_WORLD_GREEDY__MESHER_HPP
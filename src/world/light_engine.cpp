@@ -0,0 +1,914 @@
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
+#include <util/profiler.hpp>
+
+#include "greedy_mesher.hpp"
+#include "light_engine.hpp"
+
+namespace
+{
+    using world::ChunkCoordinate;
+    using world::ChunkExtent;
+    using world::Face;
+    using world::LocalPosition;
+
+    constexpr std::int32_t LastLayer = ChunkExtent - 1;
+
+    /// @brief One step to a face neighbour, offset is along toLinearIndex
+    struct Step
+    {
+        Face           face;
+        std::int32_t   axis;
+        std::int32_t   sign;
+        std::ptrdiff_t offset;
+    };
+
+    constexpr std::array<Step, world::NumberOfFaces> Steps {{
+        {.face {Face::PositiveX}, .axis {0}, .sign {1},  .offset {1}},
+        {.face {Face::NegativeX}, .axis {0}, .sign {-1}, .offset {-1}},
+        {.face {Face::PositiveY}, .axis {1}, .sign {1},  .offset {ChunkExtent * ChunkExtent}},
+        {.face {Face::NegativeY}, .axis {1}, .sign {-1}, .offset {-ChunkExtent * ChunkExtent}},
+        {.face {Face::PositiveZ}, .axis {2}, .sign {1},  .offset {ChunkExtent}},
+        {.face {Face::NegativeZ}, .axis {2}, .sign {-1}, .offset {-ChunkExtent}},
+    }};
+
+    constexpr LocalPosition fromLinearIndex(std::size_t index)
+    {
+        const auto i = static_cast<std::int32_t>(index);
+
+        return {
+            i & LastLayer,
+            i >> (2 * world::ChunkExtentLog2),
+            (i >> world::ChunkExtentLog2) & LastLayer,
+        };
+    }
+
+    constexpr std::uint8_t toBit(Face face)
+    {
+        return static_cast<std::uint8_t>(1U << static_cast<std::uint8_t>(face));
+    }
+
+    /// @brief The faces of the chunk @param position lies on
+    constexpr std::uint8_t getBorderFaces(LocalPosition position)
+    {
+        unsigned faces = 0;
+
+        for (const Step& step : Steps)
+        {
+            const std::int32_t edge = step.sign > 0 ? LastLayer : 0;
+            faces |= position[step.axis] == edge ? toBit(step.face) : 0U;
+        }
+
+        return static_cast<std::uint8_t>(faces);
+    }
+
+    /// @brief Where @param step leads from @param position if it stays in
+    /// the chunk
+    constexpr bool isInside(LocalPosition position, const Step& step)
+    {
+        return step.sign > 0 ? position[step.axis] < LastLayer : position[step.axis] > 0;
+    }
+
+    /// @brief The voxel @param step leads to from @param position, in the
+    /// neighbouring chunk
+    constexpr std::uint16_t getCrossedIndex(LocalPosition position, const Step& step)
+    {
+        position[step.axis] = step.sign > 0 ? 0 : LastLayer;
+
+        return static_cast<std::uint16_t>(world::toLinearIndex(position));
+    }
+
+    constexpr ChunkCoordinate getNeighbour(ChunkCoordinate coordinate, const Step& step)
+    {
+        coordinate[step.axis] += step.sign;
+        return coordinate;
+    }
+} // namespace
+
+namespace world
+{
+    LightEngine::LightEngine(util::WorkerPool& pool_)
+        : pool {pool_}
+        , rounds {0}
+        , visited_voxels {0}
+        , queued_changes {0}
+        , spreading_changes {0}
+        , settled_changes {0}
+        , statistics {}
+        , thread {[this](std::stop_token stopToken)
+                  {
+                      this->work(stopToken);
+                  }}
+    {}
+
+    void LightEngine::addChunk(ChunkCoordinate coordinate, const Chunk& chunk)
+    {
+        this->queue(Change {
+            .kind     {ChangeKind::AddChunk},
+            .position {coordinate},
+            .after    {AirVoxel},
+            .chunk    {chunk},
+        });
+    }
+
+    void LightEngine::removeChunk(ChunkCoordinate coordinate)
+    {
+        this->queue(Change {
+            .kind     {ChangeKind::RemoveChunk},
+            .position {coordinate},
+            .after    {AirVoxel},
+            .chunk    {std::nullopt},
+        });
+    }
+
+    void LightEngine::updateVoxel(WorldPosition position, Voxel, Voxel after)
+    {
+        this->queue(Change {
+            .kind     {ChangeKind::UpdateVoxel},
+            .position {position},
+            .after    {after},
+            .chunk    {std::nullopt},
+        });
+    }
+
+    std::uint64_t LightEngine::getQueuedChanges() const
+    {
+        return this->queued_changes;
+    }
+
+    LightEngine::Collected LightEngine::collect()
+    {
+        std::vector<Baked>           finished {};
+        std::vector<ChunkCoordinate> staleChunks {};
+        std::uint64_t                settled = 0;
+        {
+            std::lock_guard lock {this->mutex};
+
+            finished.swap(this->baked);
+            staleChunks.swap(this->stale);
+            settled = this->settled_changes;
+        }
+
+        for (Baked& chunk : finished)
+        {
+            if (chunk.light.has_value())
+            {
+                this->collected_light.insert_or_assign(chunk.coordinate, std::move(*chunk.light));
+            }
+            else
+            {
+                this->collected_light.erase(chunk.coordinate);
+            }
+        }
+
+        // a chunk changed by several rounds is stale once
+        const std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> unique {staleChunks.cbegin(), staleChunks.cend()};
+
+        return Collected {
+            .stale           {unique.cbegin(), unique.cend()},
+            .settled_changes {settled},
+        };
+    }
+
+    void LightEngine::waitUntilSettled()
+    {
+        std::unique_lock lock {this->mutex};
+
+        this->changes_settled.wait(lock, [&]
+        {
+            return this->pending_changes.empty() && this->spreading_changes == 0;
+        });
+    }
+
+    bool LightEngine::isIdle() const
+    {
+        std::lock_guard lock {this->mutex};
+
+        return this->pending_changes.empty() && this->spreading_changes == 0 && this->baked.empty()
+            && this->stale.empty();
+    }
+
+    const ChunkLight* LightEngine::getLight(ChunkCoordinate coordinate) const
+    {
+        const auto found = this->collected_light.find(coordinate);
+
+        return found == this->collected_light.end() ? nullptr : &found->second;
+    }
+
+    PackedLight LightEngine::getVoxelLight(WorldPosition position) const
+    {
+        const ChunkLight* light = this->getLight(toChunkCoordinate(position));
+
+        if (light == nullptr)
+        {
+            return OpenSkyLight;
+        }
+
+        return light->get(toLinearIndex(toLocalPosition(position)));
+    }
+
+    LightEngine::Statistics LightEngine::getStatistics() const
+    {
+        Statistics current {};
+        {
+            std::lock_guard lock {this->mutex};
+
+            current                 = this->statistics;
+            current.pending_changes = this->pending_changes.size();
+        }
+
+        current.workers     = this->pool.getWorkerCount();
+        current.lit_chunks  = this->collected_light.size();
+        current.light_bytes = 0;
+
+        for (const auto& [coordinate, light] : this->collected_light)
+        {
+            current.light_bytes += light.getMemoryUsage();
+        }
+
+        return current;
+    }
+
+    void LightEngine::insertChunk(ChunkCoordinate coordinate, Chunk chunk)
+    {
+        ChunkState inserted {};
+        inserted.source = std::move(chunk);
+
+        this->chunks.insert_or_assign(coordinate, std::move(inserted));
+
+        // Light coming in from lit neighbours, their voxels facing this
+        // chunk spread again once their light is current
+        for (const Step& step : Steps)
+        {
+            const auto neighbour = this->chunks.find(getNeighbour(coordinate, step));
+
+            if (neighbour == this->chunks.end() || !neighbour->second.is_seeded)
+            {
+                continue;
+            }
+
+            ChunkState& state = neighbour->second;
+
+            // the chunk below gets its top relit from scratch, which spreads
+            // its sky light up again anyway
+            const bool isBelow = step.face == Face::NegativeY;
+
+            for (std::int32_t a = 0; a < ChunkExtent; ++a)
+            {
+                for (std::int32_t b = 0; b < ChunkExtent; ++b)
+                {
+                    LocalPosition facing {0, 0, 0};
+                    facing[step.axis]           = step.sign > 0 ? 0 : LastLayer;
+                    facing[(step.axis + 1) % 3] = a;
+                    facing[(step.axis + 2) % 3] = b;
+
+                    const auto index = static_cast<std::uint16_t>(toLinearIndex(facing));
+
+                    if (!isBelow && state.light.sky.get(index) > 1)
+                    {
+                        state.additions[static_cast<std::size_t>(Channel::Sky)].push_back(Node {index, 0, false});
+                    }
+
+                    if (state.light.block.get(index) > 1)
+                    {
+                        state.additions[static_cast<std::size_t>(Channel::Block)].push_back(Node {index, 0, false});
+                    }
+                }
+            }
+
+            if (!isBelow)
+            {
+                continue;
+            }
+
+            for (std::int32_t z = 0; z < ChunkExtent; ++z)
+            {
+                for (std::int32_t x = 0; x < ChunkExtent; ++x)
+                {
+                    const std::size_t  index = toLinearIndex({x, LastLayer, z});
+                    const std::uint8_t sky   = state.light.sky.get(index);
+
+                    if (sky != 0)
+                    {
+                        setLevel(state, Channel::Sky, index, 0);
+                        state.removals[static_cast<std::size_t>(Channel::Sky)].push_back(
+                            Node {static_cast<std::uint16_t>(index), sky, false});
+                    }
+                }
+            }
+        }
+    }
+
+    void LightEngine::eraseChunk(ChunkCoordinate coordinate)
+    {
+        this->chunks.erase(coordinate);
+
+        std::lock_guard lock {this->mutex};
+        this->baked.push_back(Baked {.coordinate {coordinate}, .light {std::nullopt}});
+    }
+
+    void LightEngine::setVoxel(WorldPosition position, Voxel after)
+    {
+        const ChunkCoordinate coordinate = toChunkCoordinate(position);
+        const LocalPosition   local      = toLocalPosition(position);
+        const auto            found      = this->chunks.find(coordinate);
+
+        if (found == this->chunks.end())
+        {
+            return;
+        }
+
+        // seeded from the copy once it's lit, which gets the edit instead
+        if (!found->second.is_seeded)
+        {
+            found->second.source->set(local, after);
+            return;
+        }
+
+        ChunkState&       state = found->second;
+        const std::size_t index = toLinearIndex(local);
+        const auto        node  = Node {static_cast<std::uint16_t>(index), 0, false};
+
+        state.opaque[index] = after != AirVoxel;
+
+        // whatever the voxel held is gone, what still reaches it comes back
+        // when its neighbours spread again
+        for (const Channel channel : {Channel::Sky, Channel::Block})
+        {
+            const std::uint8_t level = getChannel(state, channel).get(index);
+
+            if (level != 0)
+            {
+                setLevel(state, channel, index, 0);
+                state.removals[static_cast<std::size_t>(channel)].push_back(Node {node.index, level, false});
+            }
+        }
+
+        if (const std::uint8_t emission = getLightEmission(after); emission != 0)
+        {
+            setLevel(state, Channel::Block, index, emission);
+            state.additions[static_cast<std::size_t>(Channel::Block)].push_back(node);
+        }
+
+        if (after != AirVoxel)
+        {
+            return;
+        }
+
+        for (const Step& step : Steps)
+        {
+            ChunkState*   neighbour      = &state;
+            std::uint16_t neighbourIndex = 0;
+
+            if (isInside(local, step))
+            {
+                neighbourIndex = static_cast<std::uint16_t>(static_cast<std::ptrdiff_t>(index) + step.offset);
+            }
+            else
+            {
+                const auto other = this->chunks.find(getNeighbour(coordinate, step));
+
+                if (other == this->chunks.end() || !other->second.is_seeded)
+                {
+                    continue;
+                }
+
+                neighbour      = &other->second;
+                neighbourIndex = getCrossedIndex(local, step);
+            }
+
+            for (const Channel channel : {Channel::Sky, Channel::Block})
+            {
+                if (getChannel(*neighbour, channel).get(neighbourIndex) != 0)
+                {
+                    neighbour->additions[static_cast<std::size_t>(channel)].push_back(
+                        Node {neighbourIndex, 0, false});
+                }
+            }
+        }
+
+        if (local.y == LastLayer && !this->chunks.contains(coordinate + ChunkCoordinate {0, 1, 0}))
+        {
+            setLevel(state, Channel::Sky, index, MaxLightLevel);
+            state.additions[static_cast<std::size_t>(Channel::Sky)].push_back(node);
+        }
+    }
+
+    void LightEngine::propagate(std::vector<Change>& changes, std::stop_token stopToken)
+    {
+        PROFILE_SCOPE("LightEngine::propagate");
+
+        for (Change& change : changes)
+        {
+            switch (change.kind)
+            {
+            case ChangeKind::AddChunk:
+                this->insertChunk(change.position, std::move(*change.chunk));
+                break;
+            case ChangeKind::RemoveChunk:
+                this->eraseChunk(change.position);
+                break;
+            case ChangeKind::UpdateVoxel:
+                this->setVoxel(change.position, change.after);
+                break;
+            }
+        }
+
+        if (this->runPhase(Phase::Remove, stopToken))
+        {
+            (void)this->runPhase(Phase::Add, stopToken);
+        }
+    }
+
+    bool LightEngine::hasWork(const ChunkState& state, Phase phase) const
+    {
+        const auto isAnyQueued = [](const std::array<std::vector<Node>, NumberOfChannels>& queues)
+        {
+            return std::ranges::any_of(queues, [](const std::vector<Node>& queue) { return !queue.empty(); });
+        };
+
+        if (phase == Phase::Remove)
+        {
+            return isAnyQueued(state.removals) || isAnyQueued(state.incoming_removals);
+        }
+
+        return !state.is_seeded || isAnyQueued(state.additions) || isAnyQueued(state.incoming_additions);
+    }
+
+    bool LightEngine::runPhase(Phase phase, std::stop_token stopToken)
+    {
+        std::vector<Task> tasks {};
+
+        while (true)
+        {
+            if (stopToken.stop_requested())
+            {
+                return false;
+            }
+
+            tasks.clear();
+
+            for (auto& [coordinate, state] : this->chunks)
+            {
+                if (!this->hasWork(state, phase))
+                {
+                    continue;
+                }
+
+                tasks.push_back(Task {
+                    .coordinate   {coordinate},
+                    .state        {&state},
+                    .chunk        {state.source.has_value() ? &*state.source : nullptr},
+                    .is_sky_above {!this->chunks.contains(coordinate + ChunkCoordinate {0, 1, 0})},
+                    .crossings    {},
+                    .visited      {0},
+                });
+            }
+
+            if (tasks.empty())
+            {
+                return true;
+            }
+
+            this->runRound(tasks, phase);
+            ++this->rounds;
+
+            for (const Task& task : tasks)
+            {
+                this->visited_voxels += task.visited;
+
+                for (const Crossing& crossing : task.crossings)
+                {
+                    const auto target = this->chunks.find(crossing.target);
+
+                    // unseeded chunks have nothing to clear yet
+                    if (target == this->chunks.end()
+                        || (crossing.phase == Phase::Remove && !target->second.is_seeded))
+                    {
+                        continue;
+                    }
+
+                    auto& incoming = crossing.phase == Phase::Remove
+                        ? target->second.incoming_removals
+                        : target->second.incoming_additions;
+
+                    incoming[static_cast<std::size_t>(crossing.channel)].push_back(crossing.node);
+                }
+            }
+
+            this->bake(tasks);
+        }
+    }
+
+    void LightEngine::runRound(std::vector<Task>& tasks, Phase phase)
+    {
+        PROFILE_SCOPE("LightEngine::runRound");
+
+        this->pool.run(tasks.size(), [&](std::size_t i)
+        {
+            runTask(tasks[i], phase);
+        });
+    }
+
+    void LightEngine::bake(const std::vector<Task>& tasks)
+    {
+        std::vector<Baked>           changed {};
+        std::vector<ChunkCoordinate> staleChunks {};
+
+        for (const Task& task : tasks)
+        {
+            ChunkState& state = *task.state;
+
+            if (!state.is_changed)
+            {
+                continue;
+            }
+
+            changed.push_back(Baked {.coordinate {task.coordinate}, .light {state.light}});
+            staleChunks.push_back(task.coordinate);
+
+            for (const Step& step : Steps)
+            {
+                if ((state.changed_faces & toBit(step.face)) != 0)
+                {
+                    staleChunks.push_back(getNeighbour(task.coordinate, step));
+                }
+            }
+
+            state.is_changed    = false;
+            state.changed_faces = 0;
+        }
+
+        if (changed.empty())
+        {
+            return;
+        }
+
+        std::lock_guard lock {this->mutex};
+
+        this->baked.insert(
+            this->baked.end(), std::make_move_iterator(changed.begin()), std::make_move_iterator(changed.end()));
+        this->stale.insert(this->stale.end(), staleChunks.cbegin(), staleChunks.cend());
+    }
+
+    void LightEngine::runTask(Task& task, Phase phase)
+    {
+        ChunkState& state = *task.state;
+
+        if (phase == Phase::Remove)
+        {
+            for (std::size_t c = 0; c < NumberOfChannels; ++c)
+            {
+                for (const Node node : state.incoming_removals[c])
+                {
+                    clearNeighbour(state, static_cast<Channel>(c), node.index, node.level, node.is_downward);
+                }
+
+                state.incoming_removals[c].clear();
+            }
+
+            clear(task);
+            return;
+        }
+
+        if (!state.is_seeded)
+        {
+            seed(task);
+
+            state.source.reset();
+            task.chunk = nullptr;
+        }
+
+        for (std::size_t c = 0; c < NumberOfChannels; ++c)
+        {
+            NibbleArray& light = getChannel(state, static_cast<Channel>(c));
+
+            for (const Node node : state.incoming_additions[c])
+            {
+                if (!state.opaque[node.index] && light.get(node.index) < node.level)
+                {
+                    setLevel(state, static_cast<Channel>(c), node.index, node.level);
+                    state.additions[c].push_back(node);
+                }
+            }
+
+            state.incoming_additions[c].clear();
+        }
+
+        spread(task);
+    }
+
+    void LightEngine::seed(Task& task)
+    {
+        PROFILE_SCOPE("LightEngine::seed");
+
+        ChunkState& state = *task.state;
+        state.is_seeded = true;
+        // it had no light before, even staying dark is a change
+        state.is_changed = true;
+
+        auto& skyAdditions   = state.additions[static_cast<std::size_t>(Channel::Sky)];
+        auto& blockAdditions = state.additions[static_cast<std::size_t>(Channel::Block)];
+
+        const std::uint8_t topFace = toBit(Face::PositiveY);
+
+        const std::optional<Voxel> uniform = task.chunk->getUniformVoxel();
+
+        if (uniform.has_value() && *uniform != AirVoxel && getLightEmission(*uniform) == 0)
+        {
+            state.opaque.set();
+            return;
+        }
+
+        // open sky over air, every face but the top spreads into the
+        // neighbours
+        if (uniform == AirVoxel)
+        {
+            if (!task.is_sky_above)
+            {
+                return;
+            }
+
+            state.light.sky.fill(MaxLightLevel);
+            state.is_changed    = true;
+            state.changed_faces = static_cast<std::uint8_t>((1U << NumberOfFaces) - 1);
+
+            for (std::size_t index = 0; index < ChunkVolume; ++index)
+            {
+                if ((getBorderFaces(fromLinearIndex(index)) & ~topFace) != 0)
+                {
+                    skyAdditions.push_back(Node {static_cast<std::uint16_t>(index), 0, false});
+                }
+            }
+
+            return;
+        }
+
+        std::array<Voxel, ChunkVolume> voxels;
+        task.chunk->unpack(voxels);
+
+        for (std::size_t index = 0; index < ChunkVolume; ++index)
+        {
+            state.opaque[index] = voxels[index] != AirVoxel;
+
+            if (const std::uint8_t emission = getLightEmission(voxels[index]); emission != 0)
+            {
+                setLevel(state, Channel::Block, index, emission);
+                blockAdditions.push_back(Node {static_cast<std::uint16_t>(index), 0, false});
+            }
+        }
+
+        if (!task.is_sky_above)
+        {
+            return;
+        }
+
+        // full sky light falls down every column to the first opaque voxel
+        for (std::int32_t z = 0; z < ChunkExtent; ++z)
+        {
+            for (std::int32_t x = 0; x < ChunkExtent; ++x)
+            {
+                for (std::int32_t y = LastLayer; y >= 0; --y)
+                {
+                    const std::size_t index = toLinearIndex({x, y, z});
+
+                    if (state.opaque[index])
+                    {
+                        break;
+                    }
+
+                    setLevel(state, Channel::Sky, index, MaxLightLevel);
+                }
+            }
+        }
+
+        // only the lit voxels next to unlit air or another chunk have
+        // anywhere to spread
+        for (std::size_t index = 0; index < ChunkVolume; ++index)
+        {
+            if (state.light.sky.get(index) != MaxLightLevel)
+            {
+                continue;
+            }
+
+            const LocalPosition position = fromLinearIndex(index);
+            bool isFrontier = (getBorderFaces(position) & ~topFace) != 0;
+
+            for (const Step& step : Steps)
+            {
+                if (isFrontier || step.axis == 1 || !isInside(position, step))
+                {
+                    continue;
+                }
+
+                const auto next = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) + step.offset);
+                isFrontier = !state.opaque[next] && state.light.sky.get(next) != MaxLightLevel;
+            }
+
+            if (isFrontier)
+            {
+                skyAdditions.push_back(Node {static_cast<std::uint16_t>(index), 0, false});
+            }
+        }
+    }
+
+    void LightEngine::spread(Task& task)
+    {
+        ChunkState& state = *task.state;
+
+        for (std::size_t c = 0; c < NumberOfChannels; ++c)
+        {
+            const auto         channel = static_cast<Channel>(c);
+            NibbleArray&       light   = getChannel(state, channel);
+            std::vector<Node>& queue   = state.additions[c];
+
+            // spreading appends to queue, so nodes are copied out by index
+            for (std::size_t head = 0; head < queue.size(); ++head)
+            {
+                const std::size_t  index = queue[head].index;
+                const std::uint8_t level = light.get(index);
+
+                if (level <= 1)
+                {
+                    continue;
+                }
+
+                const LocalPosition position = fromLinearIndex(index);
+
+                for (const Step& step : Steps)
+                {
+                    const bool isFalling = channel == Channel::Sky && step.face == Face::NegativeY
+                        && level == MaxLightLevel;
+                    const auto received = static_cast<std::uint8_t>(isFalling ? level : level - 1);
+
+                    if (!isInside(position, step))
+                    {
+                        task.crossings.push_back(Crossing {
+                            .target  {getNeighbour(task.coordinate, step)},
+                            .channel {channel},
+                            .phase   {Phase::Add},
+                            .node    {getCrossedIndex(position, step), received, false},
+                        });
+                        continue;
+                    }
+
+                    const auto next = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) + step.offset);
+
+                    if (!state.opaque[next] && light.get(next) < received)
+                    {
+                        setLevel(state, channel, next, received);
+                        queue.push_back(Node {static_cast<std::uint16_t>(next), 0, false});
+                    }
+                }
+            }
+
+            task.visited += queue.size();
+            queue.clear();
+        }
+    }
+
+    void LightEngine::clear(Task& task)
+    {
+        ChunkState& state = *task.state;
+
+        for (std::size_t c = 0; c < NumberOfChannels; ++c)
+        {
+            const auto         channel = static_cast<Channel>(c);
+            std::vector<Node>& queue   = state.removals[c];
+
+            for (std::size_t head = 0; head < queue.size(); ++head)
+            {
+                const Node          node     = queue[head];
+                const LocalPosition position = fromLinearIndex(node.index);
+
+                for (const Step& step : Steps)
+                {
+                    const bool isDownward = step.face == Face::NegativeY;
+
+                    if (!isInside(position, step))
+                    {
+                        task.crossings.push_back(Crossing {
+                            .target  {getNeighbour(task.coordinate, step)},
+                            .channel {channel},
+                            .phase   {Phase::Remove},
+                            .node    {getCrossedIndex(position, step), node.level, isDownward},
+                        });
+                        continue;
+                    }
+
+                    clearNeighbour(
+                        state,
+                        channel,
+                        static_cast<std::size_t>(static_cast<std::ptrdiff_t>(node.index) + step.offset),
+                        node.level,
+                        isDownward);
+                }
+            }
+
+            task.visited += queue.size();
+            queue.clear();
+        }
+    }
+
+    NibbleArray& LightEngine::getChannel(ChunkState& state, Channel channel)
+    {
+        return channel == Channel::Sky ? state.light.sky : state.light.block;
+    }
+
+    void LightEngine::setLevel(ChunkState& state, Channel channel, std::size_t index, std::uint8_t level)
+    {
+        getChannel(state, channel).set(index, level);
+
+        state.is_changed = true;
+        state.changed_faces |= getBorderFaces(fromLinearIndex(index));
+    }
+
+    void LightEngine::clearNeighbour(
+        ChunkState& state, Channel channel, std::size_t index, std::uint8_t removed, bool isDownward)
+    {
+        const std::uint8_t level = getChannel(state, channel).get(index);
+
+        if (level == 0)
+        {
+            return;
+        }
+
+        // only emitters are opaque and lit, they keep their own light
+        const bool isFalling = channel == Channel::Sky && isDownward
+            && removed == MaxLightLevel && level == MaxLightLevel;
+
+        if (!state.opaque[index] && (level < removed || isFalling))
+        {
+            setLevel(state, channel, index, 0);
+            state.removals[static_cast<std::size_t>(channel)].push_back(
+                Node {static_cast<std::uint16_t>(index), level, false});
+            return;
+        }
+
+        state.additions[static_cast<std::size_t>(channel)].push_back(
+            Node {static_cast<std::uint16_t>(index), 0, false});
+    }
+
+    void LightEngine::queue(Change change)
+    {
+        {
+            std::lock_guard lock {this->mutex};
+            this->pending_changes.push_back(std::move(change));
+        }
+
+        ++this->queued_changes;
+        this->changes_queued.notify_one();
+    }
+
+    void LightEngine::work(std::stop_token stopToken)
+    {
+        util::profiler::setThreadName("Light");
+
+        while (true)
+        {
+            std::vector<Change> changes {};
+            {
+                std::unique_lock lock {this->mutex};
+
+                const bool isQueued = this->changes_queued.wait(lock, stopToken, [&]
+                {
+                    return !this->pending_changes.empty();
+                });
+
+                if (!isQueued)
+                {
+                    return;
+                }
+
+                changes.swap(this->pending_changes);
+                this->spreading_changes = changes.size();
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+
+            this->rounds         = 0;
+            this->visited_voxels = 0;
+            this->propagate(changes, stopToken);
+
+            const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+            {
+                std::lock_guard lock {this->mutex};
+
+                this->settled_changes += this->spreading_changes;
+                this->spreading_changes = 0;
+
+                this->statistics.rounds           = this->rounds;
+                this->statistics.visited_voxels   = this->visited_voxels;
+                this->statistics.propagation_time = time;
+                this->statistics.rounds_total += this->rounds;
+                this->statistics.visited_voxels_total += this->visited_voxels;
+                this->statistics.propagation_time_total += time;
+            }
+
+            this->changes_settled.notify_all();
+        }
+    }
+} // namespace world
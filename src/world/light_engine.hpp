@@ -0,0 +1,266 @@
+#ifndef SRC_WORLD_LIGHT__ENGINE_HPP
+#define SRC_WORLD_LIGHT__ENGINE_HPP
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <util/worker_pool.hpp>
+
+#include "chunk_light.hpp"
+#include "voxel_storage.hpp"
+
+namespace world
+{
+    /// @brief Sky and block light of every resident chunk, spread by flood
+    /// fill and updated incrementally.
+    ///
+    /// Light drops by one per voxel of air it crosses, except sky light at
+    /// full strength which falls straight down without losing any. Chunks
+    /// without a chunk above are under the open sky. Removing light clears
+    /// everything the removed level could have lit and then refills it from
+    /// whatever is still lit around it, so an edit only ever touches the
+    /// voxels its light reached.
+    ///
+    /// Changes are queued and spread on the engine's own thread, so nothing
+    /// waits for light. Every chunk keeps its own queues and a propagation
+    /// drains them in rounds, each chunk a task of a util::WorkerPool
+    /// writing only its own light. Light crossing a chunk's border is handed
+    /// to the neighbour between rounds. All removals finish before any light
+    /// is added back. The light of every chunk a round changed is handed
+    /// back through collect() as soon as the round finishes, rather than
+    /// once the whole propagation settles. Chunks are lit from a copy taken
+    /// when they are added, the engine never reads a VoxelStorage.
+    ///
+    /// Everything but the engine's thread must be called from one thread.
+    class LightEngine
+    {
+    public:
+        struct Statistics
+        {
+            std::size_t workers;
+            // as of the last collect()
+            std::size_t lit_chunks;
+            std::size_t light_bytes;
+            // queued but not yet spread
+            std::size_t pending_changes;
+
+            // of the last propagation
+            std::size_t rounds;
+            // voxels taken off a queue
+            std::size_t visited_voxels;
+            std::chrono::duration<double> propagation_time;
+
+            // of every propagation so far
+            std::size_t rounds_total;
+            std::size_t visited_voxels_total;
+            std::chrono::duration<double> propagation_time_total;
+        };
+
+        /// @brief What the rounds finished since the last collect() changed
+        struct Collected
+        {
+            // chunks whose meshes are out of date: those whose light changed
+            // and the neighbours of any whose border did
+            std::vector<ChunkCoordinate> stale;
+            // of the changes queued so far, those whose light has settled
+            std::uint64_t settled_changes;
+        };
+
+        /// @param pool runs every round's chunks, and must outlive the engine
+        explicit LightEngine(util::WorkerPool& pool);
+        ~LightEngine() = default;
+
+        LightEngine(const LightEngine&)            = delete;
+        LightEngine(LightEngine&&)                 = delete;
+        LightEngine& operator=(const LightEngine&) = delete;
+        LightEngine& operator=(LightEngine&&)      = delete;
+
+        /// @brief Lights @param chunk, just inserted at @param coordinate.
+        /// The chunk below is relit from its top, it may have been lit as if
+        /// under the open sky
+        void addChunk(ChunkCoordinate coordinate, const Chunk& chunk);
+        /// @brief Drops the chunk's light, its neighbours keep theirs
+        void removeChunk(ChunkCoordinate);
+        /// @brief Call after the voxel at @param position was changed from
+        /// @param before to @param after
+        void updateVoxel(WorldPosition position, Voxel before, Voxel after);
+        /// @brief Every addChunk(), removeChunk() and updateVoxel() so far
+        [[nodiscard]] std::uint64_t getQueuedChanges() const;
+
+        /// @brief Takes the light of every round finished since the last
+        /// call, getLight() returns it from then on
+        [[nodiscard]] Collected collect();
+        /// @brief Blocks until every change queued so far has settled
+        void waitUntilSettled();
+        /// @brief Nothing is queued, spreading or left to collect()
+        [[nodiscard]] bool isIdle() const;
+
+        /// @brief As of the last collect(), nullptr for chunks without light
+        [[nodiscard]] const ChunkLight* getLight(ChunkCoordinate) const;
+        /// @brief OpenSkyLight outside of lit chunks
+        [[nodiscard]] PackedLight getVoxelLight(WorldPosition) const;
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        enum class Channel : std::uint8_t
+        {
+            Sky   = 0,
+            Block = 1,
+        };
+        constexpr static std::size_t NumberOfChannels = 2;
+
+        enum class Phase : std::uint8_t
+        {
+            Remove,
+            Add,
+        };
+
+        enum class ChangeKind : std::uint8_t
+        {
+            AddChunk,
+            RemoveChunk,
+            UpdateVoxel,
+        };
+
+        /// @brief A call waiting for the engine's thread, position is the
+        /// chunk's coordinate unless it's an UpdateVoxel
+        struct Change
+        {
+            ChangeKind           kind;
+            WorldPosition        position;
+            Voxel                after;
+            std::optional<Chunk> chunk;
+        };
+
+        /// @brief A chunk's light as a round left it, nullopt once the
+        /// chunk is removed
+        struct Baked
+        {
+            ChunkCoordinate           coordinate;
+            std::optional<ChunkLight> light;
+        };
+
+        /// @brief A voxel of a queue. Additions read the level from the
+        /// light, removals carry the level that was cleared
+        struct Node
+        {
+            std::uint16_t index;
+            std::uint8_t  level;
+            // removals only, the node was cleared by the voxel above it
+            bool          is_downward;
+        };
+
+        /// @brief Light leaving a chunk during a round, level is what the
+        /// neighbour's voxel receives or, for removals, the removed level
+        struct Crossing
+        {
+            ChunkCoordinate target;
+            Channel         channel;
+            Phase           phase;
+            Node            node;
+        };
+
+        struct ChunkState
+        {
+            ChunkLight               light;
+            std::bitset<ChunkVolume> opaque;
+            // lit from the voxels on the first round that adds light
+            bool                     is_seeded;
+            // those voxels, dropped once it's seeded
+            std::optional<Chunk>     source;
+
+            // what this chunk still has to spread or clear
+            std::array<std::vector<Node>, NumberOfChannels> additions;
+            std::array<std::vector<Node>, NumberOfChannels> removals;
+            // crossings from neighbours, applied at the start of a round
+            std::array<std::vector<Node>, NumberOfChannels> incoming_additions;
+            std::array<std::vector<Node>, NumberOfChannels> incoming_removals;
+
+            bool         is_changed;
+            // bit per Face whose outermost layer of voxels changed
+            std::uint8_t changed_faces;
+        };
+
+        struct Task
+        {
+            ChunkCoordinate       coordinate;
+            ChunkState*           state;
+            const Chunk*          chunk;
+            bool                  is_sky_above;
+            std::vector<Crossing> crossings;
+            std::size_t           visited;
+        };
+
+        void insertChunk(ChunkCoordinate, Chunk);
+        void eraseChunk(ChunkCoordinate);
+        void setVoxel(WorldPosition, Voxel after);
+
+        /// @brief Applies @param changes and spreads them until the light
+        /// settles or @param stopToken is set
+        void propagate(std::vector<Change>& changes, std::stop_token stopToken);
+        [[nodiscard]] bool hasWork(const ChunkState&, Phase) const;
+        /// @brief Runs @param phase on every chunk with work for it until
+        /// none has any left, false if it stopped first
+        bool runPhase(Phase, std::stop_token);
+        /// @brief Every task once, on the pool
+        void runRound(std::vector<Task>& tasks, Phase);
+        /// @brief Hands the light of every chunk @param tasks changed to
+        /// collect(), and which meshes it made stale
+        void bake(const std::vector<Task>& tasks);
+
+        static void runTask(Task&, Phase);
+        static void seed(Task&);
+        static void spread(Task&);
+        static void clear(Task&);
+
+        [[nodiscard]] static NibbleArray& getChannel(ChunkState&, Channel);
+        /// @brief Also records what changed for bake() to hand over
+        static void setLevel(ChunkState&, Channel, std::size_t index, std::uint8_t level);
+        /// @brief The removal rule for the voxel at @param index, next to
+        /// one whose @param removed level was just cleared. Voxels that level
+        /// could have lit are cleared too, brighter ones will light the gap
+        static void clearNeighbour(
+            ChunkState&, Channel, std::size_t index, std::uint8_t removed, bool isDownward);
+
+        void queue(Change);
+        void work(std::stop_token);
+
+        util::WorkerPool& pool;
+
+        // the engine's thread only
+        std::unordered_map<ChunkCoordinate, ChunkState, ChunkCoordinateHash> chunks;
+        std::size_t rounds;
+        std::size_t visited_voxels;
+
+        // the calling thread only, as of the last collect()
+        std::unordered_map<ChunkCoordinate, ChunkLight, ChunkCoordinateHash> collected_light;
+        std::uint64_t queued_changes;
+
+        mutable std::mutex           mutex;
+        std::condition_variable_any  changes_queued;
+        std::condition_variable_any  changes_settled;
+        std::vector<Change>          pending_changes;
+        // taken by the engine's thread and still spreading
+        std::size_t                  spreading_changes;
+        std::uint64_t                settled_changes;
+        // in the order the rounds finished
+        std::vector<Baked>           baked;
+        std::vector<ChunkCoordinate> stale;
+        Statistics                   statistics;
+
+        // last, so it's joined before anything it touches is destroyed
+        std::jthread thread;
+    }; // class LightEngine
+} // namespace world
+
+#endif // SRC_WORLD_LIGHT__ENGINE_HPP
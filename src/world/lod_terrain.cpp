@@ -0,0 +1,377 @@
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "lod_terrain.hpp"
+
+namespace
+{
+    // per level, nodes are cheap to mesh and levels mesh side by side
+    constexpr std::size_t MaxNodesInFlight = 16;
+    // nodes are only ever evicted by distance, this never binds
+    constexpr std::size_t MaxResidentNodes = std::size_t {1} << 20;
+} // namespace
+
+namespace world
+{
+    LodRings::LodRings(
+        const std::array<std::int32_t, LodLevelCount>& radii,
+        ChunkCoordinate center_,
+        const ColumnCounts& residentColumns)
+        : radii_squared {}
+        , center {center_.x, 0, center_.z}
+        , resident_columns {&residentColumns}
+    {
+        for (std::size_t i = 0; i < LodLevelCount; ++i)
+        {
+            this->radii_squared[i] = std::int64_t {radii[i]} * radii[i];
+        }
+    }
+
+    std::optional<std::size_t> LodRings::getLevel(ChunkCoordinate column) const
+    {
+        if (this->resident_columns->contains(column))
+        {
+            return 0;
+        }
+
+        const std::int64_t dx = column.x - this->center.x;
+        const std::int64_t dz = column.z - this->center.z;
+
+        for (std::size_t i = 0; i < LodLevelCount; ++i)
+        {
+            if (dx * dx + dz * dz <= this->radii_squared[i])
+            {
+                return i + 1;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    PaddedChunk::ColumnMask LodRings::getColumnMask(std::size_t level, ChunkCoordinate node) const
+    {
+        const std::int32_t scale = getLodScale(level);
+        const std::int32_t stride = scale + 2;
+        // cells per chunk are a power of two, shifting rounds the border's
+        // -1 down into the previous chunk
+        const auto cellShift = ChunkExtentLog2 - static_cast<std::int32_t>(level);
+
+        // the node's chunk columns plus one on every side, which is all the
+        // padded border can reach
+        std::array<bool, Signature {}.size()> isDrawn {};
+        for (std::int32_t dz = -1; dz <= scale; ++dz)
+        {
+            for (std::int32_t dx = -1; dx <= scale; ++dx)
+            {
+                isDrawn[static_cast<std::size_t>((dz + 1) * stride + dx + 1)] =
+                    this->getLevel({node.x * scale + dx, 0, node.z * scale + dz}) == level;
+            }
+        }
+
+        PaddedChunk::ColumnMask mask {};
+        for (std::int32_t z = -1; z <= ChunkExtent; ++z)
+        {
+            for (std::int32_t x = -1; x <= ChunkExtent; ++x)
+            {
+                mask[PaddedChunk::toColumnIndex(x, z)] =
+                    isDrawn[static_cast<std::size_t>(((z >> cellShift) + 1) * stride + (x >> cellShift) + 1)];
+            }
+        }
+
+        return mask;
+    }
+
+    LodRings::Signature LodRings::getSignature(std::size_t level, ChunkCoordinate node) const
+    {
+        const std::int32_t scale = getLodScale(level);
+
+        Signature   signature {};
+        std::size_t bit = 0;
+
+        for (std::int32_t dz = -1; dz <= scale; ++dz)
+        {
+            for (std::int32_t dx = -1; dx <= scale; ++dx)
+            {
+                signature[bit++] = this->getLevel({node.x * scale + dx, 0, node.z * scale + dz}) == level;
+            }
+        }
+
+        return signature;
+    }
+
+    LodTerrain::Level::Level(
+        std::size_t level_,
+        const LodSettings& settings,
+        Generator generator,
+        std::size_t workers,
+        LodTerrain& terrain)
+        : level {level_}
+        , scale {getLodScale(level_)}
+        , storage {}
+        , layers {}
+        , signatures {}
+        , streamer {
+            StreamingSettings {
+                // a node partly inside the radius still draws, and one past
+                // that pads it
+                .load_radius         {settings.radii[level_ - 1] / getLodScale(level_) + 2},
+                .unload_radius       {settings.radii[level_ - 1] / getLodScale(level_) + 3},
+                .min_chunk_y         {toLodNode({0, settings.min_chunk_y, 0}, level_).y},
+                .max_chunk_y         {toLodNode({0, settings.max_chunk_y - 1, 0}, level_).y + 1},
+                .max_resident_chunks {MaxResidentNodes},
+                .max_resident_bytes  {settings.max_resident_bytes},
+                .max_cached_bytes    {settings.max_cached_bytes},
+                .max_generating      {workers * 4},
+            },
+            [generator = std::move(generator), cellScale = getLodScale(level_)](ChunkCoordinate node)
+            {
+                return generator(node, cellScale);
+            },
+            workers
+        }
+        , meshing {workers, MaxNodesInFlight, [&terrain, level_](ChunkCoordinate node)
+        {
+            return std::optional {terrain.rings->getColumnMask(level_, node)};
+        }}
+    {}
+
+    LodTerrain::LodTerrain(LodSettings settings_, Generator generator, std::size_t workersPerLevel)
+        : settings {settings_}
+    {
+        seb::assertFatal(
+            this->settings.radii[0] > 0 && std::ranges::is_sorted(this->settings.radii),
+            "Level radii have to grow outwards");
+
+        for (std::size_t i = 0; i < LodLevelCount; ++i)
+        {
+            this->levels[i] = std::make_unique<Level>(i + 1, this->settings, generator, workersPerLevel, *this);
+        }
+    }
+
+    void LodTerrain::recordFullResolutionChanges(const ChunkStreamer::Changes& changes)
+    {
+        for (ChunkCoordinate chunk : changes.loaded)
+        {
+            const ChunkCoordinate column {chunk.x, 0, chunk.z};
+
+            if (this->resident_columns[column]++ == 0)
+            {
+                this->changed_columns.insert(column);
+            }
+        }
+
+        for (ChunkCoordinate chunk : changes.evicted)
+        {
+            const ChunkCoordinate column {chunk.x, 0, chunk.z};
+            const auto            found = this->resident_columns.find(column);
+
+            if (found != this->resident_columns.end() && --found->second == 0)
+            {
+                this->resident_columns.erase(found);
+                this->changed_columns.insert(column);
+            }
+        }
+    }
+
+    LodTerrain::Changes LodTerrain::update(const CameraView& view)
+    {
+        PROFILE_SCOPE("LodTerrain::update");
+
+        ChunkCoordinate center = toChunkCoordinate(WorldPosition {glm::floor(view.position)});
+        center.y = 0;
+
+        const bool hasMoved = this->last_center != center;
+
+        this->last_center = center;
+        this->rings.emplace(this->settings.radii, center, this->resident_columns);
+
+        Changes changes {};
+
+        for (const std::unique_ptr<Level>& level : this->levels)
+        {
+            const auto scale = static_cast<float>(level->scale);
+
+            // node space is world space shrunk by the scale
+            const CameraView levelView {
+                .position        {view.position / scale},
+                .view_projection {view.view_projection * glm::scale(glm::mat4 {1.0f}, glm::vec3 {scale})},
+            };
+
+            const ChunkStreamer::Changes streamed = level->streamer.update(level->storage, levelView);
+
+            for (ChunkCoordinate node : streamed.loaded)
+            {
+                ++level->layers[{node.x, 0, node.z}];
+
+                level->meshing.markDirty(node);
+                markNeighboursDirty(*level, node);
+            }
+
+            for (ChunkCoordinate node : streamed.evicted)
+            {
+                const ChunkCoordinate column {node.x, 0, node.z};
+
+                if (const auto found = level->layers.find(column); found != level->layers.end() && --found->second == 0)
+                {
+                    level->layers.erase(found);
+                    level->signatures.erase(column);
+                }
+
+                changes.evicted.emplace_back(level->level, node);
+                markNeighboursDirty(*level, node);
+            }
+
+            // Rings only move when the camera crosses into another chunk
+            // column, and only the first level borders the full resolution
+            // columns
+            std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> columns {};
+
+            if (hasMoved)
+            {
+                for (const auto& [column, layerCount] : level->layers)
+                {
+                    columns.insert(column);
+                }
+            }
+            else
+            {
+                for (ChunkCoordinate node : streamed.loaded)
+                {
+                    columns.insert({node.x, 0, node.z});
+                }
+
+                if (level->level == 1)
+                {
+                    for (ChunkCoordinate changed : this->changed_columns)
+                    {
+                        for (std::int32_t dz = -1; dz <= 1; ++dz)
+                        {
+                            for (std::int32_t dx = -1; dx <= 1; ++dx)
+                            {
+                                const ChunkCoordinate node = toLodNode(changed + ChunkCoordinate {dx, 0, dz}, 1);
+
+                                if (level->layers.contains({node.x, 0, node.z}))
+                                {
+                                    columns.insert({node.x, 0, node.z});
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (ChunkCoordinate column : columns)
+            {
+                this->refreshColumn(*level, column);
+            }
+
+            level->meshing.dispatch(level->storage, levelView);
+        }
+
+        this->changed_columns.clear();
+
+        return changes;
+    }
+
+    std::vector<LodTerrain::Result> LodTerrain::collect(std::size_t maxResults)
+    {
+        std::vector<Result> results {};
+
+        for (const std::unique_ptr<Level>& level : this->levels)
+        {
+            if (results.size() >= maxResults)
+            {
+                break;
+            }
+
+            for (MeshingPipeline::Result& result : level->meshing.collect(maxResults - results.size()))
+            {
+                results.push_back(Result {
+                    .level {level->level},
+                    .node  {result.coordinate},
+                    .mesh  {std::move(result.mesh)},
+                });
+            }
+        }
+
+        return results;
+    }
+
+    bool LodTerrain::isResident(std::size_t level, ChunkCoordinate node) const
+    {
+        return this->levels.at(level - 1)->storage.getChunk(node) != nullptr;
+    }
+
+    const LodSettings& LodTerrain::getSettings() const
+    {
+        return this->settings;
+    }
+
+    std::array<LodTerrain::LevelStatistics, LodLevelCount> LodTerrain::getStatistics() const
+    {
+        std::array<LevelStatistics, LodLevelCount> statistics {};
+
+        for (std::size_t i = 0; i < LodLevelCount; ++i)
+        {
+            const ChunkStreamer::Statistics streaming = this->levels[i]->streamer.getStatistics();
+
+            statistics[i] = LevelStatistics {
+                .resident_nodes      {this->levels[i]->storage.getChunkCount()},
+                .resident_bytes      {streaming.resident_bytes},
+                .generating          {streaming.generating},
+                .meshing_queue_depth {this->levels[i]->meshing.getStatistics().getQueueDepth()},
+            };
+        }
+
+        return statistics;
+    }
+
+    void LodTerrain::markNeighboursDirty(Level& level, ChunkCoordinate node)
+    {
+        const std::array<ChunkCoordinate, 6> neighbours {
+            node + ChunkCoordinate {1, 0, 0},
+            node + ChunkCoordinate {-1, 0, 0},
+            node + ChunkCoordinate {0, 1, 0},
+            node + ChunkCoordinate {0, -1, 0},
+            node + ChunkCoordinate {0, 0, 1},
+            node + ChunkCoordinate {0, 0, -1},
+        };
+
+        for (ChunkCoordinate neighbour : neighbours)
+        {
+            if (level.storage.getChunk(neighbour) != nullptr)
+            {
+                level.meshing.markDirty(neighbour);
+            }
+        }
+    }
+
+    void LodTerrain::refreshColumn(Level& level, ChunkCoordinate column)
+    {
+        const LodRings::Signature signature = this->rings->getSignature(level.level, column);
+
+        if (const auto [existing, isNew] = level.signatures.try_emplace(column, signature); !isNew)
+        {
+            if (existing->second == signature)
+            {
+                return;
+            }
+
+            existing->second = signature;
+        }
+
+        const StreamingSettings& streaming = level.streamer.getSettings();
+
+        for (std::int32_t y = streaming.min_chunk_y; y < streaming.max_chunk_y; ++y)
+        {
+            if (level.storage.getChunk({column.x, y, column.z}) != nullptr)
+            {
+                level.meshing.markDirty({column.x, y, column.z});
+            }
+        }
+    }
+} // namespace world
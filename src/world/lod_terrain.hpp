@@ -0,0 +1,190 @@
+#ifndef SRC_WORLD_LOD__TERRAIN_HPP
+#define SRC_WORLD_LOD__TERRAIN_HPP
+
+#include <array>
+#include <bitset>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "camera_view.hpp"
+#include "chunk_streamer.hpp"
+#include "meshing_pipeline.hpp"
+#include "padded_chunk.hpp"
+#include "voxel_storage.hpp"
+
+namespace world
+{
+    /// Past the full resolution chunks the world is drawn in coarser levels.
+    /// A node of level L is a Chunk of cells getLodScale(L) voxels wide, so
+    /// it covers getLodScale(L) chunks along each axis and its coordinate is
+    /// toLodNode() of any chunk it covers.
+    constexpr std::size_t LodLevelCount = 3;
+
+    [[nodiscard]] constexpr std::int32_t getLodScale(std::size_t level)
+    {
+        return std::int32_t {1} << level;
+    }
+
+    [[nodiscard]] constexpr ChunkCoordinate toLodNode(ChunkCoordinate chunk, std::size_t level)
+    {
+        const auto shift = static_cast<std::int32_t>(level);
+
+        return {chunk.x >> shift, chunk.y >> shift, chunk.z >> shift};
+    }
+
+    /// @brief Chunk columns are keyed by their chunk coordinate with y = 0
+    using ColumnCounts = std::unordered_map<ChunkCoordinate, std::size_t, ChunkCoordinateHash>;
+
+    /// @brief Which level draws each chunk column.
+    ///
+    /// Columns with a resident full resolution chunk are level 0, every
+    /// other column belongs to the first level whose radius it is inside.
+    /// Each level only meshes its own columns and reads the others as air,
+    /// so no two levels ever draw the same place and the faces left open on
+    /// a ring's borders hang down past the neighbouring ring's surface as
+    /// skirts, hiding the cracks between the two resolutions.
+    class LodRings
+    {
+    public:
+        /// @brief Enough bits for any level's columns plus a border of one
+        using Signature = std::bitset<
+            static_cast<std::size_t>((getLodScale(LodLevelCount) + 2) * (getLodScale(LodLevelCount) + 2))>;
+
+        /// @param radii outer radius of levels 1 through LodLevelCount, in
+        /// chunks horizontally around @param center's column
+        LodRings(
+            const std::array<std::int32_t, LodLevelCount>& radii,
+            ChunkCoordinate center,
+            const ColumnCounts& residentColumns);
+
+        /// @brief nullopt past the last radius, nothing draws the column
+        [[nodiscard]] std::optional<std::size_t> getLevel(ChunkCoordinate column) const;
+        /// @brief The columns of @param node's PaddedChunk, border included,
+        /// that @param level draws
+        [[nodiscard]] PaddedChunk::ColumnMask getColumnMask(std::size_t level, ChunkCoordinate node) const;
+        /// @brief Which chunk columns of @param node and the ring of columns
+        /// around it @param level draws, changes whenever the node's mask does
+        [[nodiscard]] Signature getSignature(std::size_t level, ChunkCoordinate node) const;
+
+    private:
+        std::array<std::int64_t, LodLevelCount> radii_squared;
+        ChunkCoordinate                         center;
+        const ColumnCounts*                     resident_columns;
+    }; // class LodRings
+
+    struct LodSettings
+    {
+        // outer radius of levels 1 through LodLevelCount in chunks, the
+        // first has to cover everything the ChunkStreamer keeps resident
+        std::array<std::int32_t, LodLevelCount> radii;
+        // chunk layers that are ever loaded at full resolution, [min, max)
+        std::int32_t min_chunk_y;
+        std::int32_t max_chunk_y;
+
+        // per level
+        std::size_t max_resident_bytes;
+        std::size_t max_cached_bytes;
+    };
+
+    /// @brief Streams, masks and meshes the nodes of every level around the
+    /// camera.
+    ///
+    /// Each level is a ChunkStreamer and a MeshingPipeline working in its
+    /// own node space, fed a CameraView scaled down to match, so they load
+    /// and mesh nearest first exactly as they do for chunks. Nodes are
+    /// remeshed whenever the columns they draw change, as the camera moves
+    /// or full resolution chunks come and go.
+    class LodTerrain
+    {
+    public:
+        /// @brief Called on worker threads, cells are @param scale voxels wide
+        using Generator = std::function<Chunk(ChunkCoordinate node, std::int32_t scale)>;
+
+        struct Result
+        {
+            // in [1, LodLevelCount]
+            std::size_t     level;
+            ChunkCoordinate node;
+            ChunkMesh       mesh;
+        };
+
+        struct Changes
+        {
+            // (level, node) of nodes whose meshes have to go
+            std::vector<std::pair<std::size_t, ChunkCoordinate>> evicted;
+        };
+
+        struct LevelStatistics
+        {
+            std::size_t resident_nodes;
+            std::size_t resident_bytes;
+            std::size_t generating;
+            std::size_t meshing_queue_depth;
+        };
+
+        LodTerrain(LodSettings, Generator, std::size_t workersPerLevel);
+        ~LodTerrain() = default;
+
+        LodTerrain(const LodTerrain&)            = delete;
+        LodTerrain(LodTerrain&&)                 = delete;
+        LodTerrain& operator=(const LodTerrain&) = delete;
+        LodTerrain& operator=(LodTerrain&&)      = delete;
+
+        /// @brief Tracks which columns the full resolution level draws
+        void recordFullResolutionChanges(const ChunkStreamer::Changes&);
+        /// @brief Streams nodes in and out and dispatches the ones whose
+        /// meshes are out of date
+        [[nodiscard]] Changes update(const CameraView&);
+        /// @brief At most @param maxResults meshes, spread over the levels
+        [[nodiscard]] std::vector<Result> collect(std::size_t maxResults);
+
+        [[nodiscard]] bool isResident(std::size_t level, ChunkCoordinate node) const;
+        [[nodiscard]] const LodSettings& getSettings() const;
+        /// @brief Indexed by level - 1
+        [[nodiscard]] std::array<LevelStatistics, LodLevelCount> getStatistics() const;
+
+    private:
+        struct Level
+        {
+            Level(std::size_t level, const LodSettings&, Generator, std::size_t workers, LodTerrain&);
+
+            std::size_t   level;
+            std::int32_t  scale;
+            VoxelStorage  storage;
+            // layers resident in each node column, and what it drew when it
+            // was last dispatched
+            std::unordered_map<ChunkCoordinate, std::size_t, ChunkCoordinateHash>          layers;
+            std::unordered_map<ChunkCoordinate, LodRings::Signature, ChunkCoordinateHash> signatures;
+
+            // declared last, their workers go first
+            ChunkStreamer   streamer;
+            MeshingPipeline meshing;
+        };
+
+        /// @brief Marks @param node's resident neighbours dirty, they mesh
+        /// against it
+        static void markNeighboursDirty(Level&, ChunkCoordinate node);
+        /// @brief Marks every resident layer of @param column dirty if what
+        /// it draws changed
+        void refreshColumn(Level&, ChunkCoordinate column);
+
+        LodSettings settings;
+
+        // full resolution chunks resident in each chunk column, and the
+        // columns that gained or lost all of them since the last update
+        ColumnCounts                                             resident_columns;
+        std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> changed_columns;
+
+        std::optional<ChunkCoordinate> last_center;
+        // valid during update(), the meshing pipelines mask with it
+        std::optional<LodRings>        rings;
+
+        std::array<std::unique_ptr<Level>, LodLevelCount> levels;
+    }; // class LodTerrain
+} // namespace world
+
+#endif // SRC_WORLD_LOD__TERRAIN_HPP
@@ -0,0 +1,246 @@
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <util/profiler.hpp>
+
+#include "binary_mesher.hpp"
+#include "meshing_pipeline.hpp"
+
+namespace
+{
+    void pushRolling(std::deque<std::chrono::duration<double>>& window,
+        std::chrono::duration<double> value, std::size_t size)
+    {
+        window.push_back(value);
+
+        if (window.size() > size)
+        {
+            window.pop_front();
+        }
+    }
+
+    std::chrono::duration<double> getAverage(const std::deque<std::chrono::duration<double>>& window)
+    {
+        if (window.empty())
+        {
+            return std::chrono::duration<double> {0.0};
+        }
+
+        std::chrono::duration<double> total {0.0};
+        for (std::chrono::duration<double> value : window)
+        {
+            total += value;
+        }
+
+        return total / static_cast<double>(window.size());
+    }
+} // namespace
+
+namespace world
+{
+    std::size_t MeshingPipeline::Statistics::getQueueDepth() const
+    {
+        return this->dirty + this->queued + this->meshing + this->completed;
+    }
+
+    std::size_t MeshingPipeline::getDefaultWorkerCount()
+    {
+        const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    MeshingPipeline::MeshingPipeline(std::size_t workerCount, std::size_t maxInFlight, ColumnMasker columnMasker)
+        : max_in_flight {maxInFlight}
+        , column_masker {std::move(columnMasker)}
+        , meshed_total {0}
+        , meshing {0}
+    {
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            this->workers.emplace_back([this, i](std::stop_token stopToken)
+            {
+                this->work(stopToken, i);
+            });
+        }
+    }
+
+    void MeshingPipeline::markDirty(ChunkCoordinate coordinate)
+    {
+        // latency counts from the first edit that made the chunk dirty
+        this->dirty.try_emplace(coordinate, Clock::now());
+    }
+
+    void MeshingPipeline::dispatch(const VoxelStorage& storage, const CameraView& view, const LightEngine* light)
+    {
+        PROFILE_SCOPE("MeshingPipeline::dispatch");
+
+        if (this->in_flight.size() >= this->max_in_flight || this->dirty.empty())
+        {
+            return;
+        }
+
+        const ChunkPrioritizer prioritizer {view};
+
+        struct Candidate
+        {
+            float           priority;
+            ChunkCoordinate coordinate;
+        };
+
+        std::vector<Candidate> candidates {};
+        candidates.reserve(this->dirty.size());
+
+        for (const auto& [coordinate, dirtiedAt] : this->dirty)
+        {
+            if (this->in_flight.contains(coordinate))
+            {
+                continue;
+            }
+
+            candidates.push_back(Candidate {
+                .priority   {prioritizer.getPriority(coordinate)},
+                .coordinate {coordinate},
+            });
+        }
+
+        const std::size_t count = std::min(this->max_in_flight - this->in_flight.size(), candidates.size());
+        const auto        last  = candidates.begin() + static_cast<std::ptrdiff_t>(count);
+
+        std::ranges::partial_sort(candidates, last, {}, &Candidate::priority);
+
+        std::vector<Job> newJobs {};
+        newJobs.reserve(count);
+
+        const Clock::time_point now = Clock::now();
+
+        for (auto candidate = candidates.begin(); candidate != last; ++candidate)
+        {
+            const auto dirtyEntry = this->dirty.find(candidate->coordinate);
+
+            this->in_flight.emplace(candidate->coordinate, dirtyEntry->second);
+            this->dirty.erase(dirtyEntry);
+
+            newJobs.push_back(Job {
+                .snapshot      {takeChunkSnapshot(storage, candidate->coordinate, light)},
+                .snapshot_time {now},
+                .mask          {this->column_masker ? this->column_masker(candidate->coordinate) : std::nullopt},
+            });
+        }
+
+        {
+            std::lock_guard lock {this->mutex};
+
+            for (Job& job : newJobs)
+            {
+                this->jobs.push_back(std::move(job));
+            }
+        }
+
+        this->job_available.notify_all();
+    }
+
+    std::vector<MeshingPipeline::Result> MeshingPipeline::collect(std::size_t maxResults)
+    {
+        PROFILE_SCOPE("MeshingPipeline::collect");
+
+        std::vector<Result> results {};
+        {
+            std::lock_guard lock {this->mutex};
+
+            const std::size_t count = std::min(maxResults, this->finished.size());
+            const auto        last  = this->finished.begin() + static_cast<std::ptrdiff_t>(count);
+
+            results.assign(std::make_move_iterator(this->finished.begin()), std::make_move_iterator(last));
+            this->finished.erase(this->finished.begin(), last);
+        }
+
+        const Clock::time_point now = Clock::now();
+
+        for (const Result& result : results)
+        {
+            const auto flight = this->in_flight.find(result.coordinate);
+
+            pushRolling(this->latencies, now - flight->second, StatisticsWindow);
+            this->in_flight.erase(flight);
+            ++this->meshed_total;
+        }
+
+        return results;
+    }
+
+    bool MeshingPipeline::isIdle() const
+    {
+        return this->dirty.empty() && this->in_flight.empty();
+    }
+
+    MeshingPipeline::Statistics MeshingPipeline::getStatistics() const
+    {
+        std::lock_guard lock {this->mutex};
+
+        return Statistics {
+            .workers           {this->workers.size()},
+            .dirty             {this->dirty.size()},
+            .queued            {this->jobs.size()},
+            .meshing           {this->meshing},
+            .completed         {this->finished.size()},
+            .meshed_total      {this->meshed_total},
+            .average_mesh_time {getAverage(this->mesh_times)},
+            .average_latency   {getAverage(this->latencies)},
+            .worst_latency     {
+                this->latencies.empty()
+                ? std::chrono::duration<double> {0.0}
+                : *std::ranges::max_element(this->latencies)
+            },
+        };
+    }
+
+    void MeshingPipeline::work(std::stop_token stopToken, std::size_t workerIndex)
+    {
+        util::profiler::setThreadName(fmt::format("Mesher {}", workerIndex));
+
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock {this->mutex};
+
+                if (!this->job_available.wait(lock, stopToken, [this] { return !this->jobs.empty(); }))
+                {
+                    return;
+                }
+
+                job = std::move(this->jobs.front());
+                this->jobs.pop_front();
+                ++this->meshing;
+            }
+
+            const Clock::time_point start = Clock::now();
+
+            PaddedChunk padded {job.snapshot};
+
+            if (job.mask.has_value())
+            {
+                padded.keepColumns(*job.mask);
+            }
+
+            ChunkMesh mesh = buildChunkMesh(meshBinary(padded));
+            mesh.connectivity = ChunkConnectivity::compute(padded);
+
+            const std::chrono::duration<double> meshTime = Clock::now() - start;
+
+            {
+                std::lock_guard lock {this->mutex};
+
+                this->finished.push_back(Result {
+                    .coordinate    {job.snapshot.coordinate},
+                    .mesh          {std::move(mesh)},
+                    .snapshot_time {job.snapshot_time},
+                });
+                pushRolling(this->mesh_times, meshTime, StatisticsWindow);
+                --this->meshing;
+            }
+        }
+    }
+} // namespace world
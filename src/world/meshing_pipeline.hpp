@@ -0,0 +1,121 @@
+#ifndef SRC_WORLD_MESHING__PIPELINE_HPP
+#define SRC_WORLD_MESHING__PIPELINE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "camera_view.hpp"
+#include "chunk_mesh.hpp"
+#include "padded_chunk.hpp"
+
+namespace world
+{
+    /// @brief Meshes dirty chunks on worker threads.
+    ///
+    /// The owning thread marks chunks dirty and calls dispatch() and collect()
+    /// once per tick. dispatch() only snapshots the ChunkPrioritizer's first
+    /// chunks until max_in_flight chunks are queued, meshing or waiting to
+    /// be collected, so priorities stay current as the camera moves and the
+    /// per tick cost is bounded no matter how many chunks are dirty. A chunk
+    /// is never meshed twice at once; edits made while it is in flight keep
+    /// it dirty and it is dispatched again after its result was collected.
+    class MeshingPipeline
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Result
+        {
+            ChunkCoordinate coordinate;
+            ChunkMesh       mesh;
+            // when the voxels were copied, edits after it aren't in the mesh
+            Clock::time_point snapshot_time;
+        };
+
+        struct Statistics
+        {
+            std::size_t workers;
+            std::size_t dirty;     // waiting to be dispatched
+            std::size_t queued;    // snapshotted, waiting for a worker
+            std::size_t meshing;   // on a worker right now
+            std::size_t completed; // waiting to be collected
+            std::size_t meshed_total;
+
+            // rolling over the last StatisticsWindow chunks
+            std::chrono::duration<double> average_mesh_time; // on the worker
+            std::chrono::duration<double> average_latency;   // marked dirty to collected
+            std::chrono::duration<double> worst_latency;
+
+            [[nodiscard]] std::size_t getQueueDepth() const;
+        };
+
+        /// @brief Called on the owning thread as a chunk is dispatched,
+        /// columns without a bit are meshed as air. nullopt keeps them all
+        using ColumnMasker = std::function<std::optional<PaddedChunk::ColumnMask>(ChunkCoordinate)>;
+
+        /// @brief All but one hardware thread, at least one
+        [[nodiscard]] static std::size_t getDefaultWorkerCount();
+
+        /// @param maxInFlight should be a couple of ticks worth of collect()
+        MeshingPipeline(std::size_t workers, std::size_t maxInFlight, ColumnMasker = {});
+        ~MeshingPipeline() = default;
+
+        MeshingPipeline(const MeshingPipeline&)            = delete;
+        MeshingPipeline(MeshingPipeline&&)                 = delete;
+        MeshingPipeline& operator=(const MeshingPipeline&) = delete;
+        MeshingPipeline& operator=(MeshingPipeline&&)      = delete;
+
+        void markDirty(ChunkCoordinate);
+        /// @param light is snapshotted along with the voxels, meshes are
+        /// drawn under the open sky without it
+        void dispatch(const VoxelStorage&, const CameraView&, const LightEngine* light = nullptr);
+        /// @brief At most @param maxResults finished meshes, in completion order
+        [[nodiscard]] std::vector<Result> collect(std::size_t maxResults);
+
+        /// @brief Nothing dirty, queued or waiting to be collected
+        [[nodiscard]] bool isIdle() const;
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        constexpr static std::size_t StatisticsWindow = 256;
+
+        struct Job
+        {
+            ChunkSnapshot                           snapshot;
+            Clock::time_point                       snapshot_time;
+            std::optional<PaddedChunk::ColumnMask>  mask;
+        };
+
+        void work(std::stop_token, std::size_t workerIndex);
+
+        std::size_t  max_in_flight;
+        ColumnMasker column_masker;
+
+        // owning thread only
+        std::unordered_map<ChunkCoordinate, Clock::time_point, ChunkCoordinateHash> dirty;
+        std::unordered_map<ChunkCoordinate, Clock::time_point, ChunkCoordinateHash> in_flight;
+        std::deque<std::chrono::duration<double>> latencies;
+        std::size_t meshed_total;
+
+        // shared with the workers
+        mutable std::mutex                        mutex;
+        std::condition_variable_any               job_available;
+        std::deque<Job>                           jobs;
+        std::vector<Result>                       finished;
+        std::size_t                               meshing;
+        std::deque<std::chrono::duration<double>> mesh_times;
+
+        // last, so the workers are joined before anything they touch is destroyed
+        std::vector<std::jthread> workers;
+    }; // class MeshingPipeline
+} // namespace world
+
+#endif // SRC_WORLD_MESHING__PIPELINE_HPP
@@ -0,0 +1,404 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif // __AVX2__
+
+#include <sebib/seblog.hpp>
+
+#include "noise.hpp"
+
+namespace
+{
+    constexpr std::uint32_t PrimeX  = 0x8DA6B343;
+    constexpr std::uint32_t PrimeY  = 0xD8163841;
+    constexpr std::uint32_t PrimeZ  = 0xCB1AB31F;
+    constexpr std::uint32_t Mix     = 0x27D4EB2D;
+    constexpr std::uint32_t SignBit = 0x80000000;
+
+    // 2D samples already stay within [-1, 1], the 3D gradients' longer
+    // diagonals reach about 1.2
+    constexpr float Scale3 = 0.85f;
+
+    // Octave seeds only need to differ, the golden ratio spreads them out
+    constexpr std::uint32_t OctaveSeedStep = 0x9E3779B9;
+
+    /// @brief The top three bits pick the signs of a (±1, ±1, ±1) gradient
+    std::uint32_t hashCorner(std::uint32_t seed, std::int32_t x, std::int32_t y, std::int32_t z)
+    {
+        return (seed
+            ^ static_cast<std::uint32_t>(x) * PrimeX
+            ^ static_cast<std::uint32_t>(y) * PrimeY
+            ^ static_cast<std::uint32_t>(z) * PrimeZ) * Mix;
+    }
+
+    float flipSign(float value, std::uint32_t signBit)
+    {
+        return std::bit_cast<float>(std::bit_cast<std::uint32_t>(value) ^ signBit);
+    }
+
+    float gradient(std::uint32_t hash, float dx, float dz)
+    {
+        return flipSign(dx, (hash << 2) & SignBit) + flipSign(dz, (hash << 1) & SignBit);
+    }
+
+    float gradient(std::uint32_t hash, float dx, float dy, float dz)
+    {
+        return flipSign(dx, (hash << 2) & SignBit)
+            + flipSign(dy, (hash << 1) & SignBit)
+            + flipSign(dz, hash & SignBit);
+    }
+
+    float fade(float t)
+    {
+        return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+    }
+
+    float lerp(float a, float b, float t)
+    {
+        return a + t * (b - a);
+    }
+
+#if defined(__AVX2__)
+    __m256i hashCorner8(__m256i seed, __m256i x, __m256i y, __m256i z)
+    {
+        const __m256i hash = _mm256_xor_si256(
+            _mm256_xor_si256(seed, _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<std::int32_t>(PrimeX)))),
+            _mm256_xor_si256(
+                _mm256_mullo_epi32(y, _mm256_set1_epi32(static_cast<std::int32_t>(PrimeY))),
+                _mm256_mullo_epi32(z, _mm256_set1_epi32(static_cast<std::int32_t>(PrimeZ)))));
+
+        return _mm256_mullo_epi32(hash, _mm256_set1_epi32(static_cast<std::int32_t>(Mix)));
+    }
+
+    __m256 flipSign8(__m256 value, __m256i signBits)
+    {
+        const __m256i sign = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min());
+
+        return _mm256_xor_ps(value, _mm256_castsi256_ps(_mm256_and_si256(signBits, sign)));
+    }
+
+    __m256 gradient8(__m256i hash, __m256 dx, __m256 dz)
+    {
+        return _mm256_add_ps(
+            flipSign8(dx, _mm256_slli_epi32(hash, 2)),
+            flipSign8(dz, _mm256_slli_epi32(hash, 1)));
+    }
+
+    __m256 gradient8(__m256i hash, __m256 dx, __m256 dy, __m256 dz)
+    {
+        return _mm256_add_ps(
+            _mm256_add_ps(
+                flipSign8(dx, _mm256_slli_epi32(hash, 2)),
+                flipSign8(dy, _mm256_slli_epi32(hash, 1))),
+            flipSign8(dz, hash));
+    }
+
+    __m256 fade8(__m256 t)
+    {
+        const __m256 inner = _mm256_add_ps(
+            _mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))),
+            _mm256_set1_ps(10.0f));
+
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+    }
+
+    __m256 lerp8(__m256 a, __m256 b, __m256 t)
+    {
+        return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+    }
+
+    __m256 sample8(std::uint32_t seed_, __m256 x, __m256 z)
+    {
+        const __m256i seed = _mm256_set1_epi32(static_cast<std::int32_t>(seed_));
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one  = _mm256_set1_epi32(1);
+        const __m256  fone = _mm256_set1_ps(1.0f);
+
+        const __m256  fx = _mm256_floor_ps(x);
+        const __m256  fz = _mm256_floor_ps(z);
+        const __m256i x0 = _mm256_cvttps_epi32(fx);
+        const __m256i z0 = _mm256_cvttps_epi32(fz);
+        const __m256i x1 = _mm256_add_epi32(x0, one);
+        const __m256i z1 = _mm256_add_epi32(z0, one);
+        const __m256  dx = _mm256_sub_ps(x, fx);
+        const __m256  dz = _mm256_sub_ps(z, fz);
+        const __m256  dx1 = _mm256_sub_ps(dx, fone);
+        const __m256  dz1 = _mm256_sub_ps(dz, fone);
+
+        const __m256 g00 = gradient8(hashCorner8(seed, x0, zero, z0), dx,  dz);
+        const __m256 g10 = gradient8(hashCorner8(seed, x1, zero, z0), dx1, dz);
+        const __m256 g01 = gradient8(hashCorner8(seed, x0, zero, z1), dx,  dz1);
+        const __m256 g11 = gradient8(hashCorner8(seed, x1, zero, z1), dx1, dz1);
+
+        const __m256 u = fade8(dx);
+        const __m256 w = fade8(dz);
+
+        return lerp8(lerp8(g00, g10, u), lerp8(g01, g11, u), w);
+    }
+
+    __m256 sample8(std::uint32_t seed_, __m256 x, __m256 y, __m256 z)
+    {
+        const __m256i seed = _mm256_set1_epi32(static_cast<std::int32_t>(seed_));
+        const __m256i one  = _mm256_set1_epi32(1);
+        const __m256  fone = _mm256_set1_ps(1.0f);
+
+        const __m256  fx = _mm256_floor_ps(x);
+        const __m256  fy = _mm256_floor_ps(y);
+        const __m256  fz = _mm256_floor_ps(z);
+        const __m256i x0 = _mm256_cvttps_epi32(fx);
+        const __m256i y0 = _mm256_cvttps_epi32(fy);
+        const __m256i z0 = _mm256_cvttps_epi32(fz);
+        const __m256i x1 = _mm256_add_epi32(x0, one);
+        const __m256i y1 = _mm256_add_epi32(y0, one);
+        const __m256i z1 = _mm256_add_epi32(z0, one);
+        const __m256  dx = _mm256_sub_ps(x, fx);
+        const __m256  dy = _mm256_sub_ps(y, fy);
+        const __m256  dz = _mm256_sub_ps(z, fz);
+        const __m256  dx1 = _mm256_sub_ps(dx, fone);
+        const __m256  dy1 = _mm256_sub_ps(dy, fone);
+        const __m256  dz1 = _mm256_sub_ps(dz, fone);
+
+        const __m256 g000 = gradient8(hashCorner8(seed, x0, y0, z0), dx,  dy,  dz);
+        const __m256 g100 = gradient8(hashCorner8(seed, x1, y0, z0), dx1, dy,  dz);
+        const __m256 g010 = gradient8(hashCorner8(seed, x0, y1, z0), dx,  dy1, dz);
+        const __m256 g110 = gradient8(hashCorner8(seed, x1, y1, z0), dx1, dy1, dz);
+        const __m256 g001 = gradient8(hashCorner8(seed, x0, y0, z1), dx,  dy,  dz1);
+        const __m256 g101 = gradient8(hashCorner8(seed, x1, y0, z1), dx1, dy,  dz1);
+        const __m256 g011 = gradient8(hashCorner8(seed, x0, y1, z1), dx,  dy1, dz1);
+        const __m256 g111 = gradient8(hashCorner8(seed, x1, y1, z1), dx1, dy1, dz1);
+
+        const __m256 u = fade8(dx);
+        const __m256 v = fade8(dy);
+        const __m256 w = fade8(dz);
+
+        const __m256 y0z0 = lerp8(g000, g100, u);
+        const __m256 y1z0 = lerp8(g010, g110, u);
+        const __m256 y0z1 = lerp8(g001, g101, u);
+        const __m256 y1z1 = lerp8(g011, g111, u);
+
+        return _mm256_mul_ps(
+            lerp8(lerp8(y0z0, y1z0, v), lerp8(y0z1, y1z1, v), w),
+            _mm256_set1_ps(Scale3));
+    }
+
+    __m256 getRowPositions8(float start, float step, std::size_t first)
+    {
+        const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        const __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(first)), lanes);
+
+        return _mm256_add_ps(_mm256_set1_ps(start), _mm256_mul_ps(index, _mm256_set1_ps(step)));
+    }
+#endif // __AVX2__
+} // namespace
+
+namespace world
+{
+    GradientNoise::GradientNoise(std::uint32_t seed_)
+        : seed {seed_}
+    {}
+
+    float GradientNoise::sample(float x, float z) const
+    {
+        const float fx = std::floor(x);
+        const float fz = std::floor(z);
+        const auto  x0 = static_cast<std::int32_t>(fx);
+        const auto  z0 = static_cast<std::int32_t>(fz);
+        const float dx = x - fx;
+        const float dz = z - fz;
+
+        const float g00 = gradient(hashCorner(this->seed, x0,     0, z0),     dx,        dz);
+        const float g10 = gradient(hashCorner(this->seed, x0 + 1, 0, z0),     dx - 1.0f, dz);
+        const float g01 = gradient(hashCorner(this->seed, x0,     0, z0 + 1), dx,        dz - 1.0f);
+        const float g11 = gradient(hashCorner(this->seed, x0 + 1, 0, z0 + 1), dx - 1.0f, dz - 1.0f);
+
+        const float u = fade(dx);
+        const float w = fade(dz);
+
+        return lerp(lerp(g00, g10, u), lerp(g01, g11, u), w);
+    }
+
+    float GradientNoise::sample(float x, float y, float z) const
+    {
+        const float fx = std::floor(x);
+        const float fy = std::floor(y);
+        const float fz = std::floor(z);
+        const auto  x0 = static_cast<std::int32_t>(fx);
+        const auto  y0 = static_cast<std::int32_t>(fy);
+        const auto  z0 = static_cast<std::int32_t>(fz);
+        const float dx = x - fx;
+        const float dy = y - fy;
+        const float dz = z - fz;
+
+        const float g000 = gradient(hashCorner(this->seed, x0,     y0,     z0),     dx,        dy,        dz);
+        const float g100 = gradient(hashCorner(this->seed, x0 + 1, y0,     z0),     dx - 1.0f, dy,        dz);
+        const float g010 = gradient(hashCorner(this->seed, x0,     y0 + 1, z0),     dx,        dy - 1.0f, dz);
+        const float g110 = gradient(hashCorner(this->seed, x0 + 1, y0 + 1, z0),     dx - 1.0f, dy - 1.0f, dz);
+        const float g001 = gradient(hashCorner(this->seed, x0,     y0,     z0 + 1), dx,        dy,        dz - 1.0f);
+        const float g101 = gradient(hashCorner(this->seed, x0 + 1, y0,     z0 + 1), dx - 1.0f, dy,        dz - 1.0f);
+        const float g011 = gradient(hashCorner(this->seed, x0,     y0 + 1, z0 + 1), dx,        dy - 1.0f, dz - 1.0f);
+        const float g111 = gradient(hashCorner(this->seed, x0 + 1, y0 + 1, z0 + 1), dx - 1.0f, dy - 1.0f, dz - 1.0f);
+
+        const float u = fade(dx);
+        const float v = fade(dy);
+        const float w = fade(dz);
+
+        const float y0z0 = lerp(g000, g100, u);
+        const float y1z0 = lerp(g010, g110, u);
+        const float y0z1 = lerp(g001, g101, u);
+        const float y1z1 = lerp(g011, g111, u);
+
+        return lerp(lerp(y0z0, y1z0, v), lerp(y0z1, y1z1, v), w) * Scale3;
+    }
+
+    void GradientNoise::sampleRow(float x, float z, float step, std::span<float> out) const
+    {
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        for (; i + 8 <= out.size(); i += 8)
+        {
+            _mm256_storeu_ps(out.data() + i, sample8(this->seed, getRowPositions8(x, step, i), _mm256_set1_ps(z)));
+        }
+#endif // __AVX2__
+
+        for (; i < out.size(); ++i)
+        {
+            out[i] = this->sample(x + static_cast<float>(i) * step, z);
+        }
+    }
+
+    void GradientNoise::sampleRow(float x, float y, float z, float step, std::span<float> out) const
+    {
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        for (; i + 8 <= out.size(); i += 8)
+        {
+            _mm256_storeu_ps(out.data() + i,
+                sample8(this->seed, getRowPositions8(x, step, i), _mm256_set1_ps(y), _mm256_set1_ps(z)));
+        }
+#endif // __AVX2__
+
+        for (; i < out.size(); ++i)
+        {
+            out[i] = this->sample(x + static_cast<float>(i) * step, y, z);
+        }
+    }
+
+    FractalNoise::FractalNoise(std::uint32_t seed, FractalSettings settings_)
+        : settings {settings_}
+        , normalization {0.0f}
+    {
+        seb::assertFatal(this->settings.octaves > 0, "Fractal noise needs at least one octave");
+
+        float amplitude = 1.0f;
+
+        for (std::uint32_t octave = 0; octave < this->settings.octaves; ++octave)
+        {
+            this->octaves.emplace_back(seed + octave * OctaveSeedStep);
+            this->normalization += amplitude;
+            amplitude *= this->settings.gain;
+        }
+
+        this->normalization = 1.0f / this->normalization;
+    }
+
+    float FractalNoise::sample(float x, float z) const
+    {
+        float frequency = this->settings.frequency;
+        float amplitude = this->normalization;
+        float sum       = 0.0f;
+
+        for (const GradientNoise& octave : this->octaves)
+        {
+            sum += octave.sample(x * frequency, z * frequency) * amplitude;
+            frequency *= this->settings.lacunarity;
+            amplitude *= this->settings.gain;
+        }
+
+        return sum;
+    }
+
+    float FractalNoise::sample(float x, float y, float z) const
+    {
+        float frequency = this->settings.frequency;
+        float amplitude = this->normalization;
+        float sum       = 0.0f;
+
+        for (const GradientNoise& octave : this->octaves)
+        {
+            sum += octave.sample(x * frequency, y * frequency, z * frequency) * amplitude;
+            frequency *= this->settings.lacunarity;
+            amplitude *= this->settings.gain;
+        }
+
+        return sum;
+    }
+
+    void FractalNoise::sampleRow(float x, float z, float step, std::span<float> out) const
+    {
+        constexpr std::size_t Block = 64;
+        std::array<float, Block> octaveSamples {};
+
+        for (std::size_t first = 0; first < out.size(); first += Block)
+        {
+            const std::span<float> block = out.subspan(first, std::min(Block, out.size() - first));
+            const float            start = x + static_cast<float>(first) * step;
+
+            float frequency = this->settings.frequency;
+            float amplitude = this->normalization;
+
+            std::ranges::fill(block, 0.0f);
+
+            for (const GradientNoise& octave : this->octaves)
+            {
+                octave.sampleRow(start * frequency, z * frequency, step * frequency,
+                    std::span {octaveSamples}.first(block.size()));
+
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    block[i] += octaveSamples[i] * amplitude;
+                }
+
+                frequency *= this->settings.lacunarity;
+                amplitude *= this->settings.gain;
+            }
+        }
+    }
+
+    void FractalNoise::sampleRow(float x, float y, float z, float step, std::span<float> out) const
+    {
+        constexpr std::size_t Block = 64;
+        std::array<float, Block> octaveSamples {};
+
+        for (std::size_t first = 0; first < out.size(); first += Block)
+        {
+            const std::span<float> block = out.subspan(first, std::min(Block, out.size() - first));
+            const float            start = x + static_cast<float>(first) * step;
+
+            float frequency = this->settings.frequency;
+            float amplitude = this->normalization;
+
+            std::ranges::fill(block, 0.0f);
+
+            for (const GradientNoise& octave : this->octaves)
+            {
+                octave.sampleRow(start * frequency, y * frequency, z * frequency, step * frequency,
+                    std::span {octaveSamples}.first(block.size()));
+
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    block[i] += octaveSamples[i] * amplitude;
+                }
+
+                frequency *= this->settings.lacunarity;
+                amplitude *= this->settings.gain;
+            }
+        }
+    }
+} // namespace world
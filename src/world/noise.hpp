@@ -0,0 +1,80 @@
+#ifndef SRC_WORLD_NOISE_HPP
+#define SRC_WORLD_NOISE_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace world
+{
+    /// @brief Seeded gradient noise in 2D and 3D, roughly in [-1, 1].
+    ///
+    /// Lattice gradients come from hashing each cell corner with the seed,
+    /// there is no permutation table to build or share, so any number of
+    /// threads get the same values from equally seeded noise. The row
+    /// functions evaluate 8 samples at once with AVX2 when it's available,
+    /// sample() is the same arithmetic one at a time.
+    class GradientNoise
+    {
+    public:
+        explicit GradientNoise(std::uint32_t seed);
+        ~GradientNoise() = default;
+
+        GradientNoise(const GradientNoise&)            = default;
+        GradientNoise(GradientNoise&&)                 = default;
+        GradientNoise& operator=(const GradientNoise&) = default;
+        GradientNoise& operator=(GradientNoise&&)      = default;
+
+        [[nodiscard]] float sample(float x, float z) const;
+        [[nodiscard]] float sample(float x, float y, float z) const;
+
+        /// @brief out[i] = sample(x + i * step, z)
+        void sampleRow(float x, float z, float step, std::span<float> out) const;
+        /// @brief out[i] = sample(x + i * step, y, z)
+        void sampleRow(float x, float y, float z, float step, std::span<float> out) const;
+
+    private:
+        std::uint32_t seed;
+    }; // class GradientNoise
+
+    struct FractalSettings
+    {
+        std::uint32_t octaves;
+        // of the first octave, in cycles per unit
+        float         frequency;
+        // frequency multiplier from one octave to the next
+        float         lacunarity;
+        // amplitude multiplier from one octave to the next
+        float         gain;
+    };
+
+    /// @brief Octaves of GradientNoise, each seeded differently, summed and
+    /// scaled back to roughly [-1, 1]. Rows match sample() up to rounding,
+    /// each octave scales the row's positions rather than every sample's
+    class FractalNoise
+    {
+    public:
+        FractalNoise(std::uint32_t seed, FractalSettings);
+        ~FractalNoise() = default;
+
+        FractalNoise(const FractalNoise&)            = default;
+        FractalNoise(FractalNoise&&)                 = default;
+        FractalNoise& operator=(const FractalNoise&) = default;
+        FractalNoise& operator=(FractalNoise&&)      = default;
+
+        [[nodiscard]] float sample(float x, float z) const;
+        [[nodiscard]] float sample(float x, float y, float z) const;
+
+        /// @brief out[i] = sample(x + i * step, z)
+        void sampleRow(float x, float z, float step, std::span<float> out) const;
+        /// @brief out[i] = sample(x + i * step, y, z)
+        void sampleRow(float x, float y, float z, float step, std::span<float> out) const;
+
+    private:
+        FractalSettings            settings;
+        std::vector<GradientNoise> octaves;
+        float                      normalization;
+    }; // class FractalNoise
+} // namespace world
+
+#endif // SRC_WORLD_NOISE_HPP
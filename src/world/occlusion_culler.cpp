@@ -0,0 +1,113 @@
+#include <cstdlib>
+#include <deque>
+#include <optional>
+
+#include <util/profiler.hpp>
+
+#include "occlusion_culler.hpp"
+
+namespace world
+{
+    OcclusionCuller::OcclusionCuller()
+        : visited_steps {0}
+    {}
+
+    void OcclusionCuller::setConnectivity(ChunkCoordinate coordinate, const ChunkConnectivity& chunkConnectivity)
+    {
+        if (chunkConnectivity.isOpen())
+        {
+            this->connectivity.erase(coordinate);
+        }
+        else
+        {
+            this->connectivity.insert_or_assign(coordinate, chunkConnectivity);
+        }
+    }
+
+    void OcclusionCuller::eraseConnectivity(ChunkCoordinate coordinate)
+    {
+        this->connectivity.erase(coordinate);
+    }
+
+    void OcclusionCuller::cull(const CameraView& view, ChunkCoordinate min, ChunkCoordinate max)
+    {
+        PROFILE_SCOPE("OcclusionCuller::cull");
+
+        const ChunkPrioritizer frustum {view};
+        const ChunkCoordinate  camera = toChunkCoordinate(WorldPosition {glm::floor(view.position)});
+
+        min = glm::min(min, camera);
+        max = glm::max(max, camera);
+
+        this->entered.clear();
+        this->visited_steps = 0;
+
+        // (chunk, face it was entered through), the camera's has none
+        std::deque<std::pair<ChunkCoordinate, std::optional<Face>>> frontier {};
+
+        this->entered[camera] = 0;
+        frontier.emplace_back(camera, std::nullopt);
+
+        while (!frontier.empty())
+        {
+            const auto [chunk, from] = frontier.front();
+            frontier.pop_front();
+            ++this->visited_steps;
+
+            const auto found = this->connectivity.find(chunk);
+
+            for (std::uint8_t i = 0; i < NumberOfFaces; ++i)
+            {
+                const auto          to   = static_cast<Face>(i);
+                const std::int32_t  axis = getFaceAxes(to).normal;
+
+                ChunkCoordinate neighbour = chunk;
+                neighbour[axis] += isPositive(to) ? 1 : -1;
+
+                // only ever away from the camera, a chunk that is seen
+                // through another never leads back past it
+                if (std::abs(neighbour[axis] - camera[axis]) <= std::abs(chunk[axis] - camera[axis]))
+                {
+                    continue;
+                }
+
+                if (from.has_value() && found != this->connectivity.end() && !found->second.isConnected(*from, to))
+                {
+                    continue;
+                }
+
+                // the search starts inside the bounds and only the stepped
+                // axis changes
+                if (neighbour[axis] < min[axis] || neighbour[axis] > max[axis] || !frustum.isInFrustum(neighbour))
+                {
+                    continue;
+                }
+
+                // faces come in +- pairs, the neighbour is entered through
+                // the opposite of the one left through
+                const auto         entry    = static_cast<Face>(i ^ 1U);
+                const std::uint8_t entryBit = static_cast<std::uint8_t>(1U << (i ^ 1U));
+                std::uint8_t&      faces    = this->entered[neighbour];
+
+                if ((faces & entryBit) == 0)
+                {
+                    faces |= entryBit;
+                    frontier.emplace_back(neighbour, entry);
+                }
+            }
+        }
+    }
+
+    bool OcclusionCuller::isVisible(ChunkCoordinate coordinate) const
+    {
+        return this->entered.contains(coordinate);
+    }
+
+    OcclusionCuller::Statistics OcclusionCuller::getStatistics() const
+    {
+        return Statistics {
+            .visible_chunks {this->entered.size()},
+            .visited_steps  {this->visited_steps},
+        };
+    }
+} // namespace world
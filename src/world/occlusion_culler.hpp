@@ -0,0 +1,60 @@
+#ifndef SRC_WORLD_OCCLUSION__CULLER_HPP
+#define SRC_WORLD_OCCLUSION__CULLER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "camera_view.hpp"
+#include "chunk_connectivity.hpp"
+#include "voxel_storage.hpp"
+
+namespace world
+{
+    /// @brief Finds the chunks the camera might see past the terrain.
+    ///
+    /// A breadth first search from the camera's chunk steps into a neighbour
+    /// only if the step moves away from the camera, the neighbour is in the
+    /// frustum and the chunk it leaves connects the face it was entered
+    /// through to the one it leaves through. Sealed off caves and the
+    /// ground under the surface are never reached. Chunks without recorded
+    /// connectivity are treated as air.
+    class OcclusionCuller
+    {
+    public:
+        struct Statistics
+        {
+            // of the last cull()
+            std::size_t visible_chunks;
+            // (chunk, face entered through) pairs searched
+            std::size_t visited_steps;
+        };
+
+        OcclusionCuller();
+        ~OcclusionCuller() = default;
+
+        OcclusionCuller(const OcclusionCuller&)            = delete;
+        OcclusionCuller(OcclusionCuller&&)                 = delete;
+        OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+        OcclusionCuller& operator=(OcclusionCuller&&)      = delete;
+
+        void setConnectivity(ChunkCoordinate, const ChunkConnectivity&);
+        void eraseConnectivity(ChunkCoordinate);
+
+        /// @brief Searches the chunks in [@param min, @param max], grown to
+        /// include the camera's chunk
+        void cull(const CameraView&, ChunkCoordinate min, ChunkCoordinate max);
+        /// @brief As of the last cull()
+        [[nodiscard]] bool isVisible(ChunkCoordinate) const;
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        // fully connected chunks are left out
+        std::unordered_map<ChunkCoordinate, ChunkConnectivity, ChunkCoordinateHash> connectivity;
+        // faces each reached chunk was entered through, 0 for the camera's
+        std::unordered_map<ChunkCoordinate, std::uint8_t, ChunkCoordinateHash> entered;
+        std::size_t visited_steps;
+    }; // class OcclusionCuller
+} // namespace world
+
+#endif // SRC_WORLD_OCCLUSION__CULLER_HPP
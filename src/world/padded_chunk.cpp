@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <array>
+
+#include <util/profiler.hpp>
+
+#include "light_engine.hpp"
+#include "padded_chunk.hpp"
+
+namespace
+{
+    using world::ChunkCoordinate;
+    using world::ChunkExtent;
+    using world::LocalPosition;
+
+    /// @brief Calls @param visit(offset, min, max) for each of the 26
+    /// neighbours with the region of it that lies in the border. In each
+    /// axis an offset of -1 contributes its last layer, +1 its first and 0
+    /// the whole range
+    template<class Visit>
+    void forEachBorderRegion(Visit&& visit)
+    {
+        const auto rangeMin = [](std::int32_t d) { return d < 0 ? ChunkExtent - 1 : 0; };
+        const auto rangeMax = [](std::int32_t d) { return d > 0 ? 1 : ChunkExtent; };
+
+        for (std::int32_t dy = -1; dy <= 1; ++dy)
+        {
+            for (std::int32_t dz = -1; dz <= 1; ++dz)
+            {
+                for (std::int32_t dx = -1; dx <= 1; ++dx)
+                {
+                    if (dx == 0 && dy == 0 && dz == 0)
+                    {
+                        continue;
+                    }
+
+                    visit(
+                        ChunkCoordinate {dx, dy, dz},
+                        LocalPosition {rangeMin(dx), rangeMin(dy), rangeMin(dz)},
+                        LocalPosition {rangeMax(dx), rangeMax(dy), rangeMax(dz)}
+                    );
+                }
+            }
+        }
+    }
+
+    /// @brief Edges and corners, the neighbours sharing less than a face
+    bool isEdge(ChunkCoordinate offset)
+    {
+        return (offset.x != 0 ? 1 : 0) + (offset.y != 0 ? 1 : 0) + (offset.z != 0 ? 1 : 0) >= 2;
+    }
+
+    /// @brief Calls @param visit(border, facing) for every voxel of the
+    /// layer face neighbour @param i of ChunkSnapshot::neighbours shares
+    /// with the chunk. border is the voxel's position in the padded chunk
+    /// and facing its position in the neighbour
+    template<class Visit>
+    void forEachNeighbourLayerVoxel(std::size_t i, Visit&& visit)
+    {
+        const auto         axis = static_cast<glm::length_t>(i / 2);
+        const std::int32_t sign = i % 2 == 0 ? 1 : -1;
+
+        for (std::int32_t a = 0; a < ChunkExtent; ++a)
+        {
+            for (std::int32_t b = 0; b < ChunkExtent; ++b)
+            {
+                LocalPosition border {0, 0, 0};
+                border[axis]           = sign > 0 ? ChunkExtent : -1;
+                border[(axis + 1) % 3] = a;
+                border[(axis + 2) % 3] = b;
+
+                LocalPosition facing = border;
+                facing[axis]         = sign > 0 ? 0 : ChunkExtent - 1;
+
+                visit(border, facing);
+            }
+        }
+    }
+
+    /// @brief Calls @param visit(position) for every voxel in [@param min,
+    /// @param max)
+    template<class Visit>
+    void forEachVoxel(LocalPosition min, LocalPosition max, Visit&& visit)
+    {
+        for (std::int32_t y = min.y; y < max.y; ++y)
+        {
+            for (std::int32_t z = min.z; z < max.z; ++z)
+            {
+                for (std::int32_t x = min.x; x < max.x; ++x)
+                {
+                    visit(LocalPosition {x, y, z});
+                }
+            }
+        }
+    }
+} // namespace
+
+namespace world
+{
+    PaddedChunk::PaddedChunk()
+        : voxels (Volume, AirVoxel)
+    {}
+
+    PaddedChunk::PaddedChunk(const VoxelStorage& storage, ChunkCoordinate coordinate)
+        : PaddedChunk {}
+    {
+        PROFILE_SCOPE("PaddedChunk::PaddedChunk");
+
+        if (const Chunk* center = storage.getChunk(coordinate); center != nullptr)
+        {
+            this->copyCenter(*center);
+        }
+
+        forEachBorderRegion([&](ChunkCoordinate offset, LocalPosition min, LocalPosition max)
+        {
+            if (const Chunk* neighbour = storage.getChunk(coordinate + offset); neighbour != nullptr)
+            {
+                this->copyRegion(*neighbour, min, max, offset * ChunkExtent);
+            }
+        });
+    }
+
+    PaddedChunk::PaddedChunk(const ChunkSnapshot& snapshot)
+        : PaddedChunk {}
+    {
+        PROFILE_SCOPE("PaddedChunk::PaddedChunk(ChunkSnapshot)");
+
+        if (snapshot.center.has_value())
+        {
+            this->copyCenter(*snapshot.center);
+        }
+
+        for (std::size_t i = 0; i < snapshot.neighbours.size(); ++i)
+        {
+            if (!snapshot.neighbours[i].has_value())
+            {
+                continue;
+            }
+
+            const std::int32_t axis = static_cast<std::int32_t>(i / 2);
+            const std::int32_t sign = i % 2 == 0 ? 1 : -1;
+
+            // the neighbour's layer touching this chunk, full range otherwise
+            LocalPosition min {0, 0, 0};
+            LocalPosition max {ChunkExtent, ChunkExtent, ChunkExtent};
+            LocalPosition offset {0, 0, 0};
+
+            min[axis]    = sign > 0 ? 0 : ChunkExtent - 1;
+            max[axis]    = min[axis] + 1;
+            offset[axis] = sign * ChunkExtent;
+
+            this->copyRegion(*snapshot.neighbours[i], min, max, offset);
+        }
+
+        std::size_t edge = 0;
+
+        forEachBorderRegion([&](ChunkCoordinate offset, LocalPosition min, LocalPosition max)
+        {
+            if (!isEdge(offset))
+            {
+                return;
+            }
+
+            forEachVoxel(min, max, [&](LocalPosition position)
+            {
+                this->set(position + offset * ChunkExtent, snapshot.edges[edge++]);
+            });
+        });
+
+        if (!snapshot.light.has_value())
+        {
+            return;
+        }
+
+        this->light.assign(Volume, OpenSkyLight);
+
+        for (std::int32_t y = 0; y < ChunkExtent; ++y)
+        {
+            for (std::int32_t z = 0; z < ChunkExtent; ++z)
+            {
+                for (std::int32_t x = 0; x < ChunkExtent; ++x)
+                {
+                    this->light[toPaddedIndex({x, y, z})] = snapshot.light->get(toLinearIndex({x, y, z}));
+                }
+            }
+        }
+
+        auto neighbourLight = snapshot.neighbour_light.cbegin();
+
+        for (std::size_t i = 0; i < snapshot.neighbours.size(); ++i)
+        {
+            forEachNeighbourLayerVoxel(i, [&](LocalPosition border, LocalPosition)
+            {
+                this->light[toPaddedIndex(border)] = *neighbourLight++;
+            });
+        }
+    }
+
+    ChunkSnapshot takeChunkSnapshot(const VoxelStorage& storage, ChunkCoordinate coordinate, const LightEngine* light)
+    {
+        PROFILE_SCOPE("takeChunkSnapshot");
+
+        const auto copy = [&](ChunkCoordinate c) -> std::optional<Chunk>
+        {
+            if (const Chunk* chunk = storage.getChunk(c); chunk != nullptr)
+            {
+                return *chunk;
+            }
+
+            return std::nullopt;
+        };
+
+        std::array<Voxel, ChunkSnapshot::NumberOfEdgeVoxels> edges {};
+        std::size_t edge = 0;
+
+        forEachBorderRegion([&](ChunkCoordinate offset, LocalPosition min, LocalPosition max)
+        {
+            if (!isEdge(offset))
+            {
+                return;
+            }
+
+            const Chunk* neighbour = storage.getChunk(coordinate + offset);
+
+            forEachVoxel(min, max, [&](LocalPosition position)
+            {
+                edges[edge++] = neighbour != nullptr ? neighbour->get(position) : AirVoxel;
+            });
+        });
+
+        std::optional<ChunkLight> centerLight {};
+        std::vector<PackedLight>  neighbourLight {};
+
+        if (const ChunkLight* center = light != nullptr ? light->getLight(coordinate) : nullptr; center != nullptr)
+        {
+            centerLight = *center;
+            neighbourLight.reserve(6 * ChunkExtent * ChunkExtent);
+
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                ChunkCoordinate offset {0, 0, 0};
+                offset[static_cast<glm::length_t>(i / 2)] = i % 2 == 0 ? 1 : -1;
+
+                const ChunkLight* neighbour = light->getLight(coordinate + offset);
+
+                forEachNeighbourLayerVoxel(i, [&](LocalPosition, LocalPosition facing)
+                {
+                    neighbourLight.push_back(
+                        neighbour != nullptr ? neighbour->get(toLinearIndex(facing)) : OpenSkyLight);
+                });
+            }
+        }
+
+        return ChunkSnapshot {
+            .coordinate      {coordinate},
+            .center          {copy(coordinate)},
+            .neighbours      {
+                copy(coordinate + ChunkCoordinate {1, 0, 0}),
+                copy(coordinate + ChunkCoordinate {-1, 0, 0}),
+                copy(coordinate + ChunkCoordinate {0, 1, 0}),
+                copy(coordinate + ChunkCoordinate {0, -1, 0}),
+                copy(coordinate + ChunkCoordinate {0, 0, 1}),
+                copy(coordinate + ChunkCoordinate {0, 0, -1}),
+            },
+            .edges           {edges},
+            .light           {std::move(centerLight)},
+            .neighbour_light {std::move(neighbourLight)},
+        };
+    }
+
+    void PaddedChunk::set(LocalPosition position, Voxel voxel)
+    {
+        this->voxels[toPaddedIndex(position)] = voxel;
+    }
+
+    void PaddedChunk::keepColumns(const ColumnMask& keep)
+    {
+        if (keep.all())
+        {
+            return;
+        }
+
+        for (std::int32_t z = -1; z <= ChunkExtent; ++z)
+        {
+            for (std::int32_t x = -1; x <= ChunkExtent; ++x)
+            {
+                if (keep[toColumnIndex(x, z)])
+                {
+                    continue;
+                }
+
+                for (std::int32_t y = -1; y <= ChunkExtent; ++y)
+                {
+                    this->voxels[toPaddedIndex({x, y, z})] = AirVoxel;
+                }
+            }
+        }
+    }
+
+    bool PaddedChunk::isUniform(Voxel voxel) const
+    {
+        return std::ranges::all_of(this->voxels, [voxel](Voxel v) { return v == voxel; });
+    }
+
+    std::span<const Voxel> PaddedChunk::getVoxels() const
+    {
+        return this->voxels;
+    }
+
+    std::span<const PackedLight> PaddedChunk::getLight() const
+    {
+        return this->light;
+    }
+
+    void PaddedChunk::copyCenter(const Chunk& center)
+    {
+        if (center.isUniform())
+        {
+            this->copyRegion(center, {0, 0, 0}, {ChunkExtent, ChunkExtent, ChunkExtent}, {0, 0, 0});
+            return;
+        }
+
+        std::array<Voxel, ChunkVolume> unpacked;
+        center.unpack(unpacked);
+
+        for (std::int32_t y = 0; y < ChunkExtent; ++y)
+        {
+            for (std::int32_t z = 0; z < ChunkExtent; ++z)
+            {
+                const auto row = unpacked.cbegin() + static_cast<std::ptrdiff_t>(toLinearIndex({0, y, z}));
+
+                std::copy(row, row + ChunkExtent, this->voxels.begin()
+                    + static_cast<std::ptrdiff_t>(toPaddedIndex({0, y, z})));
+            }
+        }
+    }
+
+    void PaddedChunk::copyRegion(const Chunk& chunk, LocalPosition min, LocalPosition max, LocalPosition offset)
+    {
+        const std::optional<Voxel> uniform = chunk.getUniformVoxel();
+
+        for (std::int32_t y = min.y; y < max.y; ++y)
+        {
+            for (std::int32_t z = min.z; z < max.z; ++z)
+            {
+                const auto row = this->voxels.begin()
+                    + static_cast<std::ptrdiff_t>(toPaddedIndex(LocalPosition {min.x, y, z} + offset));
+
+                if (uniform.has_value())
+                {
+                    std::fill(row, row + (max.x - min.x), *uniform);
+                    continue;
+                }
+
+                for (std::int32_t x = min.x; x < max.x; ++x)
+                {
+                    row[x - min.x] = chunk.get({x, y, z});
+                }
+            }
+        }
+    }
+} // namespace world
@@ -0,0 +1,122 @@
+#ifndef SRC_WORLD_PADDED__CHUNK_HPP
+#define SRC_WORLD_PADDED__CHUNK_HPP
+
+#include <array>
+#include <bitset>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "chunk_light.hpp"
+#include "voxel_storage.hpp"
+
+namespace world
+{
+    class LightEngine;
+
+    /// @brief Copies of a chunk and its 6 face neighbours, everything needed
+    /// to mesh it while the storage keeps changing. Neighbours are ordered
+    /// +x -x +y -y +z -z, missing chunks are nullopt and read as air.
+    ///
+    /// Of the 12 edge and 8 corner neighbours only the voxels in the padded
+    /// border are kept, ambient occlusion looks no further. Light is only
+    /// ever read in front of a face, so of the face neighbours only their
+    /// layer touching the chunk is kept.
+    struct ChunkSnapshot
+    {
+        constexpr static std::size_t NumberOfEdgeVoxels = 12 * ChunkExtent + 8;
+
+        ChunkCoordinate                            coordinate;
+        std::optional<Chunk>                       center;
+        std::array<std::optional<Chunk>, 6>        neighbours;
+        /// @brief Ordered by neighbour offset in (dy, dz, dx) and then by
+        /// voxel in (y, z, x), missing neighbours are air
+        std::array<Voxel, NumberOfEdgeVoxels>      edges;
+        /// @brief nullopt if the chunk isn't lit
+        std::optional<ChunkLight>                  light;
+        /// @brief ChunkExtent² levels per neighbour in the order of
+        /// neighbours, empty if the chunk isn't lit. Unlit neighbours are
+        /// open sky
+        std::vector<PackedLight>                   neighbour_light;
+    };
+
+    /// @param light nullptr for scenes without lighting
+    [[nodiscard]] ChunkSnapshot takeChunkSnapshot(
+        const VoxelStorage&, ChunkCoordinate, const LightEngine* light = nullptr);
+
+    /// @brief A chunk's voxels surrounded by a one voxel border copied from
+    /// its 26 neighbours, missing neighbours read as air.
+    ///
+    /// Meshers only ever look at this copy so they never touch the chunk map,
+    /// which also makes a PaddedChunk a self contained snapshot.
+    class PaddedChunk
+    {
+    public:
+        constexpr static std::int32_t Extent = ChunkExtent + 2;
+        constexpr static std::size_t  Volume = Extent * Extent * Extent;
+
+        /// @brief One bit per vertical column, border included, indexed
+        /// by toColumnIndex
+        using ColumnMask = std::bitset<Extent * Extent>;
+
+        /// @brief All air
+        PaddedChunk();
+        PaddedChunk(const VoxelStorage&, ChunkCoordinate);
+        explicit PaddedChunk(const ChunkSnapshot&);
+        ~PaddedChunk() = default;
+
+        PaddedChunk(const PaddedChunk&)            = default;
+        PaddedChunk(PaddedChunk&&)                 = default;
+        PaddedChunk& operator=(const PaddedChunk&) = default;
+        PaddedChunk& operator=(PaddedChunk&&)      = default;
+
+        /// @brief @param position is chunk local, each axis in [-1, ChunkExtent]
+        [[nodiscard]] Voxel get(LocalPosition position) const
+        {
+            return this->voxels[toPaddedIndex(position)];
+        }
+        void set(LocalPosition, Voxel);
+
+        /// @brief Every column without a bit in @param keep becomes air
+        void keepColumns(const ColumnMask& keep);
+
+        /// @brief True if every voxel, border included, is @param voxel
+        [[nodiscard]] bool isUniform(Voxel voxel) const;
+
+        /// @brief Indexed by toPaddedIndex
+        [[nodiscard]] std::span<const Voxel> getVoxels() const;
+        /// @brief Indexed by toPaddedIndex, empty if the chunk isn't lit.
+        /// Only the center and the border's face slabs are filled in
+        [[nodiscard]] std::span<const PackedLight> getLight() const;
+
+        /// @brief Distance between neighbouring voxels along @param axis in
+        /// toPaddedIndex space, 0 = x, 1 = y, 2 = z
+        [[nodiscard]] constexpr static std::size_t getStride(std::int32_t axis)
+        {
+            return axis == 0 ? 1 : axis == 1 ? Extent * Extent : Extent;
+        }
+
+        /// @brief @param x and @param z are chunk local, in [-1, ChunkExtent]
+        [[nodiscard]] constexpr static std::size_t toColumnIndex(std::int32_t x, std::int32_t z)
+        {
+            return static_cast<std::size_t>((z + 1) * Extent + (x + 1));
+        }
+
+        /// @brief Same layout as toLinearIndex, shifted by the border
+        [[nodiscard]] constexpr static std::size_t toPaddedIndex(LocalPosition position)
+        {
+            return static_cast<std::size_t>(
+                ((position.y + 1) * Extent + (position.z + 1)) * Extent + (position.x + 1)
+            );
+        }
+
+    private:
+        void copyCenter(const Chunk&);
+        void copyRegion(const Chunk&, LocalPosition min, LocalPosition max, LocalPosition offset);
+
+        std::vector<Voxel>       voxels;
+        std::vector<PackedLight> light;
+    }; // class PaddedChunk
+} // namespace world
+
+#endif // SRC_WORLD_PADDED__CHUNK_HPP
@@ -0,0 +1,226 @@
+#include <cmath>
+#include <limits>
+
+#include <sebib/seblog.hpp>
+
+#include "raycast.hpp"
+
+namespace
+{
+    using world::Chunk;
+    using world::ChunkCoordinate;
+    using world::Face;
+    using world::Ray;
+    using world::RaycastHit;
+    using world::VoxelStorage;
+    using world::WorldPosition;
+
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+    /// @brief The last chunk looked up, consecutive voxels almost always
+    /// share one
+    struct ChunkCursor
+    {
+        const VoxelStorage& storage;
+        ChunkCoordinate     coordinate;
+        const Chunk*        chunk;
+        // chunks that aren't loaded are air
+        std::optional<world::Voxel> uniform;
+        bool                        is_valid;
+
+        void moveTo(ChunkCoordinate wanted)
+        {
+            if (this->is_valid && wanted == this->coordinate)
+            {
+                return;
+            }
+
+            this->coordinate = wanted;
+            this->chunk      = this->storage.getChunk(wanted);
+            this->uniform    = this->chunk == nullptr ? std::optional {world::AirVoxel} : this->chunk->getUniformVoxel();
+            this->is_valid   = true;
+        }
+    };
+
+    /// @brief The face a ray stepping along @param axis in @param step enters through
+    Face getEnteredFace(glm::length_t axis, std::int32_t step)
+    {
+        return static_cast<Face>(axis * 2 + (step > 0 ? 1 : 0));
+    }
+
+    std::optional<RaycastHit> cast(ChunkCursor& cursor, const Ray& ray)
+    {
+        const float length = glm::length(ray.direction);
+
+        seb::assertFatal(length > 0.0f, "Raycast without a direction");
+        seb::assertFatal(std::isfinite(ray.max_distance), "Raycast without a max distance");
+
+        const glm::vec3 direction = ray.direction / length;
+
+        WorldPosition position {glm::floor(ray.origin)};
+        glm::i32vec3  step {};
+        glm::vec3     nextBoundary {};
+        glm::vec3     boundaryDelta {};
+
+        glm::length_t majorAxis = 0;
+
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            if (direction[axis] > 0.0f)
+            {
+                step[axis]         = 1;
+                nextBoundary[axis] = (static_cast<float>(position[axis] + 1) - ray.origin[axis]) / direction[axis];
+            }
+            else if (direction[axis] < 0.0f)
+            {
+                step[axis]         = -1;
+                nextBoundary[axis] = (static_cast<float>(position[axis]) - ray.origin[axis]) / direction[axis];
+            }
+            else
+            {
+                step[axis]         = 0;
+                nextBoundary[axis] = Infinity;
+            }
+
+            boundaryDelta[axis] = step[axis] != 0 ? 1.0f / std::abs(direction[axis]) : Infinity;
+
+            if (std::abs(direction[axis]) > std::abs(direction[majorAxis]))
+            {
+                majorAxis = axis;
+            }
+        }
+
+        // distance at which the ray entered the current voxel
+        float distance = 0.0f;
+        Face  face     = getEnteredFace(majorAxis, step[majorAxis]);
+
+        while (distance <= ray.max_distance)
+        {
+            const ChunkCoordinate coordinate = world::toChunkCoordinate(position);
+            cursor.moveTo(coordinate);
+
+            const std::optional<world::Voxel>& uniform = cursor.uniform;
+
+            if (uniform.has_value() && *uniform != world::AirVoxel)
+            {
+                return RaycastHit {
+                    .position {position},
+                    .voxel    {*uniform},
+                    .face     {face},
+                    .distance {distance},
+                };
+            }
+
+            if (uniform.has_value())
+            {
+                // Every step the DDA would take inside the chunk at once.
+                // crossings[axis] boundaries lie between the current voxel
+                // and the chunk's far side, the first axis to use them all
+                // up leaves the chunk
+                glm::i32vec3  crossings {};
+                glm::length_t exitAxis = majorAxis;
+                float         exitDistance = Infinity;
+
+                for (glm::length_t axis = 0; axis < 3; ++axis)
+                {
+                    if (step[axis] == 0)
+                    {
+                        continue;
+                    }
+
+                    const std::int32_t first = coordinate[axis] * world::ChunkExtent;
+
+                    crossings[axis] = step[axis] > 0
+                        ? first + world::ChunkExtent - position[axis]
+                        : position[axis] - first + 1;
+
+                    const float leaving =
+                        nextBoundary[axis] + static_cast<float>(crossings[axis] - 1) * boundaryDelta[axis];
+
+                    if (leaving < exitDistance)
+                    {
+                        exitDistance = leaving;
+                        exitAxis     = axis;
+                    }
+                }
+
+                for (glm::length_t axis = 0; axis < 3; ++axis)
+                {
+                    std::int32_t taken = 0;
+
+                    if (axis == exitAxis)
+                    {
+                        taken = crossings[axis];
+                    }
+                    else if (step[axis] != 0 && nextBoundary[axis] < exitDistance)
+                    {
+                        // the boundaries crossed before the exit, never
+                        // enough to leave the chunk along this axis too
+                        const auto before = static_cast<std::int32_t>(
+                            std::floor((exitDistance - nextBoundary[axis]) / boundaryDelta[axis]) + 1.0f);
+
+                        taken = std::min(before, crossings[axis] - 1);
+                    }
+
+                    position[axis] += step[axis] * taken;
+                    nextBoundary[axis] += static_cast<float>(taken) * boundaryDelta[axis];
+                }
+
+                distance = exitDistance;
+                face     = getEnteredFace(exitAxis, step[exitAxis]);
+
+                continue;
+            }
+
+            if (const world::Voxel voxel = cursor.chunk->get(world::toLocalPosition(position)); voxel != world::AirVoxel)
+            {
+                return RaycastHit {
+                    .position {position},
+                    .voxel    {voxel},
+                    .face     {face},
+                    .distance {distance},
+                };
+            }
+
+            glm::length_t axis = 0;
+            if (nextBoundary[1] < nextBoundary[axis])
+            {
+                axis = 1;
+            }
+            if (nextBoundary[2] < nextBoundary[axis])
+            {
+                axis = 2;
+            }
+
+            distance = nextBoundary[axis];
+            face     = getEnteredFace(axis, step[axis]);
+
+            position[axis] += step[axis];
+            nextBoundary[axis] += boundaryDelta[axis];
+        }
+
+        return std::nullopt;
+    }
+} // namespace
+
+namespace world
+{
+    std::optional<RaycastHit> raycast(const VoxelStorage& storage, const Ray& ray)
+    {
+        ChunkCursor cursor {.storage {storage}, .coordinate {}, .chunk {nullptr}, .uniform {}, .is_valid {false}};
+
+        return cast(cursor, ray);
+    }
+
+    void raycast(const VoxelStorage& storage, std::span<const Ray> rays, std::span<std::optional<RaycastHit>> hits)
+    {
+        seb::assertFatal(rays.size() == hits.size(), "{} rays but room for {} hits", rays.size(), hits.size());
+
+        ChunkCursor cursor {.storage {storage}, .coordinate {}, .chunk {nullptr}, .uniform {}, .is_valid {false}};
+
+        for (std::size_t i = 0; i < rays.size(); ++i)
+        {
+            hits[i] = cast(cursor, rays[i]);
+        }
+    }
+} // namespace world
@@ -0,0 +1,49 @@
+#ifndef SRC_WORLD_RAYCAST_HPP
+#define SRC_WORLD_RAYCAST_HPP
+
+#include <optional>
+#include <span>
+
+#include "greedy_mesher.hpp"
+#include "voxel_storage.hpp"
+
+namespace world
+{
+    struct Ray
+    {
+        glm::vec3 origin;
+        // needn't be normalized
+        glm::vec3 direction;
+        // finite, chunks that aren't loaded are crossed like air
+        float     max_distance;
+    };
+
+    struct RaycastHit
+    {
+        WorldPosition position;
+        Voxel         voxel;
+        /// @brief The face of the voxel the ray entered through, its
+        /// getFaceNormal() points back at the ray. Rays starting inside of a
+        /// voxel take the face opposite their largest direction component
+        Face          face;
+        /// @brief From the ray's origin to where it entered the voxel
+        float         distance;
+    };
+
+    /// @brief The first solid voxel along @param ray within its
+    /// max_distance, or nullopt.
+    ///
+    /// Walks the voxels the ray passes through one at a time with the
+    /// Amanatides-Woo DDA, but crosses chunks that aren't loaded or are
+    /// uniformly air in a single step, and stops at the first voxel of a
+    /// uniformly solid one without reading it.
+    [[nodiscard]] std::optional<RaycastHit> raycast(const VoxelStorage&, const Ray& ray);
+
+    /// @brief raycast() for every ray, @param hits parallel to @param rays.
+    /// Rays are cast in order and reuse each other's chunk lookups, so rays
+    /// starting near each other are cheaper cast together
+    void raycast(
+        const VoxelStorage&, std::span<const Ray> rays, std::span<std::optional<RaycastHit>> hits);
+} // namespace world
+
+#endif // SRC_WORLD_RAYCAST_HPP
@@ -0,0 +1,461 @@
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sebib/seblog.hpp>
+
+#include <util/lz4.hpp>
+
+#include "region_file.hpp"
+
+namespace
+{
+    static_assert(std::endian::native == std::endian::little, "Region files are stored little endian");
+
+    // "DRGN"
+    constexpr std::uint32_t RegionMagic   = 0x4E475244;
+    constexpr std::uint32_t RegionVersion = 1;
+
+    // compressed bytes then run bytes, both u32
+    constexpr std::size_t EncodedHeaderBytes = 8;
+    // more than any chunk's runs can take, guards allocations against
+    // corrupt headers
+    constexpr std::size_t MaxRunBytes = world::ChunkVolume * 8;
+
+    constexpr std::size_t MaxSectorCount = 0xFF;
+    constexpr std::size_t MaxFirstSector = 0xFFFFFF;
+
+    /// @brief Returns once what was written to @param file is on disk
+    bool syncData(int file)
+    {
+        #if defined(__APPLE__)
+            return ::fsync(file) == 0;
+        #else
+            return ::fdatasync(file) == 0;
+        #endif
+    }
+
+    void writeVarint(std::vector<std::byte>& out, std::size_t value)
+    {
+        for (; value >= 0x80; value >>= 7)
+        {
+            out.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+        }
+
+        out.push_back(static_cast<std::byte>(value));
+    }
+
+    bool readVarint(std::span<const std::byte> in, std::size_t& position, std::size_t& value)
+    {
+        value = 0;
+
+        // nothing encoded needs more than 3 bytes
+        for (std::size_t shift = 0; shift < 21 && position < in.size(); shift += 7)
+        {
+            const auto byte = std::to_integer<std::size_t>(in[position++]);
+            value |= (byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void write32(std::span<std::byte> out, std::uint32_t value)
+    {
+        std::memcpy(out.data(), &value, sizeof(value));
+    }
+
+    std::uint32_t read32(std::span<const std::byte> in)
+    {
+        std::uint32_t value = 0;
+        std::memcpy(&value, in.data(), sizeof(value));
+
+        return value;
+    }
+} // namespace
+
+namespace world
+{
+    std::vector<std::byte> encodeChunk(const Chunk& chunk)
+    {
+        std::vector<Voxel> voxels (ChunkVolume);
+        chunk.unpack(std::span<Voxel, ChunkVolume> {voxels.data(), ChunkVolume});
+
+        // palette in order of first appearance, linear order keeps
+        // horizontal slices together so runs are long
+        std::vector<Voxel>                     palette {};
+        std::unordered_map<Voxel, std::size_t> lookup {};
+        std::vector<std::pair<std::size_t, std::size_t>> runs {};
+
+        for (std::size_t i = 0; i < ChunkVolume;)
+        {
+            const Voxel voxel = voxels[i];
+            std::size_t end   = i + 1;
+
+            while (end < ChunkVolume && voxels[end] == voxel)
+            {
+                ++end;
+            }
+
+            const auto [it, isNew] = lookup.try_emplace(voxel, palette.size());
+
+            if (isNew)
+            {
+                palette.push_back(voxel);
+            }
+
+            runs.emplace_back(it->second, end - i);
+            i = end;
+        }
+
+        std::vector<std::byte> encodedRuns {};
+        encodedRuns.reserve(2 + palette.size() * 2 + runs.size() * 3);
+
+        writeVarint(encodedRuns, palette.size());
+
+        for (Voxel voxel : palette)
+        {
+            writeVarint(encodedRuns, voxel);
+        }
+
+        for (const auto& [paletteIndex, length] : runs)
+        {
+            writeVarint(encodedRuns, length - 1);
+            writeVarint(encodedRuns, paletteIndex);
+        }
+
+        const std::vector<std::byte> compressed = util::lz4::compress(encodedRuns);
+
+        std::vector<std::byte> encoded (EncodedHeaderBytes + compressed.size());
+        write32(std::span {encoded}.subspan(0, 4), static_cast<std::uint32_t>(compressed.size()));
+        write32(std::span {encoded}.subspan(4, 4), static_cast<std::uint32_t>(encodedRuns.size()));
+        std::ranges::copy(compressed, encoded.begin() + EncodedHeaderBytes);
+
+        return encoded;
+    }
+
+    std::optional<Chunk> decodeChunk(std::span<const std::byte> encoded)
+    {
+        if (encoded.size() < EncodedHeaderBytes)
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t compressedBytes = read32(encoded.subspan(0, 4));
+        const std::size_t runBytes        = read32(encoded.subspan(4, 4));
+
+        if (compressedBytes > encoded.size() - EncodedHeaderBytes || runBytes > MaxRunBytes)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<std::byte> encodedRuns (runBytes);
+
+        if (!util::lz4::decompress(encoded.subspan(EncodedHeaderBytes, compressedBytes), encodedRuns))
+        {
+            return std::nullopt;
+        }
+
+        std::size_t position    = 0;
+        std::size_t paletteSize = 0;
+
+        if (!readVarint(encodedRuns, position, paletteSize) || paletteSize == 0 || paletteSize > ChunkVolume)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<Voxel> palette (paletteSize);
+
+        for (Voxel& voxel : palette)
+        {
+            std::size_t value = 0;
+
+            if (!readVarint(encodedRuns, position, value) || value > std::numeric_limits<Voxel>::max())
+            {
+                return std::nullopt;
+            }
+
+            voxel = static_cast<Voxel>(value);
+        }
+
+        std::vector<Voxel> voxels (ChunkVolume);
+
+        for (std::size_t filled = 0; filled < ChunkVolume;)
+        {
+            std::size_t length       = 0;
+            std::size_t paletteIndex = 0;
+
+            if (!readVarint(encodedRuns, position, length)
+                || !readVarint(encodedRuns, position, paletteIndex)
+                || paletteIndex >= paletteSize
+                || length >= ChunkVolume - filled)
+            {
+                return std::nullopt;
+            }
+
+            std::fill_n(voxels.begin() + static_cast<std::ptrdiff_t>(filled), length + 1, palette[paletteIndex]);
+            filled += length + 1;
+        }
+
+        if (position != encodedRuns.size())
+        {
+            return std::nullopt;
+        }
+
+        Chunk chunk {};
+        chunk.pack(std::span<const Voxel, ChunkVolume> {voxels.data(), ChunkVolume});
+
+        return chunk;
+    }
+
+    RegionFile::RegionFile(std::filesystem::path path_)
+        : path         {std::move(path_)}
+        , file         {::open(this->path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)}
+        , mutex        {}
+        , mapping      {nullptr}
+        , mapped_bytes {0}
+        , entries      {}
+        , used_sectors {}
+    {
+        seb::assertFatal(this->file != -1, "Failed to open region file {} | {}",
+            this->path.string(), std::strerror(errno));
+
+        std::array<std::uint32_t, 2> header {};
+
+        const bool isValid =
+            ::pread(this->file, header.data(), sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))
+            && header[0] == RegionMagic
+            && header[1] == RegionVersion
+            && ::pread(this->file, this->entries.data(), sizeof(this->entries), SectorBytes)
+                == static_cast<ssize_t>(sizeof(this->entries));
+
+        if (!isValid)
+        {
+            if (this->getFileSize() != 0)
+            {
+                seb::logWarn("Region file {} has an unknown format, starting it over", this->path.string());
+            }
+
+            this->initialize();
+        }
+
+        this->used_sectors.assign(this->getFileSize() / SectorBytes, false);
+        std::fill_n(this->used_sectors.begin(), FirstDataSector, true);
+
+        for (std::uint32_t& entry : this->entries)
+        {
+            if (entry == 0)
+            {
+                continue;
+            }
+
+            const std::size_t first = entry >> 8;
+            const std::size_t count = entry & MaxSectorCount;
+
+            if (first < FirstDataSector || count == 0 || first + count > this->used_sectors.size())
+            {
+                seb::logWarn("Region file {} has an entry past its end, dropping it", this->path.string());
+                entry = 0;
+                continue;
+            }
+
+            std::fill_n(this->used_sectors.begin() + static_cast<std::ptrdiff_t>(first), count, true);
+        }
+
+        this->remap();
+    }
+
+    RegionFile::~RegionFile()
+    {
+        if (this->mapping != nullptr)
+        {
+            ::munmap(const_cast<std::byte*>(this->mapping), this->mapped_bytes);
+        }
+
+        ::close(this->file);
+    }
+
+    std::optional<Chunk> RegionFile::read(ChunkCoordinate coordinate) const
+    {
+        const std::size_t index = toEntryIndex(coordinate);
+
+        {
+            std::shared_lock lock {this->mutex};
+
+            const std::uint32_t entry = this->entries[index];
+
+            if (entry == 0)
+            {
+                return std::nullopt;
+            }
+
+            if (((entry >> 8) + (entry & MaxSectorCount)) * SectorBytes <= this->mapped_bytes)
+            {
+                return this->decodeEntry(entry);
+            }
+        }
+
+        // written since the file was last mapped
+        std::unique_lock lock {this->mutex};
+
+        this->remap();
+
+        return this->decodeEntry(this->entries[index]);
+    }
+
+    void RegionFile::write(ChunkCoordinate coordinate, std::span<const std::byte> encoded)
+    {
+        constexpr std::array<std::byte, SectorBytes> Padding {};
+
+        const std::size_t index       = toEntryIndex(coordinate);
+        const std::size_t sectorCount = (encoded.size() + SectorBytes - 1) / SectorBytes;
+
+        seb::assertFatal(sectorCount > 0 && sectorCount <= MaxSectorCount,
+            "Encoded chunk of {} bytes doesn't fit a region entry", encoded.size());
+
+        std::unique_lock lock {this->mutex};
+
+        // never over the previous copy, the entry still points at it until
+        // the new one is complete
+        const std::size_t first   = this->allocateSectors(sectorCount);
+        const auto        offset  = static_cast<off_t>(first * SectorBytes);
+        const std::size_t padding = sectorCount * SectorBytes - encoded.size();
+
+        const bool isWritten =
+            ::pwrite(this->file, encoded.data(), encoded.size(), offset) == static_cast<ssize_t>(encoded.size())
+            && ::pwrite(this->file, Padding.data(), padding, offset + static_cast<off_t>(encoded.size()))
+                == static_cast<ssize_t>(padding)
+            // or the entry could reach the disk before the sectors it points at
+            && syncData(this->file);
+
+        const auto entry = static_cast<std::uint32_t>((first << 8) | sectorCount);
+
+        seb::assertFatal(
+            isWritten && ::pwrite(this->file, &entry, sizeof(entry),
+                static_cast<off_t>(SectorBytes + index * sizeof(entry))) == static_cast<ssize_t>(sizeof(entry)),
+            "Failed to write region file {} | {}", this->path.string(), std::strerror(errno));
+
+        if (const std::uint32_t previous = this->entries[index]; previous != 0)
+        {
+            std::fill_n(this->used_sectors.begin() + static_cast<std::ptrdiff_t>(previous >> 8),
+                previous & MaxSectorCount, false);
+        }
+
+        this->entries[index] = entry;
+    }
+
+    bool RegionFile::contains(ChunkCoordinate coordinate) const
+    {
+        std::shared_lock lock {this->mutex};
+
+        return this->entries[toEntryIndex(coordinate)] != 0;
+    }
+
+    std::size_t RegionFile::getFileSize() const
+    {
+        struct stat status {};
+
+        seb::assertFatal(::fstat(this->file, &status) == 0, "Failed to stat region file {} | {}",
+            this->path.string(), std::strerror(errno));
+
+        return static_cast<std::size_t>(status.st_size);
+    }
+
+    std::size_t RegionFile::toEntryIndex(ChunkCoordinate coordinate)
+    {
+        return static_cast<std::size_t>(
+            ((coordinate.z & (RegionExtent - 1)) << RegionExtentLog2) | (coordinate.x & (RegionExtent - 1)));
+    }
+
+    void RegionFile::initialize()
+    {
+        std::vector<std::byte> header (FirstDataSector * SectorBytes);
+        write32(std::span {header}.subspan(0, 4), RegionMagic);
+        write32(std::span {header}.subspan(4, 4), RegionVersion);
+
+        seb::assertFatal(
+            ::ftruncate(this->file, 0) == 0
+            && ::pwrite(this->file, header.data(), header.size(), 0) == static_cast<ssize_t>(header.size()),
+            "Failed to initialize region file {} | {}", this->path.string(), std::strerror(errno));
+
+        this->entries.fill(0);
+    }
+
+    void RegionFile::remap() const
+    {
+        if (this->mapping != nullptr)
+        {
+            ::munmap(const_cast<std::byte*>(this->mapping), this->mapped_bytes);
+        }
+
+        this->mapped_bytes = this->getFileSize();
+
+        void* const newMapping = ::mmap(nullptr, this->mapped_bytes, PROT_READ, MAP_SHARED, this->file, 0);
+
+        seb::assertFatal(newMapping != MAP_FAILED, "Failed to map region file {} | {}",
+            this->path.string(), std::strerror(errno));
+
+        this->mapping = static_cast<const std::byte*>(newMapping);
+    }
+
+    std::optional<Chunk> RegionFile::decodeEntry(std::uint32_t entry) const
+    {
+        if (entry == 0)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<Chunk> chunk = decodeChunk(std::span {
+            this->mapping + (entry >> 8) * SectorBytes,
+            (entry & MaxSectorCount) * SectorBytes,
+        });
+
+        if (!chunk.has_value())
+        {
+            seb::logWarn("Region file {} has a corrupt chunk, it will be regenerated", this->path.string());
+        }
+
+        return chunk;
+    }
+
+    std::size_t RegionFile::allocateSectors(std::size_t count)
+    {
+        std::size_t run = 0;
+
+        for (std::size_t sector = FirstDataSector; sector < this->used_sectors.size(); ++sector)
+        {
+            run = this->used_sectors[sector] ? 0 : run + 1;
+
+            if (run == count)
+            {
+                const std::size_t first = sector + 1 - count;
+                std::fill_n(this->used_sectors.begin() + static_cast<std::ptrdiff_t>(first), count, true);
+
+                return first;
+            }
+        }
+
+        // nothing fits, grow the file starting from any free sectors at its end
+        const std::size_t first = this->used_sectors.size() - run;
+
+        seb::assertFatal(first <= MaxFirstSector, "Region file {} is full", this->path.string());
+
+        this->used_sectors.resize(first + count, false);
+        std::fill_n(this->used_sectors.begin() + static_cast<std::ptrdiff_t>(first), count, true);
+
+        return first;
+    }
+} // namespace world
@@ -0,0 +1,91 @@
+#ifndef SRC_WORLD_REGION__FILE_HPP
+#define SRC_WORLD_REGION__FILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+
+#include "chunk.hpp"
+
+namespace world
+{
+    /// @brief Run lengths of palette indices in linear order, then LZ4 over
+    /// those. Self describing, the result can be stored as is
+    [[nodiscard]] std::vector<std::byte> encodeChunk(const Chunk&);
+    /// @brief Empty if @param encoded is truncated or corrupt
+    [[nodiscard]] std::optional<Chunk> decodeChunk(std::span<const std::byte> encoded);
+
+    constexpr std::int32_t RegionExtentLog2 = 5;
+    constexpr std::int32_t RegionExtent     = 1 << RegionExtentLog2;
+    constexpr std::size_t  RegionChunkCount = RegionExtent * RegionExtent;
+
+    /// @brief Which region file holds a chunk, regions are RegionExtent x
+    /// RegionExtent chunks of a single chunk layer
+    using RegionCoordinate = glm::i32vec3;
+
+    [[nodiscard]] constexpr RegionCoordinate toRegionCoordinate(ChunkCoordinate chunk)
+    {
+        return {chunk.x >> RegionExtentLog2, chunk.y, chunk.z >> RegionExtentLog2};
+    }
+
+    /// @brief One region's chunks in one file.
+    ///
+    /// The file is 4 KiB sectors: a header, a table with one entry per chunk
+    /// (first sector << 8 | sector count, 0 when absent), then encoded
+    /// chunks. A rewritten chunk goes to free sectors and is flushed to disk
+    /// before its entry is updated, so a write cut short, even by a power
+    /// loss, leaves the previous copy readable.
+    /// Reads decode straight out of a read only mapping of the file, any
+    /// number of threads can read while one writes.
+    class RegionFile
+    {
+    public:
+        /// @brief Opens @param path, creating it if it doesn't exist.
+        /// A file with another format is logged and started over
+        explicit RegionFile(std::filesystem::path path);
+        ~RegionFile();
+
+        RegionFile(const RegionFile&)            = delete;
+        RegionFile(RegionFile&&)                 = delete;
+        RegionFile& operator=(const RegionFile&) = delete;
+        RegionFile& operator=(RegionFile&&)      = delete;
+
+        /// @brief Empty if the chunk was never written or can't be decoded
+        [[nodiscard]] std::optional<Chunk> read(ChunkCoordinate) const;
+        /// @brief Stores @param encoded, the output of encodeChunk
+        void write(ChunkCoordinate, std::span<const std::byte> encoded);
+
+        [[nodiscard]] bool contains(ChunkCoordinate) const;
+        [[nodiscard]] std::size_t getFileSize() const;
+
+    private:
+        constexpr static std::size_t SectorBytes = 4096;
+        // the header and the table
+        constexpr static std::size_t FirstDataSector = 2;
+
+        [[nodiscard]] static std::size_t toEntryIndex(ChunkCoordinate);
+
+        void initialize();
+        /// @brief Maps the whole file again after writes grew it, the
+        /// exclusive lock must be held
+        void remap() const;
+        /// @brief The shared or exclusive lock must be held
+        [[nodiscard]] std::optional<Chunk> decodeEntry(std::uint32_t entry) const;
+        [[nodiscard]] std::size_t allocateSectors(std::size_t count);
+
+        std::filesystem::path path;
+        int                   file;
+
+        mutable std::shared_mutex                     mutex;
+        mutable const std::byte*                      mapping;
+        mutable std::size_t                           mapped_bytes;
+        std::array<std::uint32_t, RegionChunkCount>   entries;
+        std::vector<bool>                             used_sectors;
+    }; // class RegionFile
+} // namespace world
+
+#endif // SRC_WORLD_REGION__FILE_HPP
@@ -0,0 +1,169 @@
+#include <fmt/format.h>
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "region_store.hpp"
+
+namespace world
+{
+    RegionStore::RegionStore(std::filesystem::path directory_)
+        : directory         {std::move(directory_)}
+        , loaded_total      {0}
+        , saved_total       {0}
+        , saved_bytes_total {0}
+    {
+        std::filesystem::create_directories(this->directory);
+
+        this->writer = std::jthread {[this](std::stop_token stopToken)
+        {
+            util::profiler::setThreadName("Region Writer");
+            this->work(stopToken);
+        }};
+    }
+
+    RegionStore::~RegionStore()
+    {
+        this->flush();
+    }
+
+    std::optional<Chunk> RegionStore::load(ChunkCoordinate coordinate)
+    {
+        PROFILE_SCOPE("RegionStore::load");
+
+        RegionFile* region = nullptr;
+        {
+            std::lock_guard lock {this->mutex};
+
+            // not on disk yet, or not completely
+            if (const auto found = this->queued.find(coordinate); found != this->queued.end())
+            {
+                ++this->loaded_total;
+                return found->second;
+            }
+
+            if (this->writing.has_value() && this->writing->first == coordinate)
+            {
+                ++this->loaded_total;
+                return this->writing->second;
+            }
+
+            region = this->getRegion(toRegionCoordinate(coordinate), false);
+        }
+
+        if (region == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        // regions are never closed, and the file locks itself
+        std::optional<Chunk> chunk = region->read(coordinate);
+
+        if (chunk.has_value())
+        {
+            std::lock_guard lock {this->mutex};
+            ++this->loaded_total;
+        }
+
+        return chunk;
+    }
+
+    void RegionStore::save(ChunkCoordinate coordinate, Chunk chunk)
+    {
+        {
+            std::lock_guard lock {this->mutex};
+
+            if (const auto [it, isNew] = this->queued.insert_or_assign(coordinate, std::move(chunk)); isNew)
+            {
+                this->queued_order.push_back(coordinate);
+            }
+        }
+
+        this->save_queued.notify_one();
+    }
+
+    void RegionStore::flush()
+    {
+        std::unique_lock lock {this->mutex};
+
+        this->saves_written.wait(lock, [this]
+        {
+            return this->queued_order.empty() && !this->writing.has_value();
+        });
+    }
+
+    RegionStore::Statistics RegionStore::getStatistics() const
+    {
+        std::lock_guard lock {this->mutex};
+
+        return Statistics {
+            .open_regions      {this->regions.size()},
+            .queued_saves      {this->queued.size() + (this->writing.has_value() ? 1 : 0)},
+            .loaded_total      {this->loaded_total},
+            .saved_total       {this->saved_total},
+            .saved_bytes_total {this->saved_bytes_total},
+        };
+    }
+
+    RegionFile* RegionStore::getRegion(RegionCoordinate coordinate, bool shouldCreate)
+    {
+        if (const auto found = this->regions.find(coordinate); found != this->regions.end())
+        {
+            return found->second.get();
+        }
+
+        const std::filesystem::path path = this->directory
+            / fmt::format("r.{}.{}.{}.region", coordinate.x, coordinate.y, coordinate.z);
+
+        if (!shouldCreate && !std::filesystem::exists(path))
+        {
+            return nullptr;
+        }
+
+        return this->regions.emplace(coordinate, std::make_unique<RegionFile>(path)).first->second.get();
+    }
+
+    void RegionStore::work(std::stop_token stopToken)
+    {
+        while (true)
+        {
+            RegionFile* region = nullptr;
+            {
+                std::unique_lock lock {this->mutex};
+
+                if (!this->save_queued.wait(lock, stopToken, [this] { return !this->queued_order.empty(); }))
+                {
+                    return;
+                }
+
+                const ChunkCoordinate coordinate = this->queued_order.front();
+                this->queued_order.pop_front();
+
+                this->writing.emplace(coordinate, std::move(this->queued.extract(coordinate).mapped()));
+                region = this->getRegion(toRegionCoordinate(coordinate), true);
+            }
+
+            // only this thread changes writing, load() copies it under the lock
+            const std::vector<std::byte> encoded = [&]
+            {
+                PROFILE_SCOPE("RegionStore::encode");
+                return encodeChunk(this->writing->second);
+            }();
+
+            {
+                PROFILE_SCOPE("RegionStore::write");
+                region->write(this->writing->first, encoded);
+            }
+
+            {
+                std::lock_guard lock {this->mutex};
+
+                ++this->saved_total;
+                this->saved_bytes_total += encoded.size();
+                this->writing.reset();
+            }
+
+            this->saves_written.notify_all();
+        }
+    }
+} // namespace world
@@ -0,0 +1,85 @@
+#ifndef SRC_WORLD_REGION__STORE_HPP
+#define SRC_WORLD_REGION__STORE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+
+#include "region_file.hpp"
+
+namespace world
+{
+    /// @brief Chunks persisted as RegionFiles under one directory.
+    ///
+    /// save() only queues a copy, a writer thread encodes and writes it.
+    /// Saving a chunk again before it's written replaces the queued copy,
+    /// and load() sees queued chunks, so callers never read stale data.
+    /// load() is safe from any thread.
+    class RegionStore
+    {
+    public:
+        struct Statistics
+        {
+            std::size_t open_regions;
+            std::size_t queued_saves;
+
+            std::size_t loaded_total;
+            std::size_t saved_total;
+            // encoded, what actually went to disk
+            std::size_t saved_bytes_total;
+        };
+
+        explicit RegionStore(std::filesystem::path directory);
+        /// @brief Writes everything still queued
+        ~RegionStore();
+
+        RegionStore(const RegionStore&)            = delete;
+        RegionStore(RegionStore&&)                 = delete;
+        RegionStore& operator=(const RegionStore&) = delete;
+        RegionStore& operator=(RegionStore&&)      = delete;
+
+        /// @brief Empty if the chunk was never saved
+        [[nodiscard]] std::optional<Chunk> load(ChunkCoordinate);
+        void save(ChunkCoordinate, Chunk);
+
+        /// @brief Blocks until every queued chunk is written
+        void flush();
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        /// @brief Opens the region's file, null if it doesn't exist and
+        /// @param shouldCreate is false. The mutex must be held
+        [[nodiscard]] RegionFile* getRegion(RegionCoordinate, bool shouldCreate);
+        void work(std::stop_token);
+
+        std::filesystem::path directory;
+
+        mutable std::mutex          mutex;
+        std::condition_variable_any save_queued;
+        std::condition_variable_any saves_written;
+
+        std::unordered_map<RegionCoordinate, std::unique_ptr<RegionFile>, ChunkCoordinateHash> regions;
+
+        // newest copy of each queued chunk, queued_order holds each once
+        std::unordered_map<ChunkCoordinate, Chunk, ChunkCoordinateHash> queued;
+        std::deque<ChunkCoordinate>                                     queued_order;
+        // being encoded and written by the writer
+        std::optional<std::pair<ChunkCoordinate, Chunk>>                writing;
+
+        std::size_t loaded_total;
+        std::size_t saved_total;
+        std::size_t saved_bytes_total;
+
+        // last, so it's joined before anything it touches is destroyed
+        std::jthread writer;
+    }; // class RegionStore
+} // namespace world
+
+#endif // SRC_WORLD_REGION__STORE_HPP
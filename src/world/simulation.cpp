@@ -0,0 +1,276 @@
+#include <algorithm>
+
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "simulation.hpp"
+
+namespace world
+{
+    Simulation::Simulation(double ticksPerSecond, util::WorkerPool& pool)
+        : tick_duration {std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double> {1.0 / ticksPerSecond})}
+        , tick_seconds {static_cast<float>(1.0 / ticksPerSecond)}
+        , systems {pool}
+        , tick_count {0}
+        // ahead of every snapshot's, so the empty brickmap is published too
+        , brickmap_version {1}
+        , flattened_version {0}
+        , pending_brickmap_version {2}
+        , is_brickmap_published {false}
+        , statistics {}
+    {
+        seb::assertFatal(ticksPerSecond > 0.0, "Simulation tick rate {} isn't positive", ticksPerSecond);
+
+        this->systems.add<render::Transform, const Motion>(
+            "motion",
+            [seconds = this->tick_seconds](render::Transform& transform, const Motion& motion)
+            {
+                Simulation::move(transform, motion, seconds);
+            });
+
+        this->thread = std::jthread {[this](std::stop_token stopToken)
+        {
+            this->run(stopToken);
+        }};
+    }
+
+    std::size_t Simulation::addBody(const render::Transform& transform, const Motion& motion)
+    {
+        std::lock_guard lock {this->mutex};
+
+        this->pending_bodies.push_back({transform, motion});
+
+        return this->statistics.bodies++;
+    }
+
+    std::uint64_t Simulation::setChunk(ChunkCoordinate coordinate, const Chunk& chunk)
+    {
+        std::lock_guard lock {this->mutex};
+
+        this->pending_chunks.insert_or_assign(coordinate, chunk);
+
+        return this->pending_brickmap_version;
+    }
+
+    std::uint64_t Simulation::removeChunk(ChunkCoordinate coordinate)
+    {
+        std::lock_guard lock {this->mutex};
+
+        this->pending_chunks.insert_or_assign(coordinate, std::nullopt);
+
+        return this->pending_brickmap_version;
+    }
+
+    void Simulation::setBrickmapPublished(bool isPublished)
+    {
+        std::lock_guard lock {this->mutex};
+
+        this->is_brickmap_published = isPublished;
+    }
+
+    bool Simulation::acquireSnapshot()
+    {
+        return this->snapshots.acquire();
+    }
+
+    const Simulation::Snapshot& Simulation::getSnapshot() const
+    {
+        return this->snapshots.getFront();
+    }
+
+    float Simulation::getAlpha(const Snapshot& snapshot, Clock::time_point now) const
+    {
+        const double alpha = std::chrono::duration<double> {now - snapshot.time}
+                           / std::chrono::duration<double> {this->tick_duration};
+
+        return static_cast<float>(std::clamp(alpha, 0.0, 1.0));
+    }
+
+    Simulation::Clock::duration Simulation::getTickDuration() const
+    {
+        return this->tick_duration;
+    }
+
+    Simulation::Statistics Simulation::getStatistics() const
+    {
+        std::lock_guard lock {this->mutex};
+
+        return this->statistics;
+    }
+
+    render::Transform Simulation::interpolate(const render::Transform& from, const render::Transform& to, float alpha)
+    {
+        // a tick apart rotations barely differ, normalizing their lerp is
+        // as close as slerp without the trigonometry
+        const float sign = glm::dot(from.rotation, to.rotation) < 0.0f ? -1.0f : 1.0f;
+
+        render::Transform transform {};
+        transform.translation = glm::mix(from.translation, to.translation, alpha);
+        transform.rotation    = glm::normalize(from.rotation * (1.0f - alpha) + to.rotation * (sign * alpha));
+        transform.scale       = glm::mix(from.scale, to.scale, alpha);
+
+        return transform;
+    }
+
+    void Simulation::move(render::Transform& transform, const Motion& motion, float seconds)
+    {
+        transform.translation += motion.velocity * seconds;
+
+        const float rate = glm::length(motion.angular_velocity);
+
+        if (rate > 0.0f)
+        {
+            transform.rotation = glm::normalize(
+                glm::angleAxis(rate * seconds, motion.angular_velocity / rate) * transform.rotation);
+        }
+    }
+
+    void Simulation::run(std::stop_token stopToken)
+    {
+        util::profiler::setThreadName("Simulation");
+
+        Clock::time_point due = Clock::now() + this->tick_duration;
+
+        while (true)
+        {
+            {
+                std::unique_lock lock {this->mutex};
+
+                // only ever woken to stop
+                this->wake.wait_until(lock, stopToken, due, [] { return false; });
+            }
+
+            if (stopToken.stop_requested())
+            {
+                return;
+            }
+
+            const Clock::time_point now = Clock::now();
+
+            if (now < due)
+            {
+                continue;
+            }
+
+            const auto dueTicks = static_cast<std::size_t>((now - due) / this->tick_duration) + 1;
+
+            // a stall this long would otherwise be made up for by a burst of
+            // ticks that only falls further behind
+            if (dueTicks > MaxCatchUpTicks)
+            {
+                const std::size_t dropped = dueTicks - MaxCatchUpTicks;
+                due += this->tick_duration * static_cast<Clock::rep>(dropped);
+
+                std::lock_guard lock {this->mutex};
+                this->statistics.dropped_ticks += dropped;
+            }
+
+            for (; due <= now; due += this->tick_duration)
+            {
+                this->tick(due);
+            }
+        }
+    }
+
+    void Simulation::tick(Clock::time_point time)
+    {
+        PROFILE_SCOPE("Simulation::tick");
+
+        const Clock::time_point start = Clock::now();
+
+        std::vector<std::pair<render::Transform, Motion>> added {};
+        std::unordered_map<ChunkCoordinate, std::optional<Chunk>, ChunkCoordinateHash> chunks {};
+        bool isPublished = false;
+        {
+            std::lock_guard lock {this->mutex};
+            added.swap(this->pending_bodies);
+            chunks.swap(this->pending_chunks);
+            isPublished = this->is_brickmap_published;
+
+            // updateBrickmap() bumps brickmap_version to it for these
+            this->pending_brickmap_version += chunks.empty() ? 0U : 1U;
+        }
+
+        for (const auto& [transform, motion] : added)
+        {
+            this->bodies.create(Body {this->transforms.size()}, transform, motion);
+            this->transforms.push_back(transform);
+        }
+
+        // the back buffer was published two ticks ago, its vectors are
+        // reused rather than reallocated. The last tick's transforms become
+        // previous, what was previous is overwritten below
+        Snapshot& snapshot = this->snapshots.getBack();
+        snapshot.previous.swap(this->transforms);
+
+        this->systems.run(this->bodies);
+
+        snapshot.current.resize(snapshot.previous.size());
+
+        this->bodies.forEach<const Body, const render::Transform>(
+            [&](const Body& body, const render::Transform& transform)
+            {
+                snapshot.current[body.index] = transform;
+            });
+
+        snapshot.tick    = ++this->tick_count;
+        snapshot.time    = time;
+        this->transforms = snapshot.current;
+
+        const bool isBrickmapChanged = !chunks.empty();
+        this->updateBrickmap(chunks, isPublished, snapshot);
+
+        this->snapshots.publish();
+
+        const std::optional<Brickmap::Statistics> brickmapStatistics =
+            isBrickmapChanged ? std::optional {this->brickmap.getStatistics()} : std::nullopt;
+
+        std::lock_guard lock {this->mutex};
+        this->statistics.ticks     = this->tick_count;
+        this->statistics.tick_time = Clock::now() - start;
+        this->statistics.brickmap  = brickmapStatistics.value_or(this->statistics.brickmap);
+    }
+
+    void Simulation::updateBrickmap(
+        const std::unordered_map<ChunkCoordinate, std::optional<Chunk>, ChunkCoordinateHash>& chunks,
+        bool                                                                               isPublished,
+        Snapshot&                                                                          snapshot)
+    {
+        PROFILE_SCOPE("Simulation::updateBrickmap");
+
+        for (const auto& [coordinate, chunk] : chunks)
+        {
+            if (chunk.has_value())
+            {
+                this->brickmap.setChunk(coordinate, *chunk);
+            }
+            else
+            {
+                this->brickmap.removeChunk(coordinate);
+            }
+        }
+
+        this->brickmap_version += chunks.empty() ? 0U : 1U;
+
+        if (!isPublished)
+        {
+            return;
+        }
+
+        // whole, the brickmap is a small fraction of the meshes it replaces
+        if (this->flattened_version != this->brickmap_version)
+        {
+            this->brickmap_words.resize(this->brickmap.getGpuWordCount());
+            this->brickmap.writeGpuWords(this->brickmap_words);
+            this->flattened_version = this->brickmap_version;
+        }
+
+        // each buffer copies the words once it falls behind
+        if (snapshot.brickmap_version != this->flattened_version)
+        {
+            snapshot.brickmap_words   = this->brickmap_words;
+            snapshot.brickmap_version = this->flattened_version;
+        }
+    }
+} // namespace world
@@ -0,0 +1,165 @@
+#ifndef SRC_WORLD_SIMULATION_HPP
+#define SRC_WORLD_SIMULATION_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <render/render_structs.hpp>
+#include <util/triple_buffer.hpp>
+#include <util/worker_pool.hpp>
+
+#include "brickmap.hpp"
+#include "entity_store.hpp"
+#include "system_scheduler.hpp"
+
+namespace world
+{
+    /// @brief Moves bodies at a fixed tick rate on its own thread, however
+    /// fast or slow frames are.
+    ///
+    /// Every tick publishes a Snapshot of every body's transform before and
+    /// after it through a util::TripleBuffer, so neither thread ever waits on
+    /// the other. The render thread draws one tick behind, interpolating
+    /// between the two by getAlpha(), and frames faster than the tick rate
+    /// don't run any extra ticks. Ticks running late are caught up, up to
+    /// MaxCatchUpTicks at once, past that the time is dropped.
+    ///
+    /// The far field's Brickmap is kept on the same thread. Chunks set or
+    /// removed are applied at the start of the next tick, and while the
+    /// brickmap is published every snapshot carries its GPU words, flattened
+    /// once per change.
+    class Simulation
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        constexpr static std::size_t MaxCatchUpTicks = 4;
+
+        /// @brief Per second, @param angular_velocity is about its own
+        /// direction by its length in radians
+        struct Motion
+        {
+            glm::vec3 velocity;
+            glm::vec3 angular_velocity;
+        };
+
+        struct Snapshot
+        {
+            std::uint64_t tick;
+            // when the tick was due, current is drawn a tick later
+            Clock::time_point time;
+            // by body, bodies added since have neither
+            std::vector<render::Transform> previous;
+            std::vector<render::Transform> current;
+            // Brickmap::writeGpuWords() as of brickmap_version, which only
+            // grows. Left as they were while the brickmap isn't published
+            std::vector<std::uint32_t> brickmap_words;
+            std::uint64_t              brickmap_version;
+        };
+
+        struct Statistics
+        {
+            std::size_t ticks;
+            std::size_t dropped_ticks;
+            std::size_t bodies;
+            std::chrono::duration<double> tick_time;
+            // as of the last tick that changed it
+            Brickmap::Statistics brickmap;
+        };
+
+        /// @param pool runs the bodies' systems alongside the simulation's
+        /// own thread, and must outlive the simulation
+        Simulation(double ticksPerSecond, util::WorkerPool& pool);
+        ~Simulation() = default;
+
+        Simulation(const Simulation&)            = delete;
+        Simulation(Simulation&&)                 = delete;
+        Simulation& operator=(const Simulation&) = delete;
+        Simulation& operator=(Simulation&&)      = delete;
+
+        /// @brief Moves from the next tick on, returns the body's index into
+        /// every later Snapshot
+        [[nodiscard]] std::size_t addBody(const render::Transform&, const Motion&);
+        /// @brief Replaces the brickmap's chunk at @param coordinate with
+        /// @param chunk from the next tick on. Both return the
+        /// brickmap_version of the first snapshot that has the change
+        [[nodiscard]] std::uint64_t setChunk(ChunkCoordinate coordinate, const Chunk& chunk);
+        [[nodiscard]] std::uint64_t removeChunk(ChunkCoordinate);
+        /// @brief Whether ticks flatten the brickmap into their snapshots,
+        /// off by default since nothing reads it with the far field off
+        void setBrickmapPublished(bool isPublished);
+
+        /// @brief Render thread only, true if a newer snapshot replaced the
+        /// one getSnapshot() returns
+        bool acquireSnapshot();
+        /// @brief Render thread only
+        [[nodiscard]] const Snapshot& getSnapshot() const;
+        /// @brief How far from previous to current @param snapshot is at
+        /// @param now, in [0, 1]
+        [[nodiscard]] float getAlpha(const Snapshot& snapshot, Clock::time_point now) const;
+        [[nodiscard]] Clock::duration getTickDuration() const;
+        [[nodiscard]] Statistics getStatistics() const;
+
+        [[nodiscard]] static render::Transform
+        interpolate(const render::Transform& from, const render::Transform& to, float alpha);
+        /// @brief @param transform after @param seconds of @param motion
+        static void move(render::Transform& transform, const Motion& motion, float seconds);
+
+    private:
+        struct Body
+        {
+            std::size_t index;
+        };
+
+        void run(std::stop_token);
+        /// @brief Moves every body once and publishes the tick due at @param time
+        void tick(Clock::time_point time);
+        /// @brief Applies @param chunks, nullopt removes one, and brings the
+        /// words of @param snapshot up to date if @param isPublished
+        void updateBrickmap(
+            const std::unordered_map<ChunkCoordinate, std::optional<Chunk>, ChunkCoordinateHash>& chunks,
+            bool                                                                               isPublished,
+            Snapshot&                                                                          snapshot);
+
+        Clock::duration tick_duration;
+        float           tick_seconds;
+
+        // simulation thread only
+        EntityStore                    bodies;
+        SystemScheduler                systems;
+        // by body as of the last tick, the next snapshot's previous
+        std::vector<render::Transform> transforms;
+        std::uint64_t                  tick_count;
+        Brickmap                       brickmap;
+        std::uint64_t                  brickmap_version;
+        // the brickmap's words as of flattened_version
+        std::vector<std::uint32_t>     brickmap_words;
+        std::uint64_t                  flattened_version;
+
+        util::TripleBuffer<Snapshot> snapshots;
+
+        mutable std::mutex          mutex;
+        std::condition_variable_any wake;
+        // added since the last tick, in order of their index
+        std::vector<std::pair<render::Transform, Motion>> pending_bodies;
+        // set or removed since the last tick, only the last change of each
+        std::unordered_map<ChunkCoordinate, std::optional<Chunk>, ChunkCoordinateHash> pending_chunks;
+        // the brickmap_version the next tick applies them as
+        std::uint64_t               pending_brickmap_version;
+        bool                        is_brickmap_published;
+        Statistics                  statistics;
+
+        // last, so it's joined before anything it touches is destroyed
+        std::jthread thread;
+    }; // class Simulation
+} // namespace world
+
+#endif // SRC_WORLD_SIMULATION_HPP
@@ -0,0 +1,100 @@
+#include <algorithm>
+
+#include <util/profiler.hpp>
+
+#include "system_scheduler.hpp"
+
+namespace world
+{
+    SystemScheduler::SystemScheduler(util::WorkerPool& pool_)
+        : pool {pool_}
+        , stages {0}
+        , batches {0}
+        , run_time {0.0}
+    {}
+
+    void SystemScheduler::run(EntityStore& store)
+    {
+        PROFILE_SCOPE("SystemScheduler::run");
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<Batch> stage {};
+        ComponentMask      stageReads  = 0;
+        ComponentMask      stageWrites = 0;
+
+        this->stages  = 0;
+        this->batches = 0;
+
+        const auto finishStage = [&]
+        {
+            if (!stage.empty())
+            {
+                this->runStage(store, stage);
+
+                ++this->stages;
+                this->batches += stage.size();
+            }
+
+            stage.clear();
+            stageReads  = 0;
+            stageWrites = 0;
+        };
+
+        for (const System& system : this->systems)
+        {
+            const ComponentMask reads = system.query & ~system.writes;
+
+            // written while another system of the stage touches it, or read
+            // while another writes it
+            if ((system.writes & (stageReads | stageWrites)) != 0 || (reads & stageWrites) != 0)
+            {
+                finishStage();
+            }
+
+            stageReads  |= reads;
+            stageWrites |= system.writes;
+
+            for (std::size_t archetype : store.getMatchingArchetypes(system.query))
+            {
+                const std::size_t rows = store.getArchetypeSize(archetype);
+
+                for (std::size_t begin = 0; begin < rows; begin += BatchRows)
+                {
+                    stage.push_back(Batch {
+                        .system    {&system},
+                        .archetype {archetype},
+                        .begin     {begin},
+                        .end       {std::min(begin + BatchRows, rows)},
+                    });
+                }
+            }
+        }
+
+        finishStage();
+
+        this->run_time = std::chrono::steady_clock::now() - start;
+    }
+
+    SystemScheduler::Statistics SystemScheduler::getStatistics() const
+    {
+        return Statistics {
+            .workers  {this->pool.getWorkerCount()},
+            .systems  {this->systems.size()},
+            .stages   {this->stages},
+            .batches  {this->batches},
+            .run_time {this->run_time},
+        };
+    }
+
+    void SystemScheduler::runStage(EntityStore& store, const std::vector<Batch>& stageBatches)
+    {
+        PROFILE_SCOPE("SystemScheduler::runStage");
+
+        this->pool.run(stageBatches.size(), [&](std::size_t i)
+        {
+            const Batch& batch = stageBatches[i];
+            batch.system->run(store, batch.archetype, batch.begin, batch.end);
+        });
+    }
+} // namespace world
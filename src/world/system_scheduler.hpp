@@ -0,0 +1,112 @@
+#ifndef SRC_WORLD_SYSTEM__SCHEDULER_HPP
+#define SRC_WORLD_SYSTEM__SCHEDULER_HPP
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <util/worker_pool.hpp>
+
+#include "entity_store.hpp"
+
+namespace world
+{
+    /// @brief Runs systems, functions called for every entity of an
+    /// EntityStore matching a query, on a util::WorkerPool.
+    ///
+    /// Systems run in the order they were added, except that consecutive
+    /// ones whose components don't overlap, or overlap only where both read,
+    /// form one stage and run at the same time. Each stage is cut into
+    /// batches of at most BatchRows rows of one archetype, each a task of
+    /// the pool, so one system over many entities is spread over every
+    /// thread as well.
+    class SystemScheduler
+    {
+    public:
+        constexpr static std::size_t BatchRows = 4096;
+
+        struct Statistics
+        {
+            std::size_t workers;
+            std::size_t systems;
+
+            // of the last run()
+            std::size_t stages;
+            std::size_t batches;
+            std::chrono::duration<double> run_time;
+        };
+
+        /// @param pool runs every stage's batches, and must outlive the
+        /// scheduler
+        explicit SystemScheduler(util::WorkerPool& pool);
+        ~SystemScheduler() = default;
+
+        SystemScheduler(const SystemScheduler&)            = delete;
+        SystemScheduler(SystemScheduler&&)                 = delete;
+        SystemScheduler& operator=(const SystemScheduler&) = delete;
+        SystemScheduler& operator=(SystemScheduler&&)      = delete;
+
+        /// @brief @param function is called with the Components... of every
+        /// entity that has them, from any thread and several at once.
+        /// Components it only reads must be const, the rest are what keeps it
+        /// apart from other systems
+        template<class... Components, class Function>
+        void add(std::string name, Function function)
+        {
+            this->systems.push_back(System {
+                .name   {std::move(name)},
+                .query  {EntityStore::getComponentMask<Components...>()},
+                .writes {(getWriteMask<Components>() | ... | ComponentMask {0})},
+                .run    {
+                    [function = std::move(function)](
+                        EntityStore& store, std::size_t archetype, std::size_t begin, std::size_t end)
+                    {
+                        store.forEachInRange<Components...>(archetype, begin, end, function);
+                    }
+                },
+            });
+        }
+
+        /// @brief Every system over @param store once. Nothing may create or
+        /// destroy entities or add or remove components meanwhile
+        void run(EntityStore& store);
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        struct System
+        {
+            std::string   name;
+            ComponentMask query;
+            ComponentMask writes;
+            std::function<void(EntityStore&, std::size_t archetype, std::size_t begin, std::size_t end)> run;
+        };
+
+        struct Batch
+        {
+            const System* system;
+            std::size_t   archetype;
+            std::size_t   begin;
+            std::size_t   end;
+        };
+
+        template<class Component>
+        [[nodiscard]] static ComponentMask getWriteMask()
+        {
+            return std::is_const_v<Component> ? ComponentMask {0} : EntityStore::getComponentMask<Component>();
+        }
+
+        /// @brief Every batch once, on the pool
+        void runStage(EntityStore&, const std::vector<Batch>& batches);
+
+        util::WorkerPool& pool;
+        std::vector<System> systems;
+        std::size_t stages;
+        std::size_t batches;
+        std::chrono::duration<double> run_time;
+    }; // class SystemScheduler
+} // namespace world
+
+#endif // SRC_WORLD_SYSTEM__SCHEDULER_HPP
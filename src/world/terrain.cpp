@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "terrain.hpp"
+
+namespace
+{
+    constexpr float SurfaceMidpoint =
+        static_cast<float>(world::TerrainGenerator::MinSurfaceHeight + world::TerrainGenerator::MaxSurfaceHeight) / 2.0f;
+    constexpr float SurfaceAmplitude =
+        static_cast<float>(world::TerrainGenerator::MaxSurfaceHeight - world::TerrainGenerator::MinSurfaceHeight) / 2.0f;
+
+    // cave noise above this is carved out, about a tenth of the underground
+    constexpr float         CaveThreshold = 0.3f;
+    constexpr std::uint32_t CaveSeedSalt  = 0x5BD1E995;
+    constexpr std::int32_t  DirtDepth     = 4;
+
+    /// @brief Stone with a sprinkling of ores
+    world::Voxel sampleStone(world::WorldPosition position)
+    {
+        // unsigned so the products wrap instead of overflowing
+        const std::uint32_t hash = static_cast<std::uint32_t>(position.x) * 73856093U
+            ^ static_cast<std::uint32_t>(position.y) * 19349663U
+            ^ static_cast<std::uint32_t>(position.z) * 83492791U;
+
+        return hash % 97 == 0
+            ? static_cast<world::Voxel>(world::material::FirstOre + hash % world::material::OreCount)
+            : world::material::Stone;
+    }
+} // namespace
+
+namespace world
+{
+    Voxel sampleHills(WorldPosition position)
+    {
+        const float height = 64.0f
+            + 24.0f * std::sin(static_cast<float>(position.x) * 0.031f)
+            * std::cos(static_cast<float>(position.z) * 0.027f);
+        const auto surface = static_cast<std::int32_t>(height);
+
+        if (position.y > surface)
+        {
+            return AirVoxel;
+        }
+
+        if (position.y == surface)
+        {
+            return material::Grass;
+        }
+
+        if (position.y > surface - DirtDepth)
+        {
+            return material::Dirt;
+        }
+
+        return sampleStone(position);
+    }
+
+    Chunk generateHillsChunk(ChunkCoordinate coordinate)
+    {
+        Chunk chunk {};
+
+        for (std::int32_t y = 0; y < ChunkExtent; ++y)
+        {
+            for (std::int32_t z = 0; z < ChunkExtent; ++z)
+            {
+                for (std::int32_t x = 0; x < ChunkExtent; ++x)
+                {
+                    chunk.set({x, y, z}, sampleHills(toWorldPosition(coordinate, {x, y, z})));
+                }
+            }
+        }
+
+        return chunk;
+    }
+
+    TerrainGenerator::TerrainGenerator(std::uint32_t seed)
+        : height_noise {seed, FractalSettings {
+            .octaves    {5},
+            .frequency  {1.0f / 256.0f},
+            .lacunarity {2.0f},
+            .gain       {0.5f},
+        }}
+        , cave_noise {seed ^ CaveSeedSalt, FractalSettings {
+            .octaves    {2},
+            .frequency  {1.0f / 48.0f},
+            .lacunarity {2.0f},
+            .gain       {0.5f},
+        }}
+    {}
+
+    Chunk TerrainGenerator::generateChunk(ChunkCoordinate coordinate) const
+    {
+        return this->generateCells(coordinate, 1);
+    }
+
+    Chunk TerrainGenerator::generateCells(ChunkCoordinate node, std::int32_t scale) const
+    {
+        // the center voxel of the first cell, cells are scale apart from there
+        const WorldPosition origin = toWorldPosition(node, {0, 0, 0}) * scale + scale / 2;
+
+        // [z][x] across the chunk's column, the highest of each row lets
+        // rows that are all sky skip the cave noise
+        std::array<std::int32_t, ChunkExtent * ChunkExtent> surface {};
+        std::array<std::int32_t, ChunkExtent>               rowHighest {};
+
+        for (std::int32_t z = 0; z < ChunkExtent; ++z)
+        {
+            const std::span<std::int32_t, ChunkExtent> row {
+                surface.data() + z * ChunkExtent, static_cast<std::size_t>(ChunkExtent)};
+
+            this->sampleSurfaceRow(origin.x, origin.z + z * scale, scale, row);
+            rowHighest[static_cast<std::size_t>(z)] = std::ranges::max(row);
+        }
+
+        const std::int32_t highest = std::ranges::max(rowHighest);
+
+        if (origin.y > highest)
+        {
+            return Chunk {};
+        }
+
+        std::vector<Voxel>             voxels (ChunkVolume, AirVoxel);
+        std::array<float, ChunkExtent> caves {};
+
+        for (std::int32_t y = 0; y < ChunkExtent && origin.y + y * scale <= highest; ++y)
+        {
+            const std::int32_t worldY = origin.y + y * scale;
+
+            for (std::int32_t z = 0; z < ChunkExtent; ++z)
+            {
+                if (worldY > rowHighest[static_cast<std::size_t>(z)])
+                {
+                    continue;
+                }
+
+                this->cave_noise.sampleRow(
+                    static_cast<float>(origin.x),
+                    static_cast<float>(worldY),
+                    static_cast<float>(origin.z + z * scale),
+                    static_cast<float>(scale),
+                    caves);
+
+                for (std::int32_t x = 0; x < ChunkExtent; ++x)
+                {
+                    const std::int32_t height = surface[static_cast<std::size_t>(z * ChunkExtent + x)];
+
+                    if (worldY > height || caves[static_cast<std::size_t>(x)] > CaveThreshold)
+                    {
+                        continue;
+                    }
+
+                    Voxel& voxel = voxels[toLinearIndex({x, y, z})];
+
+                    // the surface is somewhere inside the topmost cell
+                    if (height - worldY < scale)
+                    {
+                        voxel = material::Grass;
+                    }
+                    else if (height - worldY < DirtDepth)
+                    {
+                        voxel = material::Dirt;
+                    }
+                    else
+                    {
+                        voxel = sampleStone({origin.x + x * scale, worldY, origin.z + z * scale});
+                    }
+                }
+            }
+        }
+
+        Chunk chunk {};
+        chunk.pack(std::span<const Voxel, ChunkVolume> {voxels.data(), ChunkVolume});
+
+        return chunk;
+    }
+
+    std::int32_t TerrainGenerator::getSurfaceHeight(std::int32_t x, std::int32_t z) const
+    {
+        // the same row generateChunk samples, a lone sample could round
+        // differently
+        std::array<std::int32_t, ChunkExtent> row {};
+        this->sampleSurfaceRow(x & ~(ChunkExtent - 1), z, 1, row);
+
+        return row[static_cast<std::size_t>(x & (ChunkExtent - 1))];
+    }
+
+    void TerrainGenerator::sampleSurfaceRow(
+        std::int32_t x,
+        std::int32_t z,
+        std::int32_t step,
+        std::span<std::int32_t, ChunkExtent> out) const
+    {
+        std::array<float, ChunkExtent> heights {};
+        this->height_noise.sampleRow(
+            static_cast<float>(x), static_cast<float>(z), static_cast<float>(step), heights);
+
+        for (std::size_t i = 0; i < heights.size(); ++i)
+        {
+            out[i] = std::clamp(
+                static_cast<std::int32_t>(std::floor(SurfaceMidpoint + SurfaceAmplitude * heights[i])),
+                MinSurfaceHeight,
+                MaxSurfaceHeight);
+        }
+    }
+} // namespace world
@@ -0,0 +1,62 @@
+#ifndef SRC_WORLD_TERRAIN_HPP
+#define SRC_WORLD_TERRAIN_HPP
+
+#include "chunk.hpp"
+#include "noise.hpp"
+
+namespace world
+{
+    /// @brief Rolling hills of stone under dirt and grass with a sprinkling
+    /// of ores, cheap to evaluate and roughly what generated terrain
+    /// palettes look like. The surface stays within y in [40, 88]
+    [[nodiscard]] Voxel sampleHills(WorldPosition);
+    [[nodiscard]] Chunk generateHillsChunk(ChunkCoordinate);
+
+    /// @brief Fractal noise hills with caves carved out of them.
+    ///
+    /// Everything is derived from the seed and the position, so any number
+    /// of threads can generate chunks from one generator, or from equally
+    /// seeded copies, in any order and get identical chunks. Noise is
+    /// evaluated a row of a chunk at a time, the heightmap once per chunk
+    /// column and caves only below the surface.
+    class TerrainGenerator
+    {
+    public:
+        // the surface stays within y in [MinSurfaceHeight, MaxSurfaceHeight]
+        constexpr static std::int32_t MinSurfaceHeight = 16;
+        constexpr static std::int32_t MaxSurfaceHeight = 112;
+
+        explicit TerrainGenerator(std::uint32_t seed);
+        ~TerrainGenerator() = default;
+
+        TerrainGenerator(const TerrainGenerator&)            = default;
+        TerrainGenerator(TerrainGenerator&&)                 = default;
+        TerrainGenerator& operator=(const TerrainGenerator&) = default;
+        TerrainGenerator& operator=(TerrainGenerator&&)      = default;
+
+        [[nodiscard]] Chunk generateChunk(ChunkCoordinate) const;
+        /// @brief A chunk of cells @param scale voxels wide along each axis,
+        /// so @param node covers @param scale chunks along each axis. Each
+        /// cell takes the material of the voxel at its center, or grass if
+        /// the surface passes through it. A scale of 1 is exactly
+        /// generateChunk()
+        [[nodiscard]] Chunk generateCells(ChunkCoordinate node, std::int32_t scale) const;
+        /// @brief y of the topmost voxel before caves are carved
+        [[nodiscard]] std::int32_t getSurfaceHeight(std::int32_t x, std::int32_t z) const;
+
+    private:
+        /// @brief Surface heights of the ChunkExtent columns @param step
+        /// apart along x from (@param x, @param z). For a step of 1, x is
+        /// always a chunk's minimum corner
+        void sampleSurfaceRow(
+            std::int32_t x,
+            std::int32_t z,
+            std::int32_t step,
+            std::span<std::int32_t, ChunkExtent> out) const;
+
+        FractalNoise height_noise;
+        FractalNoise cave_noise;
+    }; // class TerrainGenerator
+} // namespace world
+
+#endif // SRC_WORLD_TERRAIN_HPP
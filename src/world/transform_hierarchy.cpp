@@ -0,0 +1,428 @@
+#include <algorithm>
+
+#include <sebib/seblog.hpp>
+
+#include <util/profiler.hpp>
+
+#include "transform_hierarchy.hpp"
+
+namespace
+{
+    /// @brief @param parent * @param local as 3x3 matrices, the padding stays 0
+    render::NormalMatrix multiplyNormals(const render::NormalMatrix& parent, const render::NormalMatrix& local)
+    {
+        render::NormalMatrix result {1.0f};
+
+        for (int column = 0; column < 3; ++column)
+        {
+            result[column] = parent[0] * local[column].x + parent[1] * local[column].y + parent[2] * local[column].z;
+        }
+
+        return result;
+    }
+} // namespace
+
+namespace world
+{
+    TransformHierarchy::TransformHierarchy(util::WorkerPool& pool_)
+        : pool {pool_}
+        , node_count {0}
+        , updated_nodes {0}
+        , changed_ranges {0}
+        , changed_matrices {0}
+        , update_time {0.0}
+    {}
+
+    TransformNode TransformHierarchy::create(const render::Transform& transform, std::optional<TransformNode> parent)
+    {
+        if (parent.has_value())
+        {
+            this->assertAlive(*parent);
+        }
+
+        std::uint32_t node = NoNode;
+
+        if (!this->free_nodes.empty())
+        {
+            node = this->free_nodes.back();
+            this->free_nodes.pop_back();
+        }
+        else
+        {
+            seb::assertFatal(this->parents.size() < NoNode, "Too many transform nodes");
+
+            node = static_cast<std::uint32_t>(this->parents.size());
+
+            // written below
+            for (std::vector<float>& component : this->translations)
+            {
+                component.push_back(0.0f);
+            }
+
+            for (std::vector<float>& component : this->rotations)
+            {
+                component.push_back(0.0f);
+            }
+
+            for (std::vector<float>& component : this->scales)
+            {
+                component.push_back(0.0f);
+            }
+
+            this->parents.push_back(NoNode);
+            this->first_children.push_back(NoNode);
+            this->next_siblings.push_back(NoNode);
+            this->previous_siblings.push_back(NoNode);
+            this->depths.push_back(0);
+            this->is_alive.push_back(0);
+            this->is_queued.push_back(0);
+            this->world_matrices.emplace_back(1.0f);
+            this->normal_matrices.emplace_back(1.0f);
+        }
+
+        this->writeTransform(node, transform);
+        this->first_children[node]    = NoNode;
+        this->previous_siblings[node] = NoNode;
+        this->next_siblings[node]     = NoNode;
+        this->is_alive[node]          = 1;
+
+        if (parent.has_value())
+        {
+            const std::uint32_t p = parent->index;
+
+            // pushed to the front of the parent's children
+            if (this->first_children[p] != NoNode)
+            {
+                this->previous_siblings[this->first_children[p]] = node;
+            }
+
+            this->parents[node]       = p;
+            this->next_siblings[node] = this->first_children[p];
+            this->depths[node]        = this->depths[p] + 1;
+            this->first_children[p]   = node;
+        }
+        else
+        {
+            this->parents[node] = NoNode;
+            this->depths[node]  = 0;
+        }
+
+        if (this->queued_nodes.size() <= this->depths[node])
+        {
+            this->queued_nodes.resize(this->depths[node] + 1);
+        }
+
+        ++this->node_count;
+        this->enqueue(node);
+
+        return TransformNode {node};
+    }
+
+    void TransformHierarchy::destroy(TransformNode node)
+    {
+        this->assertAlive(node);
+
+        const std::uint32_t n = node.index;
+
+        seb::assertFatal(this->first_children[n] == NoNode, "Destroyed transform node {} has children left", n);
+
+        const std::uint32_t previous = this->previous_siblings[n];
+        const std::uint32_t next     = this->next_siblings[n];
+
+        if (previous != NoNode)
+        {
+            this->next_siblings[previous] = next;
+        }
+        else if (this->parents[n] != NoNode)
+        {
+            this->first_children[this->parents[n]] = next;
+        }
+
+        if (next != NoNode)
+        {
+            this->previous_siblings[next] = previous;
+        }
+
+        this->is_alive[n] = 0;
+        --this->node_count;
+        this->destroyed_nodes.push_back(n);
+    }
+
+    void TransformHierarchy::setTransform(TransformNode node, const render::Transform& transform)
+    {
+        this->assertAlive(node);
+
+        this->writeTransform(node.index, transform);
+        this->enqueue(node.index);
+    }
+
+    render::Transform TransformHierarchy::getTransform(TransformNode node) const
+    {
+        this->assertAlive(node);
+
+        const std::uint32_t n = node.index;
+
+        render::Transform transform {};
+        transform.translation = {this->translations[0][n], this->translations[1][n], this->translations[2][n]};
+        transform.rotation.x  = this->rotations[0][n];
+        transform.rotation.y  = this->rotations[1][n];
+        transform.rotation.z  = this->rotations[2][n];
+        transform.rotation.w  = this->rotations[3][n];
+        transform.scale       = {this->scales[0][n], this->scales[1][n], this->scales[2][n]};
+
+        return transform;
+    }
+
+    std::optional<TransformNode> TransformHierarchy::getParent(TransformNode node) const
+    {
+        this->assertAlive(node);
+
+        if (this->parents[node.index] == NoNode)
+        {
+            return std::nullopt;
+        }
+
+        return TransformNode {this->parents[node.index]};
+    }
+
+    const glm::mat4& TransformHierarchy::getWorldMatrix(TransformNode node) const
+    {
+        this->assertAlive(node);
+
+        return this->world_matrices[node.index];
+    }
+
+    std::span<const glm::mat4> TransformHierarchy::getWorldMatrices() const
+    {
+        return this->world_matrices;
+    }
+
+    std::span<const render::NormalMatrix> TransformHierarchy::getNormalMatrices() const
+    {
+        return this->normal_matrices;
+    }
+
+    std::vector<TransformHierarchy::Range> TransformHierarchy::update()
+    {
+        PROFILE_SCOPE("TransformHierarchy::update");
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::uint32_t> updated {};
+
+        // a node's children are queued while it's updated, one depth down
+        for (std::size_t depth = 0; depth < this->queued_nodes.size(); ++depth)
+        {
+            std::vector<std::uint32_t>& nodes = this->queued_nodes[depth];
+
+            if (nodes.empty())
+            {
+                continue;
+            }
+
+            const std::size_t batchCount = (nodes.size() + BatchNodes - 1) / BatchNodes;
+
+            if (this->batches.size() < batchCount)
+            {
+                this->batches.resize(batchCount);
+            }
+
+            for (std::size_t i = 0; i < batchCount; ++i)
+            {
+                this->batches[i].begin = i * BatchNodes;
+                this->batches[i].end   = std::min((i + 1) * BatchNodes, nodes.size());
+                this->batches[i].children.clear();
+            }
+
+            this->runDepth(nodes, std::span {this->batches}.first(batchCount));
+
+            for (std::size_t i = 0; i < batchCount; ++i)
+            {
+                const std::vector<std::uint32_t>& children = this->batches[i].children;
+
+                if (!children.empty())
+                {
+                    this->queued_nodes[depth + 1].insert(
+                        this->queued_nodes[depth + 1].end(), children.cbegin(), children.cend());
+                }
+            }
+
+            updated.insert(updated.end(), nodes.cbegin(), nodes.cend());
+            nodes.clear();
+        }
+
+        // nothing queues them anymore
+        this->free_nodes.insert(this->free_nodes.end(), this->destroyed_nodes.cbegin(), this->destroyed_nodes.cend());
+        this->destroyed_nodes.clear();
+
+        // past a few percent of the nodes, marking them and walking every
+        // index is cheaper than sorting them
+        if (updated.size() * DenseUpdateRatio >= this->parents.size())
+        {
+            this->is_updated.assign(this->parents.size(), 0);
+
+            for (std::uint32_t node : updated)
+            {
+                this->is_updated[node] = 1;
+            }
+
+            updated.clear();
+
+            for (std::size_t node = 0; node < this->is_updated.size(); ++node)
+            {
+                if (this->is_updated[node] != 0)
+                {
+                    updated.push_back(static_cast<std::uint32_t>(node));
+                }
+            }
+        }
+        else
+        {
+            std::sort(updated.begin(), updated.end());
+        }
+
+        std::vector<Range> ranges {};
+        this->updated_nodes    = 0;
+        this->changed_matrices = 0;
+
+        for (std::uint32_t node : updated)
+        {
+            if (this->is_alive[node] == 0)
+            {
+                continue;
+            }
+
+            ++this->updated_nodes;
+
+            if (!ranges.empty() && node <= ranges.back().first + ranges.back().count + MaxRangeGap)
+            {
+                ranges.back().count = node - ranges.back().first + 1;
+            }
+            else
+            {
+                ranges.push_back(Range {.first {node}, .count {1}});
+            }
+        }
+
+        for (const Range& range : ranges)
+        {
+            this->changed_matrices += range.count;
+        }
+
+        this->changed_ranges = ranges.size();
+        this->update_time    = std::chrono::steady_clock::now() - start;
+
+        return ranges;
+    }
+
+    TransformHierarchy::Statistics TransformHierarchy::getStatistics() const
+    {
+        return Statistics {
+            .workers          {this->pool.getWorkerCount()},
+            .nodes            {this->node_count},
+            .depth            {this->queued_nodes.size()},
+            .updated_nodes    {this->updated_nodes},
+            .changed_ranges   {this->changed_ranges},
+            .changed_matrices {this->changed_matrices},
+            .update_time      {this->update_time},
+        };
+    }
+
+    void TransformHierarchy::assertAlive(TransformNode node) const
+    {
+        seb::assertFatal(
+            node.index < this->is_alive.size() && this->is_alive[node.index] != 0,
+            "Transform node {} was destroyed",
+            node.index);
+    }
+
+    void TransformHierarchy::enqueue(std::uint32_t node)
+    {
+        if (this->is_queued[node] == 0)
+        {
+            this->is_queued[node] = 1;
+            this->queued_nodes[this->depths[node]].push_back(node);
+        }
+    }
+
+    void TransformHierarchy::updateNodes(std::span<const std::uint32_t> nodes, Batch& batch)
+    {
+        batch.models.resize(nodes.size());
+        batch.normals.resize(nodes.size());
+
+        // destroyed nodes' fields are still there, composing them is harmless
+        composeMatrices(this->getFields(), nodes, batch.models, batch.normals);
+
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            const std::uint32_t node = nodes[i];
+
+            this->is_queued[node] = 0;
+
+            if (this->is_alive[node] == 0)
+            {
+                continue;
+            }
+
+            const std::uint32_t parent = this->parents[node];
+
+            // the parent is a depth up, done before this one started. Normal
+            // matrices compose like the matrices they're of
+            if (parent == NoNode)
+            {
+                this->world_matrices[node]  = batch.models[i];
+                this->normal_matrices[node] = batch.normals[i];
+            }
+            else
+            {
+                this->world_matrices[node]  = this->world_matrices[parent] * batch.models[i];
+                this->normal_matrices[node] = multiplyNormals(this->normal_matrices[parent], batch.normals[i]);
+            }
+
+            // only this node queues its children, so no other thread touches
+            // their flags meanwhile
+            for (std::uint32_t child = this->first_children[node]; child != NoNode; child = this->next_siblings[child])
+            {
+                if (this->is_queued[child] == 0)
+                {
+                    this->is_queued[child] = 1;
+                    batch.children.push_back(child);
+                }
+            }
+        }
+    }
+
+    void TransformHierarchy::runDepth(std::span<const std::uint32_t> nodes, std::span<Batch> depthBatches)
+    {
+        PROFILE_SCOPE("TransformHierarchy::runDepth");
+
+        this->pool.run(depthBatches.size(), [&](std::size_t i)
+        {
+            Batch& batch = depthBatches[i];
+            this->updateNodes(nodes.subspan(batch.begin, batch.end - batch.begin), batch);
+        });
+    }
+
+    void TransformHierarchy::writeTransform(std::uint32_t node, const render::Transform& transform)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            this->translations[i][node] = transform.translation[static_cast<glm::length_t>(i)];
+            this->scales[i][node]       = transform.scale[static_cast<glm::length_t>(i)];
+        }
+
+        this->rotations[0][node] = transform.rotation.x;
+        this->rotations[1][node] = transform.rotation.y;
+        this->rotations[2][node] = transform.rotation.z;
+        this->rotations[3][node] = transform.rotation.w;
+    }
+
+    TransformFields TransformHierarchy::getFields() const
+    {
+        return TransformFields {
+            .translation {this->translations[0], this->translations[1], this->translations[2]},
+            .rotation    {this->rotations[0], this->rotations[1], this->rotations[2], this->rotations[3]},
+            .scale       {this->scales[0], this->scales[1], this->scales[2]},
+        };
+    }
+} // namespace world
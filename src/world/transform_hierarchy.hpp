@@ -0,0 +1,171 @@
+#ifndef SRC_WORLD_TRANSFORM__HIERARCHY_HPP
+#define SRC_WORLD_TRANSFORM__HIERARCHY_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <render/render_structs.hpp>
+#include <util/worker_pool.hpp>
+
+#include "transform_kernels.hpp"
+
+namespace world
+{
+    /// @brief A node of a TransformHierarchy, its index is also that of its
+    /// world matrix
+    struct TransformNode
+    {
+        std::uint32_t index;
+
+        [[nodiscard]] bool operator==(const TransformNode&) const = default;
+    };
+
+    /// @brief Transforms relative to a parent, and the world and normal
+    /// matrices they add up to, cached.
+    ///
+    /// Translations, rotations and scales are stored one float array per
+    /// component, as composeMatrices() loads them. World and normal matrices
+    /// are kept in contiguous arrays laid out like the renderer's.
+    ///
+    /// Setting a node's transform only queues it, update() recomputes the
+    /// queued nodes and everything below them depth by depth, so every
+    /// parent is done before its children, with each depth spread over a
+    /// util::WorkerPool. Nodes nothing changed under cost nothing per update.
+    class TransformHierarchy
+    {
+    public:
+        // nodes of one depth per task of the pool
+        constexpr static std::size_t BatchNodes  = 1024;
+        // changed matrices this close together are one range, a few clean
+        // matrices cost less to write than another range
+        constexpr static std::size_t MaxRangeGap = 4;
+
+        /// @brief Indices of consecutive world matrices
+        struct Range
+        {
+            std::size_t first;
+            std::size_t count;
+        };
+
+        struct Statistics
+        {
+            std::size_t workers;
+            std::size_t nodes;
+            // of the deepest node so far, roots are depth 1
+            std::size_t depth;
+
+            // of the last update()
+            std::size_t updated_nodes;
+            std::size_t changed_ranges;
+            // in every range, clean ones between changed ones included
+            std::size_t changed_matrices;
+            std::chrono::duration<double> update_time;
+        };
+
+        /// @param pool runs every depth's batches, and must outlive the
+        /// hierarchy
+        explicit TransformHierarchy(util::WorkerPool& pool);
+        ~TransformHierarchy() = default;
+
+        TransformHierarchy(const TransformHierarchy&)            = delete;
+        TransformHierarchy(TransformHierarchy&&)                 = delete;
+        TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+        TransformHierarchy& operator=(TransformHierarchy&&)      = delete;
+
+        /// @brief At @param transform relative to @param parent, or to the
+        /// world for roots. Its world matrix is valid after the next update()
+        [[nodiscard]] TransformNode create(
+            const render::Transform& transform,
+            std::optional<TransformNode> parent = std::nullopt);
+        /// @brief @param node must not have children left. Its index is
+        /// reused after the next update()
+        void destroy(TransformNode node);
+
+        void setTransform(TransformNode, const render::Transform&);
+        [[nodiscard]] render::Transform getTransform(TransformNode) const;
+        [[nodiscard]] std::optional<TransformNode> getParent(TransformNode) const;
+
+        /// @brief As of the last update()
+        [[nodiscard]] const glm::mat4& getWorldMatrix(TransformNode) const;
+        /// @brief By index, those of destroyed nodes are left as they were
+        [[nodiscard]] std::span<const glm::mat4> getWorldMatrices() const;
+        /// @brief Parallel to getWorldMatrices()
+        [[nodiscard]] std::span<const render::NormalMatrix> getNormalMatrices() const;
+
+        /// @brief Recomputes the world matrix of every node created or set
+        /// since the last update and of everything below them. Returns the
+        /// ranges that changed, in order and never overlapping
+        [[nodiscard]] std::vector<Range> update();
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        constexpr static std::uint32_t NoNode = std::numeric_limits<std::uint32_t>::max();
+        // updates touching more than 1 / this of the nodes find their ranges
+        // without sorting
+        constexpr static std::size_t   DenseUpdateRatio = 32;
+
+        struct Batch
+        {
+            std::size_t begin;
+            std::size_t end;
+            // queued by the batch's nodes, for the next depth
+            std::vector<std::uint32_t> children;
+            // the local matrices of the batch's nodes, by position
+            std::vector<glm::mat4>            models;
+            std::vector<render::NormalMatrix> normals;
+        };
+
+        void assertAlive(TransformNode) const;
+        /// @brief Queues @param node for the next update() unless it already is
+        void enqueue(std::uint32_t node);
+
+        /// @brief Recomputes @param nodes, the batch's of one depth, queueing
+        /// their children into its children
+        void updateNodes(std::span<const std::uint32_t> nodes, Batch&);
+        /// @brief Every batch once, on the pool
+        void runDepth(std::span<const std::uint32_t> nodes, std::span<Batch> batches);
+
+        void writeTransform(std::uint32_t node, const render::Transform&);
+        [[nodiscard]] TransformFields getFields() const;
+
+        util::WorkerPool& pool;
+
+        // by node, the rotations' x, y, z and w
+        std::array<std::vector<float>, 3> translations;
+        std::array<std::vector<float>, 4> rotations;
+        std::array<std::vector<float>, 3> scales;
+        std::vector<std::uint32_t> parents;
+        std::vector<std::uint32_t> first_children;
+        std::vector<std::uint32_t> next_siblings;
+        std::vector<std::uint32_t> previous_siblings;
+        std::vector<std::uint32_t> depths;
+        std::vector<std::uint8_t>  is_alive;
+        std::vector<std::uint8_t>  is_queued;
+        // scratch of dense updates
+        std::vector<std::uint8_t>  is_updated;
+        std::vector<glm::mat4>     world_matrices;
+        std::vector<render::NormalMatrix> normal_matrices;
+
+        std::vector<std::uint32_t> free_nodes;
+        // freed by the next update(), they may still be queued
+        std::vector<std::uint32_t> destroyed_nodes;
+        // by depth, what the next update() recomputes
+        std::vector<std::vector<std::uint32_t>> queued_nodes;
+        // kept between updates for their vectors' capacity
+        std::vector<Batch>         batches;
+        std::size_t                node_count;
+
+        std::size_t updated_nodes;
+        std::size_t changed_ranges;
+        std::size_t changed_matrices;
+        std::chrono::duration<double> update_time;
+    }; // class TransformHierarchy
+} // namespace world
+
+#endif // SRC_WORLD_TRANSFORM__HIERARCHY_HPP
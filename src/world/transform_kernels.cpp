@@ -0,0 +1,236 @@
+#include <array>
+#include <cstddef>
+#include <limits>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif // __AVX2__
+
+#include <sebib/seblog.hpp>
+
+#include "transform_kernels.hpp"
+
+namespace
+{
+    static_assert(sizeof(glm::mat4) == 16 * sizeof(float));
+    static_assert(sizeof(render::NormalMatrix) == 12 * sizeof(float));
+
+    /// @brief glm::mat4_cast()'s rotation, a column per array
+    struct Rotation
+    {
+        std::array<float, 3> x;
+        std::array<float, 3> y;
+        std::array<float, 3> z;
+    };
+
+    Rotation getRotation(glm::quat q)
+    {
+        // doubling is exact, so x * (x + x) rounds the same as glm's 2 * (x * x)
+        const float x2 = q.x + q.x;
+        const float y2 = q.y + q.y;
+        const float z2 = q.z + q.z;
+
+        const float xx = q.x * x2;
+        const float yy = q.y * y2;
+        const float zz = q.z * z2;
+        const float xy = q.x * y2;
+        const float xz = q.x * z2;
+        const float yz = q.y * z2;
+        const float wx = q.w * x2;
+        const float wy = q.w * y2;
+        const float wz = q.w * z2;
+
+        return Rotation {
+            .x {1.0f - (yy + zz), xy + wz, xz - wy},
+            .y {xy - wz, 1.0f - (xx + zz), yz + wx},
+            .z {xz + wy, yz - wx, 1.0f - (xx + yy)},
+        };
+    }
+
+    glm::vec3 loadVector(const std::array<std::span<const float>, 3>& components, std::uint32_t index)
+    {
+        return {components[0][index], components[1][index], components[2][index]};
+    }
+
+    glm::quat loadRotation(const world::TransformFields& fields, std::uint32_t index)
+    {
+        // by name, glm's constructor order follows GLM_FORCE_QUAT_DATA_WXYZ
+        glm::quat rotation {};
+        rotation.x = fields.rotation[0][index];
+        rotation.y = fields.rotation[1][index];
+        rotation.z = fields.rotation[2][index];
+        rotation.w = fields.rotation[3][index];
+
+        return rotation;
+    }
+
+#if defined(__AVX2__)
+    constexpr std::size_t Lanes = 8;
+
+    /// @brief Lane i of @param a, @param b, @param c and @param d as the
+    /// four floats at @param first + i * @param stride
+    void storeColumns(float* first, std::size_t stride, __m256 a, __m256 b, __m256 c, __m256 d)
+    {
+        const __m256 abLow  = _mm256_unpacklo_ps(a, b);
+        const __m256 abHigh = _mm256_unpackhi_ps(a, b);
+        const __m256 cdLow  = _mm256_unpacklo_ps(c, d);
+        const __m256 cdHigh = _mm256_unpackhi_ps(c, d);
+
+        // a 4x4 transpose in each 128 bit half, column i holds lanes i and i + 4
+        const __m256 column0 = _mm256_shuffle_ps(abLow, cdLow, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 column1 = _mm256_shuffle_ps(abLow, cdLow, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 column2 = _mm256_shuffle_ps(abHigh, cdHigh, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 column3 = _mm256_shuffle_ps(abHigh, cdHigh, _MM_SHUFFLE(3, 2, 3, 2));
+
+        _mm_storeu_ps(first, _mm256_castps256_ps128(column0));
+        _mm_storeu_ps(first + stride, _mm256_castps256_ps128(column1));
+        _mm_storeu_ps(first + 2 * stride, _mm256_castps256_ps128(column2));
+        _mm_storeu_ps(first + 3 * stride, _mm256_castps256_ps128(column3));
+        _mm_storeu_ps(first + 4 * stride, _mm256_extractf128_ps(column0, 1));
+        _mm_storeu_ps(first + 5 * stride, _mm256_extractf128_ps(column1, 1));
+        _mm_storeu_ps(first + 6 * stride, _mm256_extractf128_ps(column2, 1));
+        _mm_storeu_ps(first + 7 * stride, _mm256_extractf128_ps(column3, 1));
+    }
+
+    /// @brief composeModelMatrix() and composeNormalMatrix() of the eight
+    /// transforms at @param indices, a lane each
+    void composeLanes(
+        const world::TransformFields& fields,
+        const std::uint32_t*          indices,
+        glm::mat4*                    models,
+        render::NormalMatrix*         normals)
+    {
+        const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices));
+        const __m256i run   = _mm256_add_epi32(
+            _mm256_set1_epi32(static_cast<int>(indices[0])), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+        // nodes queued in order and dense updates mostly are
+        const bool isConsecutive = _mm256_movemask_epi8(_mm256_cmpeq_epi32(index, run)) == -1;
+
+        const auto load = [&](std::span<const float> component)
+        {
+            return isConsecutive ? _mm256_loadu_ps(component.data() + indices[0])
+                                 : _mm256_i32gather_ps(component.data(), index, 4);
+        };
+
+        const __m256 tx = load(fields.translation[0]);
+        const __m256 ty = load(fields.translation[1]);
+        const __m256 tz = load(fields.translation[2]);
+        const __m256 sx = load(fields.scale[0]);
+        const __m256 sy = load(fields.scale[1]);
+        const __m256 sz = load(fields.scale[2]);
+        const __m256 qx = load(fields.rotation[0]);
+        const __m256 qy = load(fields.rotation[1]);
+        const __m256 qz = load(fields.rotation[2]);
+        const __m256 qw = load(fields.rotation[3]);
+
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one  = _mm256_set1_ps(1.0f);
+
+        // as getRotation(), lane by lane
+        const __m256 x2 = _mm256_add_ps(qx, qx);
+        const __m256 y2 = _mm256_add_ps(qy, qy);
+        const __m256 z2 = _mm256_add_ps(qz, qz);
+
+        const __m256 xx = _mm256_mul_ps(qx, x2);
+        const __m256 yy = _mm256_mul_ps(qy, y2);
+        const __m256 zz = _mm256_mul_ps(qz, z2);
+        const __m256 xy = _mm256_mul_ps(qx, y2);
+        const __m256 xz = _mm256_mul_ps(qx, z2);
+        const __m256 yz = _mm256_mul_ps(qy, z2);
+        const __m256 wx = _mm256_mul_ps(qw, x2);
+        const __m256 wy = _mm256_mul_ps(qw, y2);
+        const __m256 wz = _mm256_mul_ps(qw, z2);
+
+        const __m256 r00 = _mm256_sub_ps(one, _mm256_add_ps(yy, zz));
+        const __m256 r01 = _mm256_add_ps(xy, wz);
+        const __m256 r02 = _mm256_sub_ps(xz, wy);
+        const __m256 r10 = _mm256_sub_ps(xy, wz);
+        const __m256 r11 = _mm256_sub_ps(one, _mm256_add_ps(xx, zz));
+        const __m256 r12 = _mm256_add_ps(yz, wx);
+        const __m256 r20 = _mm256_add_ps(xz, wy);
+        const __m256 r21 = _mm256_sub_ps(yz, wx);
+        const __m256 r22 = _mm256_sub_ps(one, _mm256_add_ps(xx, yy));
+
+        auto* model = reinterpret_cast<float*>(models);
+
+        storeColumns(model, 16, _mm256_mul_ps(r00, sx), _mm256_mul_ps(r01, sx), _mm256_mul_ps(r02, sx), zero);
+        storeColumns(model + 4, 16, _mm256_mul_ps(r10, sy), _mm256_mul_ps(r11, sy), _mm256_mul_ps(r12, sy), zero);
+        storeColumns(model + 8, 16, _mm256_mul_ps(r20, sz), _mm256_mul_ps(r21, sz), _mm256_mul_ps(r22, sz), zero);
+        storeColumns(model + 12, 16, tx, ty, tz, one);
+
+        auto* normal = reinterpret_cast<float*>(normals);
+
+        storeColumns(normal, 12, _mm256_div_ps(r00, sx), _mm256_div_ps(r01, sx), _mm256_div_ps(r02, sx), zero);
+        storeColumns(normal + 4, 12, _mm256_div_ps(r10, sy), _mm256_div_ps(r11, sy), _mm256_div_ps(r12, sy), zero);
+        storeColumns(normal + 8, 12, _mm256_div_ps(r20, sz), _mm256_div_ps(r21, sz), _mm256_div_ps(r22, sz), zero);
+    }
+#endif // __AVX2__
+} // namespace
+
+namespace world
+{
+    glm::mat4 composeModelMatrix(glm::vec3 translation, glm::quat rotation, glm::vec3 scale)
+    {
+        const Rotation r = getRotation(rotation);
+
+        glm::mat4 matrix {1.0f};
+        matrix[0] = glm::vec4 {r.x[0] * scale.x, r.x[1] * scale.x, r.x[2] * scale.x, 0.0f};
+        matrix[1] = glm::vec4 {r.y[0] * scale.y, r.y[1] * scale.y, r.y[2] * scale.y, 0.0f};
+        matrix[2] = glm::vec4 {r.z[0] * scale.z, r.z[1] * scale.z, r.z[2] * scale.z, 0.0f};
+        matrix[3] = glm::vec4 {translation.x, translation.y, translation.z, 1.0f};
+
+        return matrix;
+    }
+
+    render::NormalMatrix composeNormalMatrix(glm::quat rotation, glm::vec3 scale)
+    {
+        const Rotation r = getRotation(rotation);
+
+        // (R * S)^-T = R^-T * S^-T = R * S^-1
+        render::NormalMatrix matrix {1.0f};
+        matrix[0] = glm::vec4 {r.x[0] / scale.x, r.x[1] / scale.x, r.x[2] / scale.x, 0.0f};
+        matrix[1] = glm::vec4 {r.y[0] / scale.y, r.y[1] / scale.y, r.y[2] / scale.y, 0.0f};
+        matrix[2] = glm::vec4 {r.z[0] / scale.z, r.z[1] / scale.z, r.z[2] / scale.z, 0.0f};
+
+        return matrix;
+    }
+
+    void composeMatrices(
+        const TransformFields&          fields,
+        std::span<const std::uint32_t>  indices,
+        std::span<glm::mat4>            models,
+        std::span<render::NormalMatrix> normals)
+    {
+        seb::assertFatal(
+            models.size() == indices.size() && normals.size() == indices.size(),
+            "{} transforms into {} model and {} normal matrices",
+            indices.size(),
+            models.size(),
+            normals.size());
+        // the gathers' offsets are 32 bit
+        seb::assertFatal(
+            fields.rotation[0].size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()),
+            "{} transforms are too many to gather",
+            fields.rotation[0].size());
+
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        for (; i + Lanes <= indices.size(); i += Lanes)
+        {
+            composeLanes(fields, indices.data() + i, models.data() + i, normals.data() + i);
+        }
+#endif // __AVX2__
+
+        for (; i < indices.size(); ++i)
+        {
+            const std::uint32_t index    = indices[i];
+            const glm::quat     rotation = loadRotation(fields, index);
+            const glm::vec3     scale    = loadVector(fields.scale, index);
+
+            models[i]  = composeModelMatrix(loadVector(fields.translation, index), rotation, scale);
+            normals[i] = composeNormalMatrix(rotation, scale);
+        }
+    }
+} // namespace world
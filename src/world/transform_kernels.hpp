@@ -0,0 +1,41 @@
+#ifndef SRC_WORLD_TRANSFORM__KERNELS_HPP
+#define SRC_WORLD_TRANSFORM__KERNELS_HPP
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include <render/render_structs.hpp>
+
+namespace world
+{
+    /// @brief Transforms by component, a float array each indexed the same,
+    /// so a component of consecutive transforms is one load
+    struct TransformFields
+    {
+        std::array<std::span<const float>, 3> translation;
+        // x, y, z and w
+        std::array<std::span<const float>, 4> rotation;
+        std::array<std::span<const float>, 3> scale;
+    };
+
+    /// @brief render::Transform::asModelMatrix() in closed form, the columns
+    /// of glm::mat4_cast() scaled by their axis' scale
+    [[nodiscard]] glm::mat4 composeModelMatrix(glm::vec3 translation, glm::quat rotation, glm::vec3 scale);
+    /// @brief inverse(transpose(mat3())) of the same model matrix, which for
+    /// a rotation and a scale is the rotation divided by the scale
+    [[nodiscard]] render::NormalMatrix composeNormalMatrix(glm::quat rotation, glm::vec3 scale);
+
+    /// @brief The model and normal matrices of the transforms at @param
+    /// indices into @param fields, written to @param models and @param
+    /// normals in the order of the indices. With AVX2 eight transforms at a
+    /// time, a lane each, their components loaded whole where the eight
+    /// indices are consecutive and gathered otherwise, the rest one by one
+    void composeMatrices(
+        const TransformFields&          fields,
+        std::span<const std::uint32_t>  indices,
+        std::span<glm::mat4>            models,
+        std::span<render::NormalMatrix> normals);
+} // namespace world
+
+#endif // SRC_WORLD_TRANSFORM__KERNELS_HPP
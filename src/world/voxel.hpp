@@ -0,0 +1,108 @@
+#ifndef SRC_WORLD_VOXEL_HPP
+#define SRC_WORLD_VOXEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#include <glm/vec3.hpp>
+#pragma GCC diagnostic pop
+#pragma GCC diagnostic pop
+
+namespace world
+{
+    /// @brief Material id, 0 is always air
+    using Voxel = std::uint16_t;
+    constexpr Voxel AirVoxel = 0;
+
+    /// @brief Materials produced by the built in terrain
+    namespace material
+    {
+        constexpr Voxel Stone     = 1;
+        constexpr Voxel Dirt      = 2;
+        constexpr Voxel Grass     = 3;
+        constexpr Voxel FirstOre  = 4;
+        constexpr Voxel OreCount  = 8;
+        /// @brief Never generated, only placed, gives off block light
+        constexpr Voxel Lamp      = FirstOre + OreCount;
+    } // namespace material
+
+    constexpr std::int32_t ChunkExtentLog2 = 5;
+    constexpr std::int32_t ChunkExtent     = 1 << ChunkExtentLog2;
+    constexpr std::size_t  ChunkVolume     = ChunkExtent * ChunkExtent * ChunkExtent;
+
+    /// Three coordinate spaces are in use:
+    /// - WorldPosition: a voxel anywhere in the world
+    /// - ChunkCoordinate: a chunk, the world position of its minimum corner
+    ///   divided by ChunkExtent
+    /// - LocalPosition: a voxel inside of a chunk, each axis in [0, ChunkExtent)
+    using WorldPosition   = glm::i32vec3;
+    using ChunkCoordinate = glm::i32vec3;
+    using LocalPosition   = glm::i32vec3;
+
+    [[nodiscard]] constexpr ChunkCoordinate toChunkCoordinate(WorldPosition position)
+    {
+        // arithmetic shifts round towards negative infinity
+        return {
+            position.x >> ChunkExtentLog2,
+            position.y >> ChunkExtentLog2,
+            position.z >> ChunkExtentLog2,
+        };
+    }
+
+    [[nodiscard]] constexpr LocalPosition toLocalPosition(WorldPosition position)
+    {
+        return {
+            position.x & (ChunkExtent - 1),
+            position.y & (ChunkExtent - 1),
+            position.z & (ChunkExtent - 1),
+        };
+    }
+
+    [[nodiscard]] constexpr WorldPosition toWorldPosition(ChunkCoordinate chunk, LocalPosition local)
+    {
+        return {
+            chunk.x * ChunkExtent + local.x,
+            chunk.y * ChunkExtent + local.y,
+            chunk.z * ChunkExtent + local.z,
+        };
+    }
+
+    /// @brief x is the fastest moving axis, then z, then y so that horizontal
+    /// slices of a chunk are contiguous
+    [[nodiscard]] constexpr std::size_t toLinearIndex(LocalPosition local)
+    {
+        return static_cast<std::size_t>(
+            (local.y << (2 * ChunkExtentLog2)) | (local.z << ChunkExtentLog2) | local.x
+        );
+    }
+
+    struct ChunkCoordinateHash
+    {
+        [[nodiscard]] std::size_t operator()(ChunkCoordinate coordinate) const
+        {
+            // pack 21 bits per axis then finalize with murmur3's mixer so
+            // neighbouring chunks land far apart even with power of two tables
+            constexpr std::uint64_t AxisMask = (std::uint64_t {1} << 21) - 1;
+
+            std::uint64_t key =
+                (static_cast<std::uint64_t>(static_cast<std::uint32_t>(coordinate.x)) & AxisMask)
+                | ((static_cast<std::uint64_t>(static_cast<std::uint32_t>(coordinate.y)) & AxisMask) << 21)
+                | ((static_cast<std::uint64_t>(static_cast<std::uint32_t>(coordinate.z)) & AxisMask) << 42);
+
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDULL;
+            key ^= key >> 33;
+            key *= 0xC4CEB9FE1A85EC53ULL;
+            key ^= key >> 33;
+
+            return key;
+        }
+    };
+} // namespace world
+
+#endif // SRC_WORLD_VOXEL_HPP
@@ -0,0 +1,197 @@
+#include <limits>
+
+#include "voxel_storage.hpp"
+
+namespace
+{
+    // chunk coordinates are world positions >> 5, x can never reach this
+    constexpr world::ChunkCoordinate EmptySlot {
+        std::numeric_limits<std::int32_t>::min(), 0, 0
+    };
+
+    constexpr std::size_t InitialCapacity = 64;
+} // namespace
+
+namespace world
+{
+    VoxelStorage::VoxelStorage()
+        : slot_coordinates (InitialCapacity, EmptySlot)
+        , slot_chunks      (InitialCapacity)
+        , number_of_chunks {0}
+    {}
+
+    Voxel VoxelStorage::getVoxel(WorldPosition position) const
+    {
+        if (const Chunk* chunk = this->getChunk(toChunkCoordinate(position)); chunk != nullptr)
+        {
+            return chunk->get(toLocalPosition(position));
+        }
+
+        return AirVoxel;
+    }
+
+    void VoxelStorage::setVoxel(WorldPosition position, Voxel voxel)
+    {
+        const ChunkCoordinate coordinate = toChunkCoordinate(position);
+
+        if (voxel == AirVoxel)
+        {
+            if (Chunk* chunk = this->getChunk(coordinate); chunk != nullptr)
+            {
+                chunk->set(toLocalPosition(position), voxel);
+            }
+
+            return;
+        }
+
+        this->getOrCreateChunk(coordinate).set(toLocalPosition(position), voxel);
+    }
+
+    const Chunk* VoxelStorage::getChunk(ChunkCoordinate coordinate) const
+    {
+        const std::size_t slot = this->findSlot(coordinate);
+
+        return this->slot_coordinates[slot] == coordinate ? this->slot_chunks[slot].get() : nullptr;
+    }
+
+    Chunk* VoxelStorage::getChunk(ChunkCoordinate coordinate)
+    {
+        const std::size_t slot = this->findSlot(coordinate);
+
+        return this->slot_coordinates[slot] == coordinate ? this->slot_chunks[slot].get() : nullptr;
+    }
+
+    Chunk& VoxelStorage::getOrCreateChunk(ChunkCoordinate coordinate)
+    {
+        if (Chunk* chunk = this->getChunk(coordinate); chunk != nullptr)
+        {
+            return *chunk;
+        }
+
+        this->insertChunk(coordinate, Chunk {AirVoxel});
+
+        return *this->getChunk(coordinate);
+    }
+
+    void VoxelStorage::insertChunk(ChunkCoordinate coordinate, Chunk chunk)
+    {
+        // kept at most half full so probe sequences stay short
+        if ((this->number_of_chunks + 1) * 2 > this->slot_coordinates.size())
+        {
+            this->grow();
+        }
+
+        const std::size_t slot = this->findSlot(coordinate);
+
+        if (this->slot_coordinates[slot] == coordinate)
+        {
+            *this->slot_chunks[slot] = std::move(chunk);
+            return;
+        }
+
+        this->slot_coordinates[slot] = coordinate;
+        this->slot_chunks[slot] = std::make_unique<Chunk>(std::move(chunk));
+        ++this->number_of_chunks;
+    }
+
+    std::optional<Chunk> VoxelStorage::removeChunk(ChunkCoordinate coordinate)
+    {
+        const std::size_t mask = this->slot_coordinates.size() - 1;
+        std::size_t slot = this->findSlot(coordinate);
+
+        if (this->slot_coordinates[slot] != coordinate)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<Chunk> removed {std::move(*this->slot_chunks[slot])};
+
+        this->slot_coordinates[slot] = EmptySlot;
+        this->slot_chunks[slot].reset();
+        --this->number_of_chunks;
+
+        // Backward shift deletion, pulls later members of the probe sequence
+        // into the hole so lookups never need tombstones
+        std::size_t hole = slot;
+        for (slot = (slot + 1) & mask; this->slot_coordinates[slot] != EmptySlot; slot = (slot + 1) & mask)
+        {
+            const std::size_t home = ChunkCoordinateHash {}(this->slot_coordinates[slot]) & mask;
+
+            // moves if its home isn't cyclically within (hole, slot]
+            if (((slot - home) & mask) >= ((slot - hole) & mask))
+            {
+                this->slot_coordinates[hole] = this->slot_coordinates[slot];
+                this->slot_chunks[hole] = std::move(this->slot_chunks[slot]);
+                this->slot_coordinates[slot] = EmptySlot;
+                hole = slot;
+            }
+        }
+
+        return removed;
+    }
+
+    void VoxelStorage::forEachChunk(const std::function<void(ChunkCoordinate, const Chunk&)>& function) const
+    {
+        for (std::size_t slot = 0; slot < this->slot_coordinates.size(); ++slot)
+        {
+            if (this->slot_coordinates[slot] != EmptySlot)
+            {
+                function(this->slot_coordinates[slot], *this->slot_chunks[slot]);
+            }
+        }
+    }
+
+    std::size_t VoxelStorage::getChunkCount() const
+    {
+        return this->number_of_chunks;
+    }
+
+    std::size_t VoxelStorage::getMemoryUsage() const
+    {
+        std::size_t bytes = sizeof(VoxelStorage)
+            + this->slot_coordinates.capacity() * sizeof(ChunkCoordinate)
+            + this->slot_chunks.capacity() * sizeof(std::unique_ptr<Chunk>);
+
+        this->forEachChunk([&](ChunkCoordinate, const Chunk& chunk)
+        {
+            bytes += chunk.getMemoryUsage();
+        });
+
+        return bytes;
+    }
+
+    std::size_t VoxelStorage::findSlot(ChunkCoordinate coordinate) const
+    {
+        const std::size_t mask = this->slot_coordinates.size() - 1;
+        std::size_t slot = ChunkCoordinateHash {}(coordinate) & mask;
+
+        // there's always an empty slot so this terminates
+        while (this->slot_coordinates[slot] != coordinate && this->slot_coordinates[slot] != EmptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        return slot;
+    }
+
+    void VoxelStorage::grow()
+    {
+        std::vector<ChunkCoordinate>        oldCoordinates = std::move(this->slot_coordinates);
+        std::vector<std::unique_ptr<Chunk>> oldChunks      = std::move(this->slot_chunks);
+
+        this->slot_coordinates.assign(oldCoordinates.size() * 2, EmptySlot);
+        this->slot_chunks.clear();
+        this->slot_chunks.resize(oldCoordinates.size() * 2);
+
+        for (std::size_t i = 0; i < oldCoordinates.size(); ++i)
+        {
+            if (oldCoordinates[i] != EmptySlot)
+            {
+                const std::size_t slot = this->findSlot(oldCoordinates[i]);
+
+                this->slot_coordinates[slot] = oldCoordinates[i];
+                this->slot_chunks[slot] = std::move(oldChunks[i]);
+            }
+        }
+    }
+} // namespace world
@@ -0,0 +1,61 @@
+#ifndef SRC_WORLD_VOXEL__STORAGE_HPP
+#define SRC_WORLD_VOXEL__STORAGE_HPP
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "chunk.hpp"
+#include "voxel.hpp"
+
+namespace world
+{
+    /// @brief Every loaded chunk, keyed by chunk coordinate. Positions
+    /// without a chunk read as air.
+    ///
+    /// Chunks are found through an open addressed table of coordinates so a
+    /// lookup only probes a dense array instead of chasing hash map nodes.
+    /// Chunks themselves are heap allocated and never move while loaded.
+    class VoxelStorage
+    {
+    public:
+
+        VoxelStorage();
+        ~VoxelStorage() = default;
+
+        VoxelStorage(const VoxelStorage&)            = delete;
+        VoxelStorage(VoxelStorage&&)                 = delete;
+        VoxelStorage& operator=(const VoxelStorage&) = delete;
+        VoxelStorage& operator=(VoxelStorage&&)      = delete;
+
+        [[nodiscard]] Voxel getVoxel(WorldPosition) const;
+        /// @brief Creates the containing chunk if needed, unless @param voxel
+        /// is air
+        void setVoxel(WorldPosition, Voxel voxel);
+
+        [[nodiscard]] const Chunk* getChunk(ChunkCoordinate) const;
+        [[nodiscard]] Chunk* getChunk(ChunkCoordinate);
+        /// @brief Inserts an all air chunk if none exists at @param coordinate
+        Chunk& getOrCreateChunk(ChunkCoordinate coordinate);
+        void insertChunk(ChunkCoordinate, Chunk);
+        /// @brief The removed chunk, nullopt if there was none
+        std::optional<Chunk> removeChunk(ChunkCoordinate);
+
+        void forEachChunk(const std::function<void(ChunkCoordinate, const Chunk&)>&) const;
+        [[nodiscard]] std::size_t getChunkCount() const;
+        /// @brief Bytes used by every chunk plus the table itself
+        [[nodiscard]] std::size_t getMemoryUsage() const;
+
+    private:
+        [[nodiscard]] std::size_t findSlot(ChunkCoordinate) const;
+        void grow();
+
+        // parallel arrays, an empty slot holds EmptySlot as its coordinate
+        std::vector<ChunkCoordinate>        slot_coordinates;
+        std::vector<std::unique_ptr<Chunk>> slot_chunks;
+        std::size_t                         number_of_chunks;
+    }; // class VoxelStorage
+} // namespace world
+
+#endif // SRC_WORLD_VOXEL__STORAGE_HPP
@@ -1,47 +1,1156 @@
+#include <algorithm>
+#include <limits>
+
+#include <sebib/seblog.hpp>
+
+#include <util/executable_path.hpp>
+#include <util/profiler.hpp>
+
+#include "terrain.hpp"
 #include "world.hpp"
 
+namespace
+{
+    /// @brief From @param position to the nearest voxel of the chunk at
+    /// @param coordinate, 0 inside of it
+    float getDistanceToChunk(glm::vec3 position, world::ChunkCoordinate coordinate)
+    {
+        const glm::vec3 min {world::toWorldPosition(coordinate, {0, 0, 0})};
+        const glm::vec3 max = min + static_cast<float>(world::ChunkExtent);
+
+        return glm::length(glm::max(min, glm::min(position, max)) - position);
+    }
+} // namespace
+
 namespace world
 {
-    World::World(const render::Renderer& renderer)
+    World::World(const render::Renderer& renderer, std::string_view scene, std::filesystem::path saveDirectory)
+        // half the cores for work split across the pool, the meshing
+        // workers get the rest
+        : worker_pool {std::max(std::size_t {1}, MeshingPipeline::getDefaultWorkerCount() / 2)}
+        , systems {this->worker_pool}
+        , simulation {SimulationTickRate, this->worker_pool}
+        , transform_hierarchy {this->worker_pool}
+        , uploaded_brickmap_version {0}
+        , queued_brickmap_version {0}
+        , far_field_distance {std::nullopt}
+        , light_engine {this->worker_pool}
+        , meshing_pipeline {
+              std::max(std::size_t {1}, MeshingPipeline::getDefaultWorkerCount() - this->worker_pool.getWorkerCount()),
+              MaxChunksInFlight}
+        , save_directory {std::move(saveDirectory)}
+        , settled_light_changes {0}
+        , edits_total {0}
+        , edited_chunks_total {0}
+        , culling_statistics {}
+    {
+        if (scene == "default")
+        {
+            this->loadDefaultScene(renderer);
+        }
+        else if (scene == "cubes")
+        {
+            this->loadCubesScene(renderer);
+        }
+        else if (scene == "terrain")
+        {
+            this->loadTerrainScene(renderer);
+        }
+        else
+        {
+            seb::panic("Unknown scene {}", scene);
+        }
+    }
+
+    World::~World()
+    {
+        if (this->streamer != nullptr)
+        {
+            this->streamer->saveModified(this->voxels);
+        }
+    }
+
+    std::vector<std::string_view> World::getSceneNames()
+    {
+        return {"default", "cubes", "terrain"};
+    }
+
+    std::filesystem::path World::getDefaultSaveDirectory()
+    {
+        return util::getExecutableDirectory() / "saves";
+    }
+
+    CameraView World::getCameraView(const render::Camera& camera, vk::Extent2D extent)
+    {
+        // same projection as the recorder
+        return CameraView {
+            .position {camera.getPosition()},
+            .view_projection {
+                render::Camera::getPerspectiveMatrix(
+                    glm::radians(70.f),
+                    static_cast<float>(extent.width) / static_cast<float>(extent.height),
+                    0.1f,
+                    200000.0f
+                ) * camera.asViewMatrix()
+            },
+        };
+    }
+
+    const EntityStore& World::getEntities() const
+    {
+        return this->entities;
+    }
+
+    const std::vector<const render::Renderer::PipelinedObject*>& World::getVisibleObjects() const
+    {
+        return this->visible_objects;
+    }
+
+    VoxelStorage& World::getVoxels()
+    {
+        return this->voxels;
+    }
+
+    const VoxelStorage& World::getVoxels() const
+    {
+        return this->voxels;
+    }
+
+    MeshingPipeline::Statistics World::getMeshingStatistics() const
+    {
+        return this->meshing_pipeline.getStatistics();
+    }
+
+    std::optional<ChunkStreamer::Statistics> World::getStreamingStatistics() const
+    {
+        if (this->streamer == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        return this->streamer->getStatistics();
+    }
+
+    World::EditStatistics World::getEditStatistics() const
+    {
+        std::size_t heldMeshes = 0;
+        for (const EditBatch& batch : this->edit_batches)
+        {
+            heldMeshes += batch.meshes.size();
+        }
+
+        std::chrono::duration<double> totalLatency {0.0};
+        for (std::chrono::duration<double> latency : this->edit_latencies)
+        {
+            totalLatency += latency;
+        }
+
+        return EditStatistics {
+            .edits_total         {this->edits_total},
+            .edited_chunks_total {this->edited_chunks_total},
+            .held_meshes         {heldMeshes},
+            .pending_batches     {this->edit_batches.size()},
+            .average_latency     {
+                this->edit_latencies.empty()
+                ? std::chrono::duration<double> {0.0}
+                : totalLatency / static_cast<double>(this->edit_latencies.size())
+            },
+            .worst_latency       {
+                this->edit_latencies.empty()
+                ? std::chrono::duration<double> {0.0}
+                : *std::ranges::max_element(this->edit_latencies)
+            },
+        };
+    }
+
+    std::vector<World::LodRingStatistics> World::getLodStatistics() const
+    {
+        std::vector<LodRingStatistics> rings {};
+
+        rings.push_back(LodRingStatistics {
+            .level       {0},
+            .scale       {1},
+            .resident    {this->voxels.getChunkCount()},
+            .voxel_bytes {this->voxels.getMemoryUsage()},
+            .objects     {0},
+            .triangles   {0},
+            .mesh_bytes  {0},
+        });
+
+        if (this->lod_terrain != nullptr)
+        {
+            const auto levels = this->lod_terrain->getStatistics();
+
+            for (std::size_t i = 0; i < LodLevelCount; ++i)
+            {
+                rings.push_back(LodRingStatistics {
+                    .level       {i + 1},
+                    .scale       {getLodScale(i + 1)},
+                    .resident    {levels[i].resident_nodes},
+                    .voxel_bytes {levels[i].resident_bytes},
+                    .objects     {0},
+                    .triangles   {0},
+                    .mesh_bytes  {0},
+                });
+            }
+        }
+
+        this->entities.forEach<const ChunkObject>([&](const ChunkObject& chunk)
+        {
+            LodRingStatistics& ring = rings.at(chunk.level);
+
+            ++ring.objects;
+            ring.triangles += chunk.triangles;
+            ring.mesh_bytes += chunk.mesh_bytes;
+        });
+
+        return rings;
+    }
+
+    World::CullingStatistics World::getCullingStatistics() const
+    {
+        return this->culling_statistics;
+    }
+
+    LightEngine::Statistics World::getLightingStatistics() const
+    {
+        return this->light_engine.getStatistics();
+    }
+
+    SystemScheduler::Statistics World::getSystemStatistics() const
+    {
+        return this->systems.getStatistics();
+    }
+
+    Simulation::Statistics World::getSimulationStatistics() const
+    {
+        return this->simulation.getStatistics();
+    }
+
+    TransformHierarchy::Statistics World::getTransformStatistics() const
+    {
+        return this->transform_hierarchy.getStatistics();
+    }
+
+    void World::setFarFieldDistance(std::optional<float> distance)
+    {
+        this->far_field_distance = distance;
+        this->simulation.setBrickmapPublished(distance.has_value());
+    }
+
+    std::optional<float> World::getFarFieldDistance() const
+    {
+        return this->far_field_distance;
+    }
+
+    bool World::isFarFieldCurrent() const
+    {
+        return !this->far_field_distance.has_value()
+            || this->uploaded_brickmap_version >= this->queued_brickmap_version;
+    }
+
+    bool World::isStreamingSettled() const
+    {
+        return this->streamer == nullptr || this->streamer->isSettled();
+    }
+
+    void World::tick(render::Renderer& renderer, const render::Camera& camera)
+    {
+        PROFILE_SCOPE("World::tick");
+
+        const CameraView view = getCameraView(camera, renderer.getRenderExtent());
+
+        if (this->streamer != nullptr)
+        {
+            const ChunkStreamer::Changes changes = this->streamer->update(this->voxels, view);
+
+            // neighbours mesh their shared faces against what is resident
+            for (ChunkCoordinate coordinate : changes.loaded)
+            {
+                if (const Chunk* chunk = this->voxels.getChunk(coordinate); chunk != nullptr)
+                {
+                    this->queued_brickmap_version = this->simulation.setChunk(coordinate, *chunk);
+                    this->light_engine.addChunk(coordinate, *chunk);
+                }
+
+                this->markChunkDirty(coordinate);
+                this->markNeighboursDirty(coordinate);
+            }
+
+            for (ChunkCoordinate coordinate : changes.evicted)
+            {
+                if (const auto existing = this->chunk_objects[0].find(coordinate); existing != this->chunk_objects[0].end())
+                {
+                    this->removeObject(renderer, existing->second);
+                }
+
+                this->queued_brickmap_version = this->simulation.removeChunk(coordinate);
+                this->light_engine.removeChunk(coordinate);
+                this->occlusion_culler.eraseConnectivity(coordinate);
+                this->dropFromEditBatches(coordinate);
+                this->markNeighboursDirty(coordinate);
+            }
+
+            if (this->lod_terrain != nullptr)
+            {
+                this->lod_terrain->recordFullResolutionChanges(changes);
+            }
+        }
+
+        if (this->lod_terrain != nullptr)
+        {
+            for (const auto& [level, node] : this->lod_terrain->update(view).evicted)
+            {
+                if (const auto existing = this->chunk_objects[level].find(node); existing != this->chunk_objects[level].end())
+                {
+                    this->removeObject(renderer, existing->second);
+                }
+            }
+        }
+
+        // before dispatching, so every mesh snapshotted from here on has
+        // this tick's edits and whatever light has spread since the last
+        this->formEditBatch();
+        this->collectLight();
+
+        this->meshing_pipeline.dispatch(this->voxels, view, &this->light_engine);
+
+        std::vector<MeshingPipeline::Result> results = this->meshing_pipeline.collect(MaxUploadsPerTick);
+
+        for (MeshingPipeline::Result& result : results)
+        {
+            if (!this->holdForEditBatch(result))
+            {
+                this->uploadChunkMesh(renderer, 0, result.coordinate, std::move(result.mesh));
+            }
+        }
+
+        // coarser levels get whatever the full resolution chunks left over
+        if (this->lod_terrain != nullptr)
+        {
+            for (LodTerrain::Result& result : this->lod_terrain->collect(MaxUploadsPerTick - results.size()))
+            {
+                this->uploadChunkMesh(renderer, result.level, result.node, std::move(result.mesh));
+            }
+        }
+
+        this->uploadCompletedEditBatches(renderer);
+
+        renderer.setFarFieldDistance(this->far_field_distance);
+
+        // a tick behind, so there's always a newer tick to move towards
+        this->simulation.acquireSnapshot();
+
+        const Simulation::Snapshot& snapshot = this->simulation.getSnapshot();
+
+        // the simulation flattened it, this only hands the words over
+        if (this->far_field_distance.has_value() && snapshot.brickmap_version > this->uploaded_brickmap_version)
+        {
+            renderer.setFarFieldBrickmap(snapshot.brickmap_words);
+            this->uploaded_brickmap_version = snapshot.brickmap_version;
+        }
+        const float alpha = this->simulation.getAlpha(snapshot, Simulation::Clock::now());
+
+        this->entities.forEach<const SimulatedBody, render::Transform, const TransformNode>(
+            [&](const SimulatedBody& body, render::Transform& transform, const TransformNode& node)
+            {
+                if (body.index < snapshot.current.size())
+                {
+                    transform = Simulation::interpolate(
+                        snapshot.previous[body.index],
+                        snapshot.current[body.index],
+                        alpha);
+
+                    this->transform_hierarchy.setTransform(node, transform);
+                }
+            });
+
+        this->systems.run(this->entities);
+
+        // objects nothing moved keep their matrices from earlier ticks
+        const std::vector<TransformHierarchy::Range> changed = this->transform_hierarchy.update();
+        const std::span<const glm::mat4>            models  = this->transform_hierarchy.getWorldMatrices();
+        const std::span<const render::NormalMatrix> normals = this->transform_hierarchy.getNormalMatrices();
+
+        for (const TransformHierarchy::Range& range : changed)
+        {
+            renderer.writeModelMatrices(
+                range.first,
+                models.subspan(range.first, range.count),
+                normals.subspan(range.first, range.count));
+        }
+
+        this->cullObjects(view);
+    }
+
+    void World::markChunkDirty(ChunkCoordinate coordinate)
+    {
+        this->meshing_pipeline.markDirty(coordinate);
+    }
+
+    void World::markChunkEdited(ChunkCoordinate coordinate)
+    {
+        this->markChunkDirty(coordinate);
+
+        if (this->streamer != nullptr)
+        {
+            this->streamer->markModified(coordinate);
+        }
+    }
+
+    bool World::isMeshingIdle() const
+    {
+        return this->meshing_pipeline.isIdle() && this->light_engine.isIdle();
+    }
+
+    void World::setVoxel(WorldPosition position, Voxel voxel)
+    {
+        const Clock::time_point start      = Clock::now();
+        const ChunkCoordinate   coordinate = toChunkCoordinate(position);
+        const LocalPosition     local      = toLocalPosition(position);
+
+        Chunk* chunk = this->voxels.getChunk(coordinate);
+
+        if (chunk == nullptr)
+        {
+            if (this->streamer != nullptr || voxel == AirVoxel)
+            {
+                return;
+            }
+
+            chunk = &this->voxels.getOrCreateChunk(coordinate);
+            this->light_engine.addChunk(coordinate, *chunk);
+        }
+
+        const Voxel before = chunk->get(local);
+
+        if (before == voxel)
+        {
+            return;
+        }
+
+        chunk->set(local, voxel);
+        this->light_engine.updateVoxel(position, before, voxel);
+        this->markEdited(coordinate, local, local);
+
+        ++this->edits_total;
+        this->first_edit_this_tick = this->first_edit_this_tick.value_or(start);
+    }
+
+    void World::fillBox(WorldPosition min, WorldPosition max, Voxel voxel)
+    {
+        this->editVoxels(glm::min(min, max), glm::max(min, max), [voxel](WorldPosition)
+        {
+            return std::optional {voxel};
+        });
+    }
+
+    void World::fillSphere(glm::vec3 center, float radius, Voxel voxel)
+    {
+        const float radiusSquared = radius * radius;
+
+        this->editVoxels(
+            WorldPosition {glm::floor(center - radius)},
+            WorldPosition {glm::ceil(center + radius)},
+            [&](WorldPosition position) -> std::optional<Voxel>
+            {
+                const glm::vec3 offset = glm::vec3 {position} + 0.5f - center;
+
+                if (glm::dot(offset, offset) > radiusSquared)
+                {
+                    return std::nullopt;
+                }
+
+                return voxel;
+            });
+    }
+
+    std::optional<RaycastHit> World::raycast(const Ray& ray) const
+    {
+        return world::raycast(this->voxels, ray);
+    }
+
+    void World::raycast(std::span<const Ray> rays, std::span<std::optional<RaycastHit>> hits) const
+    {
+        PROFILE_SCOPE("World::raycast");
+
+        world::raycast(this->voxels, rays, hits);
+    }
+
+    void World::editVoxels(
+        WorldPosition min,
+        WorldPosition max,
+        const std::function<std::optional<Voxel>(WorldPosition)>& getVoxel)
+    {
+        PROFILE_SCOPE("World::editVoxels");
+
+        const Clock::time_point start    = Clock::now();
+        const ChunkCoordinate   minChunk = toChunkCoordinate(min);
+        const ChunkCoordinate   maxChunk = toChunkCoordinate(max);
+
+        // a chunk's worth of set() calls would keep growing and repacking
+        // its palette, editing a plain copy and packing once is cheaper
+        std::vector<Voxel> unpacked (ChunkVolume);
+        const std::span<Voxel, ChunkVolume> unpackedSpan {unpacked.data(), ChunkVolume};
+
+        bool isChanged = false;
+
+        for (std::int32_t cy = minChunk.y; cy <= maxChunk.y; ++cy)
+        {
+            for (std::int32_t cz = minChunk.z; cz <= maxChunk.z; ++cz)
+            {
+                for (std::int32_t cx = minChunk.x; cx <= maxChunk.x; ++cx)
+                {
+                    const ChunkCoordinate coordinate {cx, cy, cz};
+
+                    Chunk* chunk = this->voxels.getChunk(coordinate);
+
+                    // the streamer would replace it when it loads
+                    if (chunk == nullptr && this->streamer != nullptr)
+                    {
+                        continue;
+                    }
+
+                    if (chunk != nullptr)
+                    {
+                        chunk->unpack(unpackedSpan);
+                    }
+                    else
+                    {
+                        std::ranges::fill(unpacked, AirVoxel);
+                    }
+
+                    const WorldPosition origin = toWorldPosition(coordinate, {0, 0, 0});
+                    const LocalPosition first  = glm::max(min - origin, LocalPosition {0});
+                    const LocalPosition last   = glm::min(max - origin, LocalPosition {ChunkExtent - 1});
+
+                    LocalPosition changedMin {ChunkExtent};
+                    LocalPosition changedMax {-1};
+
+                    for (std::int32_t y = first.y; y <= last.y; ++y)
+                    {
+                        for (std::int32_t z = first.z; z <= last.z; ++z)
+                        {
+                            for (std::int32_t x = first.x; x <= last.x; ++x)
+                            {
+                                const LocalPosition        local {x, y, z};
+                                const std::optional<Voxel> voxel = getVoxel(origin + local);
+                                Voxel&                     current = unpacked[toLinearIndex(local)];
+
+                                if (!voxel.has_value() || *voxel == current)
+                                {
+                                    continue;
+                                }
+
+                                this->light_engine.updateVoxel(origin + local, current, *voxel);
+
+                                current    = *voxel;
+                                changedMin = glm::min(changedMin, local);
+                                changedMax = glm::max(changedMax, local);
+                            }
+                        }
+                    }
+
+                    if (changedMax.x < 0)
+                    {
+                        continue;
+                    }
+
+                    // lit from a copy, so only once it holds the edits
+                    const bool isCreated = chunk == nullptr;
+
+                    if (isCreated)
+                    {
+                        chunk = &this->voxels.getOrCreateChunk(coordinate);
+                    }
+
+                    chunk->pack(unpackedSpan);
+
+                    if (isCreated)
+                    {
+                        this->light_engine.addChunk(coordinate, *chunk);
+                    }
+                    this->markEdited(coordinate, changedMin, changedMax);
+
+                    isChanged = true;
+                }
+            }
+        }
+
+        if (isChanged)
+        {
+            ++this->edits_total;
+            this->first_edit_this_tick = this->first_edit_this_tick.value_or(start);
+        }
+    }
+
+    void World::markEdited(ChunkCoordinate coordinate, LocalPosition changedMin, LocalPosition changedMax)
+    {
+        this->queued_brickmap_version = this->simulation.setChunk(coordinate, *this->voxels.getChunk(coordinate));
+        this->markChunkEdited(coordinate);
+        this->edited_this_tick.insert(coordinate);
+        ++this->edited_chunks_total;
+
+        // only neighbours whose padded border holds a changed voxel mesh
+        // against it, edges and corners included for ambient occlusion
+        for (std::int32_t dy = -1; dy <= 1; ++dy)
+        {
+            for (std::int32_t dz = -1; dz <= 1; ++dz)
+            {
+                for (std::int32_t dx = -1; dx <= 1; ++dx)
+                {
+                    const ChunkCoordinate offset {dx, dy, dz};
+                    bool isTouched = offset != ChunkCoordinate {0, 0, 0};
+
+                    for (glm::length_t axis = 0; axis < 3; ++axis)
+                    {
+                        isTouched &= offset[axis] >= 0 || changedMin[axis] == 0;
+                        isTouched &= offset[axis] <= 0 || changedMax[axis] == ChunkExtent - 1;
+                    }
+
+                    const ChunkCoordinate neighbour = coordinate + offset;
+
+                    if (isTouched && this->voxels.getChunk(neighbour) != nullptr)
+                    {
+                        this->markChunkDirty(neighbour);
+                        this->edited_this_tick.insert(neighbour);
+                    }
+                }
+            }
+        }
+    }
+
+    void World::formEditBatch()
+    {
+        if (this->edited_this_tick.empty())
+        {
+            return;
+        }
+
+        const Clock::time_point now = Clock::now();
+
+        EditBatch batch {};
+        batch.edit_times.push_back(*this->first_edit_this_tick);
+        batch.light_changes = this->light_engine.getQueuedChanges();
+
+        for (ChunkCoordinate coordinate : this->edited_this_tick)
+        {
+            batch.waiting.emplace(coordinate, now);
+        }
+
+        this->edited_this_tick.clear();
+        this->first_edit_this_tick.reset();
+
+        // pending batches never share chunks, so one that overlaps is merged
+        // and this batch's newer times win for the chunks in both
+        for (auto pending = this->edit_batches.begin(); pending != this->edit_batches.end();)
+        {
+            const bool isOverlapping = std::ranges::any_of(batch.waiting, [&](const auto& entry)
+            {
+                return pending->waiting.contains(entry.first) || pending->meshes.contains(entry.first);
+            });
+
+            if (!isOverlapping)
+            {
+                ++pending;
+                continue;
+            }
+
+            batch.edit_times.insert(batch.edit_times.end(), pending->edit_times.cbegin(), pending->edit_times.cend());
+            batch.light_changes = std::max(batch.light_changes, pending->light_changes);
+            batch.waiting.insert(pending->waiting.cbegin(), pending->waiting.cend());
+            batch.meshes.merge(pending->meshes);
+
+            pending = this->edit_batches.erase(pending);
+        }
+
+        this->edit_batches.push_back(std::move(batch));
+    }
+
+    bool World::holdForEditBatch(MeshingPipeline::Result& result)
+    {
+        for (EditBatch& batch : this->edit_batches)
+        {
+            const auto waiting = batch.waiting.find(result.coordinate);
+
+            if (waiting == batch.waiting.end() && !batch.meshes.contains(result.coordinate))
+            {
+                continue;
+            }
+
+            // an older snapshot is still newer than what's drawn, but it
+            // waits for the one with the edits all the same
+            if (waiting != batch.waiting.end() && result.snapshot_time >= waiting->second)
+            {
+                batch.waiting.erase(waiting);
+            }
+
+            batch.meshes.insert_or_assign(result.coordinate, std::move(result.mesh));
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void World::uploadCompletedEditBatches(render::Renderer& renderer)
+    {
+        const Clock::time_point now = Clock::now();
+
+        for (auto batch = this->edit_batches.begin(); batch != this->edit_batches.end();)
+        {
+            if (!batch->waiting.empty() || batch->light_changes > this->settled_light_changes)
+            {
+                ++batch;
+                continue;
+            }
+
+            // all at once, ignoring MaxUploadsPerTick, anything less shows
+            // half an edit for a frame
+            for (auto& [coordinate, mesh] : batch->meshes)
+            {
+                this->uploadChunkMesh(renderer, 0, coordinate, std::move(mesh));
+            }
+
+            for (Clock::time_point editTime : batch->edit_times)
+            {
+                this->edit_latencies.push_back(now - editTime);
+
+                if (this->edit_latencies.size() > StatisticsWindow)
+                {
+                    this->edit_latencies.pop_front();
+                }
+            }
+
+            batch = this->edit_batches.erase(batch);
+        }
+    }
+
+    void World::dropFromEditBatches(ChunkCoordinate coordinate)
+    {
+        for (EditBatch& batch : this->edit_batches)
+        {
+            batch.waiting.erase(coordinate);
+            batch.meshes.erase(coordinate);
+        }
+    }
+
+    void World::collectLight()
+    {
+        PROFILE_SCOPE("World::collectLight");
+
+        const Clock::time_point      now       = Clock::now();
+        const LightEngine::Collected collected = this->light_engine.collect();
+
+        // light spread for a batch's edits arrives over several ticks, its
+        // chunks join the oldest batch whose light hadn't settled yet
+        const auto unsettled = std::ranges::find_if(this->edit_batches, [&](const EditBatch& batch)
+        {
+            return batch.light_changes > this->settled_light_changes;
+        });
+
+        this->settled_light_changes = collected.settled_changes;
+
+        for (ChunkCoordinate coordinate : collected.stale)
+        {
+            if (this->voxels.getChunk(coordinate) == nullptr)
+            {
+                continue;
+            }
+
+            this->markChunkDirty(coordinate);
+
+            if (unsettled == this->edit_batches.end())
+            {
+                continue;
+            }
+
+            // pending batches never share chunks, one that has it already
+            // waits for the relit mesh instead
+            const auto holding = std::ranges::find_if(this->edit_batches, [&](const EditBatch& batch)
+            {
+                return batch.waiting.contains(coordinate) || batch.meshes.contains(coordinate);
+            });
+
+            EditBatch& batch = holding != this->edit_batches.end() ? *holding : *unsettled;
+            batch.waiting.insert_or_assign(coordinate, now);
+        }
+    }
+
+    void World::markNeighboursDirty(ChunkCoordinate coordinate)
+    {
+        // all 26, ambient occlusion reads the edges and corners of the border
+        for (std::int32_t dy = -1; dy <= 1; ++dy)
+        {
+            for (std::int32_t dz = -1; dz <= 1; ++dz)
+            {
+                for (std::int32_t dx = -1; dx <= 1; ++dx)
+                {
+                    const ChunkCoordinate neighbour = coordinate + ChunkCoordinate {dx, dy, dz};
+
+                    if (neighbour != coordinate && this->voxels.getChunk(neighbour) != nullptr)
+                    {
+                        this->markChunkDirty(neighbour);
+                    }
+                }
+            }
+        }
+    }
+
+    void World::uploadChunkMesh(
+        render::Renderer& renderer,
+        std::size_t       level,
+        ChunkCoordinate   coordinate,
+        ChunkMesh         mesh)
+    {
+        PROFILE_SCOPE("World::uploadChunkMesh");
+
+        auto&      levelObjects = this->chunk_objects[level];
+        const auto existing     = levelObjects.find(coordinate);
+        const bool isResident   = level == 0
+            ? this->voxels.getChunk(coordinate) != nullptr
+            : this->lod_terrain->isResident(level, coordinate);
+
+        // meshes without faces still seal off what's behind them
+        if (level == 0)
+        {
+            if (isResident)
+            {
+                this->occlusion_culler.setConnectivity(coordinate, mesh.connectivity);
+            }
+            else
+            {
+                this->occlusion_culler.eraseConnectivity(coordinate);
+            }
+        }
+
+        // nothing visible, or the chunk was evicted while it was being meshed
+        std::optional<render::Object> object {};
+        if (!mesh.faces.empty() && isResident)
+        {
+            object = renderer.createVoxelObject(mesh.faces);
+
+            if (!object.has_value())
+            {
+                seb::logWarn(
+                    "Voxel face memory is full, chunk {} {} {} of level {} won't be drawn",
+                    coordinate.x,
+                    coordinate.y,
+                    coordinate.z,
+                    level);
+            }
+        }
+
+        if (!object.has_value())
+        {
+            if (existing != levelObjects.end())
+            {
+                this->removeObject(renderer, existing->second);
+            }
+
+            return;
+        }
+
+        const ChunkObject chunk {
+            .level      {level},
+            .coordinate {coordinate},
+            .triangles  {mesh.faces.size() * 2},
+            .mesh_bytes {mesh.faces.size() * sizeof(render::VoxelFace)},
+        };
+
+        // a node's mesh is in cells, scaling it up places it over the
+        // chunks it covers
+        const auto scale = static_cast<float>(getLodScale(level));
+
+        render::Transform placement {};
+        placement.translation = glm::vec3 {toWorldPosition(coordinate, {0, 0, 0})} * scale;
+        placement.scale       = glm::vec3 {scale};
+
+        if (existing != levelObjects.end())
+        {
+            render::Renderer::PipelinedObject& drawn =
+                *this->entities.get<render::Renderer::PipelinedObject>(existing->second);
+
+            // same chunk, same place
+            object->model_index = this->entities.get<TransformNode>(existing->second)->index;
+
+            // the previous mesh may still be drawn by a frame in flight
+            renderer.retireObject(std::move(drawn.object));
+            drawn.object = std::move(*object);
+            *this->entities.get<ChunkObject>(existing->second) = chunk;
+            return;
+        }
+
+        const TransformNode node = this->transform_hierarchy.create(placement);
+        object->model_index      = node.index;
+
+        levelObjects[coordinate] = this->entities.create(
+            render::Renderer::PipelinedObject {
+                .pipeline {render::Renderer::Pipelines::VoxelFaces},
+                .object   {std::move(*object)},
+            },
+            chunk,
+            node);
+    }
+
+    TransformNode World::addSceneNode(
+        std::optional<render::Renderer::PipelinedObject> object,
+        const render::Transform&                         transform,
+        std::optional<Simulation::Motion>                motion,
+        std::optional<TransformNode>                     parent)
+    {
+        const TransformNode node   = this->transform_hierarchy.create(transform, parent);
+        const Entity        entity = this->entities.create(transform, node);
+
+        if (object.has_value())
+        {
+            object->object.model_index = node.index;
+            this->entities.add(entity, std::move(*object));
+        }
+
+        if (motion.has_value())
+        {
+            this->entities.add(entity, SimulatedBody {this->simulation.addBody(transform, *motion)});
+        }
+
+        return node;
+    }
+
+    void World::removeObject(render::Renderer& renderer, Entity entity)
     {
+        renderer.retireObject(std::move(this->entities.get<render::Renderer::PipelinedObject>(entity)->object));
+
+        if (const ChunkObject* chunk = this->entities.get<ChunkObject>(entity); chunk != nullptr)
+        {
+            this->chunk_objects[chunk->level].erase(chunk->coordinate);
+        }
+
+        if (const TransformNode* node = this->entities.get<TransformNode>(entity); node != nullptr)
+        {
+            this->transform_hierarchy.destroy(*node);
+        }
+
+        this->entities.destroy(entity);
+    }
+
+    void World::cullObjects(const CameraView& view)
+    {
+        PROFILE_SCOPE("World::cullObjects");
+
+        const Clock::time_point start = Clock::now();
+
+        this->visible_objects.clear();
+
+        const std::unordered_map<ChunkCoordinate, Entity, ChunkCoordinateHash>& chunks = this->chunk_objects[0];
+
+        if (!chunks.empty())
+        {
+            // nothing past the drawn chunks needs searching
+            ChunkCoordinate min {std::numeric_limits<std::int32_t>::max()};
+            ChunkCoordinate max {std::numeric_limits<std::int32_t>::min()};
+
+            for (const auto& [coordinate, entity] : chunks)
+            {
+                min = glm::min(min, coordinate);
+                max = glm::max(max, coordinate);
+            }
+
+            this->occlusion_culler.cull(view, min, max);
+        }
+
+        const ChunkPrioritizer frustum {view};
+
+        CullingStatistics statistics {};
+
+        // the scene's own objects are always drawn
+        this->entities.forEach<const render::Transform, const render::Renderer::PipelinedObject>(
+            [&](const render::Transform&, const render::Renderer::PipelinedObject& object)
+            {
+                this->visible_objects.push_back(&object);
+            });
+
+        this->entities.forEach<const ChunkObject, const render::Renderer::PipelinedObject>(
+            [&](const ChunkObject& chunk, const render::Renderer::PipelinedObject& object)
+            {
+                if (chunk.level == 0)
+                {
+                    ++statistics.chunk_objects;
+                    statistics.in_frustum += frustum.isInFrustum(chunk.coordinate) ? 1U : 0U;
+
+                    if (this->far_field_distance.has_value()
+                        && getDistanceToChunk(view.position, chunk.coordinate) > *this->far_field_distance)
+                    {
+                        ++statistics.past_far_field;
+                        return;
+                    }
+
+                    if (!this->occlusion_culler.isVisible(chunk.coordinate))
+                    {
+                        return;
+                    }
+
+                    ++statistics.drawn;
+                }
+
+                this->visible_objects.push_back(&object);
+            });
+
+        statistics.visited_steps = this->occlusion_culler.getStatistics().visited_steps;
+        statistics.cull_time     = Clock::now() - start;
+
+        this->culling_statistics = statistics;
+    }
+
+    void World::loadDefaultScene(const render::Renderer& renderer)
+    {
+        render::Transform gizmo {};
+        gizmo.scale = {4.0f, 4.0f, 4.0f};
+
         auto [v, i] = render::Object::readVerticesFromFile("../models/gizmo.obj");
-        this->objects.push_back(
+        this->addSceneNode(
             render::Renderer::PipelinedObject
             {
                 .pipeline {render::Renderer::Pipelines::WorldVoxels},
                 .object   {renderer.createObject(std::move(v), std::move(i))}
-            }
+            },
+            gizmo,
+            Simulation::Motion {.velocity {0.0f, 0.0f, 0.0f}, .angular_velocity {0.0f, 0.5f, 0.0f}}
         );
-        this->objects.at(0).object.transform.scale = {4.0f, 4.0f, 4.0f};
+
+        render::Transform cube {};
+        cube.scale = {100.0f, 100.0f, 100.0f};
+        cube.translation.y -= 120.0f;
 
         auto [b, j] = render::Object::readVerticesFromFile("../models/colored_cube.obj");
-        this->objects.push_back(
+        this->addSceneNode(
             render::Renderer::PipelinedObject
             {
                 .pipeline {render::Renderer::Pipelines::FaceTexture},
                 .object   {renderer.createObject(std::move(b), std::move(j))}
-            }
+            },
+            cube,
+            std::nullopt
         );
-        this->objects.at(1).object.transform.scale = {100.0f, 100.0f, 100.0f};
-        this->objects.at(1).object.transform.translation.y -= 120.0f;
+
+        render::Transform model {};
+        model.scale = {500.0f, 500.0f, 500.0f};
+        model.translation.x += 400.0f;
+        model.translation.y += 100.0f;
 
         auto [k, l] = render::Object::readVerticesFromFile("../models/64k.obj");
-        this->objects.push_back(
+        this->addSceneNode(
             render::Renderer::PipelinedObject
             {
                 .pipeline {render::Renderer::Pipelines::FaceTexture},
                 .object   {renderer.createObject(std::move(k), std::move(l))}
-            }
+            },
+            model,
+            std::nullopt
         );
-        this->objects.at(2).object.transform.scale = {500.0f, 500.0f, 500.0f};
-        this->objects.at(2).object.transform.translation.x += 400.0f;
-        this->objects.at(2).object.transform.translation.y += 100.0f;
     }
 
-    const std::vector<render::Renderer::PipelinedObject>& World::getObjects() const 
+    /// A grid of small spinning objects, mostly measures per draw overhead.
+    /// The whole grid slowly turns about its center as well
+    void World::loadCubesScene(const render::Renderer& renderer)
     {
-        return this->objects;
+        constexpr std::size_t GridSize = 24;
+        constexpr float       Spacing  = 12.0f;
+        constexpr float       Center   = static_cast<float>(GridSize - 1) * Spacing / 2.0f;
+
+        auto [v, i] = render::Object::readVerticesFromFile("../models/colored_cube.obj");
+
+        render::Transform pivot {};
+        pivot.translation = {Center, 0.0f, Center};
+
+        const TransformNode grid = this->addSceneNode(
+            std::nullopt,
+            pivot,
+            Simulation::Motion {.velocity {0.0f, 0.0f, 0.0f}, .angular_velocity {0.0f, 0.1f, 0.0f}}
+        );
+
+        for (std::size_t x = 0; x < GridSize; ++x)
+        {
+            for (std::size_t z = 0; z < GridSize; ++z)
+            {
+                render::Transform transform {};
+                transform.scale = {4.0f, 4.0f, 4.0f};
+                transform.translation = {
+                    static_cast<float>(x) * Spacing - Center,
+                    0.0f,
+                    static_cast<float>(z) * Spacing - Center
+                };
+
+                this->addSceneNode(
+                    render::Renderer::PipelinedObject
+                    {
+                        .pipeline {
+                            (x + z) % 2 == 0
+                            ? render::Renderer::Pipelines::FaceTexture
+                            : render::Renderer::Pipelines::WorldVoxels
+                        },
+                        .object   {renderer.createObject(v, i)}
+                    },
+                    transform,
+                    Simulation::Motion {
+                        .velocity         {0.0f, 0.0f, 0.0f},
+                        .angular_velocity {0.0f, 0.5f + static_cast<float>((x + z) % 4) * 0.25f, 0.0f}
+                    },
+                    grid
+                );
+            }
+        }
+    }
+
+    /// Endless noise terrain with caves streamed in around the camera,
+    /// generated and meshed over the first frames, then 2x, 4x and 8x
+    /// coarser levels out to eight times the full resolution radius.
+    /// Edited chunks are kept in region files under terrain in the save
+    /// directory
+    void World::loadTerrainScene(const render::Renderer&)
+    {
+        constexpr std::uint32_t TerrainSeed = 1337;
+        constexpr std::int32_t  LoadRadius  = 12;
+        constexpr std::int32_t  MaxChunkY   = TerrainGenerator::MaxSurfaceHeight / ChunkExtent + 1;
+
+        const std::size_t generatorWorkers =
+            std::max(std::size_t {1}, MeshingPipeline::getDefaultWorkerCount() / 2);
+
+        this->region_store = std::make_unique<RegionStore>(this->save_directory / "terrain");
+        this->streamer     = std::make_unique<ChunkStreamer>(
+            StreamingSettings {
+                .load_radius         {LoadRadius},
+                .unload_radius       {LoadRadius + 2},
+                .min_chunk_y         {0},
+                .max_chunk_y         {MaxChunkY},
+                .max_resident_chunks {2048},
+                .max_resident_bytes  {std::size_t {512} * 1024 * 1024},
+                .max_cached_bytes    {std::size_t {128} * 1024 * 1024},
+                .max_generating      {generatorWorkers * 4},
+            },
+            [terrain = TerrainGenerator {TerrainSeed}](ChunkCoordinate coordinate)
+            {
+                return terrain.generateChunk(coordinate);
+            },
+            generatorWorkers,
+            this->region_store.get()
+        );
+
+        // edits only ever touch full resolution chunks, the coarser levels
+        // are always freshly generated
+        this->lod_terrain = std::make_unique<LodTerrain>(
+            LodSettings {
+                .radii              {LoadRadius * 2, LoadRadius * 4, LoadRadius * 8},
+                .min_chunk_y        {0},
+                .max_chunk_y        {MaxChunkY},
+                .max_resident_bytes {std::size_t {256} * 1024 * 1024},
+                .max_cached_bytes   {std::size_t {32} * 1024 * 1024},
+            },
+            [terrain = TerrainGenerator {TerrainSeed}](ChunkCoordinate node, std::int32_t scale)
+            {
+                return terrain.generateCells(node, scale);
+            },
+            1
+        );
     }
 }
 
-        
\ No newline at end of file
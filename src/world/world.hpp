@@ -1,34 +1,318 @@
 #ifndef SRC_WORLD_WORLD_HPP
 #define SRC_WORLD_WORLD_HPP
 
+#include <array>
+#include <chrono>
 #include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <set>
+#include <span>
 #include <ranges>
+#include <string_view>
 
 #include <render/renderer.hpp>
+#include <util/worker_pool.hpp>
+
+#include "camera_view.hpp"
+#include "chunk_mesh.hpp"
+#include "chunk_streamer.hpp"
+#include "entity_store.hpp"
+#include "light_engine.hpp"
+#include "lod_terrain.hpp"
+#include "meshing_pipeline.hpp"
+#include "occlusion_culler.hpp"
+#include "raycast.hpp"
+#include "simulation.hpp"
+#include "system_scheduler.hpp"
+#include "transform_hierarchy.hpp"
+#include "voxel_storage.hpp"
 
 
 namespace world
 {
+    /// @brief Everything drawn is an entity of the world's EntityStore with
+    /// a render::Renderer::PipelinedObject and a TransformNode whose world
+    /// matrix is the object's model matrix. Chunk meshes also have a
+    /// ChunkObject and are placed once, the scene's own nodes have a
+    /// render::Transform relative to their parent node, and need not be
+    /// drawn themselves. Those that move are bodies of the world's
+    /// Simulation and have their transform interpolated from its snapshots.
     class World
     {        
     public:
-        World(const render::Renderer&);
-        ~World()                       = default;
+        struct EditStatistics
+        {
+            // calls to setVoxel(), fillBox() and fillSphere() that changed a voxel
+            std::size_t edits_total;
+            std::size_t edited_chunks_total;
+            // remeshed chunks held back until the rest of their batch is done
+            std::size_t held_meshes;
+            std::size_t pending_batches;
+
+            // rolling over the last StatisticsWindow edits, from the edit to
+            // the tick that uploaded every mesh it touched
+            std::chrono::duration<double> average_latency;
+            std::chrono::duration<double> worst_latency;
+        };
+
+        /// @brief What one ring of the draw distance costs, level 0 is the
+        /// full resolution chunks
+        struct LodRingStatistics
+        {
+            std::size_t  level;
+            std::int32_t scale;
+            // chunks, or nodes past level 0
+            std::size_t  resident;
+            std::size_t  voxel_bytes;
+
+            std::size_t objects;
+            std::size_t triangles;
+            // packed faces as uploaded
+            std::size_t mesh_bytes;
+        };
+
+        /// @brief Full resolution chunk objects as of the last tick, every
+        /// other object is always drawn
+        struct CullingStatistics
+        {
+            std::size_t chunk_objects;
+            std::size_t in_frustum;
+            // left to the far field, see setFarFieldDistance()
+            std::size_t past_far_field;
+            // in the frustum and reached by the OcclusionCuller
+            std::size_t drawn;
+            std::size_t visited_steps;
+
+            std::chrono::duration<double> cull_time;
+        };
+
+        /// @brief Loads the scene named @param scene, see getSceneNames().
+        /// Scenes that save keep their files under @param saveDirectory
+        World(
+            const render::Renderer&,
+            std::string_view      scene         = "default",
+            std::filesystem::path saveDirectory = getDefaultSaveDirectory());
+        /// @brief Saves edited chunks of streamed scenes
+        ~World();
 
         World(const World&)            = delete;
         World(World&&)                 = delete;
         World& operator=(const World&) = delete;
         World& operator=(World&&)      = delete;
 
-        [[nodiscard]] const std::vector<render::Renderer::PipelinedObject>& getObjects() const;
+        [[nodiscard]] static std::vector<std::string_view> getSceneNames();
+        /// @brief saves next to the executable, wherever it's run from
+        [[nodiscard]] static std::filesystem::path getDefaultSaveDirectory();
+        /// @brief @param camera seen with the projection the renderer draws
+        /// with at @param extent
+        [[nodiscard]] static CameraView getCameraView(const render::Camera& camera, vk::Extent2D extent);
+
+        [[nodiscard]] const EntityStore& getEntities() const;
+        /// @brief What the camera of the last tick might see, valid until
+        /// the next one
+        [[nodiscard]] const std::vector<const render::Renderer::PipelinedObject*>& getVisibleObjects() const;
+        [[nodiscard]] VoxelStorage& getVoxels();
+        [[nodiscard]] const VoxelStorage& getVoxels() const;
+        [[nodiscard]] MeshingPipeline::Statistics getMeshingStatistics() const;
+        /// @brief Empty for scenes that don't stream their chunks
+        [[nodiscard]] std::optional<ChunkStreamer::Statistics> getStreamingStatistics() const;
+        [[nodiscard]] EditStatistics getEditStatistics() const;
+        /// @brief Level 0, then every level of scenes drawn with LodTerrain
+        [[nodiscard]] std::vector<LodRingStatistics> getLodStatistics() const;
+        [[nodiscard]] CullingStatistics getCullingStatistics() const;
+        [[nodiscard]] LightEngine::Statistics getLightingStatistics() const;
+        [[nodiscard]] SystemScheduler::Statistics getSystemStatistics() const;
+        [[nodiscard]] Simulation::Statistics getSimulationStatistics() const;
+        [[nodiscard]] TransformHierarchy::Statistics getTransformStatistics() const;
+
+        /// @brief Full resolution chunks entirely further than @param distance
+        /// from the camera are ray marched through the simulation's brickmap
+        /// of every resident chunk by the renderer instead of drawn, see render::FarField. nullopt, the
+        /// default, draws every chunk
+        void setFarFieldDistance(std::optional<float> distance);
+        [[nodiscard]] std::optional<float> getFarFieldDistance() const;
+        /// @brief True once the renderer has been handed the brickmap of
+        /// every chunk streamed, evicted or edited so far, always with the
+        /// far field off. The brickmap trails the chunks by a simulation tick
+        [[nodiscard]] bool isFarFieldCurrent() const;
+        /// @brief Nothing in range is missing or being generated, always
+        /// true for scenes that don't stream their chunks
+        [[nodiscard]] bool isStreamingSettled() const;
+
+        /// @brief Streams chunks in and out around @param camera, hands dirty
+        /// chunks to the meshing workers, nearest first, and uploads up to
+        /// MaxUploadsPerTick of their finished meshes, full resolution ones
+        /// before those of coarser levels. Meshes of evicted chunks are
+        /// retired to the renderer rather than freed. Places the simulation's
+        /// bodies as of a tick ago and hands the renderer its brickmap if it
+        /// changed and the far field is on, runs every system over the
+        /// entities, writes the model matrices that changed to the renderer
+        /// and ends by culling the objects the camera can't see
+        void tick(render::Renderer&, const render::Camera& camera);
+
+        /// @brief The chunk at @param coordinate gets its VoxelFaces object
+        /// rebuilt from the voxels at the time it is dispatched, or removed
+        /// if it no longer has any visible faces
+        void markChunkDirty(ChunkCoordinate coordinate);
+        /// @brief markChunkDirty(), and streamed scenes save the chunk when
+        /// it's evicted rather than generating it again
+        void markChunkEdited(ChunkCoordinate coordinate);
 
-        void tick();
+        /// @brief True once all light has spread and every dirty chunk's
+        /// mesh has been uploaded
+        [[nodiscard]] bool isMeshingIdle() const;
+
+        /// Edits remesh only the chunks they change, plus the neighbours
+        /// whose border holds a changed voxel. Every edit made between two ticks is one
+        /// batch: its chunks keep their current meshes until all of them have
+        /// been remeshed, then are swapped in the same tick so no seams open
+        /// up in between. Streamed scenes ignore edits to chunks that aren't
+        /// resident, other scenes create them. Light spreads on the light
+        /// engine's thread, the chunks it changes join the batch until all of
+        /// the batch's light has settled.
+        void setVoxel(WorldPosition, Voxel);
+        /// @brief Every voxel in [@param min, @param max]
+        void fillBox(WorldPosition min, WorldPosition max, Voxel);
+        /// @brief Every voxel whose center is within @param radius of @param center
+        void fillSphere(glm::vec3 center, float radius, Voxel);
+
+        /// @brief The first solid voxel along @param ray, see world::raycast()
+        [[nodiscard]] std::optional<RaycastHit> raycast(const Ray& ray) const;
+        /// @brief Many rays at once, @param hits parallel to @param rays
+        void raycast(std::span<const Ray> rays, std::span<std::optional<RaycastHit>> hits) const;
 
     private:
+        // object creation stalls the main thread, this bounds it per frame
+        constexpr static std::size_t MaxUploadsPerTick = 32;
+        // enough for the workers to stay busy until the next tick
+        constexpr static std::size_t MaxChunksInFlight = MaxUploadsPerTick * 2;
+        constexpr static std::size_t StatisticsWindow  = 256;
+        // bodies move this often however fast frames are
+        constexpr static double SimulationTickRate = 60.0;
+
+        using Clock = MeshingPipeline::Clock;
+
+        /// @brief Which mesh an object is, and what it cost to upload, a
+        /// component of every chunk object
+        struct ChunkObject
+        {
+            std::size_t     level;
+            ChunkCoordinate coordinate;
+            std::size_t     triangles;
+            std::size_t     mesh_bytes;
+        };
+
+        /// @brief Index of an entity's body in the simulation's snapshots
+        struct SimulatedBody
+        {
+            std::size_t index;
+        };
+
+        /// @brief Chunks remeshed for edits, uploaded together once each
+        /// one's mesh includes every edit
+        struct EditBatch
+        {
+            // the first edit of every tick merged into this batch
+            std::vector<Clock::time_point> edit_times;
+            // meshes snapshotted before its time miss an edit
+            std::unordered_map<ChunkCoordinate, Clock::time_point, ChunkCoordinateHash> waiting;
+            // newest mesh of every chunk, including those still waiting
+            std::unordered_map<ChunkCoordinate, ChunkMesh, ChunkCoordinateHash> meshes;
+            // the light engine's queued changes when the edits were made,
+            // the batch waits until that many have settled
+            std::uint64_t light_changes;
+        };
+
+        /// @brief @param coordinate is a node past level 0
+        void uploadChunkMesh(render::Renderer&, std::size_t level, ChunkCoordinate coordinate, ChunkMesh);
+        void markNeighboursDirty(ChunkCoordinate);
+        /// @brief Takes the light spread since the last tick, remeshing the
+        /// chunks whose light changed
+        void collectLight();
+        /// @brief Sets every position in [@param min, @param max] that
+        /// @param getVoxel returns a voxel for, a chunk at a time
+        void editVoxels(
+            WorldPosition min,
+            WorldPosition max,
+            const std::function<std::optional<Voxel>(WorldPosition)>& getVoxel);
+        /// @brief @param changedMin and @param changedMax bound the changed
+        /// voxels inside the chunk
+        void markEdited(ChunkCoordinate, LocalPosition changedMin, LocalPosition changedMax);
+        /// @brief Turns this tick's edits into a batch, merging it with any
+        /// pending batch it shares chunks with
+        void formEditBatch();
+        /// @brief True if @param result belongs to an edit batch, which took
+        /// its mesh to upload with the rest
+        [[nodiscard]] bool holdForEditBatch(MeshingPipeline::Result& result);
+        void uploadCompletedEditBatches(render::Renderer&);
+        void dropFromEditBatches(ChunkCoordinate);
+        void loadDefaultScene(const render::Renderer&);
+        void loadCubesScene(const render::Renderer&);
+        void loadTerrainScene(const render::Renderer&);
+
+        /// @brief A node of the scene at @param transform relative to
+        /// @param parent, drawn as @param object, always, and moved by
+        /// @param motion if it has them
+        TransformNode addSceneNode(
+            std::optional<render::Renderer::PipelinedObject> object,
+            const render::Transform&                         transform,
+            std::optional<Simulation::Motion>                motion,
+            std::optional<TransformNode>                     parent = std::nullopt);
+        /// @brief Retires the object's mesh and destroys the entity and its node
+        void removeObject(render::Renderer&, Entity);
+        /// @brief Rebuilds visible_objects, full resolution chunks are
+        /// searched for with the occlusion_culler
+        void cullObjects(const CameraView&);
+
+        // shared by the systems, the simulation, the transform hierarchy and
+        // the light engine. First, so it outlives everything that runs on it
+        util::WorkerPool worker_pool;
+        EntityStore entities;
+        SystemScheduler systems;
+        Simulation simulation;
+        TransformHierarchy transform_hierarchy;
+        VoxelStorage voxels;
+        // of the simulation's brickmap last handed to the renderer, and the
+        // first to have every chunk given to the simulation so far
+        std::uint64_t uploaded_brickmap_version;
+        std::uint64_t queued_brickmap_version;
+        std::optional<float> far_field_distance;
+        LightEngine light_engine;
+        MeshingPipeline meshing_pipeline;
+        // null for scenes that are loaded up front, the store outlives the
+        // streamer's workers
+        std::filesystem::path          save_directory;
+        std::unique_ptr<RegionStore>   region_store;
+        std::unique_ptr<ChunkStreamer> streamer;
+        // null for scenes without coarser levels past the streamed chunks
+        std::unique_ptr<LodTerrain>    lod_terrain;
+
+        // each level's chunk objects by chunk
+        std::array<
+            std::unordered_map<ChunkCoordinate, Entity, ChunkCoordinateHash>,
+            LodLevelCount + 1> chunk_objects;
+
+        // chunks edited or dirtied by edits since the last tick
+        std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> edited_this_tick;
+        std::optional<Clock::time_point>                         first_edit_this_tick;
+        std::vector<EditBatch>                                   edit_batches;
+        // of the light engine's changes, as of the last collectLight()
+        std::uint64_t                                            settled_light_changes;
+        std::deque<std::chrono::duration<double>>                edit_latencies;
+        std::size_t                                              edits_total;
+        std::size_t                                              edited_chunks_total;
 
-        std::vector<render::Renderer::PipelinedObject> objects;
+        // connectivity of every meshed full resolution chunk
+        OcclusionCuller                                       occlusion_culler;
+        std::vector<const render::Renderer::PipelinedObject*> visible_objects;
+        CullingStatistics                                     culling_statistics;
     };
 }
 